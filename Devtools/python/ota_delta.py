@@ -0,0 +1,130 @@
+"""Build a delta OTA patch and the matching ota_update manifest.
+
+    python3 Devtools/python/ota_delta.py old.bin new.bin firmware.delta [--url URL]
+
+The patch format is the one applied on the device by
+plant_nanny::services::ota::DeltaPatcher:
+
+    magic u16 | version u8 | reserved u8 | source_size u32 | target_size u32
+    records: diff_len u32 | extra_len u32 | seek i32 | diff[diff_len] | extra[extra_len]
+
+Matching is bsdiff-like: exact seeds found through a hash index of the old
+image are extended while they match approximately, so code that only moved
+or had a few addresses relocated becomes runs of zero diff bytes. Compress the
+patch (heatshrink -e -w 10 -l 5) before serving it; the device chains both.
+"""
+
+import argparse
+import hashlib
+import json
+import struct
+import sys
+
+MAGIC = 0x4450
+VERSION = 1
+SEED = 16
+STEP = 4
+
+
+def index_source(source: bytes) -> dict:
+    index = {}
+    for pos in range(0, len(source) - SEED + 1, STEP):
+        index.setdefault(source[pos:pos + SEED], pos)
+    return index
+
+
+def find_seed(index: dict, target: bytes, pos: int):
+    # Any shifted run of SEED + STEP bytes has one aligned seed in the index
+    for shift in range(STEP):
+        start = pos + shift
+        key = target[start:start + SEED]
+        if len(key) < SEED:
+            return None
+        src = index.get(key)
+        if src is not None and src >= shift:
+            return src - shift, start - shift
+    return None
+
+
+def extend(source: bytes, target: bytes, src: int, dst: int) -> int:
+    """Length of the approximate match: stop where mismatches start to dominate."""
+    best_len = score = best_score = 0
+    length = 0
+    while src + length < len(source) and dst + length < len(target):
+        score += 1 if source[src + length] == target[dst + length] else -1
+        length += 1
+        if score > best_score:
+            best_score, best_len = score, length
+        elif score < best_score - 32:
+            break
+    return best_len
+
+
+def diff(source: bytes, target: bytes) -> bytes:
+    index = index_source(source)
+    records = []  # (src, dst, length): target[dst:dst+length] ~ source[src:src+length]
+    pos = 0
+    extra_start = 0
+    while pos < len(target):
+        seed = find_seed(index, target, pos)
+        if seed is None:
+            pos += STEP
+            continue
+        src, dst = seed
+        length = extend(source, target, src, dst)
+        if dst < extra_start or length < SEED:
+            pos += 1
+            continue
+        records.append((src, dst, length))
+        pos = extra_start = dst + length
+
+    out = bytearray(struct.pack("<HBBII", MAGIC, VERSION, 0, len(source), len(target)))
+    # Leading bytes before the first match go in an extra-only record that seeks to it
+    first_dst = records[0][1] if records else len(target)
+    first_src = records[0][0] if records else 0
+    out += struct.pack("<IIi", 0, first_dst, first_src)
+    out += target[:first_dst]
+
+    for i, (src, dst, length) in enumerate(records):
+        extra_end = records[i + 1][1] if i + 1 < len(records) else len(target)
+        next_src = records[i + 1][0] if i + 1 < len(records) else src + length
+        extra = target[dst + length:extra_end]
+        out += struct.pack("<IIi", length, len(extra), next_src - (src + length))
+        out += bytes((t - s) & 0xFF for s, t in zip(source[src:src + length], target[dst:dst + length]))
+        out += extra
+    return bytes(out)
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("source", help="image currently running on the devices")
+    parser.add_argument("target", help="new image")
+    parser.add_argument("patch", help="patch file to write")
+    parser.add_argument("--url", default="http://<server>/firmware.delta", help="URL the patch is served from")
+    args = parser.parse_args()
+
+    with open(args.source, "rb") as f:
+        source = f.read()
+    with open(args.target, "rb") as f:
+        target = f.read()
+
+    patch = diff(source, target)
+    with open(args.patch, "wb") as f:
+        f.write(patch)
+
+    manifest = {
+        "action": "ota_update",
+        "url": args.url,
+        "sha256": hashlib.sha256(target).hexdigest(),
+        "delta": {
+            "source_size": len(source),
+            "source_sha256": hashlib.sha256(source).hexdigest(),
+        },
+    }
+    print(f"{len(target)} B image, {len(patch)} B patch before compression", file=sys.stderr)
+    print(json.dumps(manifest, indent=2))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -49,6 +49,7 @@ export default defineConfig({
           text: 'Development Guide',
           items: [
             { text: 'Architecture', link: '/development/architecture' },
+            { text: 'Threading Model', link: '/development/threading' },
             { text: 'Project Structure', link: '/development/project-structure' },
             { text: 'Build System', link: '/development/build-system' },
             { text: 'Code Templates', link: '/development/code-templates' }
@@ -68,6 +69,7 @@ export default defineConfig({
           items: [
             { text: 'Logger System', link: '/development/libraries/logger' },
             { text: 'Service Registry', link: '/development/libraries/service-registry' },
+            { text: 'Metrics', link: '/development/libraries/metrics' },
             { text: 'Design Patterns', link: '/development/libraries/patterns' }
           ]
         },
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace common::concurrency
+{
+    /**
+     * @brief Bounded lock-free single-producer/single-consumer queue
+     *
+     * Exactly one task may call push() and exactly one (other) task may call
+     * pop(). Neither side blocks or allocates: push() fails when the queue is
+     * full and counts the drop, pop() fails when it is empty. Slots are
+     * preallocated; T is moved in and out.
+     *
+     * @tparam Capacity Power of two
+     */
+    template <typename T, size_t Capacity>
+    class SpscQueue
+    {
+        static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                      "SpscQueue capacity must be a power of two");
+
+    private:
+        static constexpr size_t MASK = Capacity - 1;
+
+        T _slots[Capacity]{};
+        // Free-running indices; only the producer writes _head, only the consumer _tail
+        std::atomic<size_t> _head{0};
+        std::atomic<size_t> _tail{0};
+        std::atomic<uint32_t> _dropped{0};
+
+    public:
+        SpscQueue() = default;
+        SpscQueue(const SpscQueue &) = delete;
+        SpscQueue &operator=(const SpscQueue &) = delete;
+
+        /**
+         * @brief Producer side
+         * @return false if the queue was full (item dropped)
+         */
+        bool push(T item)
+        {
+            size_t head = _head.load(std::memory_order_relaxed);
+            if (head - _tail.load(std::memory_order_acquire) >= Capacity)
+            {
+                _dropped.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+            _slots[head & MASK] = std::move(item);
+            _head.store(head + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Consumer side
+         * @return false if the queue was empty
+         */
+        bool pop(T &out)
+        {
+            size_t tail = _tail.load(std::memory_order_relaxed);
+            if (tail == _head.load(std::memory_order_acquire))
+            {
+                return false;
+            }
+            out = std::move(_slots[tail & MASK]);
+            _tail.store(tail + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Approximate when called from a third task
+         */
+        size_t size() const
+        {
+            return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+        }
+
+        bool empty() const { return size() == 0; }
+        uint32_t dropped() const { return _dropped.load(std::memory_order_relaxed); }
+        static constexpr size_t capacity() { return Capacity; }
+    };
+
+} // namespace common::concurrency
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+
+namespace common::event
+{
+    using SubscriberId = uint8_t;
+
+    /**
+     * @brief Monotonic microsecond clock (esp_timer_get_time on target)
+     */
+    using Clock = std::function<uint64_t()>;
+
+    static constexpr SubscriberId INVALID_SUBSCRIBER = 0xFF;
+
+    /**
+     * @brief Payload of events that carry no data
+     */
+    struct Empty
+    {
+    };
+
+    /**
+     * @brief Compile-time event descriptor binding an id to its payload type
+     *
+     * @code
+     * using SensorUpdate = common::event::Event<EVENT_SENSOR_UPDATE, SensorSample>;
+     * bus.publish<SensorUpdate>(sample);   // does not compile with another type
+     * @endcode
+     */
+    template <int32_t Id, typename Payload>
+    struct Event
+    {
+        static constexpr int32_t ID = Id;
+        using payload_type = Payload;
+    };
+
+    /**
+     * @brief Delivery statistics of a single subscriber
+     */
+    struct SubscriberStats
+    {
+        uint32_t deliveries = 0;
+        uint32_t lastLatencyUs = 0;   // Publish to handler start
+        uint32_t maxLatencyUs = 0;
+        uint64_t totalLatencyUs = 0;
+        uint32_t maxHandlerUs = 0;    // Handler run time
+
+        uint32_t averageLatencyUs() const { return deliveries > 0 ? static_cast<uint32_t>(totalLatencyUs / deliveries) : 0; }
+    };
+
+    /**
+     * @brief Publication statistics of the bus
+     */
+    struct BusStats
+    {
+        uint32_t published = 0;
+        uint32_t dropped = 0;           // No free slot
+        uint32_t doorbellFailures = 0;  // Wake-up could not be posted (retried on next publish)
+    };
+
+    /**
+     * @brief Typed publish/subscribe bus with preallocated inline payload slots
+     *
+     * publish() may be called from any task and never blocks or allocates:
+     * the payload is copied once into a free slot and the doorbell hook
+     * wakes the dispatching task (on target: an empty esp_event post, so
+     * esp_event never copies payloads). dispatch() runs on that single task
+     * and hands every subscriber a const reference into the slot, in
+     * publication order. When every slot is taken the event is dropped and
+     * counted.
+     *
+     * Payloads must be trivially copyable and fit in SLOT_SIZE; both are
+     * checked at compile time. Subscribing allocates (std::function) and
+     * must be done before publishing starts.
+     */
+    class EventBus
+    {
+    public:
+        static constexpr size_t SLOT_COUNT = 16;
+        static constexpr size_t SLOT_SIZE = 32;
+        static constexpr size_t MAX_SUBSCRIBERS = 16;
+
+    private:
+        enum SlotState : uint8_t
+        {
+            SLOT_FREE = 0,
+            SLOT_WRITING,
+            SLOT_READY,
+        };
+
+        struct Slot
+        {
+            std::atomic<uint8_t> state{SLOT_FREE};
+            int32_t id = 0;
+            uint32_t sequence = 0;
+            uint64_t publishedUs = 0;
+            alignas(std::max_align_t) unsigned char payload[SLOT_SIZE];
+        };
+
+        struct Subscriber
+        {
+            const char *name = nullptr;
+            int32_t id = 0;
+            std::function<void(const void *)> handler;
+            SubscriberStats stats;
+        };
+
+        Clock _clock;
+        Slot _slots[SLOT_COUNT];
+        Subscriber _subscribers[MAX_SUBSCRIBERS];
+        size_t _subscriberCount = 0;
+        std::function<bool()> _doorbell;
+
+        std::atomic<uint32_t> _sequence{0};
+        std::atomic<uint32_t> _cursor{0};
+        std::atomic<bool> _doorbellPending{false};
+        std::atomic<uint32_t> _published{0};
+        std::atomic<uint32_t> _dropped{0};
+        std::atomic<uint32_t> _doorbellFailures{0};
+
+        bool publishRaw(int32_t id, const void *payload, size_t size);
+        SubscriberId subscribeRaw(const char *name, int32_t id, std::function<void(const void *)> handler);
+        void ringDoorbell();
+        void deliver(Slot &slot);
+
+    public:
+        explicit EventBus(Clock clock);
+        ~EventBus() = default;
+
+        EventBus(const EventBus &) = delete;
+        EventBus &operator=(const EventBus &) = delete;
+        EventBus(EventBus &&) = delete;
+        EventBus &operator=(EventBus &&) = delete;
+
+        /**
+         * @brief Publish an event; never blocks
+         * @return false if no slot was free (event dropped)
+         */
+        template <typename E>
+        bool publish(const typename E::payload_type &payload)
+        {
+            using Payload = typename E::payload_type;
+            static_assert(std::is_trivially_copyable_v<Payload>, "Event payloads must be trivially copyable");
+            static_assert(sizeof(Payload) <= SLOT_SIZE, "Event payload does not fit in a bus slot");
+            static_assert(alignof(Payload) <= alignof(std::max_align_t), "Event payload is over-aligned");
+            return publishRaw(E::ID, &payload, sizeof(Payload));
+        }
+
+        template <typename E>
+        bool publish()
+        {
+            static_assert(std::is_same_v<typename E::payload_type, Empty>, "Event carries a payload");
+            return publishRaw(E::ID, nullptr, 0);
+        }
+
+        /**
+         * @brief Register @p handler for event E
+         * @return Subscriber id, INVALID_SUBSCRIBER if the table is full
+         */
+        template <typename E, typename Handler>
+        SubscriberId subscribe(const char *name, Handler handler)
+        {
+            using Payload = typename E::payload_type;
+            static_assert(std::is_invocable_v<Handler &, const Payload &>,
+                          "Handler must accept the event's payload type");
+            return subscribeRaw(name, E::ID, [handler = std::move(handler)](const void *payload) mutable {
+                handler(*static_cast<const Payload *>(payload));
+            });
+        }
+
+        /**
+         * @brief Wake-up hook run after a publish when no dispatch is pending
+         * @param doorbell Returns false if the wake-up could not be posted
+         */
+        void setDoorbell(std::function<bool()> doorbell) { _doorbell = std::move(doorbell); }
+
+        /**
+         * @brief Deliver pending events; call from the dispatching task only
+         * @return Number of events delivered
+         */
+        size_t dispatch();
+
+        size_t subscriberCount() const { return _subscriberCount; }
+        const char *subscriberName(SubscriberId id) const;
+        const SubscriberStats &subscriberStats(SubscriberId id) const;
+        BusStats stats() const;
+        void resetStats();
+    };
+
+} // namespace common::event
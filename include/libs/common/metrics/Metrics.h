@@ -0,0 +1,169 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace common::metrics
+{
+    enum class Kind : uint8_t
+    {
+        Counter,
+        Gauge,
+        Histogram
+    };
+
+    /**
+     * @brief Named value registered in the process-wide metric list
+     *
+     * Metrics link themselves into the registry when constructed and are
+     * never removed, so they must have static storage duration: define them
+     * at namespace scope with the METRIC_* macros. Updating a metric is a
+     * relaxed atomic operation, safe from any task; nothing allocates.
+     */
+    class Metric
+    {
+    private:
+        const char *_name;
+        Kind _kind;
+        Metric *_next;
+
+    protected:
+        Metric(const char *name, Kind kind);
+
+    public:
+        Metric(const Metric &) = delete;
+        Metric &operator=(const Metric &) = delete;
+
+        const char *name() const { return _name; }
+        Kind kind() const { return _kind; }
+        const Metric *next() const { return _next; }
+        Metric *next() { return _next; }
+    };
+
+    /**
+     * @brief Monotonic event count since boot (wraps at 2^32)
+     */
+    class Counter : public Metric
+    {
+    private:
+        std::atomic<uint32_t> _value{0};
+
+    public:
+        explicit Counter(const char *name) : Metric(name, Kind::Counter) {}
+
+        void increment(uint32_t n = 1) { _value.fetch_add(n, std::memory_order_relaxed); }
+        uint32_t value() const { return _value.load(std::memory_order_relaxed); }
+    };
+
+    /**
+     * @brief Last value set
+     */
+    class Gauge : public Metric
+    {
+    private:
+        std::atomic<int32_t> _value{0};
+
+    public:
+        explicit Gauge(const char *name) : Metric(name, Kind::Gauge) {}
+
+        void set(int32_t value) { _value.store(value, std::memory_order_relaxed); }
+        int32_t value() const { return _value.load(std::memory_order_relaxed); }
+    };
+
+    /**
+     * @brief Distribution over fixed buckets
+     *
+     * Bucket i counts values <= bounds[i] (and above the previous bound);
+     * the last bucket counts values above every bound. Unlike counters,
+     * histograms cover the period since the last drain() or commit(), which
+     * is what a snapshot does: each published snapshot shows that interval
+     * only.
+     */
+    class Histogram : public Metric
+    {
+    public:
+        static constexpr size_t MAX_BOUNDS = 8;
+
+        struct Snapshot
+        {
+            uint32_t counts[MAX_BOUNDS + 1] = {};
+            uint32_t count = 0;
+            uint32_t sum = 0;  // Saturates rather than wraps
+            uint32_t max = 0;
+        };
+
+    private:
+        uint32_t _bounds[MAX_BOUNDS] = {};
+        uint8_t _boundCount = 0;
+        std::atomic<uint32_t> _counts[MAX_BOUNDS + 1] = {};
+        std::atomic<uint32_t> _sum{0};
+        std::atomic<uint32_t> _max{0};
+        Snapshot _peeked{};  // Reader only
+
+    public:
+        /**
+         * @param upperBounds Ascending; extra bounds past MAX_BOUNDS are ignored
+         */
+        Histogram(const char *name, std::initializer_list<uint32_t> upperBounds);
+
+        void record(uint32_t value);
+
+        /**
+         * @brief Take the counts recorded since the previous drain and reset them
+         */
+        Snapshot drain();
+
+        /**
+         * @brief Read the counts without resetting them
+         *
+         * commit() then removes exactly what was read; values recorded in
+         * between stay for the next snapshot. One reader at a time.
+         */
+        Snapshot peek();
+        void commit();
+
+        size_t bucketCount() const { return _boundCount + 1u; }
+        const uint32_t *bounds() const { return _bounds; }
+    };
+
+    /**
+     * @brief Walks every metric defined in the firmware
+     */
+    class Registry
+    {
+    public:
+        // Mutable so a caller can update metrics it only knows by name
+        static Metric *first();
+        static size_t count();
+        static const Metric *find(const char *name);
+
+        /**
+         * @brief Write a compact JSON snapshot of every metric
+         *
+         * {"c":{name:value},"g":{name:value},"h":{name:{"le":[bounds],"n":[counts],"sum":s,"max":m}}}
+         * Histograms are only read: they keep their counts until
+         * commitHistograms().
+         * @return Length written, 0 if @p size is too small
+         */
+        static size_t writeJson(char *buffer, size_t size);
+
+        /**
+         * @brief Drain what the last writeJson() read from the histograms
+         *
+         * Call once that snapshot was delivered. Never after a writeJson()
+         * that returned 0.
+         */
+        static void commitHistograms();
+    };
+
+} // namespace common::metrics
+
+/**
+ * Define a metric at namespace scope; it registers itself during static
+ * initialisation. Names are dotted, subsystem first: "mqtt.publish_failed".
+ */
+#define METRIC_COUNTER(variable, name) static ::common::metrics::Counter variable{name}
+#define METRIC_GAUGE(variable, name) static ::common::metrics::Gauge variable{name}
+#define METRIC_HISTOGRAM(variable, name, ...) static ::common::metrics::Histogram variable{name, {__VA_ARGS__}}
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace common::scheduler
+{
+    using TaskId = uint8_t;
+    using TaskFunction = std::function<void()>;
+
+    /**
+     * @brief Monotonic microsecond clock (esp_timer_get_time on target)
+     */
+    using Clock = std::function<uint64_t()>;
+
+    static constexpr TaskId INVALID_TASK = 0xFF;
+
+    /**
+     * @brief Run-time statistics of a single task
+     */
+    struct TaskStats
+    {
+        uint32_t runs = 0;
+        uint32_t lastRunUs = 0;
+        uint32_t maxRunUs = 0;
+        uint64_t totalRunUs = 0;
+        uint32_t overruns = 0;        // Runs longer than the task budget
+        uint32_t deadlineMisses = 0;  // Runs started after their deadline
+        uint32_t maxLatenessUs = 0;   // Worst start delay past the deadline
+        uint32_t skippedPeriods = 0;  // Periodic releases dropped while late
+
+        uint32_t averageRunUs() const { return runs > 0 ? static_cast<uint32_t>(totalRunUs / runs) : 0; }
+    };
+
+    /**
+     * @brief Cooperative earliest-deadline-first scheduler
+     *
+     * Tasks are either periodic (released every periodMs, deadline at the
+     * next release) or event-driven (released by signal(), deadline
+     * deadlineMs after the signal). runOnce() runs every released task once,
+     * earliest deadline first, and returns how long the caller may sleep
+     * before the next release. Tasks must not block: a task that needs to
+     * wait keeps its own deadline and returns.
+     *
+     * Registration allocates (std::function); running does not. signal() may
+     * be called from other tasks; the wake hook lets the owner cut its sleep
+     * short (e.g. with a FreeRTOS task notification).
+     */
+    class Scheduler
+    {
+    public:
+        static constexpr size_t MAX_TASKS = 16;
+        static constexpr uint32_t MAX_IDLE_MS = 1000;
+
+    private:
+        struct Task
+        {
+            const char *name = nullptr;
+            TaskFunction function;
+            uint64_t periodUs = 0;      // 0 = event-driven
+            uint64_t deadlineUs = 0;    // Relative deadline
+            uint32_t budgetUs = 0;      // 0 = no budget check
+            uint64_t releaseAt = 0;     // Periodic: next release
+            uint64_t absoluteDeadline = 0;
+            std::atomic<bool> signaled{false};
+            bool released = false;
+            bool enabled = true;
+            TaskStats stats;
+        };
+
+        Clock _clock;
+        Task _tasks[MAX_TASKS];
+        size_t _count = 0;
+        std::function<void()> _wakeHook;
+
+        TaskId add(const char *name, TaskFunction function, uint64_t periodUs,
+                   uint64_t deadlineUs, uint32_t budgetUs);
+        void release(uint64_t now);
+        void runTask(Task &task);
+
+    public:
+        explicit Scheduler(Clock clock);
+        ~Scheduler() = default;
+
+        Scheduler(const Scheduler &) = delete;
+        Scheduler &operator=(const Scheduler &) = delete;
+        Scheduler(Scheduler &&) = delete;
+        Scheduler &operator=(Scheduler &&) = delete;
+
+        /**
+         * @brief Register a task released every @p periodMs
+         * @param budgetUs Expected worst-case run time, longer runs count as overruns
+         * @return Task id, INVALID_TASK if the table is full
+         */
+        TaskId addPeriodic(const char *name, uint32_t periodMs, TaskFunction function, uint32_t budgetUs = 0);
+
+        /**
+         * @brief Register a task released by signal(), to run within @p deadlineMs
+         */
+        TaskId addEvent(const char *name, uint32_t deadlineMs, TaskFunction function, uint32_t budgetUs = 0);
+
+        /**
+         * @brief Release an event-driven task (or run a periodic one early)
+         */
+        void signal(TaskId id);
+
+        void setPeriod(TaskId id, uint32_t periodMs);
+        void setEnabled(TaskId id, bool enabled);
+        void setWakeHook(std::function<void()> hook) { _wakeHook = std::move(hook); }
+
+        /**
+         * @brief Run all released tasks once, earliest deadline first
+         * @return Milliseconds until the next release (0 = work pending)
+         */
+        uint32_t runOnce();
+
+        size_t taskCount() const { return _count; }
+        const char *name(TaskId id) const;
+        const TaskStats &stats(TaskId id) const;
+        void resetStats();
+    };
+
+} // namespace common::scheduler
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace common::utils
+{
+    /**
+     * @brief CRC-32 (IEEE 802.3, reflected, poly 0xEDB88320)
+     *
+     * Table-driven implementation usable both on target and in native tests.
+     * Pass the previous result as @p crc to checksum data incrementally.
+     */
+    class Crc32
+    {
+    public:
+        static uint32_t compute(const void *data, size_t length, uint32_t crc = 0);
+    };
+
+} // namespace common::utils
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+namespace common::utils
+{
+    /**
+     * @brief Incremental SHA-256 (FIPS 180-4)
+     *
+     * Portable implementation usable both on target and in native tests, so
+     * image hashes can be checked while the data streams through.
+     */
+    class Sha256
+    {
+    public:
+        static constexpr size_t DIGEST_SIZE = 32;
+        static constexpr size_t HEX_SIZE = 2 * DIGEST_SIZE + 1;
+        using Digest = std::array<uint8_t, DIGEST_SIZE>;
+
+        Sha256() { reset(); }
+
+        void reset();
+        void update(const void *data, size_t length);
+
+        /**
+         * @brief Pad and return the digest; call reset() before hashing again
+         */
+        Digest finish();
+
+        static Digest compute(const void *data, size_t length);
+
+        /**
+         * @brief Parse 64 hex characters (either case)
+         */
+        static bool from_hex(const char *hex, Digest &digest);
+
+        /**
+         * @brief Write the digest as 64 lowercase hex characters and a NUL
+         */
+        static void to_hex(const Digest &digest, char (&hex)[HEX_SIZE]);
+
+    private:
+        uint32_t state_[8];
+        uint8_t block_[64];
+        size_t block_length_;
+        uint64_t total_length_;
+
+        void transform(const uint8_t *block);
+    };
+
+} // namespace common::utils
@@ -5,18 +5,31 @@
 #include <memory>
 #include <PubSubClient.h>
 #include "libs/common/patterns/Result.h"
+#include "libs/common/scheduler/Scheduler.h"
+#include "libs/common/concurrency/SpscQueue.h"
+#include "libs/common/event/EventBus.h"
+#include "libs/plant_nanny/Events.h"
+#include <atomic>
 #include <string>
 #include <esp_event.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
 
 // Service interfaces
 #include "libs/plant_nanny/services/button/IButtonHandler.h"
 #include "libs/plant_nanny/services/bluetooth/IPairingManager.h"
 #include "libs/plant_nanny/services/captors/ISensorManager.h"
+#include "libs/plant_nanny/services/health/HealthMonitor.h"
 #include "libs/plant_nanny/services/config/IConfigManager.h"
 #include "libs/plant_nanny/services/mqtt/IMQTTService.h"
 #include "libs/plant_nanny/services/mqtt/IMqttCommandHandler.h"
+#include "libs/plant_nanny/services/mqtt/MQTTService.h"
+#include "libs/plant_nanny/services/bluetooth/PairingManager.h"
 #include "libs/plant_nanny/services/network/INetworkService.h"
-#include "libs/plant_nanny/services/pump/IPump.h"
+#include "libs/plant_nanny/services/pump/IDoser.h"
+#include "libs/plant_nanny/services/power/DutyCycle.h"
+#include "libs/plant_nanny/services/rules/RuleEngine.h"
+#include "libs/plant_nanny/services/timesync/ITimeService.h"
 
 // UI
 #include "libs/plant_nanny/ui/ScreenManager.h"
@@ -34,19 +47,6 @@
 
 namespace plant_nanny
 {
-    enum AppEventId : int32_t {
-        EVENT_WIFI_CONNECTED = 0,
-        EVENT_WIFI_DISCONNECTED,
-        EVENT_MQTT_CONNECTED,
-        EVENT_MQTT_DISCONNECTED,
-        EVENT_OTA_STARTED,
-        EVENT_OTA_COMPLETED,
-        EVENT_OTA_FAILED,
-        EVENT_SENSOR_UPDATE,
-        EVENT_WATERING_STARTED,
-        EVENT_WATERING_COMPLETED,
-    };
-
     /**
      * @brief Main application class using dependency injection (SOLID principles)
      * 
@@ -66,13 +66,89 @@ namespace plant_nanny
         // UI
         ui::ScreenManager _screenManager;
         std::shared_ptr<ui::screens::PairingScreen> _pairingScreen;
+        std::shared_ptr<ui::screens::NormalScreen> _normalScreen;
         
         // State machine
         StateMachine _stateMachine;
+
+        // Threading model (docs/development/threading.md): control and UI run
+        // on the Arduino loop task (core 1), WiFi/MQTT/OTA on the network task
+        // (core 0). They only exchange data through the queues below.
+        static constexpr BaseType_t CONTROL_CORE = 1;
+        static constexpr BaseType_t NETWORK_CORE = 0;
+        static constexpr uint32_t NETWORK_TASK_STACK = 8192;
+        static constexpr uint32_t SENSOR_PERIOD_MS = 10000;
+        static constexpr uint32_t DOSING_PERIOD_MS = 100;
+        static constexpr uint32_t METRICS_PERIOD_MS = 15 * 60 * 1000;
+        static constexpr uint32_t HEALTH_PERIOD_MS = 60 * 1000;
+
+        // Control task (loop task)
+        common::scheduler::Scheduler _scheduler;
+        common::scheduler::TaskId _transitionTask = common::scheduler::INVALID_TASK;
+        common::scheduler::TaskId _commandTask = common::scheduler::INVALID_TASK;
+        common::scheduler::TaskId _sensorTask = common::scheduler::INVALID_TASK;
+        common::scheduler::TaskId _screenTask = common::scheduler::INVALID_TASK;
+        common::scheduler::TaskId _restartTask = common::scheduler::INVALID_TASK;
+        TaskHandle_t _loopTask = nullptr;
+        services::rules::RuleEngine _rules;  // Clock: ruleClockSec()
+        bool _dutyCycleWake = false;         // Timer wake: rules run on the sample store clock
+        bool _sleepRequested = false;        // Network task asked to deep sleep; no new dose from here on
+
+        // Network task
+        common::scheduler::Scheduler _networkScheduler;
+        common::scheduler::TaskId _provisioningTask = common::scheduler::INVALID_TASK;
+        common::scheduler::TaskId _timeSyncTask = common::scheduler::INVALID_TASK;
+        common::scheduler::TaskId _metricsTask = common::scheduler::INVALID_TASK;
+        common::scheduler::TaskId _sleepTask = common::scheduler::INVALID_TASK;
+        TaskHandle_t _networkTask = nullptr;
+        services::mqtt::SensorReading _latestReading;  // Network task only
+        services::health::HealthMonitor _health;        // Network task only
+        std::atomic<TaskHandle_t> _eventLoopTask{nullptr};  // Set by the first bus dispatch
+
+        // Cross-task channels
+        common::concurrency::SpscQueue<services::mqtt::SensorReading, 4> _readings;        // app_loop -> network
+        common::concurrency::SpscQueue<services::mqtt::Command, 8> _commands;              // network -> control
+        struct ProvisioningRequest
+        {
+            services::bluetooth::WifiCredentials wifi;
+            services::bluetooth::MqttConfig mqtt;  // Empty host: keep the stored broker
+        };
+        struct ProvisioningResult
+        {
+            bool connected;
+            std::string ipAddress;
+        };
+        common::concurrency::SpscQueue<ProvisioningRequest, 2> _provisioning;             // control -> network
+        common::concurrency::SpscQueue<ProvisioningResult, 2> _provisioningResults;       // network -> control
+        services::bluetooth::MqttConfig _pendingMqtt;                                      // Control task only
+        common::concurrency::SpscQueue<services::captors::calibration::CalibrationRequest, 2> _calibrations; // BLE host -> control
+        std::atomic<const char*> _requestedScreen{nullptr};                                 // any task -> control
+        std::atomic<bool> _otaInProgress{false};                                            // network -> control
+
+        struct DiagnosticMessage
+        {
+            char json[1536];
+            size_t length;
+        };
+        common::concurrency::SpscQueue<DiagnosticMessage, 2> _diagnostics;                   // control -> network
+        common::concurrency::SpscQueue<ui::screens::NormalScreen::Status, 4> _statusUpdates;  // app_loop -> control
+
+        // Typed event bus, dispatched on the app_loop (esp_event) task
+        common::event::EventBus _bus;
+        ui::screens::NormalScreen::Status _uiStatus;  // app_loop task only
+        bool _mqttWasConnected = false;               // Network task only
         
         // State data
         std::string _currentPin;
-        std::string _pendingTransition;
+        StateId _pendingTransition = StateId::None;
+        uint32_t _lastActivityMs = 0;
+
+        // Duty-cycle mode: stay interactive this long after boot/button press
+        static constexpr uint32_t INTERACTIVE_WINDOW_MS = 2 * 60 * 1000;
+        // Duty-cycle mode: listen for commands after an upload
+        static constexpr uint32_t COMMAND_WINDOW_MS = 500;
+        // Duty-cycle mode: how long an upload waits for SNTP to date its samples
+        static constexpr uint32_t SNTP_WAIT_MS = 3000;
 
         // Initialization helpers
         void setupScreens();
@@ -80,6 +156,43 @@ namespace plant_nanny
         void setupAppCallbacks();
         void initMqttCallbacks();
         void tryConnectNetwork();
+        void setupTasks();
+        void setupNetworkTasks();
+        void startNetworkTask();
+        static void networkTaskMain(void* arg);
+        static void logTaskStats(const common::scheduler::Scheduler& scheduler);
+        void setupEventBus();
+        static void onBusDoorbell(void* arg, esp_event_base_t base, int32_t id, void* data);
+        void publishStatus();
+        void logBusStats() const;
+
+        // Control task
+        void applyPendingTransition();
+        void checkDutyCycleIdle();
+        void sampleSensors();
+        void dispatchCommands();
+        void applyRequestedScreen();
+        void showScreen(const char* screenId);
+        void publishStateTrace();
+        void runCalibration(const services::captors::calibration::CalibrationRequest& request, bool fromBle);
+        void applyRules(const services::config::WateringRules& rules);
+        void waterFromRule(const services::rules::WateringDecision& decision, uint32_t nowSec);
+        void publishDoseReport(const services::pump::DoseReport& report);
+        void restartIfQuiet();
+        static uint32_t uptimeSec();
+        uint32_t ruleClockSec() const;
+
+        // Network task
+        void pollMqtt();
+        void provisionWifi();
+        void publishMetrics();
+        void sampleHealth();
+        [[noreturn]] void enterRequestedSleep();
+
+        // Duty-cycle (deep-sleep) mode
+        [[noreturn]] void runDutyCycleWake(const services::config::DutyCycleConfig& config);
+        size_t uploadSampleBatch(const services::power::RtcSampleStore& store);  // Samples that reached the broker
+        [[noreturn]] void enterDutyCycleSleep(const services::power::DutyCycle& dutyCycle);
 
     public:
         /**
@@ -103,13 +216,24 @@ namespace plant_nanny
         void setCurrentPin(const std::string& pin) override { _currentPin = pin; }
         const std::string& currentPin() const override { return _currentPin; }
         ui::screens::PairingScreen& pairingScreen() override { return *_pairingScreen; }
-        void requestTransition(const std::string& stateId) override { _pendingTransition = stateId; }
+        void requestTransition(StateId stateId) override
+        {
+            _pendingTransition = stateId;
+            _scheduler.signal(_transitionTask);
+        }
+        void armStateTimeout(uint32_t delayMs) override { _stateMachine.armTimeout(delayMs); }
+        void restart() override;
 
 
 
 
+        /**
+         * @brief Typed event bus; publish() is safe from any task
+         */
+        common::event::EventBus& bus() { return _bus; }
+
         // OTA management
-        common::patterns::Result<void> perform_ota_update(const std::string &firmware_url);
+        common::patterns::Result<void> perform_ota_update(const services::ota::Manifest &manifest);
         
     private:
         void initEventLoop();
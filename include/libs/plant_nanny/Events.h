@@ -0,0 +1,66 @@
+#pragma once
+
+#include "libs/common/event/EventBus.h"
+#include "libs/plant_nanny/services/captors/SensorChannel.h"
+#include "libs/plant_nanny/services/pump/DosingController.h"
+#include <cstdint>
+
+namespace plant_nanny
+{
+    enum AppEventId : int32_t {
+        EVENT_WIFI_CONNECTED = 0,
+        EVENT_WIFI_DISCONNECTED,
+        EVENT_MQTT_CONNECTED,
+        EVENT_MQTT_DISCONNECTED,
+        EVENT_OTA_STARTED,
+        EVENT_OTA_COMPLETED,
+        EVENT_OTA_FAILED,
+        EVENT_OTA_PROGRESS,
+        EVENT_SENSOR_UPDATE,
+        EVENT_WATERING_STARTED,
+        EVENT_WATERING_COMPLETED,
+        EVENT_BUS_DOORBELL,  // Internal: wakes the event bus dispatcher
+    };
+
+    /**
+     * @brief Typed events published on the App event bus
+     *
+     * Payloads are small trivially copyable structs stored inline in the
+     * bus slots; see common::event::EventBus.
+     */
+    namespace events
+    {
+        using common::event::Empty;
+        using common::event::Event;
+
+        // Values in the order of ISensorManager::channels()
+        using SensorSample = services::captors::SensorReadings;
+
+        struct OtaTransfer
+        {
+            uint32_t bytes;
+            uint32_t total;  // 0 when unknown
+            uint32_t bytesPerSec;
+        };
+
+        struct Watering
+        {
+            uint32_t durationMs;  // Pump-on time, 0 when starting
+            uint16_t deliveredMl;
+            services::pump::DoseOutcome outcome;
+        };
+
+        using WifiConnected = Event<EVENT_WIFI_CONNECTED, Empty>;
+        using WifiDisconnected = Event<EVENT_WIFI_DISCONNECTED, Empty>;
+        using MqttConnected = Event<EVENT_MQTT_CONNECTED, Empty>;
+        using MqttDisconnected = Event<EVENT_MQTT_DISCONNECTED, Empty>;
+        using OtaStarted = Event<EVENT_OTA_STARTED, Empty>;
+        using OtaCompleted = Event<EVENT_OTA_COMPLETED, Empty>;
+        using OtaFailed = Event<EVENT_OTA_FAILED, Empty>;
+        using OtaProgress = Event<EVENT_OTA_PROGRESS, OtaTransfer>;
+        using SensorUpdate = Event<EVENT_SENSOR_UPDATE, SensorSample>;
+        using WateringStarted = Event<EVENT_WATERING_STARTED, Watering>;
+        using WateringCompleted = Event<EVENT_WATERING_COMPLETED, Watering>;
+    } // namespace events
+
+} // namespace plant_nanny
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "libs/common/metrics/Metrics.h"
+
+/**
+ * @brief Every metric the firmware publishes, in snapshot order
+ *
+ * Defined in one translation unit, which also builds natively, so
+ * test_metrics can check that a snapshot at its largest still fits in one
+ * MQTT packet (IMQTTService::MAX_PAYLOAD_SIZE). Add new metrics here rather
+ * than with the METRIC_* macros in the file that updates them.
+ */
+namespace plant_nanny::metrics
+{
+    using common::metrics::Counter;
+    using common::metrics::Gauge;
+    using common::metrics::Histogram;
+
+    // MQTT
+    extern Counter mqttConnects;
+    extern Counter mqttConnectFailures;
+    extern Counter mqttPublished;
+    extern Counter mqttPublishFailures;
+    extern Counter mqttCommands;
+    extern Histogram mqttPublishUs;  // A publish is a blocking TCP write
+
+    // WiFi
+    extern Counter wifiConnects;
+    extern Counter wifiDisconnects;
+    extern Histogram wifiConnectMs;
+
+    // Sensors
+    extern Counter sensorReadFailures;
+    extern Histogram sensorReadUs;
+
+    // Scheduler passes (idle passes included) and screen renders
+    extern Histogram controlLoopUs;
+    extern Histogram networkLoopUs;
+    extern Histogram uiRenderUs;
+
+    // Sampled by the health task; -1 for a stack not known yet
+    extern Gauge heapFree;
+    extern Gauge heapLargestBlock;
+    extern Gauge heapMinFree;
+    extern Gauge heapFragmentation;
+    extern Gauge heapTrend;
+    extern Gauge controlStackFree;
+    extern Gauge eventLoopStackFree;
+    extern Gauge networkStackFree;
+    extern Gauge healthLevel;
+
+    // Sampled when a snapshot is taken
+    extern Gauge busDropped;
+
+} // namespace plant_nanny::metrics
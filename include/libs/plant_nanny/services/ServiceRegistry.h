@@ -11,6 +11,8 @@
 #include "libs/plant_nanny/services/mqtt/IMQTTService.h"
 #include "libs/plant_nanny/services/mqtt/IMqttCommandHandler.h"
 #include "libs/plant_nanny/services/pump/IPump.h"
+#include "libs/plant_nanny/services/pump/IDoser.h"
+#include "libs/plant_nanny/services/timesync/ITimeService.h"
 
 // Implementations
 #include "libs/plant_nanny/services/button/ButtonHandler.h"
@@ -21,6 +23,8 @@
 #include "libs/plant_nanny/services/mqtt/MQTTService.h"
 #include "libs/plant_nanny/services/mqtt/MqttCommandHandler.h"
 #include "libs/plant_nanny/services/pump/Pump.h"
+#include "libs/plant_nanny/services/pump/Doser.h"
+#include "libs/plant_nanny/services/timesync/TimeService.h"
 
 namespace plant_nanny::services
 {
@@ -39,11 +43,13 @@ namespace plant_nanny::services
      * 1. ConfigManager (no dependencies, needed by PairingManager)
      * 2. ButtonHandler (no dependencies)
      * 3. SensorManager (no dependencies, self-configures)
-     * 4. NetworkManager (no dependencies)
+     * 4. NetworkManager (depends on ConfigManager for the cached WiFi link)
      * 5. MQTTService (no dependencies)
      * 6. Pump (no dependencies)
-     * 7. PairingManager (depends on ConfigManager for device ID)
-     * 8. MqttCommandHandler (depends on Pump)
+     * 7. TimeService (no dependencies)
+     * 8. PairingManager (depends on ConfigManager for device ID)
+     * 9. Doser (depends on Pump, SensorManager and ConfigManager)
+     * 10. MqttCommandHandler (depends on Doser)
      * 
      * IMPORTANT: Call common::service::DefaultRegistry::create() before calling this.
      */
@@ -55,13 +61,15 @@ namespace plant_nanny::services
         // 2. Independent services (no dependencies)
         common::service::add<button::IButtonHandler, button::ButtonHandler>();
         common::service::add<captors::ISensorManager, captors::SensorManager>();
-        common::service::add<network::INetworkService, network::Manager>();
+        common::service::add<network::INetworkService, network::Manager>(); // depends on ConfigManager
         common::service::add<mqtt::IMQTTService, mqtt::MQTTService>();
         common::service::add<pump::IPump, pump::Pump>(config.pumpGpioPin);
+        common::service::add<timesync::ITimeService, timesync::TimeService>();
         
         // 3. Services with dependencies
         common::service::add<bluetooth::IPairingManager, bluetooth::PairingManager>(); // depends on ConfigManager
-        common::service::add<mqtt::IMqttCommandHandler, mqtt::MqttCommandHandler>();   // depends on Pump
+        common::service::add<pump::IDoser, pump::Doser>();                              // depends on Pump, SensorManager
+        common::service::add<mqtt::IMqttCommandHandler, mqtt::MqttCommandHandler>();   // depends on Doser
     }
 
 } // namespace plant_nanny::services
@@ -15,6 +15,7 @@ namespace plant_nanny::services::bluetooth
     using WifiConfigCallback = std::function<void(const WifiCredentials& creds)>;
     using MqttConfigCallback = std::function<void(const MqttConfig& config)>;
     using StateChangeCallback = std::function<void(PairingState newState)>;
+    using CalibrationCallback = std::function<void(const std::string& request)>;
 
     /**
      * @brief Interface for Bluetooth pairing management (DIP - Dependency Inversion Principle)
@@ -41,10 +42,29 @@ namespace plant_nanny::services::bluetooth
         virtual void setMqttConfigCallback(MqttConfigCallback callback) = 0;
         virtual void setStateChangeCallback(StateChangeCallback callback) = 0;
 
+        /**
+         * @brief Called on the BLE host task with "<sensor>:<point>" once the PIN is verified
+         */
+        virtual void setCalibrationCallback(CalibrationCallback callback) = 0;
+
+        /**
+         * @brief Answer a calibration request on its characteristic (JSON)
+         */
+        virtual void notifyCalibration(const std::string& result) = 0;
+
         // Additional methods
         virtual void update() = 0;
         virtual const std::string& getCurrentPin() const = 0;
         virtual common::patterns::Result<void> unpair() = 0;
+
+        /**
+         * @brief Give the BLE controller memory back to the heap
+         *
+         * Irreversible until restart: pairing cannot start afterwards. Only
+         * call it once the device is configured (re-pairing needs a factory
+         * reset, which restarts).
+         */
+        virtual void releaseControllerMemory() = 0;
     };
 
 } // namespace plant_nanny::services::bluetooth
@@ -1,9 +1,12 @@
 #pragma once
 
 #include "libs/plant_nanny/services/bluetooth/IPairingManager.h"
+#include "libs/plant_nanny/services/bluetooth/WifiScanResults.h"
+#include "libs/plant_nanny/services/bluetooth/ProvisioningProtocol.h"
 #include "libs/common/patterns/Result.h"
 #include "libs/common/logger/Logger.h"
 #include "libs/common/service/Accessor.h"
+#include "libs/common/concurrency/SpscQueue.h"
 #include <functional>
 #include <string>
 #include <cstdint>
@@ -36,8 +39,8 @@ namespace plant_nanny::services::bluetooth
 
     struct MqttConfig
     {
-        std::string host;
-        uint16_t port;
+        std::string host;  // Empty: no MQTT settings given
+        uint16_t port = 0;
         std::string username;
         std::string password;
     };
@@ -47,6 +50,7 @@ namespace plant_nanny::services::bluetooth
     using WifiConfigCallback = std::function<void(const WifiCredentials& creds)>;
     using MqttConfigCallback = std::function<void(const MqttConfig& config)>;
     using StateChangeCallback = std::function<void(PairingState newState)>;
+    using CalibrationCallback = std::function<void(const std::string& request)>;
 
     /**
      * @brief Holds all BLE characteristic pointers for the pairing service
@@ -65,8 +69,28 @@ namespace plant_nanny::services::bluetooth
         NimBLECharacteristic* serverId = nullptr;
         NimBLECharacteristic* wifiNetworks = nullptr;
         NimBLECharacteristic* pin = nullptr;
+        NimBLECharacteristic* provisioning = nullptr;
+        NimBLECharacteristic* calibration = nullptr;
     };
 
+    /**
+     * @brief Free heap around the BLE stack lifecycle (bytes, 0 until measured)
+     */
+    struct BleHeapStats
+    {
+        uint32_t beforeInit = 0;
+        uint32_t afterInit = 0;
+        uint32_t afterDeinit = 0;
+        uint32_t afterRelease = 0;
+    };
+
+    /**
+     * @brief BLE pairing over NimBLE
+     *
+     * The NimBLE host and controller only run while pairing: startPairing()
+     * brings the stack up and stopPairing() tears it down completely, so the
+     * heap it uses is available the rest of the time.
+     */
     class PairingManager : public IPairingManager
     {
     private:
@@ -78,7 +102,10 @@ namespace plant_nanny::services::bluetooth
         WifiConfigCallback _wifiConfigCallback;
         MqttConfigCallback _mqttConfigCallback;
         StateChangeCallback _stateChangeCallback;
+        CalibrationCallback _calibrationCallback;
         bool _initialized;
+        bool _controllerReleased = false;
+        BleHeapStats _heapStats;
         unsigned long _pairingStartTime;
         static constexpr unsigned long PAIRING_TIMEOUT_MS = 120000;
 
@@ -88,23 +115,92 @@ namespace plant_nanny::services::bluetooth
         NimBLECharacteristicCallbacks* _pCharCallbacks = nullptr;
         BleCharacteristics _chars;
 
+        // Asynchronous WiFi scan, one channel at a time
+        static constexpr uint8_t SCAN_FIRST_CHANNEL = 1;
+        static constexpr uint8_t SCAN_LAST_CHANNEL = 13;
+        static constexpr uint32_t SCAN_MS_PER_CHANNEL = 300;
+        static constexpr size_t WIFI_NETWORKS_JSON_SIZE = 512;  // NimBLE attribute max length
+        static constexpr size_t CALIBRATION_RESULT_SIZE = 160;
+        WifiScanResults _scanResults;
+        char _networksJson[WIFI_NETWORKS_JSON_SIZE] = "[]";
+        uint8_t _scanChannel = 0;  // 0: no scan running
+
+        /**
+         * @brief Start the asynchronous scan of one channel
+         */
+        void startChannelScan(uint8_t channel);
+
+        /**
+         * @brief Collect finished channel scans and move to the next channel
+         */
+        void pollWifiScan();
+
+        /**
+         * @brief Write the current scan results to the wifiNetworks characteristic and notify
+         */
+        void publishWifiNetworks();
+
+        // Single-write provisioning
+        ProvisioningAssembler _provisioningAssembler;
+
+        /**
+         * @brief Settings received on the NimBLE host task
+         *
+         * Handed to the WiFi/MQTT callbacks by update(), so they always run
+         * on the task that calls update() and their queues keep one producer.
+         */
+        struct ReceivedConfig
+        {
+            WifiCredentials wifi;
+            MqttConfig mqtt;
+        };
+        common::concurrency::SpscQueue<ReceivedConfig, 2> _receivedConfigs;  // NimBLE host -> update()
+
+        /**
+         * @brief Queue settings for update() (NimBLE host task)
+         */
+        void handOver(const WifiCredentials& wifi, const MqttConfig& mqtt);
+
+        /**
+         * @brief Invoke the MQTT callback (if settings were given), then the WiFi one
+         */
+        void deliverConfig(const WifiCredentials& wifi, const MqttConfig& mqtt);
+
+        /**
+         * @brief Check the PIN of a complete provisioning frame and hand its settings over
+         */
+        ProvisioningStatus applyProvisioning();
+
+        /**
+         * @brief Notify [status][chunk index] on the provisioning characteristic
+         */
+        void notifyProvisioningStatus(ProvisioningStatus status, uint8_t index);
+
         /**
          * @brief Generate a random 6-digit PIN
          */
         std::string generatePin();
 
+        /**
+         * @brief Stop the NimBLE host and controller and free their memory
+         */
+        void deinitialize();
+
         /**
          * @brief Setup BLE services and characteristics
          */
         void setupServices();
 
         /**
-         * @brief Read MQTT config from characteristics and invoke callback
+         * @brief Read the MQTT config characteristics
+         * @return False when no broker host was written
          */
-        void processMqttConfig();
+        bool readMqttConfig(MqttConfig& config);
 
     public:
         static constexpr const char* DEVICE_NAME = "PlantNanny";
+        static constexpr uint16_t ATT_MTU = 256;
+        static constexpr uint16_t PROVISIONING_CHUNK_SIZE = ATT_MTU - 3;  // ATT write header
         
         // Status string constants
         struct Status {
@@ -126,6 +222,15 @@ namespace plant_nanny::services::bluetooth
          * @brief Update config status characteristic and notify (used by callbacks)
          */
         void setConfigStatus(const char* status);
+
+        /**
+         * @brief Feed one write of the provisioning characteristic (used by callbacks)
+         *
+         * The PIN, WiFi and MQTT settings arrive together in one framed,
+         * CRC-checked TLV message split into MTU-sized chunks; every chunk is
+         * answered with a notification. Replaces the per-field round-trips.
+         */
+        void handleProvisioningChunk(const uint8_t* data, size_t length);
         
         // Service UUIDs
         static constexpr const char* CONFIG_SERVICE_UUID = "12345678-1234-5678-1234-56789abcdef0";
@@ -141,6 +246,8 @@ namespace plant_nanny::services::bluetooth
         static constexpr const char* PIN_CHAR_UUID = "12345678-1234-5678-1234-56789abcdefa";
         static constexpr const char* MQTT_USERNAME_CHAR_UUID = "12345678-1234-5678-1234-56789abcdefb";
         static constexpr const char* MQTT_PASSWORD_CHAR_UUID = "12345678-1234-5678-1234-56789abcdefc";
+        static constexpr const char* PROVISIONING_CHAR_UUID = "12345678-1234-5678-1234-56789abcdefd";
+        static constexpr const char* CALIBRATION_CHAR_UUID = "12345678-1234-5678-1234-56789abcdefe";
 
         PairingManager();
         ~PairingManager() override;
@@ -165,18 +272,32 @@ namespace plant_nanny::services::bluetooth
         void setWifiConfigCallback(WifiConfigCallback callback) override { _wifiConfigCallback = callback; }
         void setMqttConfigCallback(MqttConfigCallback callback) override { _mqttConfigCallback = callback; }
         void setStateChangeCallback(StateChangeCallback callback) override { _stateChangeCallback = callback; }
+        void setCalibrationCallback(CalibrationCallback callback) override { _calibrationCallback = callback; }
+        void notifyCalibration(const std::string& result) override;
 
         // Additional methods not in interface
         void update();
         const std::string& getCurrentPin() const { return _currentPin; }
         bool isPaired() const { return _state == PairingState::PAIRED; }
-        void handleWifiCredentials(const std::string& ssid, const std::string& password);
         std::string getServerId() const;
+
+        /**
+         * @brief Start an asynchronous WiFi scan
+         *
+         * Returns immediately. Channels are scanned one after the other from
+         * update(); the wifiNetworks characteristic is rewritten and notified
+         * whenever a channel brings a new or stronger network.
+         */
         void scanWifiNetworks();
-        common::patterns::Result<void> unpair();
+        bool isScanningWifi() const { return _scanChannel != 0; }
+        common::patterns::Result<void> unpair() override;
+        void releaseControllerMemory() override;
+        bool isInitialized() const { return _initialized; }
+        const BleHeapStats& heapStats() const { return _heapStats; }
         void onWifiCredentialsReceived(const std::string& ssid, const std::string& password);
         void onMqttConfigReceived(const std::string& host, uint16_t port, 
                                   const std::string& username, const std::string& password);
+        void onCalibrationRequested(const std::string& request);
 
         // Accessors for BLE objects (used by callbacks)
         BleCharacteristics& chars() { return _chars; }
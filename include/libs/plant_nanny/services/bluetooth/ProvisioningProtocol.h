@@ -0,0 +1,134 @@
+#pragma once
+
+#include "libs/common/patterns/Result.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace plant_nanny::services::bluetooth
+{
+    /**
+     * @brief Everything the app sends to provision a device, in one message
+     *
+     * Empty strings and a zero port mean "not sent".
+     */
+    struct ProvisioningMessage
+    {
+        std::string pin;
+        std::string wifiSsid;
+        std::string wifiPassword;
+        std::string mqttHost;
+        uint16_t mqttPort = 0;
+        std::string mqttUsername;
+        std::string mqttPassword;
+        std::string serverId;
+    };
+
+    /**
+     * @brief TLV record types of the provisioning frame body
+     */
+    enum class ProvisioningField : uint8_t
+    {
+        Pin = 0x01,
+        WifiSsid = 0x02,
+        WifiPassword = 0x03,
+        MqttHost = 0x04,
+        MqttPort = 0x05,      // uint16, little endian
+        MqttUsername = 0x06,
+        MqttPassword = 0x07,
+        ServerId = 0x08,
+    };
+
+    /**
+     * @brief Encodes and validates provisioning frames
+     *
+     * Frame layout (little endian):
+     *
+     *     magic u16 | version u8 | reserved u8 | length u16 | body[length] | crc32 u32
+     *
+     * The body is a list of [type u8][length u8][value] records. Unknown types
+     * are skipped so newer apps can talk to older firmware. The CRC (IEEE
+     * 802.3) covers the header and the body.
+     */
+    class ProvisioningCodec
+    {
+    public:
+        static constexpr uint16_t MAGIC = 0x4E50;  // "PN"
+        static constexpr uint8_t VERSION = 1;
+        static constexpr size_t HEADER_SIZE = 6;
+        static constexpr size_t CRC_SIZE = 4;
+        static constexpr size_t MAX_FRAME_SIZE = 512;
+        static constexpr size_t MAX_BODY_SIZE = MAX_FRAME_SIZE - HEADER_SIZE - CRC_SIZE;
+
+        /**
+         * @brief Write a complete frame into @p out
+         * @return Number of bytes written, 0 if @p capacity is too small or a field exceeds 255 bytes
+         */
+        static size_t encode(const ProvisioningMessage& message, uint8_t* out, size_t capacity);
+
+        /**
+         * @brief Validate a frame header and read the announced body length
+         * @return false on bad magic, version or length
+         */
+        static bool readHeader(const uint8_t* header, size_t& bodyLength);
+
+        /**
+         * @brief Check the CRC of a complete frame
+         */
+        static bool checkCrc(const uint8_t* frame, size_t length);
+
+        /**
+         * @brief Parse the TLV body of a CRC-checked frame
+         */
+        static common::patterns::Result<ProvisioningMessage> decode(const uint8_t* frame, size_t length);
+    };
+
+    /**
+     * @brief Answer notified on the provisioning characteristic for every chunk
+     *
+     * Sent as two bytes: [status][chunk index].
+     */
+    enum class ProvisioningStatus : uint8_t
+    {
+        Continue = 0x00,    // Chunk stored, more expected
+        Complete = 0x01,    // Frame received, checked and applied
+        OutOfOrder = 0x02,  // Unexpected index; resend from index 0
+        TooLarge = 0x03,    // Frame exceeds MAX_FRAME_SIZE
+        BadFrame = 0x04,    // Bad magic, version or length
+        BadCrc = 0x05,
+        BadTlv = 0x06,      // Malformed body
+        Rejected = 0x07,    // Wrong PIN or device not waiting for configuration
+    };
+
+    const char* to_string(ProvisioningStatus status);
+
+    /**
+     * @brief Reassembles a frame from MTU-sized GATT writes
+     *
+     * Each write is [index u8][frame bytes]. Index 0 starts a new frame; the
+     * following chunks must come in order. The frame is complete once the
+     * length announced in its header has been received.
+     */
+    class ProvisioningAssembler
+    {
+    private:
+        uint8_t _frame[ProvisioningCodec::MAX_FRAME_SIZE];
+        size_t _received = 0;
+        size_t _expected = 0;     // Full frame size, 0 until the header is in
+        uint8_t _nextIndex = 0;
+        bool _active = false;
+
+    public:
+        /**
+         * @brief Feed one GATT write
+         * @return Continue, Complete (frame() is valid) or an error; errors drop the frame
+         */
+        ProvisioningStatus feed(const uint8_t* chunk, size_t length);
+
+        void reset();
+
+        const uint8_t* frame() const { return _frame; }
+        size_t frameSize() const { return _received; }
+    };
+
+} // namespace plant_nanny::services::bluetooth
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace plant_nanny::services::bluetooth
+{
+    /**
+     * @brief Deduplicated, RSSI-sorted list of scanned networks
+     *
+     * Fixed storage, no allocation: SSIDs are deduplicated through a small
+     * open-addressing hash set and kept strongest first. When full, a new
+     * network only gets in by evicting a weaker one.
+     *
+     * Pure logic so it can be tested natively; PairingManager feeds it from
+     * the per-channel WiFi scans.
+     */
+    class WifiScanResults
+    {
+    public:
+        static constexpr size_t CAPACITY = 10;
+        static constexpr size_t MAX_SSID_LENGTH = 32;
+
+        struct Network
+        {
+            char ssid[MAX_SSID_LENGTH + 1] = {};
+            int8_t rssi = INT8_MIN;
+        };
+
+    private:
+        static constexpr size_t HASH_SLOTS = 32;  // Power of two, > 2 * CAPACITY
+        static constexpr uint8_t EMPTY = 0xFF;
+
+        static_assert((HASH_SLOTS & (HASH_SLOTS - 1)) == 0, "HASH_SLOTS must be a power of two");
+        static_assert(HASH_SLOTS >= 2 * CAPACITY, "Keep the hash set at most half full");
+
+        Network _networks[CAPACITY];
+        uint8_t _order[CAPACITY] = {};  // Indices into _networks, strongest first
+        uint8_t _slots[HASH_SLOTS];     // Indices into _networks, EMPTY if unused
+        size_t _count = 0;
+
+        static uint32_t hash(const char* ssid, size_t length);
+        int find(const char* ssid, size_t length) const;
+        void insertSlot(const char* ssid, size_t length, uint8_t index);
+        void rebuildSlots();
+        void moveUp(size_t position);
+
+    public:
+        WifiScanResults() { clear(); }
+
+        void clear();
+
+        /**
+         * @brief Add a scanned network, or raise the RSSI of a known one
+         *
+         * Empty and over-long SSIDs are ignored.
+         * @return true if the published list changed
+         */
+        bool add(const char* ssid, size_t length, int8_t rssi);
+
+        size_t size() const { return _count; }
+
+        /**
+         * @brief i-th network, strongest first
+         */
+        const Network& at(size_t i) const { return _networks[_order[i]]; }
+
+        /**
+         * @brief Serialize as a JSON array of SSIDs into a caller buffer
+         *
+         * Networks that do not fit are left out, so the output is always a
+         * valid array (the weakest are dropped first).
+         * @return Bytes written (excluding the terminator), 0 if not even "[]" fits
+         */
+        size_t toJson(char* buffer, size_t bufferSize) const;
+    };
+
+} // namespace plant_nanny::services::bluetooth
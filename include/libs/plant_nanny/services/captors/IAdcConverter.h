@@ -0,0 +1,35 @@
+#pragma once
+
+namespace plant_nanny::services::captors
+{
+    /**
+     * @brief Turns an averaged 12-bit ADC conversion into a physical value
+     */
+    class IAdcConverter
+    {
+    public:
+        virtual ~IAdcConverter() = default;
+
+        /**
+         * @param adcValue Mean of the buffered conversions, may be NaN
+         * @return Value in the unit of the channel, NaN when unusable
+         */
+        virtual float convert(float adcValue) const = 0;
+    };
+
+    /**
+     * @brief value = adc * scale + offset, e.g. a battery behind a divider
+     */
+    class LinearConverter : public IAdcConverter
+    {
+    private:
+        float _scale;
+        float _offset;
+
+    public:
+        LinearConverter(float scale, float offset = 0.0f) : _scale(scale), _offset(offset) {}
+
+        float convert(float adcValue) const override { return adcValue * _scale + _offset; }
+    };
+
+} // namespace plant_nanny::services::captors
@@ -1,18 +1,13 @@
 #pragma once
 
+#include "libs/plant_nanny/services/captors/SensorChannel.h"
 #include "libs/plant_nanny/services/captors/temperature/Temperature.h"
+#include "libs/plant_nanny/services/config/IConfigManager.h"
+#include "libs/common/patterns/Result.h"
 #include <cstdint>
 
 namespace plant_nanny::services::captors
 {
-    struct SensorData
-    {
-        float temperatureC = 0.0f;
-        float luminosityPct = 0.0f;
-        float humidityPct = 0.0f;
-        bool valid = false;
-    };
-
     struct SensorPins
     {
         uint8_t thermistorPin = 33;
@@ -32,7 +27,33 @@ namespace plant_nanny::services::captors
         virtual void initialize() = 0;
         virtual void initialize(const SensorPins& pins) = 0;
         virtual void configureThermistor(const temperature::ThermistorConfig& config) = 0;
-        virtual SensorData read() = 0;
+        virtual SensorReadings read() = 0;
+
+        /**
+         * @brief What each index of SensorReadings::values holds
+         */
+        virtual const SensorChannels& channels() const = 0;
+
+        /**
+         * @brief Run an acquisition and return the mean ADC value of one channel
+         *
+         * Corrected for the ADC of the chip but neither converted nor
+         * filtered: what calibration points are captured from.
+         */
+        virtual common::patterns::Result<float> readAdc(int channel) = 0;
+
+        /**
+         * @brief Run an acquisition and return one channel converted but not filtered
+         *
+         * For control loops that need every sample as it is (dosing); the
+         * telemetry filters of read() are left untouched.
+         */
+        virtual common::patterns::Result<float> readUnfiltered(int channel) = 0;
+
+        /**
+         * @brief Use these reference points in the humidity and luminosity converters
+         */
+        virtual void applyCalibration(const config::SensorCalibration& calibration) = 0;
     };
 
 } // namespace plant_nanny::services::captors
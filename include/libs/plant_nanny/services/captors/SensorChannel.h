@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace plant_nanny::services::captors
+{
+    static constexpr size_t MAX_SENSOR_CHANNELS = 6;
+
+    /**
+     * @brief What a sensor channel measures
+     *
+     * The key is the field name in the telemetry JSON and must stay stable
+     * across firmware versions; the server stores readings under it.
+     */
+    struct ChannelInfo
+    {
+        const char *key = "";
+        const char *name = "";
+        const char *unit = "";
+        uint8_t decimals = 1;  // Precision worth displaying
+    };
+
+    /**
+     * @brief Channels of the PlantNanny board
+     */
+    namespace channels
+    {
+        inline constexpr ChannelInfo TEMPERATURE{"temperatureC", "Temperature", "C", 1};
+        inline constexpr ChannelInfo SOIL_HUMIDITY{"humidityPct", "Soil humidity", "%", 0};
+        inline constexpr ChannelInfo LUMINOSITY{"luminosityPct", "Luminosity", "%", 0};
+    } // namespace channels
+
+    /**
+     * @brief Ordered list of the channels a device samples
+     *
+     * The index of a channel is its position in SensorReadings::values.
+     * Filled when the sensor service is initialized and read-only after
+     * that, so every task may read it.
+     */
+    class SensorChannels
+    {
+    private:
+        ChannelInfo _channels[MAX_SENSOR_CHANNELS];
+        size_t _count = 0;
+
+    public:
+        static constexpr int NONE = -1;
+
+        /**
+         * @return Index of the new channel, NONE when full or the key is taken
+         */
+        int add(const ChannelInfo &info)
+        {
+            if (_count >= MAX_SENSOR_CHANNELS || find(info.key) != NONE)
+            {
+                return NONE;
+            }
+            _channels[_count] = info;
+            return static_cast<int>(_count++);
+        }
+
+        void clear() { _count = 0; }
+
+        int find(const char *key) const
+        {
+            for (size_t i = 0; i < _count; i++)
+            {
+                if (strcmp(_channels[i].key, key) == 0)
+                {
+                    return static_cast<int>(i);
+                }
+            }
+            return NONE;
+        }
+
+        size_t size() const { return _count; }
+        const ChannelInfo &operator[](size_t index) const { return _channels[index]; }
+
+        /**
+         * @brief Board channels in the order SensorManager registers them
+         */
+        static const SensorChannels &defaults()
+        {
+            static const SensorChannels board = []()
+            {
+                SensorChannels list;
+                list.add(channels::TEMPERATURE);
+                list.add(channels::SOIL_HUMIDITY);
+                list.add(channels::LUMINOSITY);
+                return list;
+            }();
+            return board;
+        }
+    };
+
+    /**
+     * @brief One value per channel, taken in the same acquisition
+     *
+     * Small and trivially copyable: travels on the event bus and through
+     * the SPSC queues as is. NaN marks a channel without a value.
+     */
+    struct SensorReadings
+    {
+        float values[MAX_SENSOR_CHANNELS] = {NAN, NAN, NAN, NAN, NAN, NAN};
+        uint8_t count = 0;
+        bool valid = false;
+        uint32_t acquiredMs = 0;  // millis() at acquisition, dated by timesync::ITimeService
+
+        float get(int index) const
+        {
+            return index >= 0 && index < count ? values[index] : NAN;
+        }
+
+        void set(int index, float value)
+        {
+            if (index >= 0 && static_cast<size_t>(index) < MAX_SENSOR_CHANNELS)
+            {
+                values[index] = value;
+                if (index >= count)
+                {
+                    count = static_cast<uint8_t>(index + 1);
+                }
+            }
+        }
+    };
+
+    static_assert(MAX_SENSOR_CHANNELS == 6, "Update the NaN initializer of SensorReadings::values");
+
+} // namespace plant_nanny::services::captors
@@ -4,9 +4,21 @@
 #include "libs/plant_nanny/services/captors/temperature/Temperature.h"
 #include "libs/plant_nanny/services/captors/luminosity/Luminosity.h"
 #include "libs/plant_nanny/services/captors/humidity/Humidity.h"
+#include "libs/plant_nanny/services/captors/adc/AdcEngine.h"
+#include "libs/plant_nanny/services/captors/filter/SensorFilter.h"
 
 namespace plant_nanny::services::captors
 {
+    /**
+     * @brief Filter chain settings of each channel, see filter::SensorFilter
+     */
+    struct SensorFilters
+    {
+        filter::FilterConfig temperature;
+        filter::FilterConfig luminosity;
+        filter::FilterConfig humidity;
+    };
+
     /**
      * @brief Configuration for SensorManager
      */
@@ -14,6 +26,7 @@ namespace plant_nanny::services::captors
     {
         SensorPins pins;
         temperature::ThermistorConfig thermistorConfig;
+        SensorFilters filters;
         
         static SensorManagerConfig defaultConfig()
         {
@@ -25,19 +38,59 @@ namespace plant_nanny::services::captors
             config.thermistorConfig.nominalTemperature = 25.0f;
             config.thermistorConfig.betaCoefficient = 3950.0f;
             config.thermistorConfig.seriesResistance = 5600.0f;
+
+            // One reading every SENSOR_PERIOD_MS (10 s)
+            config.filters.temperature.medianWindow = 3;
+            config.filters.temperature.spikeThreshold = 5.0f;
+            config.filters.temperature.emaAlpha = 0.5f;
+
+            config.filters.luminosity.medianWindow = 3;
+
+            // Probe noise must not trigger watering; a real watering is confirmed after 3 readings
+            config.filters.humidity.medianWindow = 5;
+            config.filters.humidity.spikeThreshold = 15.0f;
+            config.filters.humidity.spikeConfirmCount = 3;
+            config.filters.humidity.emaAlpha = 0.3f;
+            config.filters.humidity.maxRatePerSample = 10.0f;
             return config;
         }
     };
 
+    /**
+     * @brief Samples every registered channel in one ADC acquisition
+     *
+     * The board channels (channels::TEMPERATURE, SOIL_HUMIDITY, LUMINOSITY)
+     * are registered by initialize(); addChannel() appends more, e.g. a
+     * second probe or the battery voltage through a LinearConverter.
+     */
     class SensorManager : public ISensorManager
     {
     private:
+        struct AdcChannel
+        {
+            int adcSlot = adc::AdcSampleBuffer::INVALID_SLOT;
+            const IAdcConverter* converter = nullptr;
+            filter::SensorFilter filter;
+        };
+
         temperature::Temperature _temperature;
         luminosity::Luminosity _luminosity;
         humidity::Humidity _humidity;
+        adc::AdcEngine _adc;
+        SensorChannels _channels;
+        AdcChannel _sources[MAX_SENSOR_CHANNELS];
+        int _temperatureChannel = SensorChannels::NONE;
+        int _luminosityChannel = SensorChannels::NONE;
+        int _humidityChannel = SensorChannels::NONE;
         SensorPins _pins;
         bool _initialized = false;
 
+        static constexpr uint32_t WARMUP_MS = 50;
+        static constexpr size_t SAMPLES_PER_CHANNEL = adc::AdcSampleBuffer::CAPACITY;
+        static constexpr uint32_t ACQUIRE_TIMEOUT_MS = 100;
+
+        common::patterns::Result<void> acquire();
+
     public:
         SensorManager();
         explicit SensorManager(const SensorManagerConfig& config);
@@ -49,13 +102,35 @@ namespace plant_nanny::services::captors
         SensorManager& operator=(SensorManager&&) = delete;
 
         void initialize() override;
+
+        /**
+         * @brief Wire the board channels; drops channels added before
+         */
         void initialize(const SensorPins& pins) override;
         void configureThermistor(const temperature::ThermistorConfig& config) override;
-        SensorData read() override;
+        SensorReadings read() override;
+        const SensorChannels& channels() const override { return _channels; }
+        common::patterns::Result<float> readAdc(int channel) override;
+        common::patterns::Result<float> readUnfiltered(int channel) override;
+        void applyCalibration(const config::SensorCalibration& calibration) override;
+
+        /**
+         * @brief Sample another ADC1 pin with every reading
+         * @param converter Must outlive the manager
+         * @return Channel index, SensorChannels::NONE if the pin or the channel list is unavailable
+         */
+        int addChannel(const ChannelInfo& info, uint8_t pin, const IAdcConverter& converter,
+                       const filter::FilterConfig& filter = {});
+
+        /**
+         * @brief Replace the filter settings of the board channels; restarts their chains
+         */
+        void configureFilters(const SensorFilters& filters);
         
         temperature::Temperature& temperature() { return _temperature; }
         luminosity::Luminosity& luminosity() { return _luminosity; }
         humidity::Humidity& humidity() { return _humidity; }
+        adc::AdcEngine& adc() { return _adc; }
         
         bool isInitialized() const { return _initialized; }
     };
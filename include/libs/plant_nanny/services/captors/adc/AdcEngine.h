@@ -0,0 +1,70 @@
+#pragma once
+
+#include "libs/plant_nanny/services/captors/adc/AdcLinearization.h"
+#include "libs/plant_nanny/services/captors/adc/AdcSampleBuffer.h"
+#include "libs/common/patterns/Result.h"
+#include <cstdint>
+
+namespace plant_nanny::services::captors::adc
+{
+    /**
+     * @brief Continuous (DMA) ADC acquisition shared by all analog sensors
+     *
+     * The ADC1 digital controller converts the registered pins round-robin at
+     * SAMPLE_FREQ_HZ and DMA delivers the conversions in frames, so the CPU
+     * only wakes up to sort a full frame into the AdcSampleBuffer. acquire()
+     * runs the controller until every channel holds enough samples, then
+     * stops it: the sensors are only powered for that window.
+     *
+     * Only ADC1 pins can be added (GPIO 32-39 on the ESP32).
+     *
+     * average() is corrected with the eFuse calibration of the chip when it
+     * has one (see AdcLinearization).
+     */
+    class AdcEngine
+    {
+    public:
+        static constexpr uint32_t SAMPLE_FREQ_HZ = 20000;  // Lowest rate of the ESP32 controller, all channels
+        static constexpr uint32_t FRAME_SIZE = 256;        // Bytes per DMA interrupt, 2 per conversion
+        static constexpr uint32_t STORE_SIZE = 1024;       // Driver ring buffer
+
+        static constexpr uint32_t DEFAULT_VREF_MV = 1100;  // Used by esp_adc_cal on chips without eFuse data
+
+        AdcEngine();
+        ~AdcEngine();
+        AdcEngine(const AdcEngine &) = delete;
+        AdcEngine &operator=(const AdcEngine &) = delete;
+
+        /**
+         * @brief Add a pin to the conversion pattern
+         * @return Slot for average()/samples(), AdcSampleBuffer::INVALID_SLOT if not an ADC1 pin
+         */
+        int addPin(uint8_t gpio);
+
+        /**
+         * @brief Remove all pins
+         */
+        void reset();
+
+        /**
+         * @brief Sample all pins until each has samplesPerChannel conversions
+         * @param samplesPerChannel At most AdcSampleBuffer::CAPACITY
+         * @param timeoutMs Upper bound for the whole acquisition
+         */
+        common::patterns::Result<void> acquire(size_t samplesPerChannel, uint32_t timeoutMs);
+
+        float average(int slot) const { return _linearization.apply(_buffer.average(slot)); }
+        const AdcSampleBuffer &samples() const { return _buffer; }
+        bool corrected() const { return _linearization.built(); }
+
+    private:
+        AdcSampleBuffer _buffer;
+        AdcLinearization _linearization;
+        uint8_t _frame[FRAME_SIZE] = {};
+        bool _running = false;
+
+        common::patterns::Result<void> start();
+        void stop();
+    };
+
+} // namespace plant_nanny::services::captors::adc
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace plant_nanny::services::captors::adc
+{
+    /**
+     * @brief Corrects the gain, offset and non-linearity of the ESP32 ADC
+     *
+     * The raw 12-bit conversions are off by up to a few percent from one chip
+     * to the next, and bend near both ends of the 11 dB range. build() samples
+     * a raw -> millivolt characteristic (esp_adc_cal, from the eFuse values
+     * burnt at the factory) at SEGMENTS + 1 points; apply() interpolates it
+     * and rescales to counts of an ideal ADC whose full scale is the sensor
+     * supply, which is what the ratiometric converters expect.
+     *
+     * Applied to the average of a channel rather than to every conversion:
+     * the characteristic is linear within a segment, so both agree unless the
+     * samples straddle a segment boundary. Identity until built.
+     */
+    class AdcLinearization
+    {
+    public:
+        static constexpr size_t SEGMENTS = 32;
+        static constexpr uint32_t RAW_MAX = 4095;
+        static constexpr float SUPPLY_MV = 3300.0f;  // Supply of the dividers
+
+        using Characteristic = std::function<uint32_t(uint32_t raw)>;
+
+        /**
+         * @param rawToMillivolts Input voltage measured for a raw conversion
+         * @param supplyMv Voltage that reads as RAW_MAX on an ideal ADC
+         */
+        void build(const Characteristic &rawToMillivolts, float supplyMv = SUPPLY_MV);
+
+        /**
+         * @brief Back to identity (no eFuse calibration on this chip)
+         */
+        void clear() { _built = false; }
+
+        bool built() const { return _built; }
+
+        /**
+         * @param raw Raw conversion or average of conversions, NaN passes through
+         * @return Corrected value in ideal counts
+         */
+        float apply(float raw) const;
+
+    private:
+        static constexpr float SEGMENT_WIDTH = static_cast<float>(RAW_MAX + 1) / SEGMENTS;
+
+        float _points[SEGMENTS + 1] = {};
+        bool _built = false;
+    };
+
+} // namespace plant_nanny::services::captors::adc
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace plant_nanny::services::captors::adc
+{
+    /**
+     * @brief Per-channel ring buffers filled from ADC DMA frames
+     *
+     * Holds the most recent CAPACITY conversions of each registered ADC1
+     * channel. decode() parses the frames produced by the ESP32 continuous
+     * mode (ADC_DIGI_OUTPUT_FORMAT_TYPE1: 16-bit little endian entries,
+     * channel in bits 12-15, conversion in bits 0-11). No hardware access,
+     * so it is unit tested natively.
+     */
+    class AdcSampleBuffer
+    {
+    public:
+        static constexpr size_t MAX_CHANNELS = 4;
+        static constexpr size_t CAPACITY = 64;
+        static constexpr int INVALID_SLOT = -1;
+
+        /**
+         * @brief Register an ADC1 channel
+         * @return Slot used to read it back, INVALID_SLOT when full or out of range
+         */
+        int addChannel(uint8_t adcChannel);
+
+        /**
+         * @brief Forget all registered channels and samples
+         */
+        void reset();
+
+        /**
+         * @brief Drop the samples, keep the channels
+         */
+        void clear();
+
+        void push(uint8_t adcChannel, uint16_t value);
+
+        /**
+         * @brief Parse a DMA frame into the channel rings
+         * @return Number of conversions that belonged to a registered channel
+         */
+        size_t decode(const uint8_t *frame, size_t length);
+
+        size_t channelCount() const { return _channelCount; }
+        uint8_t channel(int slot) const { return _channels[slot].adcChannel; }
+        size_t count(int slot) const;
+
+        /**
+         * @brief True once every channel holds at least minSamples conversions
+         */
+        bool filled(size_t minSamples) const;
+
+        /**
+         * @brief Mean of the buffered conversions of a slot, NaN when empty
+         */
+        float average(int slot) const;
+
+        /**
+         * @brief Copy the buffered conversions of a slot, oldest first
+         * @return Number of values written
+         */
+        size_t copy(int slot, uint16_t *out, size_t maxCount) const;
+
+    private:
+        struct Channel
+        {
+            uint8_t adcChannel = 0;
+            uint16_t samples[CAPACITY] = {};
+            size_t head = 0;   // Next write position
+            size_t count = 0;
+        };
+
+        Channel _channels[MAX_CHANNELS];
+        size_t _channelCount = 0;
+
+        Channel *find(uint8_t adcChannel);
+    };
+
+} // namespace plant_nanny::services::captors::adc
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "libs/plant_nanny/services/captors/ISensorManager.h"
+#include "libs/plant_nanny/services/config/IConfigManager.h"
+#include "libs/common/patterns/Result.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace plant_nanny::services::captors::calibration
+{
+    enum class CalibrationSensor : uint8_t
+    {
+        Humidity,
+        Luminosity
+    };
+
+    enum class CalibrationPoint : uint8_t
+    {
+        Zero,   // "dry" / "dark"
+        Full,   // "wet" / "bright"
+        Reset   // Forget both points
+    };
+
+    /**
+     * @brief Capture one reference point of one sensor
+     *
+     * The user puts the sensor in the reference condition (probe in dry air,
+     * then in water; LDR covered, then under a lamp) and sends the matching
+     * request over MQTT or BLE. The points may be captured in any order and
+     * redone separately.
+     */
+    struct CalibrationRequest
+    {
+        CalibrationSensor sensor = CalibrationSensor::Humidity;
+        CalibrationPoint point = CalibrationPoint::Reset;
+    };
+
+    // ADC counts required between the two points; a closer pair means the
+    // sensor was not moved or is not connected
+    static constexpr float MIN_SPAN = 200.0f;
+
+    /**
+     * @brief Parse a sensor ("humidity", "luminosity") and a point
+     *
+     * Humidity takes "dry"/"wet", luminosity "dark"/"bright"; both take "reset".
+     */
+    bool parse(const char *sensor, const char *point, CalibrationRequest &request);
+
+    /**
+     * @brief Parse "<sensor>:<point>", as written on the BLE characteristic
+     */
+    bool parse(const std::string &text, CalibrationRequest &request);
+
+    const char *to_string(CalibrationSensor sensor);
+    const char *pointName(const CalibrationRequest &request);
+
+    /**
+     * @brief Channel the sensor is sampled on
+     */
+    const ChannelInfo &channelOf(CalibrationSensor sensor);
+
+    /**
+     * @brief Store a captured point into @p calibration, keeping the other one
+     * @return Failure if @p adc is out of range or too close to the other point
+     */
+    common::patterns::Result<config::SensorCalibration> record(config::SensorCalibration calibration,
+                                                               const CalibrationRequest &request, float adc);
+
+    /**
+     * @brief Capture (or reset) a point, then persist and apply the calibration
+     *
+     * Runs an ADC acquisition: call it from the task that samples the sensors.
+     * @return The captured ADC value, NaN for a reset
+     */
+    common::patterns::Result<float> run(ISensorManager &sensors, config::IConfigManager &config,
+                                        const CalibrationRequest &request);
+
+    /**
+     * @brief Outcome of run() as a devices/<id>/diag document
+     * @return Length written, 0 if @p capacity is too small
+     */
+    size_t toJson(const CalibrationRequest &request, const common::patterns::Result<float> &outcome,
+                  char *out, size_t capacity);
+
+} // namespace plant_nanny::services::captors::calibration
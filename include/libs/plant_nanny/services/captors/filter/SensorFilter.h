@@ -0,0 +1,253 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+namespace plant_nanny::services::captors::filter
+{
+    /**
+     * @brief Settings of one sensor channel's filter chain
+     *
+     * Values are in the unit of the channel (°C, %). Every stage has a
+     * setting that turns it into a pass-through, so a default-constructed
+     * config leaves readings untouched.
+     */
+    struct FilterConfig
+    {
+        uint8_t medianWindow = 1;        // Readings the median is taken over, 1 = off
+        float spikeThreshold = 0.0f;     // Jump from the last accepted reading that counts as a spike, 0 = off
+        uint8_t spikeConfirmCount = 3;   // Consecutive spikes accepted as a real step
+        float emaAlpha = 1.0f;           // Weight of the new reading, 1 = off
+        float maxRatePerSample = 0.0f;   // Largest change between two outputs, 0 = off
+    };
+
+    /**
+     * @brief Median of the last N readings
+     *
+     * @tparam MaxWindow Storage; the window used is FilterConfig::medianWindow
+     */
+    template <size_t MaxWindow>
+    class MedianFilter
+    {
+        static_assert(MaxWindow >= 1, "MedianFilter needs a window");
+
+    private:
+        float _values[MaxWindow]{};
+        size_t _window = 1;
+        size_t _head = 0;
+        size_t _count = 0;
+
+    public:
+        void configure(const FilterConfig &config)
+        {
+            _window = config.medianWindow == 0 ? 1 : (config.medianWindow > MaxWindow ? MaxWindow : config.medianWindow);
+            reset();
+        }
+
+        void reset()
+        {
+            _head = 0;
+            _count = 0;
+        }
+
+        float apply(float value)
+        {
+            if (std::isnan(value))
+            {
+                return value;
+            }
+
+            _values[_head] = value;
+            _head = (_head + 1) % _window;
+            if (_count < _window)
+            {
+                _count++;
+            }
+
+            // Insertion sort of a copy: the window is a handful of readings
+            float sorted[MaxWindow];
+            for (size_t i = 0; i < _count; i++)
+            {
+                size_t j = i;
+                for (; j > 0 && sorted[j - 1] > _values[i]; j--)
+                {
+                    sorted[j] = sorted[j - 1];
+                }
+                sorted[j] = _values[i];
+            }
+            return (_count % 2 == 1) ? sorted[_count / 2]
+                                     : (sorted[_count / 2 - 1] + sorted[_count / 2]) / 2.0f;
+        }
+    };
+
+    /**
+     * @brief Drop isolated jumps, follow a jump once it persists
+     *
+     * A reading further than spikeThreshold from the last accepted one is
+     * replaced by that last value. spikeConfirmCount such readings in a row
+     * are a real change (the pot was watered) and become the new reference.
+     */
+    class SpikeFilter
+    {
+    private:
+        float _threshold = 0.0f;
+        uint8_t _confirmCount = 3;
+        float _last = NAN;
+        uint8_t _rejected = 0;
+
+    public:
+        void configure(const FilterConfig &config)
+        {
+            _threshold = config.spikeThreshold;
+            _confirmCount = config.spikeConfirmCount;
+            reset();
+        }
+
+        void reset()
+        {
+            _last = NAN;
+            _rejected = 0;
+        }
+
+        float apply(float value)
+        {
+            if (std::isnan(value) || _threshold <= 0.0f)
+            {
+                return value;
+            }
+
+            if (!std::isnan(_last) && std::fabs(value - _last) > _threshold && ++_rejected < _confirmCount)
+            {
+                return _last;
+            }
+
+            _rejected = 0;
+            _last = value;
+            return value;
+        }
+
+        uint8_t rejectedInARow() const { return _rejected; }
+    };
+
+    /**
+     * @brief Exponential moving average
+     */
+    class EmaFilter
+    {
+    private:
+        float _alpha = 1.0f;
+        float _value = NAN;
+
+    public:
+        void configure(const FilterConfig &config)
+        {
+            _alpha = config.emaAlpha <= 0.0f || config.emaAlpha > 1.0f ? 1.0f : config.emaAlpha;
+            reset();
+        }
+
+        void reset() { _value = NAN; }
+
+        float apply(float value)
+        {
+            if (std::isnan(value))
+            {
+                return value;
+            }
+            _value = std::isnan(_value) ? value : _value + _alpha * (value - _value);
+            return _value;
+        }
+    };
+
+    /**
+     * @brief Bound the change between two consecutive outputs
+     */
+    class RateLimiter
+    {
+    private:
+        float _maxStep = 0.0f;
+        float _value = NAN;
+
+    public:
+        void configure(const FilterConfig &config)
+        {
+            _maxStep = config.maxRatePerSample;
+            reset();
+        }
+
+        void reset() { _value = NAN; }
+
+        float apply(float value)
+        {
+            if (std::isnan(value) || _maxStep <= 0.0f)
+            {
+                return value;
+            }
+            if (std::isnan(_value))
+            {
+                _value = value;
+            }
+            else if (value > _value + _maxStep)
+            {
+                _value += _maxStep;
+            }
+            else if (value < _value - _maxStep)
+            {
+                _value -= _maxStep;
+            }
+            else
+            {
+                _value = value;
+            }
+            return _value;
+        }
+    };
+
+    /**
+     * @brief Stages applied in order, each fed the output of the previous one
+     *
+     * A stage is any type with configure(const FilterConfig&), reset() and
+     * float apply(float). All state lives in the stages: no allocation.
+     */
+    template <typename... Stages>
+    class FilterChain
+    {
+    private:
+        std::tuple<Stages...> _stages;
+
+    public:
+        FilterChain() = default;
+        explicit FilterChain(const FilterConfig &config) { configure(config); }
+
+        void configure(const FilterConfig &config)
+        {
+            std::apply([&](auto &...stage) { (stage.configure(config), ...); }, _stages);
+        }
+
+        void reset()
+        {
+            std::apply([](auto &...stage) { (stage.reset(), ...); }, _stages);
+        }
+
+        float apply(float value)
+        {
+            std::apply([&](auto &...stage) { ((value = stage.apply(value)), ...); }, _stages);
+            return value;
+        }
+
+        template <typename Stage>
+        Stage &stage() { return std::get<Stage>(_stages); }
+    };
+
+    static constexpr size_t MAX_MEDIAN_WINDOW = 7;
+
+    /**
+     * @brief Chain used for every SensorManager channel
+     *
+     * Spikes go first so they never reach the averages; the rate limit is
+     * last so it bounds what the rules and the pump actually see.
+     */
+    using SensorFilter = FilterChain<SpikeFilter, MedianFilter<MAX_MEDIAN_WINDOW>, EmaFilter, RateLimiter>;
+
+} // namespace plant_nanny::services::captors::filter
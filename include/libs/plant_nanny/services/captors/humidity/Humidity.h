@@ -1,5 +1,7 @@
 #pragma once
 
+#include "libs/plant_nanny/services/captors/IAdcConverter.h"
+#include "libs/plant_nanny/services/config/IConfigManager.h"
 #include <cstdint>
 
 namespace plant_nanny::services::captors::humidity
@@ -7,52 +9,46 @@ namespace plant_nanny::services::captors::humidity
     /**
      * @brief Soil humidity sensor using capacitive or resistive probe
      * 
-     * Reads soil moisture level from a sensor connected to an ADC pin.
+     * Converts the ADC samples of a soil moisture probe.
      * Returns humidity as percentage (0-100%)
      * 0% = dry soil, 100% = wet soil
      */
-    class Humidity
+    class Humidity : public IAdcConverter
     {
     private:
         uint8_t _adcPin = 32;
-        uint8_t _powerPin = 0;
-        bool _hasPowerControl = false;
         bool _initialized = false;
         bool _invertReading = true;  // If true, higher ADC = less humidity (typical for capacitive sensors)
         
         static constexpr int ADC_MAX = 4095;
-        static constexpr uint32_t WARMUP_MS = 50;
-        static constexpr int NUM_SAMPLES = 10;
         
-        // Calibration values (can be adjusted per sensor)
-        int _dryValue = 4095;   // ADC value when sensor is in dry air
-        int _wetValue = 1500;   // ADC value when sensor is in water
-        
-        int readAdc();
-        float adcToHumidity(int adcValue);
-        void powerOn();
-        void powerOff();
+    public:
+        // Typical probe, used until the device is calibrated
+        static constexpr int DEFAULT_DRY_VALUE = 4095;  // ADC value when sensor is in dry air
+        static constexpr int DEFAULT_WET_VALUE = 1500;  // ADC value when sensor is in water
+
+    private:
+        int _dryValue = DEFAULT_DRY_VALUE;
+        int _wetValue = DEFAULT_WET_VALUE;
 
     public:
         Humidity() = default;
-        ~Humidity() = default;
+        ~Humidity() override = default;
         Humidity(const Humidity &) = delete;
         Humidity(Humidity &&) = delete;
         Humidity &operator=(const Humidity &) = delete;
         Humidity &operator=(Humidity &&) = delete;
         
         /**
-         * @brief Initialize with ADC pin only (no power control)
-         * @param adcPin GPIO pin for ADC reading
+         * @brief Initialize with the ADC pin the sensor is wired to
+         * @param adcPin GPIO pin sampled by the AdcEngine
          */
         void initialize(uint8_t adcPin);
-        
+
         /**
-         * @brief Initialize with ADC pin and power control
-         * @param adcPin GPIO pin for ADC reading
-         * @param powerPin GPIO pin for transistor power control
+         * @brief GPIO pin the sensor is wired to
          */
-        void initialize(uint8_t adcPin, uint8_t powerPin);
+        uint8_t pin() const { return _adcPin; }
         
         /**
          * @brief Set whether to invert the reading
@@ -66,12 +62,18 @@ namespace plant_nanny::services::captors::humidity
          * @param wetValue ADC value when sensor is wet
          */
         void calibrate(int dryValue, int wetValue);
+
+        /**
+         * @brief Calibrate from captured points, defaults for the ones not captured
+         */
+        void calibrate(const config::TwoPointCalibration& points);
         
         /**
-         * @brief Read humidity
-         * @return Humidity percentage (0-100), or NaN if error
+         * @brief Convert an averaged ADC conversion of this sensor
+         * @param adcValue Mean of the buffered 12-bit conversions (may be NaN)
+         * @return Humidity percentage (0-100), or NaN if no sample
          */
-        float read();
+        float convert(float adcValue) const override;
         
         /**
          * @brief Check if sensor is initialized
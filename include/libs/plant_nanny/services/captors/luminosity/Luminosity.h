@@ -1,5 +1,7 @@
 #pragma once
 
+#include "libs/plant_nanny/services/captors/IAdcConverter.h"
+#include "libs/plant_nanny/services/config/IConfigManager.h"
 #include <cstdint>
 
 namespace plant_nanny::services::captors::luminosity
@@ -7,59 +9,66 @@ namespace plant_nanny::services::captors::luminosity
     /**
      * @brief Luminosity sensor using LDR (Light Dependent Resistor)
      * 
-     * Reads light level from an LDR connected to an ADC pin.
+     * Converts the ADC samples of an LDR into a light level.
      * Returns luminosity as percentage (0-100%)
      */
-    class Luminosity
+    class Luminosity : public IAdcConverter
     {
     private:
         uint8_t _adcPin = 36;
-        uint8_t _powerPin = 0;
-        bool _hasPowerControl = false;
         bool _initialized = false;
         bool _invertReading = false;  // If true, higher ADC = less light
         
         static constexpr int ADC_MAX = 4095;
-        static constexpr uint32_t WARMUP_MS = 50;
-        static constexpr int NUM_SAMPLES = 10;
-        
-        int readAdc();
-        float adcToLuminosity(int adcValue);
-        void powerOn();
-        void powerOff();
+
+        // Two-point calibration, replaces the full-scale map once set
+        bool _calibrated = false;
+        float _darkValue = 0.0f;
+        float _brightValue = ADC_MAX;
 
     public:
         Luminosity() = default;
-        ~Luminosity() = default;
+        ~Luminosity() override = default;
         Luminosity(const Luminosity &) = delete;
         Luminosity(Luminosity &&) = delete;
         Luminosity &operator=(const Luminosity &) = delete;
         Luminosity &operator=(Luminosity &&) = delete;
         
         /**
-         * @brief Initialize with ADC pin only (no power control)
-         * @param adcPin GPIO pin for ADC reading
+         * @brief Initialize with the ADC pin the sensor is wired to
+         * @param adcPin GPIO pin sampled by the AdcEngine
          */
         void initialize(uint8_t adcPin);
-        
+
         /**
-         * @brief Initialize with ADC pin and power control
-         * @param adcPin GPIO pin for ADC reading
-         * @param powerPin GPIO pin for transistor power control
+         * @brief GPIO pin the sensor is wired to
          */
-        void initialize(uint8_t adcPin, uint8_t powerPin);
+        uint8_t pin() const { return _adcPin; }
         
         /**
          * @brief Set whether to invert the reading
          * @param invert If true, higher ADC = less light (LDR to GND config)
          */
         void setInverted(bool invert) { _invertReading = invert; }
+
+        /**
+         * @brief Map darkValue to 0 % and brightValue to 100 %
+         *
+         * Works for either wiring, the inversion flag no longer applies.
+         */
+        void calibrate(int darkValue, int brightValue);
+
+        /**
+         * @brief Calibrate from captured points, the full-scale ends for the ones not captured
+         */
+        void calibrate(const config::TwoPointCalibration& points);
         
         /**
-         * @brief Read luminosity
-         * @return Luminosity percentage (0-100), or NaN if error
+         * @brief Convert an averaged ADC conversion of this sensor
+         * @param adcValue Mean of the buffered 12-bit conversions (may be NaN)
+         * @return Luminosity percentage (0-100), or NaN if no sample
          */
-        float read();
+        float convert(float adcValue) const override;
         
         /**
          * @brief Check if sensor is initialized
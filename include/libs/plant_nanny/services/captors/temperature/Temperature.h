@@ -1,77 +1,59 @@
 #pragma once
 
+#include "libs/plant_nanny/services/captors/IAdcConverter.h"
+#include "libs/plant_nanny/services/captors/temperature/Thermistor.h"
+#include <cmath>
 #include <cstdint>
 
 namespace plant_nanny::services::captors::temperature
 {
-    /**
-     * @brief Thermistor configuration for temperature calculation
-     * Using Steinhart-Hart Beta model
-     */
-    struct ThermistorConfig
-    {
-        float nominalResistance = 10000.0f;  // Resistance at nominal temperature (Ohms)
-        float nominalTemperature = 25.0f;    // Nominal temperature (Celsius)
-        float betaCoefficient = 3950.0f;     // Beta coefficient of thermistor
-        float seriesResistance = 10000.0f;   // Series resistor value (Ohms)
-    };
-
     /**
      * @brief Temperature sensor using NTC thermistor
      * 
-     * Reads temperature from a thermistor connected to an ADC pin.
+     * Converts the ADC samples of a thermistor into a temperature.
      * Wiring: VCC -- Series Resistor -- ADC Pin -- Thermistor -- GND
      */
-    class Temperature
+    class Temperature : public IAdcConverter
     {
     private:
         uint8_t _adcPin = 35;
-        uint8_t _powerPin = 0;
-        bool _hasPowerControl = false;
         bool _initialized = false;
         ThermistorConfig _config;
-        
-        static constexpr int ADC_MAX = 4095;
-        static constexpr uint32_t WARMUP_MS = 50;
-        static constexpr int NUM_SAMPLES = 10;
-        
-        int readAdc();
-        float adcToTemperature(int adcValue);
-        void powerOn();
-        void powerOff();
+        ThermistorTable<> _table = DEFAULT_THERMISTOR_TABLE;
 
     public:
         Temperature() = default;
-        ~Temperature() = default;
+        ~Temperature() override = default;
         Temperature(const Temperature &) = delete;
         Temperature(Temperature &&) = delete;
         Temperature &operator=(const Temperature &) = delete;
         Temperature &operator=(Temperature &&) = delete;
         
         /**
-         * @brief Initialize with ADC pin only (no power control)
-         * @param adcPin GPIO pin for ADC reading
+         * @brief Initialize with the ADC pin the sensor is wired to
+         * @param adcPin GPIO pin sampled by the AdcEngine
          */
         void initialize(uint8_t adcPin);
-        
+
         /**
-         * @brief Initialize with ADC pin and power control
-         * @param adcPin GPIO pin for ADC reading
-         * @param powerPin GPIO pin for transistor power control
+         * @brief GPIO pin the sensor is wired to
          */
-        void initialize(uint8_t adcPin, uint8_t powerPin);
+        uint8_t pin() const { return _adcPin; }
         
         /**
          * @brief Configure thermistor parameters
-         * @param config Thermistor configuration
+         * @param config Thermistor configuration, rebuilds the lookup table
          */
         void configure(const ThermistorConfig& config);
         
         /**
-         * @brief Read temperature
-         * @return Temperature in Celsius, or NaN if error
+         * @brief Convert an averaged ADC conversion of this sensor
+         * @param adcValue Mean of the buffered 12-bit conversions (may be NaN)
+         * @return Temperature in Celsius, or NaN if out of range
          */
-        float read();
+        float convert(float adcValue) const override { return _initialized ? _table.lookup(adcValue) : NAN; }
+
+        const ThermistorConfig& config() const { return _config; }
         
         /**
          * @brief Check if sensor is initialized
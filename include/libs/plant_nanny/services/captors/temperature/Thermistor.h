@@ -0,0 +1,190 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace plant_nanny::services::captors::temperature
+{
+    /**
+     * @brief Steinhart-Hart coefficients: 1/T = a + b ln(R) + c ln(R)^3
+     *
+     * Three-point fit from a datasheet table, see fitSteinhartHart().
+     * All zero means "not set".
+     */
+    struct SteinhartHartCoefficients
+    {
+        float a = 0.0f;
+        float b = 0.0f;
+        float c = 0.0f;
+
+        constexpr bool isSet() const { return b != 0.0f; }
+    };
+
+    /**
+     * @brief Thermistor configuration for temperature calculation
+     * Using the Beta model unless Steinhart-Hart coefficients are given
+     */
+    struct ThermistorConfig
+    {
+        float nominalResistance = 10000.0f;  // Resistance at nominal temperature (Ohms)
+        float nominalTemperature = 25.0f;    // Nominal temperature (Celsius)
+        float betaCoefficient = 3950.0f;     // Beta coefficient of thermistor
+        float seriesResistance = 10000.0f;   // Series resistor value (Ohms)
+        SteinhartHartCoefficients steinhartHart;  // Full model, more accurate away from nominal
+    };
+
+    namespace detail
+    {
+        constexpr double LN2 = 0.69314718055994530942;
+        constexpr double KELVIN = 273.15;
+
+        /**
+         * @brief Natural logarithm usable in constant expressions
+         *
+         * Halves x into [1, 2), then ln(x) = 2 atanh((x - 1) / (x + 1)).
+         */
+        constexpr double ln(double x)
+        {
+            int exponent = 0;
+            while (x >= 2.0)
+            {
+                x /= 2.0;
+                exponent++;
+            }
+            while (x < 1.0)
+            {
+                x *= 2.0;
+                exponent--;
+            }
+
+            double y = (x - 1.0) / (x + 1.0);  // < 1/3
+            double y2 = y * y;
+            double term = y;
+            double sum = 0.0;
+            for (int n = 1; n < 40; n += 2)
+            {
+                sum += term / n;
+                term *= y2;
+            }
+            return 2.0 * sum + exponent * LN2;
+        }
+    } // namespace detail
+
+    constexpr int THERMISTOR_ADC_MAX = 4095;
+    constexpr int THERMISTOR_ADC_MARGIN = 10;  // Closer to a rail is an open or shorted probe
+
+    /**
+     * @brief Reference conversion with the full equations
+     *
+     * Wiring: VCC -- Thermistor -- ADC -- Series Resistor -- GND.
+     * @return Temperature in Celsius, NaN at the rails
+     */
+    constexpr double thermistorTemperature(const ThermistorConfig &config, double adcValue)
+    {
+        if (!(adcValue > THERMISTOR_ADC_MARGIN && adcValue < THERMISTOR_ADC_MAX - THERMISTOR_ADC_MARGIN))
+        {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        double resistance = config.seriesResistance * (THERMISTOR_ADC_MAX - adcValue) / adcValue;
+        double lnR = detail::ln(resistance);
+
+        double inverseKelvin;
+        if (config.steinhartHart.isSet())
+        {
+            inverseKelvin = config.steinhartHart.a + config.steinhartHart.b * lnR +
+                            config.steinhartHart.c * lnR * lnR * lnR;
+        }
+        else
+        {
+            // Beta equation: 1/T = 1/T0 + (1/B) * ln(R/R0)
+            inverseKelvin = 1.0 / (config.nominalTemperature + detail::KELVIN) +
+                            (lnR - detail::ln(config.nominalResistance)) / config.betaCoefficient;
+        }
+        return 1.0 / inverseKelvin - detail::KELVIN;
+    }
+
+    /**
+     * @brief Steinhart-Hart coefficients through three (temperature, resistance) points
+     */
+    constexpr SteinhartHartCoefficients fitSteinhartHart(double t1, double r1, double t2, double r2, double t3, double r3)
+    {
+        double l1 = detail::ln(r1), l2 = detail::ln(r2), l3 = detail::ln(r3);
+        double y1 = 1.0 / (t1 + detail::KELVIN), y2 = 1.0 / (t2 + detail::KELVIN), y3 = 1.0 / (t3 + detail::KELVIN);
+        double g2 = (y2 - y1) / (l2 - l1);
+        double g3 = (y3 - y1) / (l3 - l1);
+        double c = (g3 - g2) / (l3 - l2) / (l1 + l2 + l3);
+        double b = g2 - c * (l1 * l1 + l1 * l2 + l2 * l2);
+        double a = y1 - (b + l1 * l1 * c) * l1;
+        return SteinhartHartCoefficients{static_cast<float>(a), static_cast<float>(b), static_cast<float>(c)};
+    }
+
+    /**
+     * @brief ADC-to-temperature table with linear interpolation
+     *
+     * 2^SegmentBits equal segments over the 12-bit range, so finding the
+     * segment is a shift and a reading costs one multiply-add instead of a
+     * log and three divisions. Built by a constexpr constructor: a table
+     * for a fixed config is generated by the compiler, configure() builds
+     * one at runtime from the same code.
+     */
+    template <uint8_t SegmentBits = 7>
+    class ThermistorTable
+    {
+        static_assert(SegmentBits >= 2 && SegmentBits <= 12, "ThermistorTable segments must divide the 12-bit range");
+
+    public:
+        static constexpr size_t SEGMENTS = size_t{1} << SegmentBits;
+        static constexpr int SHIFT = 12 - SegmentBits;
+        static constexpr float STEP = static_cast<float>(1 << SHIFT);
+
+    private:
+        float _points[SEGMENTS + 1]{};
+
+    public:
+        constexpr ThermistorTable() : ThermistorTable(ThermistorConfig{}) {}
+
+        constexpr explicit ThermistorTable(const ThermistorConfig &config)
+        {
+            for (size_t i = 0; i <= SEGMENTS; i++)
+            {
+                // The two end points sit on the rails; evaluate them just inside
+                double adc = static_cast<double>(i << SHIFT);
+                if (adc <= THERMISTOR_ADC_MARGIN)
+                    adc = THERMISTOR_ADC_MARGIN + 1;
+                if (adc >= THERMISTOR_ADC_MAX - THERMISTOR_ADC_MARGIN)
+                    adc = THERMISTOR_ADC_MAX - THERMISTOR_ADC_MARGIN - 1;
+                _points[i] = static_cast<float>(thermistorTemperature(config, adc));
+            }
+        }
+
+        /**
+         * @return Temperature in Celsius, NaN at the rails or for a NaN input
+         */
+        constexpr float lookup(float adcValue) const
+        {
+            if (!(adcValue > THERMISTOR_ADC_MARGIN && adcValue < THERMISTOR_ADC_MAX - THERMISTOR_ADC_MARGIN))
+            {
+                return std::numeric_limits<float>::quiet_NaN();
+            }
+
+            size_t index = static_cast<size_t>(adcValue) >> SHIFT;
+            float fraction = (adcValue - static_cast<float>(index << SHIFT)) * (1.0f / STEP);
+            return _points[index] + fraction * (_points[index + 1] - _points[index]);
+        }
+
+        constexpr float point(size_t index) const { return _points[index]; }
+    };
+
+    /**
+     * @brief Table of the default ThermistorConfig, generated at compile time
+     */
+    inline constexpr ThermistorTable<> DEFAULT_THERMISTOR_TABLE{ThermistorConfig{}};
+
+    // Equal series and nominal resistances put the nominal temperature at mid-scale
+    static_assert(DEFAULT_THERMISTOR_TABLE.point(ThermistorTable<>::SEGMENTS / 2) > 24.9f &&
+                      DEFAULT_THERMISTOR_TABLE.point(ThermistorTable<>::SEGMENTS / 2) < 25.1f,
+                  "Thermistor table generation is off");
+
+} // namespace plant_nanny::services::captors::temperature
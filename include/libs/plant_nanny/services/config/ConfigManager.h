@@ -1,6 +1,7 @@
 #pragma once
 
 #include "libs/plant_nanny/services/config/IConfigManager.h"
+#include "libs/plant_nanny/services/config/ConfigSchema.h"
 #include "libs/common/patterns/Result.h"
 #include "libs/common/logger/Logger.h"
 #include "libs/common/service/Accessor.h"
@@ -8,10 +9,38 @@
 
 namespace plant_nanny::services::config
 {
+    /**
+     * @brief NVS-backed configuration store
+     *
+     * Each section (device, link, network, MQTT, plant, power, dosing, calibration, rules) is persisted as a single versioned,
+     * CRC-checked blob written alternately to an A and a B key. All sections
+     * are read once at initialization and served from RAM afterwards; a write
+     * only ever replaces the older copy, so a power loss mid-write leaves the
+     * previous configuration intact.
+     */
     class ConfigManager : public IConfigManager
     {
     private:
+        template <typename Section>
+        struct CachedSection
+        {
+            Section data{};
+            uint32_t sequence = 0;
+            Slot slot = Slot::B;
+            bool stored = false;
+        };
+
         bool _initialized;
+        CachedSection<DeviceSection> _device;
+        CachedSection<LinkSection> _link;
+        CachedSection<NetworkSection> _network;
+        CachedSection<MqttSection> _mqtt;
+        CachedSection<PlantSection> _plant;
+        CachedSection<PowerSection> _power;
+        CachedSection<DosingSection> _dosing;
+        CachedSection<CalibrationSection> _calibration;
+        CachedSection<RulesSection> _rules;
+
         static constexpr const char* NAMESPACE = "plantnanny";
 
     public:
@@ -28,6 +57,10 @@ namespace plant_nanny::services::config
         common::patterns::Result<void> saveWifiCredentials(const std::string& ssid, const std::string& password) override;
         common::patterns::Result<std::string> getWifiSsid() override;
         common::patterns::Result<std::string> getWifiPassword() override;
+        common::patterns::Result<void> saveWifiLinkCache(const WifiLinkCache& cache) override;
+        common::patterns::Result<WifiLinkCache> getWifiLinkCache() override;
+        common::patterns::Result<void> saveNetworkConfig(const NetworkConfig& config) override;
+        NetworkConfig getNetworkConfig() override;
         bool isConfigured() override;
         common::patterns::Result<void> setConfigured(bool configured) override;
         common::patterns::Result<void> saveMqttConfig(const std::string& host, uint16_t port = 1883) override;
@@ -37,6 +70,18 @@ namespace plant_nanny::services::config
         common::patterns::Result<std::string> getMqttUsername() override;
         common::patterns::Result<std::string> getMqttPassword() override;
         bool isMqttConfigured() override;
+        common::patterns::Result<void> savePlantThresholds(const PlantThresholds& thresholds) override;
+        PlantThresholds getPlantThresholds() override;
+        common::patterns::Result<void> saveDutyCycleConfig(const DutyCycleConfig& config) override;
+        DutyCycleConfig getDutyCycleConfig() override;
+
+        common::patterns::Result<void> saveDosingConfig(const DosingConfig& config) override;
+        DosingConfig getDosingConfig() override;
+        common::patterns::Result<void> saveSensorCalibration(const SensorCalibration& calibration) override;
+        SensorCalibration getSensorCalibration() override;
+
+        common::patterns::Result<void> saveWateringRules(const WateringRules& rules) override;
+        WateringRules getWateringRules() override;
         std::string getOrCreateDeviceId() override;
 
         std::string getDeviceId();
@@ -44,6 +89,18 @@ namespace plant_nanny::services::config
 
     private:
         std::string generateUUID();
+        common::patterns::Result<void> ensureInitialized();
+
+        template <typename Section>
+        void loadSection(CachedSection<Section>& cache);
+
+        template <typename Section>
+        common::patterns::Result<void> storeSection(CachedSection<Section>& cache);
+
+        /**
+         * @brief Import settings written by firmware that used one NVS key per value
+         */
+        void migrateLegacyKeys();
     };
 
 } // namespace plant_nanny::services::config
@@ -0,0 +1,314 @@
+#pragma once
+
+#include "libs/plant_nanny/services/config/IConfigManager.h"
+#include "libs/common/patterns/Result.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace plant_nanny::services::config
+{
+    /**
+     * @brief Header prepended to every persisted config section
+     *
+     * The CRC covers the header (with the crc field zeroed) and the payload,
+     * so a torn write or a bit flip in either is detected on load.
+     */
+    struct BlobHeader
+    {
+        uint32_t magic = 0;
+        uint16_t version = 0;
+        uint16_t length = 0;    // Payload length in bytes
+        uint32_t sequence = 0;  // Incremented on every write, newest A/B slot wins
+        uint32_t crc = 0;
+    };
+
+    /**
+     * @brief A/B slot holding a copy of a config section
+     */
+    enum class Slot : uint8_t
+    {
+        A,
+        B
+    };
+
+    /**
+     * @brief Encodes and validates raw versioned blobs
+     */
+    class BlobCodec
+    {
+    public:
+        static constexpr uint32_t MAGIC = 0x464E4E50; // "PNNF"
+        static constexpr size_t HEADER_SIZE = sizeof(BlobHeader);
+
+        /**
+         * @brief Write header + payload into @p out
+         * @return Number of bytes written, 0 if @p capacity is too small
+         */
+        static size_t encode(uint16_t version, uint32_t sequence,
+                             const void *payload, uint16_t length,
+                             uint8_t *out, size_t capacity);
+
+        /**
+         * @brief Validate magic, length and CRC of a raw blob
+         * @return The decoded header, payload starts at data + HEADER_SIZE
+         */
+        static common::patterns::Result<BlobHeader> decode(const uint8_t *data, size_t length);
+
+        /**
+         * @brief Wrap-safe sequence comparison
+         */
+        static bool isNewer(uint32_t a, uint32_t b) { return static_cast<int32_t>(a - b) > 0; }
+    };
+
+    /**
+     * @brief A section as read back from storage
+     */
+    template <typename Section>
+    struct LoadedSection
+    {
+        Section data{};
+        uint32_t sequence = 0;
+        Slot slot = Slot::A;
+    };
+
+    /**
+     * @brief Typed codec for a config section
+     *
+     * A Section is a trivially copyable struct exposing:
+     * - `static constexpr uint16_t VERSION`
+     * - `static constexpr const char *KEY_A / KEY_B` (NVS keys, max 15 chars)
+     * - `static void migrate(Section &section, uint16_t fromVersion)`
+     *
+     * Layouts evolve append-only: a blob written by an older version is copied
+     * over a default-constructed Section (new trailing fields keep their
+     * defaults) and then upgraded one version at a time through migrate().
+     */
+    template <typename Section>
+    class SectionCodec
+    {
+        static_assert(std::is_trivially_copyable_v<Section>, "Config sections must be trivially copyable");
+        static_assert(sizeof(Section) <= UINT16_MAX, "Config section too large");
+
+    public:
+        static constexpr size_t BLOB_SIZE = BlobCodec::HEADER_SIZE + sizeof(Section);
+
+        static size_t encode(const Section &section, uint32_t sequence, uint8_t *out, size_t capacity)
+        {
+            return BlobCodec::encode(Section::VERSION, sequence, &section,
+                                     static_cast<uint16_t>(sizeof(Section)), out, capacity);
+        }
+
+        static common::patterns::Result<LoadedSection<Section>> decode(const uint8_t *data, size_t length)
+        {
+            using ResultType = common::patterns::Result<LoadedSection<Section>>;
+
+            auto header = BlobCodec::decode(data, length);
+            if (header.failed())
+            {
+                return ResultType::failure(header.error());
+            }
+
+            const BlobHeader h = header.value();
+            if (h.version == 0 || h.version > Section::VERSION)
+            {
+                return ResultType::failure(common::patterns::Error("Unsupported config section version"));
+            }
+            if (h.version == Section::VERSION && h.length != sizeof(Section))
+            {
+                return ResultType::failure(common::patterns::Error("Config section size mismatch"));
+            }
+
+            LoadedSection<Section> loaded;
+            std::memcpy(&loaded.data, data + BlobCodec::HEADER_SIZE,
+                        std::min<size_t>(h.length, sizeof(Section)));
+            for (uint16_t v = h.version; v < Section::VERSION; v++)
+            {
+                Section::migrate(loaded.data, v);
+            }
+            loaded.sequence = h.sequence;
+            return ResultType::success(loaded);
+        }
+
+        /**
+         * @brief Decode both A/B copies and keep the newest valid one
+         */
+        static common::patterns::Result<LoadedSection<Section>> select(
+            const uint8_t *slotA, size_t lengthA,
+            const uint8_t *slotB, size_t lengthB)
+        {
+            auto a = decode(slotA, lengthA);
+            auto b = decode(slotB, lengthB);
+
+            if (a.succeed() && (b.failed() || !BlobCodec::isNewer(b.value().sequence, a.value().sequence)))
+            {
+                return a;
+            }
+            if (b.succeed())
+            {
+                LoadedSection<Section> loaded = b.value();
+                loaded.slot = Slot::B;
+                return common::patterns::Result<LoadedSection<Section>>::success(loaded);
+            }
+            return a;
+        }
+    };
+
+    /**
+     * @brief Copy a string into a fixed-size, NUL-terminated field (truncating)
+     */
+    template <size_t N>
+    void setField(char (&field)[N], const std::string &value)
+    {
+        size_t length = std::min(value.size(), N - 1);
+        std::memcpy(field, value.data(), length);
+        std::memset(field + length, 0, N - length);
+    }
+
+    template <size_t N>
+    std::string getField(const char (&field)[N])
+    {
+        return std::string(field, strnlen(field, N));
+    }
+
+    // ---------------------------------------------------------------------
+    // Sections
+    // ---------------------------------------------------------------------
+
+    /**
+     * @brief Device identity, provisioning flag and WiFi credentials
+     */
+    struct DeviceSection
+    {
+        static constexpr uint16_t VERSION = 1;
+        static constexpr const char *KEY_A = "dev_a";
+        static constexpr const char *KEY_B = "dev_b";
+
+        char deviceId[37] = {};
+        char wifiSsid[33] = {};
+        char wifiPassword[65] = {};
+        uint8_t configured = 0;
+
+        static void migrate(DeviceSection &, uint16_t) {}
+    };
+
+    /**
+     * @brief Cached BSSID/channel/lease of the last association
+     *
+     * Kept apart from DeviceSection since it is rewritten whenever the access
+     * point or lease changes, while credentials rarely do.
+     */
+    struct LinkSection
+    {
+        // v2: lease acquisition and lease time; a v1 lease has neither and is not reused
+        static constexpr uint16_t VERSION = 2;
+        static constexpr const char *KEY_A = "link_a";
+        static constexpr const char *KEY_B = "link_b";
+
+        WifiLinkCache cache{};
+
+        static void migrate(LinkSection &, uint16_t) {}
+    };
+
+    /**
+     * @brief WiFi connection options
+     */
+    struct NetworkSection
+    {
+        static constexpr uint16_t VERSION = 1;
+        static constexpr const char *KEY_A = "net_a";
+        static constexpr const char *KEY_B = "net_b";
+
+        NetworkConfig network{};
+
+        static void migrate(NetworkSection &, uint16_t) {}
+    };
+
+    /**
+     * @brief MQTT broker address and credentials
+     */
+    struct MqttSection
+    {
+        static constexpr uint16_t VERSION = 1;
+        static constexpr const char *KEY_A = "mqtt_a";
+        static constexpr const char *KEY_B = "mqtt_b";
+
+        char host[65] = {};
+        char username[65] = {};
+        char password[65] = {};
+        uint16_t port = 1883;
+
+        static void migrate(MqttSection &, uint16_t) {}
+    };
+
+    /**
+     * @brief Plant watering thresholds (see spec)
+     */
+    struct PlantSection
+    {
+        static constexpr uint16_t VERSION = 1;
+        static constexpr const char *KEY_A = "plant_a";
+        static constexpr const char *KEY_B = "plant_b";
+
+        PlantThresholds thresholds{};
+
+        static void migrate(PlantSection &, uint16_t) {}
+    };
+
+    struct PowerSection
+    {
+        static constexpr uint16_t VERSION = 1;
+        static constexpr const char *KEY_A = "power_a";
+        static constexpr const char *KEY_B = "power_b";
+
+        DutyCycleConfig dutyCycle{};
+
+        static void migrate(PowerSection &, uint16_t) {}
+    };
+
+    /**
+     * @brief Pump flow calibration and pulse dosing parameters
+     */
+    struct DosingSection
+    {
+        static constexpr uint16_t VERSION = 1;
+        static constexpr const char *KEY_A = "dose_a";
+        static constexpr const char *KEY_B = "dose_b";
+
+        DosingConfig dosing{};
+
+        static void migrate(DosingSection &, uint16_t) {}
+    };
+
+    /**
+     * @brief Two-point calibration of the analog sensors
+     */
+    struct CalibrationSection
+    {
+        static constexpr uint16_t VERSION = 1;
+        static constexpr const char *KEY_A = "calib_a";
+        static constexpr const char *KEY_B = "calib_b";
+
+        SensorCalibration calibration{};
+
+        static void migrate(CalibrationSection &, uint16_t) {}
+    };
+
+    /**
+     * @brief Watering rules pushed by the server
+     */
+    struct RulesSection
+    {
+        static constexpr uint16_t VERSION = 1;
+        static constexpr const char *KEY_A = "rules_a";
+        static constexpr const char *KEY_B = "rules_b";
+
+        WateringRules rules{};
+
+        static void migrate(RulesSection &, uint16_t) {}
+    };
+
+} // namespace plant_nanny::services::config
@@ -1,11 +1,184 @@
 #pragma once
 
 #include "libs/common/patterns/Result.h"
+#include <cmath>
 #include <string>
+#include <cstddef>
 #include <cstdint>
 
 namespace plant_nanny::services::config
 {
+    /**
+     * @brief Per-plant watering thresholds (see spec)
+     */
+    struct PlantThresholds
+    {
+        float optimalTemperatureC = 22.0f;
+        float optimalHumidityPct = 50.0f;
+        uint32_t wateringCycleSec = 24 * 60 * 60;  // Minimum time between two waterings
+        uint16_t waterAmountMl = 200;              // Water delivered per watering cycle
+    };
+
+    /**
+     * @brief Deep-sleep duty-cycle (low-power) operating mode
+     *
+     * The device wakes every sleepIntervalSec, samples once and only brings
+     * up WiFi/MQTT every uploadEveryWakes wakes, or earlier when a reading
+     * moved by more than its delta since the last upload.
+     */
+    struct DutyCycleConfig
+    {
+        bool enabled = false;
+        uint32_t sleepIntervalSec = 60;
+        uint16_t uploadEveryWakes = 10;
+        float temperatureDeltaC = 2.0f;
+        float humidityDeltaPct = 10.0f;
+        float luminosityDeltaPct = 25.0f;
+    };
+
+    /**
+     * @brief Pump flow calibration and pulse dosing
+     *
+     * Water is delivered in pulses of pulseMl separated by soakSec so it can
+     * reach the probe before the next one; the humidity response decides
+     * whether to go on (see pump::DosingController).
+     */
+    struct DosingConfig
+    {
+        float flowMlPerSec = 20.0f;  // Rated flow of the bundled pump until calibrated
+        uint16_t pulseMl = 50;
+        uint32_t soakSec = 30;
+        uint16_t dryCheckMl = 150;   // Delivered water after which the soil must have reacted
+        float minRisePct = 1.0f;     // Humidity rise expected by then, else the reservoir is dry
+    };
+
+    /**
+     * @brief ADC readings of a sensor at both ends of its range
+     *
+     * Captured on the device itself (probe in dry air / in water, LDR covered
+     * / in bright light) since capacitive probes differ by up to 20 % between
+     * units. NaN means the point was never captured.
+     */
+    struct TwoPointCalibration
+    {
+        float zeroAdc = NAN;  // Reading for 0 % (dry, dark)
+        float fullAdc = NAN;  // Reading for 100 % (wet, bright)
+
+        bool hasZero() const { return !std::isnan(zeroAdc); }
+        bool hasFull() const { return !std::isnan(fullAdc); }
+    };
+
+    struct SensorCalibration
+    {
+        TwoPointCalibration humidity{};
+        TwoPointCalibration luminosity{};
+    };
+
+    enum class RuleComparison : uint8_t
+    {
+        Below,
+        Above
+    };
+
+    /**
+     * @brief One threshold test of a watering rule
+     *
+     * The condition becomes active when the channel crosses the threshold and
+     * only releases once it is back past it by the hysteresis, so a reading
+     * hovering around the threshold does not toggle it.
+     */
+    struct RuleCondition
+    {
+        char channel[16] = {};  // Channel key, e.g. "humidityPct"
+        RuleComparison comparison = RuleComparison::Below;
+        float threshold = 0.0f;
+        float hysteresis = 0.0f;
+    };
+
+    /**
+     * @brief Water @ref waterAmountMl when all conditions are active
+     *
+     * A rule fires at most once per minCycleSec, counted from the last
+     * watering whatever triggered it.
+     */
+    struct WateringRule
+    {
+        static constexpr size_t MAX_CONDITIONS = 3;
+
+        RuleCondition conditions[MAX_CONDITIONS]{};
+        uint8_t conditionCount = 0;
+        uint16_t waterAmountMl = 200;
+        uint32_t minCycleSec = 24 * 60 * 60;
+    };
+
+    /**
+     * @brief Autonomous watering rules, evaluated on the device
+     *
+     * An empty set (the default) leaves watering to the server.
+     */
+    struct WateringRules
+    {
+        static constexpr size_t MAX_RULES = 4;
+
+        WateringRule rules[MAX_RULES]{};
+        uint8_t count = 0;
+    };
+
+    /**
+     * @brief WiFi connection options
+     */
+    struct NetworkConfig
+    {
+        bool reuseIpLease = true;             // Fast reconnects reapply the last DHCP lease
+        uint32_t defaultLeaseSec = 60 * 60;   // Assumed when the DHCP server's lease time is unknown
+    };
+
+    /**
+     * @brief Last successful WiFi association, used for fast reconnects
+     *
+     * Addresses are stored as returned by IPAddress (uint32_t). An ip of 0
+     * means the DHCP lease is not reused and DHCP runs as usual.
+     */
+    struct WifiLinkCache
+    {
+        uint8_t bssid[6] = {};
+        uint8_t channel = 0;  // 0 = nothing cached
+        uint32_t ip = 0;
+        uint32_t gateway = 0;
+        uint32_t subnet = 0;
+        uint32_t dns = 0;
+        uint32_t leaseAcquiredSec = 0;  // Unix time DHCP granted the lease
+        uint32_t leaseSec = 0;          // Lease time granted by the server
+
+        bool valid() const { return channel != 0; }
+
+        /**
+         * @brief Whether the lease may still be reapplied without DHCP
+         *
+         * Only its first half is used, where a DHCP client would start
+         * renewing. A clock that went backwards counts as expired.
+         */
+        bool leaseFresh(uint32_t nowSec) const
+        {
+            if (ip == 0 || leaseAcquiredSec == 0 || nowSec < leaseAcquiredSec)
+            {
+                return false;
+            }
+            return nowSec - leaseAcquiredSec < leaseSec / 2;
+        }
+
+        bool operator==(const WifiLinkCache& other) const
+        {
+            for (int i = 0; i < 6; i++)
+            {
+                if (bssid[i] != other.bssid[i]) return false;
+            }
+            return channel == other.channel && ip == other.ip && gateway == other.gateway &&
+                   subnet == other.subnet && dns == other.dns &&
+                   leaseAcquiredSec == other.leaseAcquiredSec && leaseSec == other.leaseSec;
+        }
+    };
+
     /**
      * @brief Interface for configuration management (DIP - Dependency Inversion Principle)
      */
@@ -21,6 +194,10 @@ namespace plant_nanny::services::config
         virtual common::patterns::Result<void> saveWifiCredentials(const std::string& ssid, const std::string& password) = 0;
         virtual common::patterns::Result<std::string> getWifiSsid() = 0;
         virtual common::patterns::Result<std::string> getWifiPassword() = 0;
+        virtual common::patterns::Result<void> saveWifiLinkCache(const WifiLinkCache& cache) = 0;
+        virtual common::patterns::Result<WifiLinkCache> getWifiLinkCache() = 0;
+        virtual common::patterns::Result<void> saveNetworkConfig(const NetworkConfig& config) = 0;
+        virtual NetworkConfig getNetworkConfig() = 0;
 
         // Device configuration
         virtual bool isConfigured() = 0;
@@ -35,6 +212,26 @@ namespace plant_nanny::services::config
         virtual common::patterns::Result<std::string> getMqttUsername() = 0;
         virtual common::patterns::Result<std::string> getMqttPassword() = 0;
         virtual bool isMqttConfigured() = 0;
+
+        // Plant configuration
+        virtual common::patterns::Result<void> savePlantThresholds(const PlantThresholds& thresholds) = 0;
+        virtual PlantThresholds getPlantThresholds() = 0;
+
+        // Power configuration
+        virtual common::patterns::Result<void> saveDutyCycleConfig(const DutyCycleConfig& config) = 0;
+        virtual DutyCycleConfig getDutyCycleConfig() = 0;
+
+        // Pump dosing
+        virtual common::patterns::Result<void> saveDosingConfig(const DosingConfig& config) = 0;
+        virtual DosingConfig getDosingConfig() = 0;
+
+        // Sensor calibration
+        virtual common::patterns::Result<void> saveSensorCalibration(const SensorCalibration& calibration) = 0;
+        virtual SensorCalibration getSensorCalibration() = 0;
+
+        // Watering rules
+        virtual common::patterns::Result<void> saveWateringRules(const WateringRules& rules) = 0;
+        virtual WateringRules getWateringRules() = 0;
     };
 
 } // namespace plant_nanny::services::config
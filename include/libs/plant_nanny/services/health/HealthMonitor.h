@@ -0,0 +1,125 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace plant_nanny::services::health
+{
+    /**
+     * @brief Tasks whose stack high-water mark is watched
+     */
+    enum class WatchedTask : uint8_t
+    {
+        Control,    // Arduino loop task
+        EventLoop,  // app_loop (esp_event, bus subscribers)
+        Network,
+        Count
+    };
+
+    constexpr size_t WATCHED_TASK_COUNT = static_cast<size_t>(WatchedTask::Count);
+
+    const char *to_string(WatchedTask task);
+
+    /**
+     * @brief One reading of the heap and of the task stacks
+     */
+    struct HealthSample
+    {
+        static constexpr uint32_t UNKNOWN = UINT32_MAX;
+
+        uint32_t timeSec = 0;
+        uint32_t freeBytes = 0;
+        uint32_t largestBlockBytes = 0;
+        uint32_t minFreeBytes = 0;                       // Lowest free heap since boot
+        uint32_t stackFreeBytes[WATCHED_TASK_COUNT] = {UNKNOWN, UNKNOWN, UNKNOWN};  // High-water mark
+    };
+
+    enum class HealthLevel : uint8_t
+    {
+        Ok,
+        Warning,
+        Critical
+    };
+
+    const char *to_string(HealthLevel level);
+
+    /**
+     * @brief Why the level is not Ok; bitmask of HealthReport::flags
+     */
+    namespace flags
+    {
+        constexpr uint8_t LOW_HEAP = 1 << 0;
+        constexpr uint8_t FRAGMENTED = 1 << 1;  // Largest free block small despite the free heap
+        constexpr uint8_t LEAKING = 1 << 2;     // Free heap keeps shrinking over the trend window
+        constexpr uint8_t LOW_STACK = 1 << 3;
+    }
+
+    struct HealthThresholds
+    {
+        uint32_t freeWarnBytes = 32 * 1024;
+        uint32_t freeCriticalBytes = 16 * 1024;
+        uint32_t largestBlockWarnBytes = 16 * 1024;
+        uint32_t largestBlockCriticalBytes = 6 * 1024;
+        uint32_t stackWarnBytes = 768;
+        uint32_t stackCriticalBytes = 256;
+        int32_t leakWarnBytesPerHour = 4096;
+        uint32_t trendIntervalSec = 5 * 60;     // Spacing of the trend points
+        uint8_t criticalSamplesBeforeRestart = 3;  // Ignore a transient dip
+        bool restartWhenCritical = true;
+    };
+
+    struct HealthReport
+    {
+        HealthLevel level = HealthLevel::Ok;
+        uint8_t flags = 0;
+        uint8_t fragmentationPct = 0;    // 100 - largest block / free heap, reported only
+        bool trendValid = false;         // Trend window full
+        int32_t trendBytesPerHour = 0;   // Free heap slope, negative when shrinking
+        WatchedTask tightestStack = WatchedTask::Control;
+        bool restartDue = false;
+    };
+
+    /**
+     * @brief Turns heap and stack readings into a health level and trend
+     *
+     * Pure logic: the caller samples heap_caps and uxTaskGetStackHighWaterMark
+     * at a fixed period and feeds them to update(). The free heap trend is a
+     * least-squares slope over the last TREND_POINTS points, taken at most
+     * every trendIntervalSec, so a leak shows up before it is critical.
+     *
+     * restartDue is set once the level stayed Critical for
+     * criticalSamplesBeforeRestart samples in a row; deciding when the
+     * restart is safe (no dose running) is up to the caller.
+     */
+    class HealthMonitor
+    {
+    public:
+        static constexpr size_t TREND_POINTS = 12;
+
+    private:
+        HealthThresholds _thresholds;
+        HealthReport _report{};
+        uint32_t _trendTimes[TREND_POINTS] = {};
+        uint32_t _trendFree[TREND_POINTS] = {};
+        size_t _trendCount = 0;
+        size_t _trendNext = 0;
+        uint8_t _criticalStreak = 0;
+
+        void addTrendPoint(uint32_t timeSec, uint32_t freeBytes);
+        int32_t trendBytesPerHour() const;
+
+    public:
+        explicit HealthMonitor(const HealthThresholds &thresholds = {});
+
+        const HealthReport &update(const HealthSample &sample);
+        const HealthReport &report() const { return _report; }
+        const HealthThresholds &thresholds() const { return _thresholds; }
+    };
+
+    /**
+     * @brief A sample and its report as a devices/<id>/diag document
+     * @return Length written, 0 if @p capacity is too small
+     */
+    size_t toJson(const HealthSample &sample, const HealthReport &report, char *buffer, size_t capacity);
+
+} // namespace plant_nanny::services::health
@@ -1,9 +1,11 @@
 #pragma once
 
 #include "libs/common/patterns/Result.h"
+#include "libs/plant_nanny/services/captors/SensorChannel.h"
 #include <string>
 #include <functional>
 #include <cstdint>
+#include <cstddef>
 
 namespace plant_nanny::services::mqtt
 {
@@ -19,6 +21,13 @@ namespace plant_nanny::services::mqtt
     class IMQTTService
     {
     public:
+        // Largest packet (topic + payload); sized for diagnostics documents
+        // and metrics snapshots
+        static constexpr uint16_t MQTT_BUFFER_SIZE = 2048;
+        // What is left for the payload after the fixed header, the topic
+        // length and the longest devices/<uuid>/<name> topic
+        static constexpr uint16_t MAX_PAYLOAD_SIZE = MQTT_BUFFER_SIZE - 64;
+
         virtual ~IMQTTService() = default;
 
         virtual common::patterns::Result<void> initialize(
@@ -31,8 +40,31 @@ namespace plant_nanny::services::mqtt
         virtual void set_publish_interval(unsigned long intervalMs) = 0;
         virtual void set_reading_callback(ReadingCallback callback) = 0;
         virtual void set_command_callback(CommandCallback callback) = 0;
+
+        /**
+         * @brief Channels published in readings and described on devices/<id>/channels
+         *
+         * The list must outlive the service.
+         */
+        virtual void set_channels(const captors::SensorChannels& channels) = 0;
         virtual void update() = 0;
         virtual bool is_connected() const = 0;
+
+        /**
+         * @brief Connect to the broker now instead of waiting for update()
+         */
+        virtual common::patterns::Result<void> connect() = 0;
+        virtual common::patterns::Result<void> publish_reading(const SensorReading& reading) = 0;
+
+        /**
+         * @brief Publish a JSON document on devices/<id>/diag (field debugging)
+         */
+        virtual common::patterns::Result<void> publish_diagnostics(const char* json, size_t length) = 0;
+
+        /**
+         * @brief Publish a metrics snapshot on devices/<id>/metrics
+         */
+        virtual common::patterns::Result<void> publish_metrics(const char* json, size_t length) = 0;
     };
 
 } // namespace plant_nanny::services::mqtt
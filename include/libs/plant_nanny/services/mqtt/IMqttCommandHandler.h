@@ -2,12 +2,13 @@
 
 #include "libs/plant_nanny/services/mqtt/IMQTTService.h"
 #include "libs/common/patterns/Result.h"
+#include "libs/plant_nanny/services/ota/Manifest.h"
 #include <functional>
 #include <string>
 
 namespace plant_nanny::services::mqtt
 {
-    using OtaUpdateCallback = std::function<common::patterns::Result<void>(const std::string&)>;
+    using OtaUpdateCallback = std::function<common::patterns::Result<void>(const ota::Manifest&)>;
 
     /**
      * @brief Interface for MQTT command handling (DIP - Dependency Inversion Principle)
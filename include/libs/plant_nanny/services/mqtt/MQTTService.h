@@ -4,18 +4,21 @@
 #include "libs/common/patterns/Result.h"
 #include "libs/common/logger/Logger.h"
 #include "libs/common/service/Accessor.h"
+#include "libs/plant_nanny/services/ota/Manifest.h"
+#include "libs/plant_nanny/services/captors/calibration/Calibration.h"
 #include <PubSubClient.h>
 #include <WiFiClient.h>
 #include <string>
 #include <functional>
+#include <cmath>
 
 namespace plant_nanny::services::mqtt
 {
     struct SensorReading
     {
-        float temperatureC;
-        float humidityPct;
-        float luminosityPct;
+        captors::SensorReadings readings;  // Indexed like the channels set on the service
+        uint32_t ageSec = 0;  // Buffered sample: seconds between acquisition and publish
+        uint32_t timestamp = 0;  // Unix time of acquisition, 0 while the clock is not synced
     };
 
     enum class CommandType
@@ -24,8 +27,15 @@ namespace plant_nanny::services::mqtt
         SendNow,
         PumpWater,
         SetInterval,
+        SetPowerMode,
         Restart,
-        OtaUpdate
+        OtaUpdate,
+        GetStateTrace,
+        GetMetrics,
+        Calibrate,
+        SetRules,
+        SetDosing,
+        SetNetwork
     };
 
     struct Command
@@ -34,7 +44,18 @@ namespace plant_nanny::services::mqtt
         int durationMs;
         int amountMl;
         int intervalMs;
-        std::string otaUrl;
+        float targetPct = NAN;     // pump_water: stop once the soil is this humid
+        float flowMlPerSec = 0.0f; // set_dosing fields, 0 = unchanged
+        float measuredMl = 0.0f;
+        int pulseMl = 0;
+        int soakSec = 0;
+        bool lowPower = false;
+        int sleepSec = 0;
+        int uploadEvery = 0;
+        bool reuseLease = true;    // set_network
+        ota::Manifest otaManifest;
+        captors::calibration::CalibrationRequest calibration;
+        config::WateringRules rules;
     };
 
     class MQTTService : public IMQTTService
@@ -63,6 +84,7 @@ namespace plant_nanny::services::mqtt
         
         ReadingCallback reading_callback_;
         CommandCallback command_callback_;
+        const captors::SensorChannels* channels_ = &captors::SensorChannels::defaults();
 
         static constexpr uint32_t DEFAULT_PUBLISH_INTERVAL_MS = 60000;
         static constexpr uint32_t RECONNECT_INTERVAL_MS = 5000;
@@ -71,12 +93,17 @@ namespace plant_nanny::services::mqtt
 
         bool attempt_connect();
         void publish_status(const char* status);
+        void publish_channels();
         void subscribe_to_commands();
         void handle_message(char* topic, byte* payload, unsigned int length);
         Command parse_command(const char* payload, unsigned int length);
         std::string build_data_topic() const;
         std::string build_command_topic() const;
         std::string build_status_topic() const;
+        std::string build_diag_topic() const;
+        std::string build_channels_topic() const;
+        std::string build_metrics_topic() const;
+        bool publish_payload(const std::string& topic, const char* payload, size_t length);
 
         // Static callback wrapper for PubSubClient
         static void mqtt_callback_wrapper(char* topic, byte* payload, unsigned int length);
@@ -102,15 +129,18 @@ namespace plant_nanny::services::mqtt
         void set_publish_interval(unsigned long intervalMs) override;
         void set_reading_callback(ReadingCallback callback) override;
         void set_command_callback(CommandCallback callback) override;
+        void set_channels(const captors::SensorChannels& channels) override;
         void update() override;
         bool is_connected() const override;
+        common::patterns::Result<void> connect() override;
+        common::patterns::Result<void> publish_reading(const SensorReading& reading) override;
+        common::patterns::Result<void> publish_diagnostics(const char* json, size_t length) override;
+        common::patterns::Result<void> publish_metrics(const char* json, size_t length) override;
 
         // Additional methods not in interface
         bool is_enabled() const { return enabled_; }
         const std::string& get_device_id() const { return device_id_; }
-        common::patterns::Result<void> connect();
         void disconnect();
-        common::patterns::Result<void> publish_reading(const SensorReading& reading);
         void force_send_reading();
         PubSubClient* get_client() { return &mqtt_client_; }
     };
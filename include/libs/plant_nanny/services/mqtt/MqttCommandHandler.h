@@ -1,21 +1,25 @@
 #pragma once
 
 #include "libs/plant_nanny/services/mqtt/IMqttCommandHandler.h"
-#include "libs/plant_nanny/services/pump/IPump.h"
+#include "libs/plant_nanny/services/pump/IDoser.h"
+#include <cstdint>
 
 namespace plant_nanny::services::mqtt
 {
-    using pump::IPump;
+    using pump::IDoser;
     /**
      * @brief Handles MQTT commands by delegating to appropriate services
      * 
      * Follows SRP - only responsible for command dispatch
-     * Follows DIP - depends on abstractions (IPump, callbacks)
+     * Follows DIP - depends on abstractions (IDoser, callbacks)
      */
     class MqttCommandHandler : public IMqttCommandHandler
     {
+    public:
+        static constexpr uint32_t DEFAULT_WATERING_MS = 5000;  // pump_water without amount or duration
+
     private:
-        IPump* _pump;
+        IDoser* _doser;
         OtaUpdateCallback _otaCallback;
 
     public:
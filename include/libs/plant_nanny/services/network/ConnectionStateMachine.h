@@ -0,0 +1,102 @@
+#pragma once
+
+#include "libs/plant_nanny/services/network/INetworkService.h"
+#include <cstdint>
+#include <functional>
+
+namespace plant_nanny::services::network
+{
+    /**
+     * @brief Retry policy for WiFi connection attempts
+     */
+    struct BackoffPolicy
+    {
+        uint32_t connectTimeoutMs = 10000;  // Give up on an attempt after this long
+        uint32_t fastConnectTimeoutMs = 1500; // Budget for the cached BSSID/channel path before scanning
+        uint32_t initialDelayMs = 1000;     // Delay after the first failure / link loss
+        uint32_t maxDelayMs = 60000;        // Upper bound of the exponential backoff
+        uint8_t jitterPct = 20;             // +/- random spread applied to each delay
+    };
+
+    /**
+     * @brief What the driver must do after a tick
+     */
+    enum class ConnectionAction
+    {
+        None,
+        BeginConnect,      // Start associating with a full scan (WiFi.begin)
+        BeginFastConnect,  // Start associating with the cached BSSID/channel/lease
+        AbortConnect   // Drop the pending attempt (WiFi.disconnect)
+    };
+
+    /**
+     * @brief Hardware-independent WiFi connection state machine
+     *
+     * Never blocks: the owner calls tick() from its loop with the current time
+     * and link status and performs the returned action. Failed attempts are
+     * retried with exponential backoff and jitter so a fleet does not hammer
+     * the access point in lockstep after an outage.
+     *
+     * When a cached association is available each attempt first tries the
+     * fast path and, if the link is not up within fastConnectTimeoutMs,
+     * falls back to a full scan within the same attempt.
+     */
+    class ConnectionStateMachine
+    {
+    public:
+        using RandomSource = std::function<uint32_t()>;
+
+    private:
+        BackoffPolicy _policy;
+        RandomSource _random;
+        ConnectionCallback _callback;
+        ConnectionState _state = ConnectionState::Idle;
+        bool _enabled = false;
+        bool _fastPathAvailable = false;
+        bool _fastAttempt = false;
+        uint32_t _stateSince = 0;
+        uint32_t _attemptStart = 0;
+        uint32_t _retryAt = 0;
+        uint32_t _failures = 0;
+        ConnectionStats _stats;
+
+        void enter(ConnectionState state, uint32_t now);
+        void scheduleRetry(uint32_t now);
+        ConnectionAction beginAttempt(uint32_t now);
+        void linkUp(uint32_t now);
+
+    public:
+        explicit ConnectionStateMachine(BackoffPolicy policy = BackoffPolicy{}, RandomSource random = nullptr);
+
+        /**
+         * @brief Allow (or stop) connection attempts; disabling returns to Idle
+         */
+        void setEnabled(bool enabled);
+        bool isEnabled() const { return _enabled; }
+
+        /**
+         * @brief Retry immediately, skipping any pending backoff
+         */
+        void retryNow(uint32_t now);
+
+        ConnectionAction tick(uint32_t now, bool linkUp);
+
+        /**
+         * @brief Whether a cached association exists to try before scanning
+         */
+        void setFastPathAvailable(bool available) { _fastPathAvailable = available; }
+
+        void setCallback(ConnectionCallback callback) { _callback = std::move(callback); }
+        const ConnectionStats& stats() const { return _stats; }
+        ConnectionState state() const { return _state; }
+        uint32_t failures() const { return _failures; }
+        uint32_t retryAt() const { return _retryAt; }
+        uint32_t stateSince() const { return _stateSince; }
+
+        /**
+         * @brief Backoff before the next attempt after @p failures failures, without jitter
+         */
+        uint32_t baseDelayMs(uint32_t failures) const;
+    };
+
+} // namespace plant_nanny::services::network
@@ -7,6 +7,35 @@
 
 namespace plant_nanny::services::network
 {
+    /**
+     * @brief WiFi link state as driven by maintain_connection()
+     */
+    enum class ConnectionState
+    {
+        Idle,        // No credentials, nothing to do
+        Connecting,  // Association/DHCP in progress
+        Connected,
+        Backoff      // Waiting before the next attempt
+    };
+
+    /**
+     * @brief Connection counters and the duration of the last successful attempt
+     */
+    struct ConnectionStats
+    {
+        uint32_t lastConnectMs = 0;    // From WiFi.begin() to link up
+        bool lastConnectFast = false;  // Whether the cached BSSID/channel path was used
+        uint32_t connects = 0;
+        uint32_t fastConnects = 0;
+        uint32_t fastFallbacks = 0;    // Fast attempts that fell back to a full scan
+        uint32_t failures = 0;         // Attempts that timed out
+    };
+
+    /**
+     * @brief Invoked on link edges: true when connected, false when lost
+     */
+    using ConnectionCallback = std::function<void(bool connected)>;
+
     class INetworkService
     {
     public:
@@ -19,16 +48,22 @@ namespace plant_nanny::services::network
         virtual void disconnect() = 0;
         virtual bool is_connected() const = 0;
         virtual void maintain_connection() = 0;
+        virtual ConnectionState get_connection_state() const = 0;
+        virtual ConnectionStats get_connection_stats() const = 0;
+        virtual void set_connection_callback(ConnectionCallback callback) = 0;
 
         // Network info
         virtual common::patterns::Result<std::string> get_ip_address() const = 0;
         virtual common::patterns::Result<int> get_rssi() const = 0;
 
         // HTTP utilities for OTA
+        // offset > 0 resumes with a Range request; progress reports (offset + received, total file size).
+        // Fails if the connection drops before the announced length was received.
         virtual common::patterns::Result<void> download_file(
             const std::string &url,
             std::function<bool(const uint8_t *, size_t)> chunk_handler,
-            std::function<void(size_t, size_t)> progress_callback = nullptr) = 0;
+            std::function<void(size_t, size_t)> progress_callback = nullptr,
+            size_t offset = 0) = 0;
     };
 
 } // namespace plant_nanny::services::network
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "libs/plant_nanny/services/network/INetworkService.h"
+#include "libs/plant_nanny/services/network/ConnectionStateMachine.h"
+#include "libs/plant_nanny/services/config/IConfigManager.h"
 #include "libs/common/logger/Logger.h"
 #include "libs/common/service/Accessor.h"
 #include <string>
@@ -14,13 +16,25 @@ namespace plant_nanny::services::network
     class Manager : public INetworkService
     {
     private:
+        // One TCP segment per read; the OTA pipeline does the larger buffering
+        static constexpr size_t DOWNLOAD_READ_SIZE = 1460;
+        static constexpr uint32_t DOWNLOAD_STALL_TIMEOUT_MS = 15000;
+
         common::service::Accessor<common::logger::Logger> logger_;
+        common::service::Accessor<config::IConfigManager> config_;
         std::string ssid_;
         std::string password_;
-        uint32_t last_connection_attempt_;
-        static constexpr uint32_t RECONNECT_INTERVAL_MS = 30000;
+        ConnectionStateMachine state_machine_;
+        ConnectionCallback connection_callback_;
+        config::WifiLinkCache link_cache_;
+        bool fast_attempt_active_ = false;
+        bool static_ip_applied_ = false;
 
-        bool attempt_connection();
+        void begin_connection();
+        void begin_fast_connection();
+        void load_link_cache();
+        void store_link_cache();
+        config::NetworkConfig network_config();
 
     public:
         Manager();
@@ -35,12 +49,16 @@ namespace plant_nanny::services::network
         void disconnect() override;
         bool is_connected() const override;
         void maintain_connection() override;
+        ConnectionState get_connection_state() const override;
+        ConnectionStats get_connection_stats() const override;
+        void set_connection_callback(ConnectionCallback callback) override;
         common::patterns::Result<std::string> get_ip_address() const override;
         common::patterns::Result<int> get_rssi() const override;
         common::patterns::Result<void> download_file(
             const std::string &url,
             std::function<bool(const uint8_t *, size_t)> chunk_handler,
-            std::function<void(size_t, size_t)> progress_callback = nullptr) override;
+            std::function<void(size_t, size_t)> progress_callback = nullptr,
+            size_t offset = 0) override;
     };
 
 } // namespace plant_nanny::services::network
\ No newline at end of file
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "libs/common/patterns/Result.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace plant_nanny::services::ota
+{
+    /**
+     * @brief Rebuilds a firmware image from the running one and a streamed patch
+     *
+     * bsdiff-style patch, laid out so it can be applied front to back while it
+     * downloads (little endian):
+     *
+     *     magic u16 | version u8 | reserved u8 | source_size u32 | target_size u32
+     *     records: diff_len u32 | extra_len u32 | seek i32 | diff[diff_len] | extra[extra_len]
+     *
+     * Each diff byte is added (mod 256) to the source byte under the cursor,
+     * which then advances; extra bytes are copied as is; seek then moves the
+     * source cursor. The target is written strictly sequentially, so the new
+     * image never needs to fit in RAM. Generate patches with
+     * Devtools/python/ota_delta.py.
+     */
+    class DeltaPatcher
+    {
+    public:
+        using Sink = std::function<common::patterns::Result<void>(const uint8_t *, size_t)>;
+        using SourceReader = std::function<common::patterns::Result<void>(size_t offset, uint8_t *out, size_t length)>;
+
+        static constexpr uint16_t MAGIC = 0x4450;  // "PD"
+        static constexpr uint8_t VERSION = 1;
+        static constexpr size_t HEADER_SIZE = 12;
+        static constexpr size_t CONTROL_SIZE = 12;
+        static constexpr size_t BLOCK_SIZE = 256;
+
+        DeltaPatcher(size_t source_size, SourceReader source, Sink sink);
+        DeltaPatcher(const DeltaPatcher &) = delete;
+        DeltaPatcher &operator=(const DeltaPatcher &) = delete;
+
+        /**
+         * @brief Apply a chunk of patch, flushing full output blocks to the sink
+         */
+        common::patterns::Result<void> feed(const uint8_t *data, size_t length);
+
+        /**
+         * @brief Flush the last block and check the whole target was produced
+         */
+        common::patterns::Result<void> finish();
+
+        size_t bytes_out() const { return bytes_out_; }
+
+    private:
+        enum class Field : uint8_t
+        {
+            Header,
+            Control,
+            Diff,
+            Extra,
+        };
+
+        size_t source_size_;
+        SourceReader source_;
+        Sink sink_;
+
+        Field field_ = Field::Header;
+        uint8_t pending_[HEADER_SIZE];  // Header or control record being collected
+        size_t pending_length_ = 0;
+
+        size_t target_size_ = 0;
+        size_t bytes_out_ = 0;
+        size_t cursor_ = 0;  // Source offset of the next diff byte
+        size_t diff_left_ = 0;
+        size_t extra_left_ = 0;
+        int32_t seek_ = 0;
+
+        uint8_t source_block_[BLOCK_SIZE];
+        size_t source_block_offset_ = 0;
+        size_t source_block_length_ = 0;
+
+        uint8_t output_[BLOCK_SIZE];
+        size_t output_length_ = 0;
+
+        common::patterns::Result<void> parse_header();
+        common::patterns::Result<void> parse_control();
+        common::patterns::Result<void> end_record();
+        common::patterns::Result<void> load_source(size_t offset);
+        common::patterns::Result<void> flush();
+    };
+
+} // namespace plant_nanny::services::ota
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "libs/common/patterns/Result.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+namespace plant_nanny::services::ota
+{
+    /**
+     * @brief Streaming decoder for heatshrink (LZSS) compressed images
+     *
+     * Sits between the HTTP download and the flash writer: compressed chunks
+     * go in through feed(), decompressed bytes come out through the sink in
+     * blocks of up to OUTPUT_BUFFER_SIZE. Memory use is the 2^window_bits
+     * history window plus the output block, whatever the image size.
+     *
+     * Bitstream (MSB first): tag 1 + 8 bit literal, or tag 0 + window_bits
+     * offset-1 + lookahead_bits count-1 back-reference.
+     */
+    class HeatshrinkDecoder
+    {
+    public:
+        using Sink = std::function<common::patterns::Result<void>(const uint8_t *, size_t)>;
+
+        static constexpr uint8_t MIN_WINDOW_BITS = 4;
+        static constexpr uint8_t MAX_WINDOW_BITS = 12;  // 4 KB window
+        static constexpr uint8_t MIN_LOOKAHEAD_BITS = 3;
+        static constexpr size_t OUTPUT_BUFFER_SIZE = 256;
+
+        /**
+         * @brief Same limits as the heatshrink encoder, with the window capped for SRAM
+         */
+        static bool supports(uint8_t window_bits, uint8_t lookahead_bits);
+
+        HeatshrinkDecoder(uint8_t window_bits, uint8_t lookahead_bits, Sink sink);
+        HeatshrinkDecoder(const HeatshrinkDecoder &) = delete;
+        HeatshrinkDecoder &operator=(const HeatshrinkDecoder &) = delete;
+
+        /**
+         * @brief Decode a compressed chunk, flushing full output blocks to the sink
+         */
+        common::patterns::Result<void> feed(const uint8_t *data, size_t length);
+
+        /**
+         * @brief Flush the last block and check the stream did not stop mid-record
+         */
+        common::patterns::Result<void> finish();
+
+        size_t bytes_out() const { return bytes_out_; }
+
+    private:
+        enum class Field : uint8_t
+        {
+            Tag,
+            Literal,
+            Offset,
+            Count,
+        };
+
+        uint8_t window_bits_;
+        uint8_t lookahead_bits_;
+        Sink sink_;
+
+        std::unique_ptr<uint8_t[]> window_;
+        uint8_t output_[OUTPUT_BUFFER_SIZE];
+        size_t output_length_ = 0;
+        size_t bytes_out_ = 0;
+
+        Field field_ = Field::Tag;
+        uint32_t bits_ = 0;
+        uint8_t bit_count_ = 0;
+        uint16_t offset_ = 0;
+
+        uint16_t take(uint8_t count);
+
+        /**
+         * @brief Append a byte to the window and the output block
+         * @return true when the output block is full and must be flushed
+         */
+        bool push(uint8_t byte);
+
+        common::patterns::Result<void> flush();
+    };
+
+} // namespace plant_nanny::services::ota
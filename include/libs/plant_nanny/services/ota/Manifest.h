@@ -0,0 +1,63 @@
+#pragma once
+
+#include "libs/common/utils/Sha256.h"
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+
+namespace plant_nanny::services::ota
+{
+    /**
+     * @brief Encoding of the image served at Manifest::url
+     */
+    enum class Compression : uint8_t
+    {
+        None,
+        Heatshrink,  // Raw heatshrink stream, no header (heatshrink -e -w <window> -l <lookahead>)
+    };
+
+    /**
+     * @brief Describes the image to install, as sent with the ota_update command
+     */
+    struct Manifest
+    {
+        std::string url;
+        Compression compression = Compression::None;
+        uint8_t window_bits = 10;    // heatshrink -w
+        uint8_t lookahead_bits = 5;  // heatshrink -l
+
+        // Hash of the installed image, checked before it is made bootable; required for deltas
+        std::optional<common::utils::Sha256::Digest> sha256;
+
+        // Delta: url serves a DeltaPatcher patch against the first source_size bytes of the running image
+        bool delta = false;
+        size_t source_size = 0;
+        common::utils::Sha256::Digest source_sha256{};
+    };
+
+    inline const char *to_string(Compression compression)
+    {
+        return compression == Compression::Heatshrink ? "heatshrink" : "none";
+    }
+
+    /**
+     * @brief Parse the manifest "compression" field; a missing field means none
+     * @return false for an unknown encoding, which must not be flashed as is
+     */
+    inline bool parse_compression(const char *name, Compression &compression)
+    {
+        if (name == nullptr || name[0] == '\0' || strcmp(name, "none") == 0)
+        {
+            compression = Compression::None;
+            return true;
+        }
+        if (strcmp(name, "heatshrink") == 0)
+        {
+            compression = Compression::Heatshrink;
+            return true;
+        }
+        return false;
+    }
+
+} // namespace plant_nanny::services::ota
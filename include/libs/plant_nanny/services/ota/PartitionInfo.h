@@ -1,6 +1,7 @@
 #pragma once
 
 #include "libs/common/patterns/Result.h"
+#include "libs/common/utils/Sha256.h"
 #include "esp_partition.h"
 #include <string>
 
@@ -14,6 +15,8 @@ namespace plant_nanny::services::ota
         static const esp_partition_t *get_next_update_partition();
         static bool partitions_match(const esp_partition_t *p1, const esp_partition_t *p2);
         static common::patterns::Result<const esp_partition_t *> get_update_partition();
+        static common::patterns::Result<void> read(const esp_partition_t *partition, size_t offset, void *out, size_t length);
+        static common::patterns::Result<common::utils::Sha256::Digest> hash(const esp_partition_t *partition, size_t length);
     };
 
 } // namespace plant_nanny::services::ota
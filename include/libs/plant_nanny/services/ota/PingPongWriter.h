@@ -0,0 +1,76 @@
+#pragma once
+
+#include "libs/common/patterns/Result.h"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+namespace plant_nanny::services::ota
+{
+    /**
+     * @brief Double buffer between the HTTP reader and the flash writer
+     *
+     * The reader copies downloaded bytes into one buffer while a writer thread
+     * drains the other through the sink (decompression, patching, hashing and
+     * esp_ota_write). The reader only blocks when it has filled its buffer
+     * before the writer is done with the previous one.
+     *
+     * write() and flush() belong to a single reader task. The sink runs on the
+     * writer thread, which lives as long as the object.
+     */
+    class PingPongWriter
+    {
+    public:
+        using Sink = std::function<common::patterns::Result<void>(const uint8_t *, size_t)>;
+
+        static constexpr size_t DEFAULT_BUFFER_SIZE = 4096;
+        static constexpr size_t WRITER_STACK = 6144;
+
+        PingPongWriter(size_t buffer_size, Sink sink);
+        ~PingPongWriter();
+        PingPongWriter(const PingPongWriter &) = delete;
+        PingPongWriter &operator=(const PingPongWriter &) = delete;
+
+        /**
+         * @brief Copy data in, handing full buffers to the writer
+         * @return The first sink error, once it has happened
+         */
+        common::patterns::Result<void> write(const uint8_t *data, size_t length);
+
+        /**
+         * @brief Hand over the partial buffer and wait until the writer is idle
+         */
+        common::patterns::Result<void> flush();
+
+        size_t buffer_size() const { return buffer_size_; }
+
+    private:
+        size_t buffer_size_;
+        Sink sink_;
+        std::unique_ptr<uint8_t[]> buffers_[2];
+
+        // Reader side only
+        int fill_index_ = 0;
+        size_t fill_length_ = 0;
+
+        // Shared, guarded by mutex_
+        std::mutex mutex_;
+        std::condition_variable changed_;
+        int ready_index_ = -1;  // Buffer handed over, not yet taken by the writer
+        size_t ready_length_ = 0;
+        bool writing_ = false;
+        bool stop_ = false;
+        std::optional<common::patterns::Error> error_;
+
+        std::thread writer_;
+
+        common::patterns::Result<void> hand_over();
+        void run();
+    };
+
+} // namespace plant_nanny::services::ota
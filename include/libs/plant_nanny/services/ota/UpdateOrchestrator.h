@@ -4,24 +4,52 @@
 #include "libs/common/logger/Logger.h"
 #include "libs/common/service/Accessor.h"
 #include "libs/plant_nanny/services/ota/Manager.h"
+#include "libs/plant_nanny/services/ota/Manifest.h"
+#include "libs/plant_nanny/services/ota/PingPongWriter.h"
 #include "libs/plant_nanny/services/network/INetworkService.h"
+#include <chrono>
+#include <functional>
 #include <string>
 #include <memory>
 
 namespace plant_nanny::services::ota
 {
+    struct UpdateOptions
+    {
+        size_t buffer_size = PingPongWriter::DEFAULT_BUFFER_SIZE;  // Per ping-pong buffer, two are allocated
+        uint8_t resume_attempts = 3;      // Range requests after a dropped connection
+        uint32_t resume_delay_ms = 1000;
+        uint32_t progress_interval_ms = 1000;
+    };
+
+    struct UpdateProgress
+    {
+        size_t bytes;          // Downloaded so far, including resumed ranges
+        size_t total;          // 0 when the server did not announce a length
+        uint32_t bytes_per_sec;
+    };
+
+    using ProgressCallback = std::function<void(const UpdateProgress &)>;
+
     class UpdateOrchestrator
     {
     private:
         common::service::Accessor<common::logger::Logger> logger_;
         std::unique_ptr<ota::Manager> ota_manager_;
         common::service::Accessor<network::INetworkService> network_service_;
+        UpdateOptions options_;
+        ProgressCallback progress_callback_;
 
         size_t bytes_downloaded_;
         size_t total_bytes_;
 
+        std::chrono::steady_clock::time_point started_at_;
+        std::chrono::steady_clock::time_point reported_at_;
+
+        void report_progress(size_t downloaded, size_t total);
+
     public:
-        explicit UpdateOrchestrator();
+        explicit UpdateOrchestrator(const UpdateOptions &options = {});
         ~UpdateOrchestrator() = default;
         UpdateOrchestrator(const UpdateOrchestrator &) = delete;
         UpdateOrchestrator &operator=(const UpdateOrchestrator &) = delete;
@@ -31,6 +59,12 @@ namespace plant_nanny::services::ota
         // Perform OTA update from URL
         common::patterns::Result<void> update_from_url(const std::string &firmware_url);
 
+        // Perform OTA update described by a manifest, decompressing the image while it streams in
+        common::patterns::Result<void> update(const Manifest &manifest);
+
+        // Called from the downloading task at most every progress_interval_ms, and at the end
+        void set_progress_callback(ProgressCallback callback) { progress_callback_ = std::move(callback); }
+
         // Get progress (0-100)
         uint8_t get_progress() const;
     };
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "libs/plant_nanny/services/power/DutyCycle.h"
+#include "libs/plant_nanny/services/rules/RuleEngine.h"
+#include <cstdint>
+
+namespace plant_nanny::services::power
+{
+    /**
+     * @brief Thin wrapper over esp_sleep for the duty-cycle mode
+     *
+     * Owns the RtcSampleStore and the watering rule state placed in RTC slow
+     * memory.
+     */
+    class DeepSleep
+    {
+    public:
+        static bool wokeFromTimer();
+        static bool wokeFromButton();
+
+        /**
+         * @brief Length of the last deep sleep
+         *
+         * The planned duration after a timer wake; after a button wake, the
+         * time measured on the RTC-backed system clock (SNTP only adjusts it
+         * once the network is up). 0 after a cold boot.
+         */
+        static uint32_t sleptMs();
+        static RtcSampleStore& store();
+        static rules::RuleState& ruleState();
+
+        /**
+         * @brief Enter deep sleep, waking on the timer or on @p wakePin going low
+         * @param wakePin RTC-capable GPIO, negative to disable
+         */
+        [[noreturn]] static void sleepFor(uint64_t durationUs, int wakePin = -1);
+    };
+
+} // namespace plant_nanny::services::power
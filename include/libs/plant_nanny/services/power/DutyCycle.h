@@ -0,0 +1,197 @@
+#pragma once
+
+#include "libs/plant_nanny/services/config/IConfigManager.h"
+#include "libs/plant_nanny/services/captors/ISensorManager.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace plant_nanny::services::power
+{
+    using config::DutyCycleConfig;
+
+    /**
+     * @brief One sensor sample packed for RTC slow memory (fixed point)
+     *
+     * Values keep the channel order of captors::SensorReadings.
+     */
+    struct PackedSample
+    {
+        static constexpr int16_t MISSING = INT16_MIN;
+
+        uint32_t elapsedSec = 0;    // Time since the store was reset
+        uint8_t count = 0;
+        int16_t valuesx100[captors::MAX_SENSOR_CHANNELS] = {MISSING, MISSING, MISSING, MISSING, MISSING, MISSING};
+
+        static PackedSample pack(const captors::SensorReadings& data, uint32_t elapsedSec);
+        captors::SensorReadings unpack() const;
+    };
+
+    /**
+     * @brief Sample buffer that survives deep sleep
+     *
+     * Lives in RTC slow memory (RTC_DATA_ATTR) on the device. RTC memory is
+     * lost on power-on and brown-out, so the content is only trusted when the
+     * magic and CRC match.
+     */
+    struct RtcSampleStore
+    {
+        static constexpr uint32_t MAGIC = 0x50574334; // "PWC4", bumped with the store or PackedSample layout
+        static constexpr size_t CAPACITY = 64;
+
+        uint32_t magic = 0;
+        uint32_t wakeCount = 0;
+        uint32_t elapsedSec = 0;
+        uint16_t wakesSinceUpload = 0;
+        uint16_t count = 0;
+        uint16_t elapsedMs = 0;     // Sub-second part of elapsedSec
+        uint32_t droppedSamples = 0;
+        uint32_t uploadFailures = 0;
+        bool hasReference = false;
+        bool retryPending = false;  // Last upload failed: no upload before uploadEveryWakes wakes
+        PackedSample reference{};   // Last uploaded sample, base for threshold checks
+        PackedSample samples[CAPACITY]{};
+        uint32_t crc = 0;
+    };
+
+    enum class UploadReason : uint8_t
+    {
+        None,        // Keep buffering, go back to sleep
+        FirstSample, // Nothing uploaded yet since power-on
+        Interval,    // uploadEveryWakes reached
+        Threshold,   // A reading moved past its delta
+        BufferFull
+    };
+
+    const char* to_string(UploadReason reason);
+
+    /**
+     * @brief Wake/flush policy of the deep-sleep duty-cycle mode
+     *
+     * Pure logic: the caller owns the RtcSampleStore and performs the actual
+     * sampling, upload and deep sleep.
+     */
+    class DutyCycle
+    {
+    public:
+        static constexpr uint64_t MIN_SLEEP_US = 100000;
+
+    private:
+        DutyCycleConfig _config;
+        float _deltas[captors::MAX_SENSOR_CHANNELS] = {};  // Upload threshold per channel, 0 = none
+
+        bool crossesThreshold(const RtcSampleStore& store, const PackedSample& sample) const;
+        static void addElapsed(RtcSampleStore& store, uint32_t ms);
+
+    public:
+        /**
+         * @param channels Maps the configured deltas (temperature, humidity, luminosity) to channel indices
+         */
+        explicit DutyCycle(const DutyCycleConfig& config,
+                           const captors::SensorChannels& channels = captors::SensorChannels::defaults());
+
+        static void reset(RtcSampleStore& store);
+        static bool isValid(const RtcSampleStore& store);
+        static void seal(RtcSampleStore& store);
+
+        /**
+         * @brief Record the sample taken on this wake and decide whether to upload
+         * @param sleptMs Length of the sleep that just ended
+         *
+         * Restores a corrupted or cold store first. When the buffer is full
+         * the oldest sample is dropped so the newest data always survives.
+         * After a failed upload nothing is uploaded, whatever the reason,
+         * until uploadEveryWakes wakes went by.
+         */
+        UploadReason onWake(RtcSampleStore& store, const captors::SensorReadings& data, uint32_t sleptMs) const;
+
+        /**
+         * @brief Count a sleep cut short by the button; the boot that follows is interactive
+         */
+        void onEarlyWake(RtcSampleStore& store, uint32_t sleptMs) const;
+
+        /**
+         * @brief Count the time spent awake before going back to sleep
+         *
+         * Up to the interval on a timer wake, minutes after a button wake.
+         * Ignored while the store is not valid.
+         */
+        void onSleep(RtcSampleStore& store, uint32_t awakeMs) const;
+
+        /**
+         * @brief Clear the batch after it reached the broker
+         */
+        void onUploaded(RtcSampleStore& store) const;
+
+        /**
+         * @brief Keep the batch and hold uploads for uploadEveryWakes wakes
+         */
+        void onUploadFailed(RtcSampleStore& store) const;
+
+        /**
+         * @brief Drop the first @p published samples, keep the rest as after a failed upload
+         */
+        void onPartialUpload(RtcSampleStore& store, size_t published) const;
+
+        /**
+         * @brief Age of a buffered sample relative to the newest one
+         */
+        static uint32_t ageSec(const RtcSampleStore& store, size_t index);
+
+        /**
+         * @brief Sleep time that keeps wakes sleepIntervalSec apart
+         * @param awakeMs Time already spent awake in this cycle
+         */
+        uint64_t sleepDurationUs(uint32_t awakeMs) const;
+
+        const DutyCycleConfig& config() const { return _config; }
+    };
+
+    /**
+     * @brief Current draw and timing of each phase of a duty cycle
+     *
+     * Defaults are rough figures for the LilyGO T-Display (ESP32 + ST7789
+     * backlight off), to be replaced by measurements on the actual board.
+     */
+    struct PowerProfile
+    {
+        float deepSleepCurrentMa = 0.35f;
+        float sampleCurrentMa = 45.0f;     // CPU on, radio off, sensors powered
+        uint32_t sampleActiveMs = 250;     // Boot + sampling + back to sleep
+        float uploadCurrentMa = 125.0f;    // WiFi + MQTT session
+        uint32_t uploadActiveMs = 2500;    // Association + broker connect + publish
+        float alwaysOnCurrentMa = 95.0f;   // Current firmware: WiFi modem-sleep, loop every 10 ms
+        uint32_t bytesPerSample = 110;     // JSON payload + MQTT/TCP overhead
+        uint32_t bytesPerUpload = 600;     // Connect, status, subscribe, disconnect
+    };
+
+    /**
+     * @brief Expected throughput and battery life of a duty-cycle configuration
+     */
+    struct EnergyEstimate
+    {
+        float averageCurrentMa = 0.0f;
+        float alwaysOnCurrentMa = 0.0f;
+        float samplesPerHour = 0.0f;
+        float uploadsPerHour = 0.0f;
+        float uplinkBytesPerHour = 0.0f;
+        float worstCaseLatencySec = 0.0f;  // Sample age at upload, excluding threshold uploads
+
+        float batteryLifeHours(float capacityMah) const
+        {
+            return averageCurrentMa > 0.0f ? capacityMah / averageCurrentMa : 0.0f;
+        }
+    };
+
+    /**
+     * @brief Throughput and energy model of the duty-cycle mode
+     *
+     * Assumes interval uploads only; every threshold upload adds one
+     * uploadActiveMs window at uploadCurrentMa.
+     */
+    class EnergyModel
+    {
+    public:
+        static EnergyEstimate estimate(const DutyCycleConfig& config, const PowerProfile& profile = PowerProfile{});
+    };
+
+} // namespace plant_nanny::services::power
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "libs/plant_nanny/services/pump/IDoser.h"
+#include "libs/plant_nanny/services/pump/IPump.h"
+#include "libs/plant_nanny/services/captors/ISensorManager.h"
+
+namespace plant_nanny::services::pump
+{
+    /**
+     * @brief Runs DosingController on the pump with the soil humidity channel as feedback
+     */
+    class Doser : public IDoser
+    {
+    private:
+        IPump* _pump;
+        captors::ISensorManager* _sensors;
+        DosingController _controller;
+        DoseCallback _callback;
+        bool _reservoirDry = false;
+
+        float readHumidity();
+        void complete();
+
+    public:
+        Doser();
+        ~Doser() override = default;
+
+        Doser(const Doser&) = delete;
+        Doser& operator=(const Doser&) = delete;
+
+        void configure(const DosingConfig& config) override;
+        const DosingConfig& config() const override { return _controller.config(); }
+
+        common::patterns::Result<void> start(const DoseRequest& request) override;
+        void update() override;
+        void abort() override;
+        bool isRunning() const override { return _controller.running(); }
+        bool reservoirDry() const override { return _reservoirDry; }
+
+        void setCallback(DoseCallback callback) override { _callback = std::move(callback); }
+    };
+
+} // namespace plant_nanny::services::pump
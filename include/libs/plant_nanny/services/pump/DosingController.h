@@ -0,0 +1,124 @@
+#pragma once
+
+#include "libs/plant_nanny/services/config/IConfigManager.h"
+#include "libs/common/patterns/Result.h"
+#include <cmath>
+#include <cstdint>
+#include <functional>
+
+namespace plant_nanny::services::pump
+{
+    using config::DosingConfig;
+
+    enum class DoseOutcome : uint8_t
+    {
+        Delivered,      // Whole amount pumped
+        TargetReached,  // Soil reached the target humidity first
+        DryReservoir,   // Water pumped but the soil did not react
+        Aborted
+    };
+
+    const char *to_string(DoseOutcome outcome);
+
+    /**
+     * @brief Water to deliver
+     *
+     * A durationMs runs the pump once for that long, without feedback (the
+     * historical pump_water behaviour); otherwise amountMl is delivered in
+     * pulses. targetPct stops early once the soil humidity reaches it.
+     */
+    struct DoseRequest
+    {
+        uint16_t amountMl = 0;
+        uint32_t durationMs = 0;
+        float targetPct = NAN;
+    };
+
+    struct DoseReport
+    {
+        DoseOutcome outcome = DoseOutcome::Delivered;
+        uint16_t deliveredMl = 0;  // Estimated from the flow rate
+        uint32_t pumpOnMs = 0;
+        float startPct = NAN;
+        float endPct = NAN;
+    };
+
+    /**
+     * @brief Pulse dosing with humidity feedback
+     *
+     * Pure logic: the caller steps it with a millisecond clock, switches the
+     * pump as told and provides soil humidity readings on demand (NaN when
+     * unavailable, in which case the dose runs open loop).
+     *
+     * Each pulse runs for pulseMl / flowMlPerSec, plus half the pump's
+     * soft-start ramp to make up for the water not pumped while ramping up.
+     * After each pulse but the last the soil is left to soak, then read:
+     * the dose stops when the target is reached, or when dryCheckMl has been
+     * delivered and humidity has not risen by minRisePct.
+     */
+    class DosingController
+    {
+    public:
+        using HumidityReader = std::function<float()>;
+
+        enum class Phase : uint8_t
+        {
+            Idle,
+            Pumping,
+            Soaking
+        };
+
+    private:
+        DosingConfig _config{};
+        uint32_t _rampMs = 0;
+
+        Phase _phase = Phase::Idle;
+        DoseRequest _request{};
+        DoseReport _report{};
+        uint32_t _phaseStartMs = 0;
+        uint32_t _pulseMs = 0;
+        uint16_t _pulseMl = 0;
+
+        void startPulse(uint32_t nowMs);
+        void finish(DoseOutcome outcome, float humidityPct);
+
+    public:
+        /**
+         * @param rampMs Soft-start ramp of the pump, 0 for a pump switched fully on
+         */
+        void configure(const DosingConfig &config, uint32_t rampMs = 0);
+
+        /**
+         * @brief Start a dose; fails while another one runs or when the request is empty
+         */
+        common::patterns::Result<void> start(const DoseRequest &request, float humidityPct, uint32_t nowMs);
+
+        /**
+         * @brief Advance the dose
+         * @return True when the pump must be running
+         */
+        bool update(uint32_t nowMs, const HumidityReader &readHumidity);
+
+        /**
+         * @brief Stop now, counting the water pumped so far
+         */
+        void abort(uint32_t nowMs);
+
+        bool running() const { return _phase != Phase::Idle; }
+        Phase phase() const { return _phase; }
+
+        /**
+         * @brief Outcome of the last dose, valid once running() is false again
+         */
+        const DoseReport &report() const { return _report; }
+
+        const DosingConfig &config() const { return _config; }
+
+        /**
+         * @brief Flow rate from a timed run of the pump and the water it delivered
+         * @return 0 when the measurement is unusable
+         */
+        static float flowFromRun(float measuredMl, uint32_t durationMs, uint32_t rampMs = 0);
+    };
+
+} // namespace plant_nanny::services::pump
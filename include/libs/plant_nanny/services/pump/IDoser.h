@@ -0,0 +1,41 @@
+#pragma once
+
+#include "libs/plant_nanny/services/pump/DosingController.h"
+#include "libs/common/patterns/Result.h"
+#include <functional>
+
+namespace plant_nanny::services::pump
+{
+    /**
+     * @brief Notified when a dose starts (started = true) and when it ends with its report
+     */
+    using DoseCallback = std::function<void(bool started, const DoseReport& report)>;
+
+    /**
+     * @brief Interface for pump dosing (DIP - Dependency Inversion Principle)
+     *
+     * Owned by the control task: start() returns at once and update() must
+     * be called periodically to run the dose.
+     */
+    class IDoser
+    {
+    public:
+        virtual ~IDoser() = default;
+
+        virtual void configure(const DosingConfig& config) = 0;
+        virtual const DosingConfig& config() const = 0;
+
+        virtual common::patterns::Result<void> start(const DoseRequest& request) = 0;
+        virtual void update() = 0;
+        virtual void abort() = 0;
+        virtual bool isRunning() const = 0;
+
+        /**
+         * @brief Set when the last closed-loop dose saw no humidity response
+         */
+        virtual bool reservoirDry() const = 0;
+
+        virtual void setCallback(DoseCallback callback) = 0;
+    };
+
+} // namespace plant_nanny::services::pump
@@ -8,11 +8,17 @@ namespace plant_nanny::services::pump
     /**
      * @brief Controls a pump (or LED indicator) via transistor
      * 
-     * The pump is controlled via a transistor connected to a GPIO pin.
-     * HIGH activates the pump, LOW deactivates it.
+     * The pump is controlled via a transistor connected to a GPIO pin, driven
+     * by an LEDC PWM channel. activate() ramps the duty up in hardware over
+     * SOFT_START_MS, which limits the motor inrush current (and the supply
+     * dip that resets the board on battery); deactivate() cuts it at once.
      */
     class Pump : public IPump
     {
+    public:
+        static constexpr uint32_t SOFT_START_MS = 250;
+        static constexpr uint32_t PWM_FREQUENCY_HZ = 20000;  // Above the audible range
+
     private:
         uint8_t _controlPin;
         bool _active = false;
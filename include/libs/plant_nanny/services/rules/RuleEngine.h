@@ -0,0 +1,100 @@
+#pragma once
+
+#include "libs/plant_nanny/services/captors/SensorChannel.h"
+#include "libs/plant_nanny/services/config/IConfigManager.h"
+#include "libs/common/patterns/Result.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace plant_nanny::services::rules
+{
+    using config::RuleComparison;
+    using config::RuleCondition;
+    using config::WateringRule;
+    using config::WateringRules;
+
+    // Bounds checked on every rule set before it is applied: a typo on the
+    // server must not be able to flood the pot or drain the reservoir
+    static constexpr uint32_t MIN_CYCLE_SEC = 15 * 60;
+    static constexpr uint16_t MAX_WATER_ML = 1000;
+
+    /**
+     * @brief What the engine remembers between two evaluations
+     *
+     * Trivially copyable so the duty-cycle mode can keep it in RTC memory
+     * across deep sleeps.
+     */
+    struct RuleState
+    {
+        uint8_t active[WateringRules::MAX_RULES] = {};  // Bit i set: condition i is active
+        bool hasWatered = false;
+        uint32_t lastWateringSec = 0;  // On the clock passed to evaluate()
+    };
+
+    struct WateringDecision
+    {
+        bool water = false;
+        int rule = -1;  // Index of the rule that fired
+        uint16_t amountMl = 0;
+        float targetPct = NAN;  // Release level of the rule's soil humidity condition, the dose may stop there
+    };
+
+    /**
+     * @brief Decides on the device when to water, from the filtered readings
+     *
+     * Evaluated once per sampling cycle. Conditions are latched with their
+     * hysteresis; a rule fires when all of its conditions are active, its
+     * readings are valid and minCycleSec has passed since the last watering.
+     * The first rule that fires wins. Without rules nothing ever fires and
+     * watering stays with the server.
+     *
+     * Time is any monotonic count of seconds (uptime, or the elapsed time
+     * of the duty-cycle store). When it goes backwards the watering history
+     * is forgotten rather than blocking watering until it catches up.
+     */
+    class RuleEngine
+    {
+    private:
+        WateringRules _rules{};
+        int8_t _channels[WateringRules::MAX_RULES][WateringRule::MAX_CONDITIONS] = {};
+        RuleState _state{};
+
+        static bool updateCondition(const RuleCondition &condition, float value, bool active);
+
+    public:
+        /**
+         * @brief Check bounds and that every condition names a known channel
+         */
+        static common::patterns::Result<void> validate(const WateringRules &rules,
+                                                       const captors::SensorChannels &channels);
+
+        /**
+         * @brief Replace the rules, keeping the current ones when @p rules is invalid
+         *
+         * Condition latches restart from inactive; the watering history is kept.
+         */
+        common::patterns::Result<void> configure(const WateringRules &rules,
+                                                 const captors::SensorChannels &channels);
+
+        /**
+         * @brief Decide whether to water; the decision is not recorded
+         *
+         * The caller reports the watering through noteWatering() once the
+         * pump accepted it, so a refused dose is retried on the next cycle.
+         */
+        WateringDecision evaluate(const captors::SensorReadings &readings, uint32_t nowSec);
+
+        /**
+         * @brief Record a watering: a rule dose that started, or one from the server
+         */
+        void noteWatering(uint32_t nowSec);
+
+        const RuleState &state() const { return _state; }
+        void restore(const RuleState &state) { _state = state; }
+
+        size_t ruleCount() const { return _rules.count; }
+        const WateringRules &rules() const { return _rules; }
+    };
+
+} // namespace plant_nanny::services::rules
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "libs/plant_nanny/services/timesync/SyncedClock.h"
+#include <cstdint>
+
+namespace plant_nanny::services::timesync
+{
+    /**
+     * @brief Interface for wall clock time (DIP - Dependency Inversion Principle)
+     *
+     * Owned by the network task, except monotonicMs() which any task may call.
+     * Samples are stamped with the monotonic clock when acquired and turned
+     * into Unix time when published.
+     */
+    class ITimeService
+    {
+    public:
+        virtual ~ITimeService() = default;
+
+        /**
+         * @brief Start (or restart) SNTP; call once the station has an address
+         */
+        virtual void start() = 0;
+
+        /**
+         * @brief Apply the time server answers received since the last call
+         */
+        virtual void update() = 0;
+
+        virtual bool isSynced() const = 0;
+
+        /**
+         * @brief Milliseconds since boot, never wraps; millis() is its low 32 bits
+         */
+        virtual uint64_t monotonicMs() const = 0;
+
+        /**
+         * @brief Unix time in seconds of a millis() stamp, 0 while unsynced
+         */
+        virtual uint32_t unixTimeAt(uint32_t stampMs) const = 0;
+
+        virtual const ClockStatus& status() const = 0;
+    };
+
+} // namespace plant_nanny::services::timesync
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+
+namespace plant_nanny::services::timesync
+{
+    struct ClockStatus
+    {
+        bool synced = false;
+        uint32_t syncCount = 0;
+        uint32_t stepCount = 0;     // Corrections too large to slew
+        int32_t lastErrorMs = 0;    // Wall clock minus our estimate at the last sync
+        uint64_t lastSyncMs = 0;    // Monotonic time of the last sync
+    };
+
+    /**
+     * @brief Wall clock derived from a monotonic millisecond clock and an offset
+     *
+     * Pure logic: the caller feeds (monotonic, Unix) pairs from SNTP and asks
+     * for the Unix time of any monotonic instant. Samples stamped with the
+     * monotonic clock at acquisition can thus be dated after the fact, even
+     * when the first sync comes later.
+     *
+     * The first sync sets the offset. Later ones slew it by at most 1 ms per
+     * SLEW_DIVISOR ms, so the wall clock keeps moving forward and two samples
+     * keep their order; only an error above STEP_THRESHOLD_MS steps it.
+     */
+    class SyncedClock
+    {
+    public:
+        static constexpr int64_t STEP_THRESHOLD_MS = 2000;
+        static constexpr uint32_t SLEW_DIVISOR = 200;  // 0.5 %
+        // Anything earlier is an unset RTC, not a time server answer (2024-01-01)
+        static constexpr int64_t MIN_VALID_UNIX_MS = 1704067200000LL;
+
+    private:
+        ClockStatus _status{};
+        int64_t _offsetMs = 0;
+        int64_t _slewMs = 0;         // Correction still being spread
+        uint64_t _slewStartMs = 0;
+
+        int64_t appliedSlew(uint64_t monotonicMs) const;
+
+    public:
+        /**
+         * @return False when @p unixMs is not a plausible wall clock time
+         */
+        bool sync(uint64_t monotonicMs, int64_t unixMs);
+
+        bool synced() const { return _status.synced; }
+
+        /**
+         * @return Unix time in ms, 0 until the first sync
+         */
+        int64_t unixMs(uint64_t monotonicMs) const;
+
+        const ClockStatus &status() const { return _status; }
+
+        /**
+         * @brief Extend a 32-bit millisecond stamp (millis()) to the 64-bit clock
+         *
+         * Valid for stamps less than 49 days older than @p nowMs.
+         */
+        static uint64_t widen(uint32_t stampMs, uint64_t nowMs);
+    };
+
+} // namespace plant_nanny::services::timesync
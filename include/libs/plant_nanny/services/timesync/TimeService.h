@@ -0,0 +1,53 @@
+#pragma once
+
+#include "libs/plant_nanny/services/timesync/ITimeService.h"
+#include "libs/common/concurrency/SpscQueue.h"
+
+struct timeval;
+
+namespace plant_nanny::services::timesync
+{
+    /**
+     * @brief SNTP client feeding a SyncedClock
+     *
+     * The SNTP answer arrives on the lwIP task: the callback only queues the
+     * (monotonic, Unix) pair, update() applies it on the network task.
+     */
+    class TimeService : public ITimeService
+    {
+    public:
+        static constexpr const char* SNTP_SERVER = "pool.ntp.org";
+        static constexpr uint32_t SYNC_INTERVAL_MS = 60 * 60 * 1000;
+
+    private:
+        struct SyncSample
+        {
+            uint64_t monotonicMs;
+            int64_t unixMs;
+        };
+
+        // The SNTP notification carries no user pointer
+        static TimeService* instance_;
+
+        SyncedClock _clock;
+        common::concurrency::SpscQueue<SyncSample, 2> _samples;  // lwIP -> network
+        bool _started = false;
+
+        static void onTimeSync(struct timeval* tv);
+
+    public:
+        TimeService();
+        ~TimeService() override;
+
+        TimeService(const TimeService&) = delete;
+        TimeService& operator=(const TimeService&) = delete;
+
+        void start() override;
+        void update() override;
+        bool isSynced() const override { return _clock.synced(); }
+        uint64_t monotonicMs() const override;
+        uint32_t unixTimeAt(uint32_t stampMs) const override;
+        const ClockStatus& status() const override { return _clock.status(); }
+    };
+
+} // namespace plant_nanny::services::timesync
@@ -4,6 +4,8 @@
 #include "libs/plant_nanny/services/bluetooth/IPairingManager.h"
 #include "libs/plant_nanny/services/config/IConfigManager.h"
 #include "libs/plant_nanny/ui/screens/PairingScreen.h"
+#include "libs/plant_nanny/states/StateId.h"
+#include <cstdint>
 #include <string>
 #include <functional>
 
@@ -31,7 +33,15 @@ namespace plant_nanny
         virtual ui::screens::PairingScreen& pairingScreen() = 0;
         
         // Request state transition (decoupled from StateMachine)
-        virtual void requestTransition(const std::string& stateId) = 0;
+        virtual void requestTransition(StateId stateId) = 0;
+
+        // Timed transitions: the state machine calls IAppState::onTimeout()
+        // once delayMs have passed since this call. States never block; a
+        // new transition disarms the deadline.
+        virtual void armStateTimeout(uint32_t delayMs) = 0;
+
+        // Restart the device (ESP.restart on target)
+        virtual void restart() = 0;
     };
 
 } // namespace plant_nanny
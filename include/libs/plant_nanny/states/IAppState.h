@@ -1,6 +1,7 @@
 #pragma once
 
 #include "libs/plant_nanny/services/button/ButtonHandler.h"
+#include "libs/plant_nanny/states/StateId.h"
 
 namespace plant_nanny
 {
@@ -30,19 +31,25 @@ namespace plant_nanny
 
         /**
          * @brief Handle button events
-         * @return Next state name, or empty string to stay in current state
+         * @return Next state, or StateId::None to stay in the current state
          */
-        virtual std::string handleButton(AppContext& context, services::button::ButtonEvent event) = 0;
+        virtual StateId handleButton(AppContext& context, services::button::ButtonEvent event) = 0;
 
         /**
          * @brief Called every frame for state-specific updates
          */
         virtual void update(AppContext& context) = 0;
 
+        /**
+         * @brief Called once the deadline armed with AppContext::armStateTimeout() passes
+         * @return Next state, or StateId::None to stay in the current state
+         */
+        virtual StateId onTimeout(AppContext& /*context*/) { return StateId::None; }
+
         /**
          * @brief Get state identifier
          */
-        virtual const char* id() const = 0;
+        virtual StateId id() const = 0;
     };
 
 } // namespace plant_nanny
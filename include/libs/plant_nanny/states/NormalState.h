@@ -25,9 +25,10 @@ namespace plant_nanny::states
     class NormalState : public IAppState
     {
     public:
-        static constexpr const char* ID = "normal";
+        static constexpr StateId ID = StateId::Normal;
+        static_assert(isAllowed(ID, StateId::Pairing) && isAllowed(ID, StateId::Resetting));
 
-        const char* id() const override { return ID; }
+        StateId id() const override { return ID; }
 
         void onEnter(AppContext& context) override
         {
@@ -37,7 +38,7 @@ namespace plant_nanny::states
 
         void onExit(AppContext& context) override {}
 
-        std::string handleButton(AppContext& context, services::button::ButtonEvent event) override
+        StateId handleButton(AppContext& context, services::button::ButtonEvent event) override
         {
             using namespace services::button;
 
@@ -45,14 +46,14 @@ namespace plant_nanny::states
             {
                 case ButtonEvent::LEFT_LONG_PRESS:
                     log_state("[APP] BT pairing...");
-                    return "pairing";
+                    return StateId::Pairing;
 
                 case ButtonEvent::RIGHT_LONG_PRESS:
                     log_state("[APP] Reset...");
-                    return "resetting";
+                    return StateId::Resetting;
 
                 default:
-                    return "";
+                    return StateId::None;
             }
         }
 
@@ -6,7 +6,8 @@
 #include "libs/common/logger/Logger.h"
 #include "libs/plant_nanny/services/config/IConfigManager.h"
 #include "libs/plant_nanny/services/bluetooth/IPairingManager.h"
-#include <Arduino.h>
+#include <atomic>
+#include <cstdint>
 
 namespace plant_nanny::states
 {
@@ -24,24 +25,41 @@ namespace plant_nanny::states
 
     /**
      * @brief Pairing state - BLE pairing in progress
+     *
+     * The "already paired" and "success" screens are held with a state
+     * deadline rather than a delay, so BLE keeps being serviced while they
+     * are shown.
      */
     class PairingState : public IAppState
     {
+    public:
+        static constexpr uint32_t ALREADY_PAIRED_SCREEN_MS = 3000;
+        static constexpr uint32_t SUCCESS_SCREEN_MS = 5000;  // Lets the app finish registration
+
     private:
-        bool _pairingComplete = false;
-        bool _pairingSuccess = false;
-        bool _alreadyPaired = false;
+        enum class Phase
+        {
+            AlreadyPaired,
+            Pairing,
+            Success,
+        };
+
+        Phase _phase = Phase::Pairing;
+        // Set from the BLE host task
+        std::atomic<bool> _pairingComplete{false};
+        std::atomic<bool> _pairingSuccess{false};
 
     public:
-        static constexpr const char* ID = "pairing";
+        static constexpr StateId ID = StateId::Pairing;
+        static_assert(isAllowed(ID, StateId::Normal));
 
-        const char* id() const override { return ID; }
+        StateId id() const override { return ID; }
 
         void onEnter(AppContext& context) override
         {
+            _phase = Phase::Pairing;
             _pairingComplete = false;
             _pairingSuccess = false;
-            _alreadyPaired = false;
             
             auto configManager = common::service::get<services::config::IConfigManager>();
             auto pairingManager = common::service::get<services::bluetooth::IPairingManager>();
@@ -51,7 +69,8 @@ namespace plant_nanny::states
             {
                 log_pairing("[STATE] Device already paired - showing reset required screen");
                 context.screenManager().navigateTo("already_paired");
-                _alreadyPaired = true;
+                _phase = Phase::AlreadyPaired;
+                context.armStateTimeout(ALREADY_PAIRED_SCREEN_MS);
                 return;
             }
             
@@ -64,8 +83,8 @@ namespace plant_nanny::states
                 context.screenManager().navigateTo("pairing");
                 
                 pairingManager->setPairingCompleteCallback([this](bool success) {
-                    _pairingComplete = true;
                     _pairingSuccess = success;
+                    _pairingComplete = true;
                 });
             }
             log_pairing("[STATE] Entered Pairing");
@@ -76,42 +95,55 @@ namespace plant_nanny::states
             auto pairingManager = common::service::get<services::bluetooth::IPairingManager>();
             pairingManager->stopPairing();
             context.setCurrentPin("");
+
+            // Once configured, BLE is not used again before the next restart
+            auto configManager = common::service::get<services::config::IConfigManager>();
+            if (configManager->isConfigured())
+            {
+                pairingManager->releaseControllerMemory();
+            }
         }
 
-        std::string handleButton(AppContext& context, services::button::ButtonEvent event) override
+        StateId handleButton(AppContext& context, services::button::ButtonEvent event) override
         {
             using namespace services::button;
 
             if (event == ButtonEvent::LEFT_SHORT_PRESS)
             {
                 log_pairing("[APP] Cancel pair");
-                return "normal";
+                return StateId::Normal;
             }
-            return "";
+            return StateId::None;
         }
 
         void update(AppContext& context) override
         {
-            if (_alreadyPaired)
+            if (_phase == Phase::AlreadyPaired)
             {
-                delay(3000);
-                context.requestTransition("normal");
                 return;
             }
-            
+
+            // Keep servicing BLE while the success screen is up
             auto pairingManager = common::service::get<services::bluetooth::IPairingManager>();
             pairingManager->update();
-            
-            if (_pairingComplete)
+
+            if (_phase == Phase::Pairing && _pairingComplete)
             {
                 if (_pairingSuccess)
                 {
                     context.screenManager().navigateTo("success");
-                    delay(5000);  // Wait for Flutter app to complete registration
+                    _phase = Phase::Success;
+                    context.armStateTimeout(SUCCESS_SCREEN_MS);
+                    return;
                 }
-                context.requestTransition("normal");
+                context.requestTransition(StateId::Normal);
             }
         }
+
+        StateId onTimeout(AppContext& /*context*/) override
+        {
+            return StateId::Normal;
+        }
     };
 
 } // namespace plant_nanny::states
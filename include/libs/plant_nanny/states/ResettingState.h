@@ -6,7 +6,7 @@
 #include "libs/common/logger/Logger.h"
 #include "libs/plant_nanny/services/config/IConfigManager.h"
 #include "libs/plant_nanny/services/bluetooth/IPairingManager.h"
-#include <Arduino.h>
+#include <cstdint>
 
 namespace plant_nanny::states
 {
@@ -28,9 +28,10 @@ namespace plant_nanny::states
     class ResettingState : public IAppState
     {
     public:
-        static constexpr const char* ID = "resetting";
+        static constexpr StateId ID = StateId::Resetting;
+        static constexpr uint32_t RESET_SCREEN_MS = 2000;
 
-        const char* id() const override { return ID; }
+        StateId id() const override { return ID; }
 
         void onEnter(AppContext& context) override
         {
@@ -42,19 +43,25 @@ namespace plant_nanny::states
             auto pairingManager = common::service::get<services::bluetooth::IPairingManager>();
             configManager->factoryReset();
             pairingManager->unpair();
-            
-            delay(2000);
-            ESP.restart();
+
+            // Restart once the reset screen has been shown
+            context.armStateTimeout(RESET_SCREEN_MS);
         }
 
         void onExit(AppContext& context) override {}
 
-        std::string handleButton(AppContext& context, services::button::ButtonEvent event) override
+        StateId handleButton(AppContext& context, services::button::ButtonEvent event) override
         {
-            return "";
+            return StateId::None;
         }
 
         void update(AppContext& context) override {}
+
+        StateId onTimeout(AppContext& context) override
+        {
+            context.restart();
+            return StateId::None;
+        }
     };
 
 } // namespace plant_nanny::states
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace plant_nanny
+{
+    /**
+     * @brief Application state identifiers, also used as table indices
+     *
+     * None is the state before boot and the "stay" answer of handleButton().
+     */
+    enum class StateId : uint8_t
+    {
+        None = 0,
+        Normal,
+        Pairing,
+        Resetting,
+        Count
+    };
+
+    static constexpr size_t STATE_COUNT = static_cast<size_t>(StateId::Count);
+
+    constexpr size_t index(StateId id) { return static_cast<size_t>(id); }
+
+    constexpr const char* to_string(StateId id)
+    {
+        switch (id)
+        {
+            case StateId::None:      return "none";
+            case StateId::Normal:    return "normal";
+            case StateId::Pairing:   return "pairing";
+            case StateId::Resetting: return "resetting";
+            default:                 return "unknown";
+        }
+    }
+
+    struct Transition
+    {
+        StateId from;
+        StateId to;
+    };
+
+    /**
+     * @brief Every transition the application may take
+     *
+     * Anything not listed is rejected at run time and recorded in the
+     * transition trace. States also static_assert their own targets against
+     * this table, so a new edge has to be added here first.
+     */
+    inline constexpr Transition TRANSITIONS[] = {
+        {StateId::None, StateId::Normal},        // Boot
+        {StateId::Normal, StateId::Pairing},
+        {StateId::Normal, StateId::Resetting},
+        {StateId::Pairing, StateId::Normal},     // Cancel, done, already paired
+        // Resetting ends in a restart
+    };
+
+    namespace detail
+    {
+        using TransitionTable = std::array<std::array<bool, STATE_COUNT>, STATE_COUNT>;
+
+        constexpr TransitionTable buildTransitionTable()
+        {
+            TransitionTable table{};
+            for (const Transition& t : TRANSITIONS)
+            {
+                table[index(t.from)][index(t.to)] = true;
+            }
+            return table;
+        }
+
+        constexpr bool isValidTransitionList()
+        {
+            std::array<bool, STATE_COUNT> entered{};
+            for (size_t i = 0; i < std::size(TRANSITIONS); i++)
+            {
+                const Transition& t = TRANSITIONS[i];
+                if (index(t.from) >= STATE_COUNT || index(t.to) >= STATE_COUNT)
+                {
+                    return false;
+                }
+                // No self loops, nothing goes back to None
+                if (t.from == t.to || t.to == StateId::None)
+                {
+                    return false;
+                }
+                for (size_t j = i + 1; j < std::size(TRANSITIONS); j++)
+                {
+                    if (TRANSITIONS[j].from == t.from && TRANSITIONS[j].to == t.to)
+                    {
+                        return false;
+                    }
+                }
+                entered[index(t.to)] = true;
+            }
+            // Every real state must be reachable
+            for (size_t s = index(StateId::None) + 1; s < STATE_COUNT; s++)
+            {
+                if (!entered[s])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    } // namespace detail
+
+    static_assert(detail::isValidTransitionList(),
+                  "TRANSITIONS has an out-of-range, duplicate or self edge, or an unreachable state");
+
+    inline constexpr detail::TransitionTable TRANSITION_TABLE = detail::buildTransitionTable();
+
+    constexpr bool isAllowed(StateId from, StateId to)
+    {
+        return index(from) < STATE_COUNT && index(to) < STATE_COUNT && TRANSITION_TABLE[index(from)][index(to)];
+    }
+
+} // namespace plant_nanny
@@ -2,24 +2,46 @@
 
 #include "IAppState.h"
 #include "AppContext.h"
-#include <unordered_map>
+#include "StateId.h"
+#include "TransitionTrace.h"
+#include <array>
+#include <functional>
 #include <memory>
-#include <string>
 
 namespace plant_nanny
 {
+    /**
+     * @brief Millisecond clock used to timestamp transitions (millis on target)
+     */
+    using StateClock = std::function<uint32_t()>;
+
     /**
      * @brief State machine manager (SRP - only manages state transitions)
+     *
+     * States are indexed by StateId; a transition is an array lookup plus a
+     * check against the constexpr TRANSITION_TABLE and does not allocate.
+     * Every attempt, accepted or not, is recorded in the transition trace.
+     *
+     * Each state has an entry time (enterAt) and an optional deadline
+     * (timeoutAt) armed by the state itself; update() fires onTimeout() once
+     * the deadline has passed, so states wait without blocking the loop.
      */
     class StateMachine
     {
     private:
-        std::unordered_map<std::string, std::shared_ptr<IAppState>> _states;
-        std::shared_ptr<IAppState> _currentState;
-        std::string _currentStateId;
+        std::array<std::shared_ptr<IAppState>, STATE_COUNT> _states{};
+        IAppState* _currentState = nullptr;
+        StateId _currentStateId = StateId::None;
+        StateClock _clock;
+        TransitionTrace _trace;
+        uint32_t _enterAt = 0;
+        uint32_t _timeoutAt = 0;
+        bool _timeoutArmed = false;
+
+        uint32_t now() const { return _clock ? _clock() : 0; }
 
     public:
-        StateMachine() = default;
+        explicit StateMachine(StateClock clock = nullptr);
         ~StateMachine() = default;
 
         StateMachine(const StateMachine&) = delete;
@@ -28,15 +50,15 @@ namespace plant_nanny
         StateMachine& operator=(StateMachine&&) = default;
 
         /**
-         * @brief Register a state
+         * @brief Register a state (at setup; replaces a state with the same id)
          */
         void registerState(std::shared_ptr<IAppState> state);
 
         /**
          * @brief Transition to a new state
-         * @return true if transition successful
+         * @return true if the transition is allowed and the state registered
          */
-        bool transitionTo(const std::string& stateId, AppContext& context);
+        bool transitionTo(StateId stateId, AppContext& context, TransitionCause cause = TransitionCause::Request);
 
         /**
          * @brief Handle button event in current state
@@ -44,14 +66,26 @@ namespace plant_nanny
         void handleButton(AppContext& context, services::button::ButtonEvent event);
 
         /**
-         * @brief Update current state
+         * @brief Update current state, then fire its timeout if due
          */
         void update(AppContext& context);
 
+        /**
+         * @brief Arm the current state's deadline @p delayMs from now
+         */
+        void armTimeout(uint32_t delayMs);
+        void cancelTimeout() { _timeoutArmed = false; }
+
+        uint32_t enterAt() const { return _enterAt; }
+        uint32_t timeoutAt() const { return _timeoutAt; }
+        bool timeoutArmed() const { return _timeoutArmed; }
+
         /**
          * @brief Get current state ID
          */
-        const std::string& currentStateId() const { return _currentStateId; }
+        StateId currentStateId() const { return _currentStateId; }
+
+        const TransitionTrace& trace() const { return _trace; }
     };
 
 } // namespace plant_nanny
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "libs/plant_nanny/states/StateId.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace plant_nanny
+{
+    enum class TransitionCause : uint8_t
+    {
+        Request,  // AppContext::requestTransition / transitionTo
+        Button,   // IAppState::handleButton
+        Timeout,  // IAppState::onTimeout
+    };
+
+    const char* to_string(TransitionCause cause);
+
+    struct TransitionRecord
+    {
+        uint32_t atMs = 0;
+        StateId from = StateId::None;
+        StateId to = StateId::None;
+        TransitionCause cause = TransitionCause::Request;
+        bool accepted = false;  // false: not in TRANSITIONS or state not registered
+    };
+
+    /**
+     * @brief Fixed-size ring of the latest state transitions (field debugging)
+     */
+    class TransitionTrace
+    {
+    public:
+        static constexpr size_t CAPACITY = 16;
+
+    private:
+        TransitionRecord _records[CAPACITY];
+        size_t _next = 0;
+        uint32_t _total = 0;
+        uint32_t _rejected = 0;
+
+    public:
+        void record(const TransitionRecord& record);
+
+        /**
+         * @brief Records currently held, at most CAPACITY
+         */
+        size_t size() const { return _total < CAPACITY ? _total : CAPACITY; }
+
+        /**
+         * @brief i-th held record, oldest first
+         */
+        const TransitionRecord& at(size_t i) const;
+
+        uint32_t total() const { return _total; }
+        uint32_t rejected() const { return _rejected; }
+
+        /**
+         * @brief Serialize as a JSON object into a caller buffer
+         * @return Bytes written (excluding the terminator), 0 if it does not fit
+         */
+        size_t toJson(char* buffer, size_t bufferSize, StateId current, uint32_t nowMs) const;
+    };
+
+} // namespace plant_nanny
@@ -2,15 +2,36 @@
 
 #include "libs/plant_nanny/ui/IScreen.h"
 #include <libs/common/ui/UI.h>
+#include <cmath>
+#include <cstdio>
 
 namespace plant_nanny::ui::screens
 {
     /**
-     * @brief Normal/home screen with button instructions
+     * @brief Normal/home screen with button instructions and live status
      */
     class NormalScreen : public IScreen
     {
     public:
+        /**
+         * @brief What the status lines show; NAN hides a value
+         */
+        struct Status
+        {
+            float temperatureC = NAN;
+            float luminosityPct = NAN;
+            bool wifiConnected = false;
+            bool mqttConnected = false;
+            bool watering = false;
+        };
+
+    private:
+        Status _status;
+
+    public:
+        void setStatus(const Status& status) { _status = status; }
+        const Status& status() const { return _status; }
+
         void render() override
         {
             using namespace common::ui;
@@ -20,6 +41,16 @@ namespace plant_nanny::ui::screens
             int w = get_screen_width();
             int h = get_screen_height();
 
+            char readings[32] = "--";
+            if (!std::isnan(_status.temperatureC) && !std::isnan(_status.luminosityPct))
+            {
+                snprintf(readings, sizeof(readings), "%.1fC  %.0f%% light", _status.temperatureC, _status.luminosityPct);
+            }
+            const char* link = _status.watering ? "Watering..."
+                             : _status.mqttConnected ? "WiFi + MQTT"
+                             : _status.wifiConnected ? "WiFi only"
+                             : "Offline";
+
             auto col = ColumnBuilder()
                 .mainAxisAlignment(MainAxisAlignment::CENTER)
                 .crossAxisAlignment(CrossAxisAlignment::CENTER)
@@ -28,6 +59,8 @@ namespace plant_nanny::ui::screens
                 .addChild(TextBuilder("PlantNanny").fontSize(2).align(Align::CENTER).color(Color::Green).build())
                 .addChild(TextBuilder("LEFT 3s: Pair").fontSize(1).align(Align::CENTER).color(Color::LightGray).build())
                 .addChild(TextBuilder("RIGHT 3s: Reset").fontSize(1).align(Align::CENTER).color(Color::LightGray).build())
+                .addChild(TextBuilder(readings).fontSize(1).align(Align::CENTER).color(Color::White).build())
+                .addChild(TextBuilder(link).fontSize(1).align(Align::CENTER).color(Color::LightGray).build())
                 .build();
 
             col->measure(w, h);
@@ -4,6 +4,7 @@
 
 #include <cstdint>
 #include <cstddef>
+#include <vector>
 #include "esp_err.h"
 #include "esp_partition.h"
 #include "esp_app_format.h"
@@ -21,6 +22,9 @@ typedef enum
 
 static constexpr uint32_t OTA_WITH_SEQUENTIAL_WRITES = 0xFFFFFFFF;
 
+// Bytes passed to esp_ota_write since the last esp_ota_begin, for tests to inspect
+inline std::vector<uint8_t> mock_ota_written;
+
 // Mock implementations
 inline esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_size, esp_ota_handle_t *out_handle)
 {
@@ -29,6 +33,7 @@ inline esp_err_t esp_ota_begin(const esp_partition_t *partition, size_t image_si
 
     static uint32_t handle_counter = 1;
     *out_handle = handle_counter++;
+    mock_ota_written.clear();
     return ESP_OK;
 }
 
@@ -37,6 +42,8 @@ inline esp_err_t esp_ota_write(esp_ota_handle_t handle, const void *data, size_t
     if (handle == 0 || data == nullptr || size == 0)
         return ESP_ERR_INVALID_ARG;
 
+    const uint8_t *bytes = static_cast<const uint8_t *>(data);
+    mock_ota_written.insert(mock_ota_written.end(), bytes, bytes + size);
     return ESP_OK;
 }
 
@@ -73,6 +80,15 @@ inline esp_err_t esp_ota_get_state_partition(const esp_partition_t *partition, e
     return ESP_OK;
 }
 
+inline esp_err_t esp_ota_get_partition_description(const esp_partition_t *partition, esp_app_desc_t *app_desc)
+{
+    if (partition == nullptr || app_desc == nullptr)
+        return ESP_ERR_INVALID_ARG;
+
+    *app_desc = *esp_app_get_description();
+    return ESP_OK;
+}
+
 inline esp_err_t esp_ota_mark_app_valid_cancel_rollback(void)
 {
     return ESP_OK;
@@ -3,6 +3,8 @@
 #ifdef NATIVE_TEST
 
 #include <cstdint>
+#include <cstring>
+#include <vector>
 #include "esp_err.h"
 
 typedef enum
@@ -32,7 +34,27 @@ typedef struct esp_partition
     bool encrypted;
 } esp_partition_t;
 
+// Contents returned by esp_partition_read, for any partition; tests fill it with the running image
+inline std::vector<uint8_t> mock_partition_contents;
+
 // Mock implementations
+inline esp_err_t esp_partition_read(const esp_partition_t *partition, size_t src_offset, void *dst, size_t size)
+{
+    if (partition == nullptr || dst == nullptr)
+        return ESP_ERR_INVALID_ARG;
+    if (src_offset + size > partition->size)
+        return ESP_ERR_INVALID_SIZE;
+
+    // Erased flash past the stored contents
+    memset(dst, 0xFF, size);
+    if (src_offset < mock_partition_contents.size())
+    {
+        size_t available = mock_partition_contents.size() - src_offset;
+        memcpy(dst, mock_partition_contents.data() + src_offset, size < available ? size : available);
+    }
+    return ESP_OK;
+}
+
 inline const esp_partition_t *esp_ota_get_boot_partition(void)
 {
     static esp_partition_t mock_partition = {
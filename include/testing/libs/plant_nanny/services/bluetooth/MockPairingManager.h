@@ -0,0 +1,79 @@
+#pragma once
+
+#include "libs/plant_nanny/services/bluetooth/IPairingManager.h"
+#include <string>
+
+namespace testing::mocks
+{
+    /**
+     * @brief IPairingManager double for native state tests
+     *
+     * Records calls; completePairing() plays the role of the BLE host task.
+     */
+    class MockPairingManager : public plant_nanny::services::bluetooth::IPairingManager
+    {
+    private:
+        using Result = common::patterns::Result<void>;
+        using PairingState = plant_nanny::services::bluetooth::PairingState;
+
+        PairingState state_{};
+        plant_nanny::services::bluetooth::PairingCompleteCallback pairing_complete_callback_;
+
+    public:
+        std::string pin = "123456";
+        bool startShouldSucceed = true;
+        int starts = 0;
+        int stops = 0;
+        int updates = 0;
+        int unpairs = 0;
+        int releases = 0;
+
+        void completePairing(bool success)
+        {
+            if (pairing_complete_callback_)
+            {
+                pairing_complete_callback_(success);
+            }
+        }
+
+        Result initialize() override { return Result::success(); }
+        Result startPairing() override
+        {
+            starts++;
+            return startShouldSucceed ? Result::success()
+                                      : Result::failure(common::patterns::Error("Mock pairing start failed"));
+        }
+        Result stopPairing() override
+        {
+            stops++;
+            return Result::success();
+        }
+        bool verifyPin(const std::string &value) override { return value == pin; }
+        PairingState getState() const override { return state_; }
+        void setState(PairingState state) override { state_ = state; }
+        void setDeviceId(const std::string &) override {}
+        void setIpAddress(const std::string &) override {}
+        void notifyWifiConfigured(bool) override {}
+
+        void setPinDisplayCallback(plant_nanny::services::bluetooth::PinDisplayCallback) override {}
+        void setPairingCompleteCallback(plant_nanny::services::bluetooth::PairingCompleteCallback callback) override
+        {
+            pairing_complete_callback_ = std::move(callback);
+        }
+        void setWifiConfigCallback(plant_nanny::services::bluetooth::WifiConfigCallback) override {}
+        void setMqttConfigCallback(plant_nanny::services::bluetooth::MqttConfigCallback) override {}
+        void setStateChangeCallback(plant_nanny::services::bluetooth::StateChangeCallback) override {}
+        void setCalibrationCallback(plant_nanny::services::bluetooth::CalibrationCallback) override {}
+        void notifyCalibration(const std::string &) override {}
+
+        void update() override { updates++; }
+        const std::string &getCurrentPin() const override { return pin; }
+        Result unpair() override
+        {
+            unpairs++;
+            return Result::success();
+        }
+        void releaseControllerMemory() override { releases++; }
+    };
+
+} // namespace testing::mocks
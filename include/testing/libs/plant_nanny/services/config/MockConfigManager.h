@@ -0,0 +1,157 @@
+#pragma once
+
+#include "libs/plant_nanny/services/config/IConfigManager.h"
+#include <string>
+#include <cstdint>
+
+namespace testing::mocks
+{
+    /**
+     * @brief In-memory IConfigManager for native tests
+     */
+    class MockConfigManager : public plant_nanny::services::config::IConfigManager
+    {
+    private:
+        using Result = common::patterns::Result<void>;
+        template <typename T>
+        using ResultOf = common::patterns::Result<T>;
+
+        static ResultOf<std::string> optional(const std::string &value, const char *what)
+        {
+            if (value.empty())
+            {
+                return ResultOf<std::string>::failure(common::patterns::Error(std::string(what) + " not set"));
+            }
+            return ResultOf<std::string>::success(value);
+        }
+
+    public:
+        std::string ssid;
+        std::string wifiPassword;
+        plant_nanny::services::config::WifiLinkCache linkCache;
+        plant_nanny::services::config::NetworkConfig network;
+        bool configured = false;
+        std::string deviceId = "mock-device";
+        std::string mqttHost;
+        uint16_t mqttPort = 1883;
+        std::string mqttUsername;
+        std::string mqttPassword;
+        plant_nanny::services::config::PlantThresholds thresholds;
+        plant_nanny::services::config::DutyCycleConfig dutyCycle;
+        plant_nanny::services::config::DosingConfig dosing;
+        plant_nanny::services::config::SensorCalibration calibration;
+        int calibrationSaves = 0;
+        plant_nanny::services::config::WateringRules rules;
+        int rulesSaves = 0;
+        int factoryResets = 0;
+
+        Result initialize() override { return Result::success(); }
+
+        Result factoryReset() override
+        {
+            factoryResets++;
+            ssid.clear();
+            wifiPassword.clear();
+            linkCache = {};
+            network = {};
+            configured = false;
+            mqttHost.clear();
+            mqttUsername.clear();
+            mqttPassword.clear();
+            thresholds = {};
+            dutyCycle = {};
+            dosing = {};
+            calibration = {};
+            rules = plant_nanny::services::config::WateringRules{};
+            return Result::success();
+        }
+
+        Result saveWifiCredentials(const std::string &s, const std::string &p) override
+        {
+            ssid = s;
+            wifiPassword = p;
+            return Result::success();
+        }
+        ResultOf<std::string> getWifiSsid() override { return optional(ssid, "WiFi SSID"); }
+        ResultOf<std::string> getWifiPassword() override { return ResultOf<std::string>::success(wifiPassword); }
+        Result saveWifiLinkCache(const plant_nanny::services::config::WifiLinkCache &cache) override
+        {
+            linkCache = cache;
+            return Result::success();
+        }
+        ResultOf<plant_nanny::services::config::WifiLinkCache> getWifiLinkCache() override
+        {
+            return ResultOf<plant_nanny::services::config::WifiLinkCache>::success(linkCache);
+        }
+        Result saveNetworkConfig(const plant_nanny::services::config::NetworkConfig &value) override
+        {
+            network = value;
+            return Result::success();
+        }
+        plant_nanny::services::config::NetworkConfig getNetworkConfig() override { return network; }
+
+        bool isConfigured() override { return configured; }
+        Result setConfigured(bool value) override
+        {
+            configured = value;
+            return Result::success();
+        }
+        std::string getOrCreateDeviceId() override { return deviceId; }
+
+        Result saveMqttConfig(const std::string &host, uint16_t port) override
+        {
+            mqttHost = host;
+            mqttPort = port;
+            return Result::success();
+        }
+        Result saveMqttCredentials(const std::string &username, const std::string &password) override
+        {
+            mqttUsername = username;
+            mqttPassword = password;
+            return Result::success();
+        }
+        ResultOf<std::string> getMqttHost() override { return optional(mqttHost, "MQTT host"); }
+        uint16_t getMqttPort() override { return mqttPort; }
+        ResultOf<std::string> getMqttUsername() override { return ResultOf<std::string>::success(mqttUsername); }
+        ResultOf<std::string> getMqttPassword() override { return ResultOf<std::string>::success(mqttPassword); }
+        bool isMqttConfigured() override { return !mqttHost.empty(); }
+
+        Result savePlantThresholds(const plant_nanny::services::config::PlantThresholds &value) override
+        {
+            thresholds = value;
+            return Result::success();
+        }
+        plant_nanny::services::config::PlantThresholds getPlantThresholds() override { return thresholds; }
+
+        Result saveDutyCycleConfig(const plant_nanny::services::config::DutyCycleConfig &value) override
+        {
+            dutyCycle = value;
+            return Result::success();
+        }
+        plant_nanny::services::config::DutyCycleConfig getDutyCycleConfig() override { return dutyCycle; }
+
+        Result saveDosingConfig(const plant_nanny::services::config::DosingConfig &value) override
+        {
+            dosing = value;
+            return Result::success();
+        }
+        plant_nanny::services::config::DosingConfig getDosingConfig() override { return dosing; }
+
+        Result saveSensorCalibration(const plant_nanny::services::config::SensorCalibration &value) override
+        {
+            calibration = value;
+            calibrationSaves++;
+            return Result::success();
+        }
+        plant_nanny::services::config::SensorCalibration getSensorCalibration() override { return calibration; }
+
+        Result saveWateringRules(const plant_nanny::services::config::WateringRules &value) override
+        {
+            rules = value;
+            rulesSaves++;
+            return Result::success();
+        }
+        plant_nanny::services::config::WateringRules getWateringRules() override { return rules; }
+    };
+
+} // namespace testing::mocks
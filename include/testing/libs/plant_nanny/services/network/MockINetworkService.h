@@ -2,10 +2,12 @@
 
 #include "libs/plant_nanny/services/network/INetworkService.h"
 #include <string>
+#include <algorithm>
 #include <cstdint>
 #include <functional>
 #include <fstream>
 #include <cstdlib>
+#include <vector>
 
 #ifndef NATIVE_TEST
 #include <Arduino.h>
@@ -21,6 +23,9 @@ namespace testing::mocks
         bool use_real_connection = false;
         std::string mock_ip = "192.168.1.100";
         int mock_rssi = -50;
+        std::vector<uint8_t> download_payload;  // Served by download_file; empty serves 4 fake bytes
+        size_t download_chunk_size = 512;
+        size_t download_drop_at = 0;  // Simulate one connection loss once this many bytes were served
     };
 
     class MockNetworkService : public plant_nanny::services::network::INetworkService
@@ -30,6 +35,18 @@ namespace testing::mocks
         std::string password_;
         bool connected_{false};
         MockNetworkConfig config_;
+        plant_nanny::services::network::ConnectionCallback connection_callback_;
+        std::vector<size_t> download_offsets_;
+
+        void set_link(bool connected)
+        {
+            bool changed = connected != connected_;
+            connected_ = connected;
+            if (changed && connection_callback_)
+            {
+                connection_callback_(connected);
+            }
+        }
 
     public:
         MockNetworkService() = default;
@@ -113,6 +130,7 @@ namespace testing::mocks
         const MockNetworkConfig &get_config() const { return config_; }
 
         void test_set_connected(bool connected) { connected_ = connected; }
+        const std::vector<size_t> &test_download_offsets() const { return download_offsets_; }
         void test_update_config(const MockNetworkConfig &config) { config_ = config; }
 
         void set_credentials(const std::string &ssid, const std::string &password) override
@@ -168,7 +186,7 @@ namespace testing::mocks
 
             if (config_.connect_should_succeed)
             {
-                connected_ = true;
+                set_link(true);
                 return common::patterns::Result<void>::success();
             }
             return common::patterns::Result<void>::failure(
@@ -177,7 +195,7 @@ namespace testing::mocks
 
         void disconnect() override
         {
-            connected_ = false;
+            set_link(false);
         }
 
         bool is_connected() const override
@@ -189,6 +207,22 @@ namespace testing::mocks
         {
         }
 
+        plant_nanny::services::network::ConnectionState get_connection_state() const override
+        {
+            return connected_ ? plant_nanny::services::network::ConnectionState::Connected
+                              : plant_nanny::services::network::ConnectionState::Idle;
+        }
+
+        plant_nanny::services::network::ConnectionStats get_connection_stats() const override
+        {
+            return {};
+        }
+
+        void set_connection_callback(plant_nanny::services::network::ConnectionCallback callback) override
+        {
+            connection_callback_ = std::move(callback);
+        }
+
         common::patterns::Result<std::string> get_ip_address() const override
         {
             if (!connected_)
@@ -212,8 +246,11 @@ namespace testing::mocks
         common::patterns::Result<void> download_file(
             const std::string &url,
             std::function<bool(const uint8_t *, size_t)> chunk_handler,
-            std::function<void(size_t, size_t)> progress_callback = nullptr) override
+            std::function<void(size_t, size_t)> progress_callback = nullptr,
+            size_t offset = 0) override
         {
+            download_offsets_.push_back(offset);
+
             if (!connected_)
             {
                 return common::patterns::Result<void>::failure(
@@ -226,16 +263,43 @@ namespace testing::mocks
                     common::patterns::Error("Mock download failed"));
             }
 
-            uint8_t fake_data[] = {0x01, 0x02, 0x03, 0x04};
-            if (!chunk_handler(fake_data, sizeof(fake_data)))
+            std::vector<uint8_t> payload = config_.download_payload;
+            if (payload.empty())
+            {
+                payload = {0x01, 0x02, 0x03, 0x04};
+            }
+
+            if (offset > payload.size())
             {
                 return common::patterns::Result<void>::failure(
-                    common::patterns::Error("Chunk handler failed"));
+                    common::patterns::Error("Range not satisfiable"));
             }
 
-            if (progress_callback)
+            for (size_t position = offset; position < payload.size(); position += config_.download_chunk_size)
             {
-                progress_callback(sizeof(fake_data), sizeof(fake_data));
+                size_t length = std::min(config_.download_chunk_size, payload.size() - position);
+                if (config_.download_drop_at > 0 && position + length > config_.download_drop_at)
+                {
+                    length = config_.download_drop_at > position ? config_.download_drop_at - position : 0;
+                    config_.download_drop_at = 0;
+                    if (length > 0)
+                    {
+                        chunk_handler(payload.data() + position, length);
+                    }
+                    return common::patterns::Result<void>::failure(
+                        common::patterns::Error("Connection lost"));
+                }
+
+                if (!chunk_handler(payload.data() + position, length))
+                {
+                    return common::patterns::Result<void>::failure(
+                        common::patterns::Error("Chunk handler failed"));
+                }
+
+                if (progress_callback)
+                {
+                    progress_callback(position + length, payload.size());
+                }
             }
 
             return common::patterns::Result<void>::success();
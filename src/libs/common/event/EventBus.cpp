@@ -0,0 +1,175 @@
+#include "libs/common/event/EventBus.h"
+
+namespace common::event
+{
+    EventBus::EventBus(Clock clock)
+        : _clock(std::move(clock))
+    {
+    }
+
+    SubscriberId EventBus::subscribeRaw(const char *name, int32_t id, std::function<void(const void *)> handler)
+    {
+        if (_subscriberCount >= MAX_SUBSCRIBERS)
+        {
+            return INVALID_SUBSCRIBER;
+        }
+
+        Subscriber &subscriber = _subscribers[_subscriberCount];
+        subscriber.name = name;
+        subscriber.id = id;
+        subscriber.handler = std::move(handler);
+        subscriber.stats = SubscriberStats{};
+
+        return static_cast<SubscriberId>(_subscriberCount++);
+    }
+
+    bool EventBus::publishRaw(int32_t id, const void *payload, size_t size)
+    {
+        // Start at a rotating slot so concurrent publishers rarely collide
+        uint32_t start = _cursor.fetch_add(1, std::memory_order_relaxed);
+        for (size_t i = 0; i < SLOT_COUNT; i++)
+        {
+            Slot &slot = _slots[(start + i) % SLOT_COUNT];
+            uint8_t expected = SLOT_FREE;
+            if (!slot.state.compare_exchange_strong(expected, SLOT_WRITING, std::memory_order_acquire))
+            {
+                continue;
+            }
+
+            slot.id = id;
+            slot.sequence = _sequence.fetch_add(1, std::memory_order_relaxed);
+            slot.publishedUs = _clock();
+            if (size > 0)
+            {
+                std::memcpy(slot.payload, payload, size);
+            }
+            slot.state.store(SLOT_READY, std::memory_order_release);
+
+            _published.fetch_add(1, std::memory_order_relaxed);
+            ringDoorbell();
+            return true;
+        }
+
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    void EventBus::ringDoorbell()
+    {
+        // One wake-up per dispatch is enough; dispatch() re-arms the flag
+        if (!_doorbell || _doorbellPending.exchange(true))
+        {
+            return;
+        }
+        if (!_doorbell())
+        {
+            _doorbellFailures.fetch_add(1, std::memory_order_relaxed);
+            _doorbellPending.store(false);
+        }
+    }
+
+    void EventBus::deliver(Slot &slot)
+    {
+        for (size_t i = 0; i < _subscriberCount; i++)
+        {
+            Subscriber &subscriber = _subscribers[i];
+            if (subscriber.id != slot.id)
+            {
+                continue;
+            }
+
+            uint64_t start = _clock();
+            subscriber.handler(slot.payload);
+            uint64_t end = _clock();
+
+            SubscriberStats &stats = subscriber.stats;
+            uint32_t latency = start > slot.publishedUs ? static_cast<uint32_t>(start - slot.publishedUs) : 0;
+            uint32_t runUs = static_cast<uint32_t>(end - start);
+            stats.deliveries++;
+            stats.lastLatencyUs = latency;
+            stats.totalLatencyUs += latency;
+            if (latency > stats.maxLatencyUs)
+            {
+                stats.maxLatencyUs = latency;
+            }
+            if (runUs > stats.maxHandlerUs)
+            {
+                stats.maxHandlerUs = runUs;
+            }
+        }
+    }
+
+    size_t EventBus::dispatch()
+    {
+        _doorbellPending.store(false);
+
+        // Bounded so a flood of publications cannot pin the dispatching task
+        size_t delivered = 0;
+        while (delivered < SLOT_COUNT)
+        {
+            Slot *next = nullptr;
+            for (Slot &slot : _slots)
+            {
+                if (slot.state.load(std::memory_order_acquire) != SLOT_READY)
+                {
+                    continue;
+                }
+                // Wrap-safe sequence comparison
+                if (next == nullptr || static_cast<int32_t>(slot.sequence - next->sequence) < 0)
+                {
+                    next = &slot;
+                }
+            }
+            if (next == nullptr)
+            {
+                return delivered;
+            }
+
+            deliver(*next);
+            next->state.store(SLOT_FREE, std::memory_order_release);
+            delivered++;
+        }
+
+        for (const Slot &slot : _slots)
+        {
+            if (slot.state.load(std::memory_order_acquire) == SLOT_READY)
+            {
+                ringDoorbell();
+                break;
+            }
+        }
+        return delivered;
+    }
+
+    const char *EventBus::subscriberName(SubscriberId id) const
+    {
+        return id < _subscriberCount ? _subscribers[id].name : nullptr;
+    }
+
+    const SubscriberStats &EventBus::subscriberStats(SubscriberId id) const
+    {
+        static const SubscriberStats empty{};
+        return id < _subscriberCount ? _subscribers[id].stats : empty;
+    }
+
+    BusStats EventBus::stats() const
+    {
+        BusStats stats;
+        stats.published = _published.load(std::memory_order_relaxed);
+        stats.dropped = _dropped.load(std::memory_order_relaxed);
+        stats.doorbellFailures = _doorbellFailures.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void EventBus::resetStats()
+    {
+        for (size_t i = 0; i < _subscriberCount; i++)
+        {
+            _subscribers[i].stats = SubscriberStats{};
+        }
+        _published.store(0);
+        _dropped.store(0);
+        _doorbellFailures.store(0);
+    }
+
+} // namespace common::event
@@ -0,0 +1,242 @@
+#include "libs/common/metrics/Metrics.h"
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace common::metrics
+{
+    namespace
+    {
+        // constinit: set before any metric constructor runs, whatever the link order
+        constinit Metric *s_head = nullptr;
+        constinit Metric *s_tail = nullptr;
+
+        /**
+         * Appends to a fixed buffer and remembers whether anything was cut
+         */
+        class JsonWriter
+        {
+        private:
+            char *_buffer;
+            size_t _size;
+            size_t _length = 0;
+            bool _overflow = false;
+
+        public:
+            JsonWriter(char *buffer, size_t size) : _buffer(buffer), _size(size) {}
+
+            void append(const char *format, ...)
+            {
+                if (_overflow)
+                {
+                    return;
+                }
+                va_list args;
+                va_start(args, format);
+                int written = vsnprintf(_buffer + _length, _size - _length, format, args);
+                va_end(args);
+                if (written < 0 || static_cast<size_t>(written) >= _size - _length)
+                {
+                    _overflow = true;
+                    return;
+                }
+                _length += static_cast<size_t>(written);
+            }
+
+            size_t finish() const { return _overflow ? 0 : _length; }
+        };
+
+        void writeSection(JsonWriter &out, Kind kind, const char *key)
+        {
+            out.append("\"%s\":{", key);
+            bool first = true;
+            for (Metric *metric = s_head; metric != nullptr; metric = metric->next())
+            {
+                if (metric->kind() != kind)
+                {
+                    continue;
+                }
+                out.append("%s\"%s\":", first ? "" : ",", metric->name());
+                first = false;
+
+                switch (kind)
+                {
+                case Kind::Counter:
+                    out.append("%lu", static_cast<unsigned long>(static_cast<Counter *>(metric)->value()));
+                    break;
+                case Kind::Gauge:
+                    out.append("%ld", static_cast<long>(static_cast<Gauge *>(metric)->value()));
+                    break;
+                case Kind::Histogram:
+                {
+                    auto *histogram = static_cast<Histogram *>(metric);
+                    Histogram::Snapshot snapshot = histogram->peek();
+                    out.append("{\"le\":[");
+                    for (size_t i = 0; i + 1 < histogram->bucketCount(); i++)
+                    {
+                        out.append("%s%lu", i > 0 ? "," : "", static_cast<unsigned long>(histogram->bounds()[i]));
+                    }
+                    out.append("],\"n\":[");
+                    for (size_t i = 0; i < histogram->bucketCount(); i++)
+                    {
+                        out.append("%s%lu", i > 0 ? "," : "", static_cast<unsigned long>(snapshot.counts[i]));
+                    }
+                    out.append("],\"sum\":%lu,\"max\":%lu}", static_cast<unsigned long>(snapshot.sum),
+                               static_cast<unsigned long>(snapshot.max));
+                    break;
+                }
+                }
+            }
+            out.append("}");
+        }
+    }
+
+    Metric::Metric(const char *name, Kind kind)
+        : _name(name), _kind(kind), _next(nullptr)
+    {
+        // Appended, so snapshots list metrics in definition order within a file
+        if (s_tail == nullptr)
+        {
+            s_head = this;
+        }
+        else
+        {
+            s_tail->_next = this;
+        }
+        s_tail = this;
+    }
+
+    Histogram::Histogram(const char *name, std::initializer_list<uint32_t> upperBounds)
+        : Metric(name, Kind::Histogram)
+    {
+        for (uint32_t bound : upperBounds)
+        {
+            if (_boundCount == MAX_BOUNDS)
+            {
+                break;
+            }
+            _bounds[_boundCount++] = bound;
+        }
+    }
+
+    void Histogram::record(uint32_t value)
+    {
+        size_t bucket = 0;
+        while (bucket < _boundCount && value > _bounds[bucket])
+        {
+            bucket++;
+        }
+        _counts[bucket].fetch_add(1, std::memory_order_relaxed);
+
+        uint32_t sum = _sum.load(std::memory_order_relaxed);
+        uint32_t next;
+        do
+        {
+            next = sum > UINT32_MAX - value ? UINT32_MAX : sum + value;
+        } while (!_sum.compare_exchange_weak(sum, next, std::memory_order_relaxed));
+
+        uint32_t max = _max.load(std::memory_order_relaxed);
+        while (value > max && !_max.compare_exchange_weak(max, value, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    Histogram::Snapshot Histogram::drain()
+    {
+        Snapshot snapshot = peek();
+        commit();
+        return snapshot;
+    }
+
+    Histogram::Snapshot Histogram::peek()
+    {
+        _peeked = Snapshot{};
+        for (size_t i = 0; i < bucketCount(); i++)
+        {
+            _peeked.counts[i] = _counts[i].load(std::memory_order_relaxed);
+            _peeked.count += _peeked.counts[i];
+        }
+        _peeked.sum = _sum.load(std::memory_order_relaxed);
+        _peeked.max = _max.load(std::memory_order_relaxed);
+        return _peeked;
+    }
+
+    void Histogram::commit()
+    {
+        for (size_t i = 0; i < bucketCount(); i++)
+        {
+            _counts[i].fetch_sub(_peeked.counts[i], std::memory_order_relaxed);
+        }
+
+        // A saturated sum cannot be split; it restarts from zero
+        uint32_t sum = _sum.load(std::memory_order_relaxed);
+        uint32_t next;
+        do
+        {
+            next = sum == UINT32_MAX ? 0 : sum - _peeked.sum;
+        } while (!_sum.compare_exchange_weak(sum, next, std::memory_order_relaxed));
+
+        // Keep a larger maximum recorded since peek()
+        uint32_t max = _peeked.max;
+        _max.compare_exchange_strong(max, 0, std::memory_order_relaxed);
+
+        _peeked = Snapshot{};
+    }
+
+    Metric *Registry::first()
+    {
+        return s_head;
+    }
+
+    size_t Registry::count()
+    {
+        size_t count = 0;
+        for (const Metric *metric = s_head; metric != nullptr; metric = metric->next())
+        {
+            count++;
+        }
+        return count;
+    }
+
+    const Metric *Registry::find(const char *name)
+    {
+        for (const Metric *metric = s_head; metric != nullptr; metric = metric->next())
+        {
+            if (strcmp(metric->name(), name) == 0)
+            {
+                return metric;
+            }
+        }
+        return nullptr;
+    }
+
+    size_t Registry::writeJson(char *buffer, size_t size)
+    {
+        if (buffer == nullptr || size == 0)
+        {
+            return 0;
+        }
+        JsonWriter out(buffer, size);
+        out.append("{");
+        writeSection(out, Kind::Counter, "c");
+        out.append(",");
+        writeSection(out, Kind::Gauge, "g");
+        out.append(",");
+        writeSection(out, Kind::Histogram, "h");
+        out.append("}");
+
+        return out.finish();
+    }
+
+    void Registry::commitHistograms()
+    {
+        for (Metric *metric = s_head; metric != nullptr; metric = metric->next())
+        {
+            if (metric->kind() == Kind::Histogram)
+            {
+                static_cast<Histogram *>(metric)->commit();
+            }
+        }
+    }
+
+} // namespace common::metrics
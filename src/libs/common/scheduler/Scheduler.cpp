@@ -0,0 +1,232 @@
+#include "libs/common/scheduler/Scheduler.h"
+
+namespace common::scheduler
+{
+    Scheduler::Scheduler(Clock clock)
+        : _clock(std::move(clock))
+    {
+    }
+
+    TaskId Scheduler::add(const char *name, TaskFunction function, uint64_t periodUs,
+                          uint64_t deadlineUs, uint32_t budgetUs)
+    {
+        if (_count >= MAX_TASKS || !function)
+        {
+            return INVALID_TASK;
+        }
+
+        Task &task = _tasks[_count];
+        task.name = name;
+        task.function = std::move(function);
+        task.periodUs = periodUs;
+        task.deadlineUs = deadlineUs;
+        task.budgetUs = budgetUs;
+        task.releaseAt = _clock();  // Periodic tasks run on the first pass
+        task.released = false;
+        task.enabled = true;
+        task.stats = TaskStats{};
+
+        return static_cast<TaskId>(_count++);
+    }
+
+    TaskId Scheduler::addPeriodic(const char *name, uint32_t periodMs, TaskFunction function, uint32_t budgetUs)
+    {
+        uint64_t periodUs = static_cast<uint64_t>(periodMs > 0 ? periodMs : 1) * 1000;
+        return add(name, std::move(function), periodUs, periodUs, budgetUs);
+    }
+
+    TaskId Scheduler::addEvent(const char *name, uint32_t deadlineMs, TaskFunction function, uint32_t budgetUs)
+    {
+        return add(name, std::move(function), 0, static_cast<uint64_t>(deadlineMs) * 1000, budgetUs);
+    }
+
+    void Scheduler::signal(TaskId id)
+    {
+        if (id >= _count)
+        {
+            return;
+        }
+        _tasks[id].signaled.store(true);
+        if (_wakeHook)
+        {
+            _wakeHook();
+        }
+    }
+
+    void Scheduler::setPeriod(TaskId id, uint32_t periodMs)
+    {
+        if (id >= _count || _tasks[id].periodUs == 0)
+        {
+            return;
+        }
+        Task &task = _tasks[id];
+        task.periodUs = static_cast<uint64_t>(periodMs > 0 ? periodMs : 1) * 1000;
+        task.deadlineUs = task.periodUs;
+        task.releaseAt = _clock() + task.periodUs;
+    }
+
+    void Scheduler::setEnabled(TaskId id, bool enabled)
+    {
+        if (id >= _count || _tasks[id].enabled == enabled)
+        {
+            return;
+        }
+        Task &task = _tasks[id];
+        task.enabled = enabled;
+        task.released = false;
+        if (enabled)
+        {
+            task.releaseAt = _clock();
+        }
+    }
+
+    void Scheduler::release(uint64_t now)
+    {
+        for (size_t i = 0; i < _count; i++)
+        {
+            Task &task = _tasks[i];
+            bool signaled = task.signaled.exchange(false);
+            if (!task.enabled || task.released)
+            {
+                continue;
+            }
+
+            if (signaled)
+            {
+                task.released = true;
+                task.absoluteDeadline = now + (task.periodUs > 0 ? 0 : task.deadlineUs);
+            }
+            else if (task.periodUs > 0 && now >= task.releaseAt)
+            {
+                task.released = true;
+                task.absoluteDeadline = task.releaseAt + task.deadlineUs;
+            }
+        }
+    }
+
+    void Scheduler::runTask(Task &task)
+    {
+        task.released = false;
+
+        uint64_t start = _clock();
+        TaskStats &stats = task.stats;
+        if (start > task.absoluteDeadline)
+        {
+            uint64_t lateness = start - task.absoluteDeadline;
+            stats.deadlineMisses++;
+            if (lateness > stats.maxLatenessUs)
+            {
+                stats.maxLatenessUs = static_cast<uint32_t>(lateness);
+            }
+        }
+
+        task.function();
+
+        uint64_t end = _clock();
+        uint32_t runUs = static_cast<uint32_t>(end - start);
+        stats.runs++;
+        stats.lastRunUs = runUs;
+        stats.totalRunUs += runUs;
+        if (runUs > stats.maxRunUs)
+        {
+            stats.maxRunUs = runUs;
+        }
+        if (task.budgetUs > 0 && runUs > task.budgetUs)
+        {
+            stats.overruns++;
+        }
+
+        if (task.periodUs == 0)
+        {
+            return;
+        }
+
+        if (task.releaseAt > start)
+        {
+            // Signaled early: restart the period from now
+            task.releaseAt = start + task.periodUs;
+            return;
+        }
+
+        // Fixed rate; releases that are already over are dropped, not replayed
+        task.releaseAt += task.periodUs;
+        if (task.releaseAt <= end)
+        {
+            uint64_t missed = (end - task.releaseAt) / task.periodUs + 1;
+            stats.skippedPeriods += static_cast<uint32_t>(missed);
+            task.releaseAt += missed * task.periodUs;
+        }
+    }
+
+    uint32_t Scheduler::runOnce()
+    {
+        release(_clock());
+
+        while (true)
+        {
+            Task *next = nullptr;
+            for (size_t i = 0; i < _count; i++)
+            {
+                Task &task = _tasks[i];
+                if (task.released && (next == nullptr || task.absoluteDeadline < next->absoluteDeadline))
+                {
+                    next = &task;
+                }
+            }
+            if (next == nullptr)
+            {
+                break;
+            }
+            runTask(*next);
+        }
+
+        uint64_t now = _clock();
+        uint64_t idleUs = static_cast<uint64_t>(MAX_IDLE_MS) * 1000;
+        for (size_t i = 0; i < _count; i++)
+        {
+            const Task &task = _tasks[i];
+            if (!task.enabled)
+            {
+                continue;
+            }
+            if (task.signaled.load())
+            {
+                return 0;
+            }
+            if (task.periodUs > 0)
+            {
+                if (task.releaseAt <= now)
+                {
+                    return 0;
+                }
+                if (task.releaseAt - now < idleUs)
+                {
+                    idleUs = task.releaseAt - now;
+                }
+            }
+        }
+
+        // Round up: waking a little late beats spinning on a sub-ms remainder
+        return static_cast<uint32_t>((idleUs + 999) / 1000);
+    }
+
+    const char *Scheduler::name(TaskId id) const
+    {
+        return id < _count ? _tasks[id].name : nullptr;
+    }
+
+    const TaskStats &Scheduler::stats(TaskId id) const
+    {
+        static const TaskStats empty{};
+        return id < _count ? _tasks[id].stats : empty;
+    }
+
+    void Scheduler::resetStats()
+    {
+        for (size_t i = 0; i < _count; i++)
+        {
+            _tasks[i].stats = TaskStats{};
+        }
+    }
+
+} // namespace common::scheduler
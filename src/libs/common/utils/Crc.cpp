@@ -0,0 +1,37 @@
+#include "libs/common/utils/Crc.h"
+#include <array>
+
+namespace common::utils
+{
+    namespace
+    {
+        constexpr std::array<uint32_t, 256> make_table()
+        {
+            std::array<uint32_t, 256> table{};
+            for (uint32_t i = 0; i < 256; i++)
+            {
+                uint32_t c = i;
+                for (int k = 0; k < 8; k++)
+                {
+                    c = (c & 1) ? (0xEDB88320u ^ (c >> 1)) : (c >> 1);
+                }
+                table[i] = c;
+            }
+            return table;
+        }
+
+        constexpr auto CRC32_TABLE = make_table();
+    }
+
+    uint32_t Crc32::compute(const void *data, size_t length, uint32_t crc)
+    {
+        const auto *bytes = static_cast<const uint8_t *>(data);
+        crc = ~crc;
+        for (size_t i = 0; i < length; i++)
+        {
+            crc = CRC32_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+        }
+        return ~crc;
+    }
+
+} // namespace common::utils
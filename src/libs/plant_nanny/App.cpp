@@ -1,12 +1,15 @@
 #include "libs/plant_nanny/services/ServiceRegistry.h"
 #include "libs/plant_nanny/services/dev/DevConfig.h"
 #include "libs/plant_nanny/services/ota/UpdateOrchestrator.h"
+#include "libs/plant_nanny/services/power/DeepSleep.h"
 #include "libs/plant_nanny/states/NormalState.h"
 #include "libs/plant_nanny/states/PairingState.h"
 #include "libs/plant_nanny/states/ResettingState.h"
 #include "libs/plant_nanny/ui/screens/AlreadyPairedScreen.h"
 #include "libs/plant_nanny/ui/screens/WifiErrorScreen.h"
 #include <libs/common/logger/Log.h>
+#include <libs/common/metrics/Metrics.h>
+#include <libs/plant_nanny/metrics/FirmwareMetrics.h>
 #include <libs/common/logger/Logger.h>
 #include <libs/common/logger/LoggerFactory.h>
 #include <libs/common/service/Registry.h>
@@ -14,22 +17,32 @@
 #include <libs/plant_nanny/App.h>
 
 #include <libs/common/service/Accessor.h>
+#include <esp_heap_caps.h>
+#include <esp_timer.h>
 
 ESP_EVENT_DEFINE_BASE(common::APP_EVENTS);
 
 namespace plant_nanny {
+
 void App::initEventLoop() {
-  esp_event_loop_args_t loop_args = {.queue_size = 10,
+  // Handlers touch UI/control state, so they run on the control core
+  esp_event_loop_args_t loop_args = {.queue_size = 16,
                                      .task_name = "app_loop",
                                      .task_priority = uxTaskPriorityGet(NULL),
                                      .task_stack_size = 4096,
-                                     .task_core_id = tskNO_AFFINITY};
+                                     .task_core_id = CONTROL_CORE};
   esp_event_loop_create(&loop_args, &_event_loop);
 }
 
 App::App()
     : _event_loop(nullptr), _mqtt_client(std::make_unique<PubSubClient>()),
-      _pairingScreen(std::make_shared<ui::screens::PairingScreen>()) {
+      _pairingScreen(std::make_shared<ui::screens::PairingScreen>()),
+      _normalScreen(std::make_shared<ui::screens::NormalScreen>()),
+      _stateMachine([]() { return static_cast<uint32_t>(millis()); }),
+      _scheduler([]() { return static_cast<uint64_t>(esp_timer_get_time()); }),
+      _networkScheduler(
+          []() { return static_cast<uint64_t>(esp_timer_get_time()); }),
+      _bus([]() { return static_cast<uint64_t>(esp_timer_get_time()); }) {
   initEventLoop();
 }
 
@@ -46,8 +59,7 @@ void App::setupScreens() {
 
   _screenManager.registerScreen("splash",
                                 std::make_shared<ui::screens::SplashScreen>());
-  _screenManager.registerScreen("normal",
-                                std::make_shared<ui::screens::NormalScreen>());
+  _screenManager.registerScreen("normal", _normalScreen);
   _screenManager.registerScreen("pairing", _pairingScreen);
   _screenManager.registerScreen("success",
                                 std::make_shared<ui::screens::SuccessScreen>());
@@ -76,81 +88,199 @@ void App::setupAppCallbacks() {
   auto configManager = common::service::get<services::config::IConfigManager>();
   auto mqttCommandHandler =
       common::service::get<services::mqtt::IMqttCommandHandler>();
+  auto networkManager =
+      common::service::get<services::network::INetworkService>();
+
+  // Link edges from the connection state machine go to the event bus
+  networkManager->set_connection_callback([this](bool connected) {
+    if (connected) {
+      _bus.publish<events::WifiConnected>();
+    } else {
+      _bus.publish<events::WifiDisconnected>();
+    }
+  });
 
   // Button callback needs state machine
   buttonHandler->setCallback([this](services::button::ButtonEvent event) {
+    _lastActivityMs = millis();
     _stateMachine.handleButton(*this, event);
   });
 
   // Apply dev config
   services::dev::DevConfig::apply(configManager.get());
 
-  // Pairing callbacks need screen manager
+  // Pairing callbacks run on the NimBLE host task: hand the screen change
+  // to the control task and the WiFi work to the network task
   pairingManager->setStateChangeCallback(
       [this](services::bluetooth::PairingState newState) {
         switch (newState) {
         case services::bluetooth::PairingState::AWAITING_WIFI_CONFIG:
           LOG_INFO("[APP] PIN verified, showing WiFi config screen");
-          _screenManager.navigateTo("wifi_config");
-          _screenManager.render();
+          showScreen("wifi_config");
           break;
         case services::bluetooth::PairingState::PAIRED:
           LOG_INFO("[APP] Configuration complete!");
-          _screenManager.navigateTo("config_complete");
-          _screenManager.render();
+          showScreen("config_complete");
           break;
         default:
           break;
         }
       });
 
+  pairingManager->setCalibrationCallback([this](const std::string &text) {
+    services::captors::calibration::CalibrationRequest request;
+    if (!services::captors::calibration::parse(text, request)) {
+      common::service::get<services::bluetooth::IPairingManager>()
+          ->notifyCalibration(
+          "{\"type\":\"calibration\",\"ok\":false,\"error\":\"unknown "
+          "sensor or point\"}");
+      return;
+    }
+    // Sampling belongs to the control task
+    if (!_calibrations.push(request)) {
+      LOG_WARN("[APP] Calibration already pending, ignoring");
+      return;
+    }
+    _scheduler.signal(_commandTask);
+  });
+
+  // PairingManager::update() runs both on the control task; the MQTT
+  // settings arrive first and travel with the WiFi credentials
+  pairingManager->setMqttConfigCallback(
+      [this](const services::bluetooth::MqttConfig &config) {
+        LOG_INFO("[APP] MQTT config received via BLE");
+        _pendingMqtt = config;
+      });
+
   pairingManager->setWifiConfigCallback(
       [this](const services::bluetooth::WifiCredentials &creds) {
         LOG_INFO("[APP] WiFi credentials received via BLE");
-        auto cfgMgr = common::service::get<services::config::IConfigManager>();
-        auto netMgr =
-            common::service::get<services::network::INetworkService>();
-        auto pairMgr =
-            common::service::get<services::bluetooth::IPairingManager>();
-
-        cfgMgr->saveWifiCredentials(creds.ssid, creds.password);
-        netMgr->set_credentials(creds.ssid, creds.password);
-        auto result = netMgr->connect();
-        pairMgr->notifyWifiConfigured(result.succeed());
-
-        if (result.succeed()) {
-          LOG_INFO("[APP] WiFi connected via BLE config");
-          cfgMgr->setConfigured(true);
-
-          auto ipResult = netMgr->get_ip_address();
-          if (ipResult.succeed()) {
-            pairMgr->setIpAddress(ipResult.value());
-          }
-
-          initMqttCallbacks();
-        } else {
-          LOG_INFO("[APP] WiFi connection failed - showing error screen");
-          _screenManager.navigateTo("wifi_error");
-          _screenManager.render();
-          pairMgr->setState(
-              services::bluetooth::PairingState::AWAITING_WIFI_CONFIG);
+        ProvisioningRequest request{creds, _pendingMqtt};
+        _pendingMqtt = {};
+        if (!_provisioning.push(request)) {
+          LOG_WARN("[APP] WiFi provisioning already pending, ignoring");
+          return;
         }
+        _networkScheduler.signal(_provisioningTask);
       });
 
-  pairingManager->setMqttConfigCallback(
-      [](const services::bluetooth::MqttConfig &config) {
-        LOG_INFO("[APP] MQTT config received via BLE");
-        auto cfgMgr = common::service::get<services::config::IConfigManager>();
-        cfgMgr->saveMqttConfig(config.host, config.port);
+  // OTA callback needs App
+  mqttCommandHandler->setOtaCallback(
+      [this](const services::ota::Manifest &manifest) {
+        return perform_ota_update(manifest);
+      });
 
-        if (!config.username.empty()) {
-          cfgMgr->saveMqttCredentials(config.username, config.password);
+  // Doses start and end on the control task
+  common::service::get<services::pump::IDoser>()->setCallback(
+      [this](bool started, const services::pump::DoseReport &report) {
+        events::Watering watering{report.pumpOnMs, report.deliveredMl,
+                                  report.outcome};
+        if (started) {
+          _bus.publish<events::WateringStarted>(watering);
+          return;
+        }
+        if (report.deliveredMl > 0) {
+          // Server-requested waterings also count towards the rules' cycle
+          _rules.noteWatering(ruleClockSec());
         }
+        _bus.publish<events::WateringCompleted>(watering);
+        publishDoseReport(report);
       });
+}
 
-  // OTA callback needs App
-  mqttCommandHandler->setOtaCallback(
-      [this](const std::string &url) { return perform_ota_update(url); });
+void App::setupEventBus() {
+  using namespace events;
+
+  // Subscribers run on the app_loop task: they only copy data into the
+  // queue of the task that owns the target (see threading.md)
+  _bus.subscribe<SensorUpdate>("mqtt", [this](const SensorSample &sample) {
+    services::mqtt::SensorReading reading;
+    if (sample.valid) {
+      reading.readings = sample;
+    }
+    if (!_readings.push(reading)) {
+      LOG_DEBUG("[APP] Reading queue full, network task behind");
+    }
+  });
+  // SNTP needs the link; it is started on the network task
+  _bus.subscribe<WifiConnected>("time", [this](const Empty &) {
+    _networkScheduler.signal(_timeSyncTask);
+  });
+
+  // The status screen only shows the board channels it knows about
+  const auto &channels =
+      common::service::get<services::captors::ISensorManager>()->channels();
+  int temperature = channels.find(services::captors::channels::TEMPERATURE.key);
+  int luminosity = channels.find(services::captors::channels::LUMINOSITY.key);
+  _bus.subscribe<SensorUpdate>(
+      "ui", [this, temperature, luminosity](const SensorSample &sample) {
+        _uiStatus.temperatureC = sample.valid ? sample.get(temperature) : NAN;
+        _uiStatus.luminosityPct = sample.valid ? sample.get(luminosity) : NAN;
+        publishStatus();
+      });
+  _bus.subscribe<WifiConnected>("ui", [this](const Empty &) {
+    _uiStatus.wifiConnected = true;
+    publishStatus();
+  });
+  _bus.subscribe<WifiDisconnected>("ui", [this](const Empty &) {
+    _uiStatus.wifiConnected = false;
+    _uiStatus.mqttConnected = false;
+    publishStatus();
+  });
+  _bus.subscribe<MqttConnected>("ui", [this](const Empty &) {
+    _uiStatus.mqttConnected = true;
+    publishStatus();
+  });
+  _bus.subscribe<MqttDisconnected>("ui", [this](const Empty &) {
+    _uiStatus.mqttConnected = false;
+    publishStatus();
+  });
+  _bus.subscribe<WateringStarted>("ui", [this](const Watering &) {
+    _uiStatus.watering = true;
+    publishStatus();
+  });
+  _bus.subscribe<WateringCompleted>("ui", [this](const Watering &watering) {
+    _uiStatus.watering = false;
+    publishStatus();
+    char msg[80];
+    snprintf(msg, sizeof(msg), "[APP] Watered %u ml in %lu ms (%s)",
+             static_cast<unsigned>(watering.deliveredMl),
+             static_cast<unsigned long>(watering.durationMs),
+             services::pump::to_string(watering.outcome));
+    LOG_INFO(msg);
+  });
+  _bus.subscribe<OtaProgress>("log", [](const OtaTransfer &transfer) {
+    char msg[80];
+    snprintf(msg, sizeof(msg), "[APP] OTA %lu/%lu bytes, %lu B/s",
+             static_cast<unsigned long>(transfer.bytes),
+             static_cast<unsigned long>(transfer.total),
+             static_cast<unsigned long>(transfer.bytesPerSec));
+    LOG_INFO(msg);
+  });
+
+  // Publishing only claims a slot; this empty post wakes the dispatcher.
+  // Timeout 0: a full esp_event queue is retried on the next publish
+  on(EVENT_BUS_DOORBELL, &App::onBusDoorbell, this);
+  _bus.setDoorbell([this]() {
+    return esp_event_post_to(_event_loop, common::APP_EVENTS,
+                             EVENT_BUS_DOORBELL, nullptr, 0, 0) == ESP_OK;
+  });
+}
+
+void App::onBusDoorbell(void *arg, esp_event_base_t, int32_t, void *) {
+  auto *app = static_cast<App *>(arg);
+  // esp_event does not expose its task handle; the health task needs it
+  if (app->_eventLoopTask.load(std::memory_order_relaxed) == nullptr) {
+    app->_eventLoopTask.store(xTaskGetCurrentTaskHandle(),
+                              std::memory_order_relaxed);
+  }
+  app->_bus.dispatch();
+}
+
+void App::publishStatus() {
+  if (_statusUpdates.push(_uiStatus)) {
+    _scheduler.signal(_screenTask);
+  }
 }
 
 void App::initMqttCallbacks() {
@@ -184,26 +314,38 @@ void App::initMqttCallbacks() {
     mqttService->set_credentials(userResult.value(), passResult.value());
   }
 
-  mqttService->set_reading_callback([]() {
-    auto sensorMgr = common::service::get<services::captors::ISensorManager>();
-    services::mqtt::SensorReading reading;
-    auto sensorData = sensorMgr->read();
-    if (sensorData.valid) {
-      reading.temperatureC = sensorData.temperatureC;
-      reading.luminosityPct = sensorData.luminosityPct;
-      reading.humidityPct = 0.0f;
-    } else {
-      reading.temperatureC = NAN;
-      reading.luminosityPct = NAN;
-      reading.humidityPct = NAN;
+  // Both callbacks run on the network task; sensors are sampled by the
+  // control task and reach this side through the bus and _readings
+  mqttService->set_reading_callback([this]() {
+    // Dated when published: a sample taken before the first sync still gets
+    // its acquisition time once the clock is set
+    services::mqtt::SensorReading reading = _latestReading;
+    if (reading.readings.acquiredMs != 0) {
+      reading.timestamp =
+          common::service::get<services::timesync::ITimeService>()->unixTimeAt(
+              reading.readings.acquiredMs);
     }
     return reading;
   });
+  mqttService->set_channels(
+      common::service::get<services::captors::ISensorManager>()->channels());
 
-  mqttService->set_command_callback([](const services::mqtt::Command &cmd) {
-    auto mqttCommandHandler =
-        common::service::get<services::mqtt::IMqttCommandHandler>();
-    mqttCommandHandler->handle(cmd);
+  mqttService->set_command_callback([this](const services::mqtt::Command &cmd) {
+    if (cmd.type == services::mqtt::CommandType::OtaUpdate) {
+      // OTA streams over the network and must not stall the control loop
+      common::service::get<services::mqtt::IMqttCommandHandler>()->handle(cmd);
+      return;
+    }
+    if (cmd.type == services::mqtt::CommandType::GetMetrics) {
+      // Early release; the periodic snapshot restarts its period from now
+      _networkScheduler.signal(_metricsTask);
+      return;
+    }
+    if (!_commands.push(cmd)) {
+      LOG_WARN("[APP] Command queue full, dropping command");
+      return;
+    }
+    _scheduler.signal(_commandTask);
   });
 
   mqttService->set_publish_interval(60000);
@@ -221,13 +363,9 @@ void App::tryConnectNetwork() {
   auto passResult = configManager->getWifiPassword();
 
   if (ssidResult.succeed() && !ssidResult.value().empty()) {
+    // Non-blocking: maintain_connection() drives the attempt from run()
     networkManager->set_credentials(ssidResult.value(), passResult.value());
-    auto connectResult = networkManager->connect();
-    if (connectResult.succeed()) {
-      LOG_INFO("[APP] WiFi connected");
-    } else {
-      LOG_INFO("[APP] WiFi connection failed, will retry");
-    }
+    LOG_INFO("[APP] WiFi connection started");
   }
 }
 
@@ -237,47 +375,792 @@ void App::initialize() {
   common::logger::LoggerFactory::registerLogger();
   services::registerServices();
 
+  // Reference points captured on this unit (calibrate command)
+  common::service::get<services::captors::ISensorManager>()->applyCalibration(
+      common::service::get<services::config::IConfigManager>()
+          ->getSensorCalibration());
+
+  // Watering rules pushed by the server (set_rules command)
+  auto rulesLoaded = _rules.configure(
+      common::service::get<services::config::IConfigManager>()
+          ->getWateringRules(),
+      common::service::get<services::captors::ISensorManager>()->channels());
+  if (rulesLoaded.failed()) {
+    char msg[96];
+    snprintf(msg, sizeof(msg), "[APP] Stored watering rules ignored: %s",
+             rulesLoaded.error().message().c_str());
+    LOG_WARN(msg);
+  }
+
+  // Timer wake in duty-cycle mode: sample, maybe upload, sleep again.
+  // Any other wake (power-on, button) takes the interactive path below.
+  auto dutyCycle = common::service::get<services::config::IConfigManager>()
+                       ->getDutyCycleConfig();
+  if (dutyCycle.enabled && services::power::DeepSleep::wokeFromTimer()) {
+    runDutyCycleWake(dutyCycle);
+  }
+  if (services::power::DeepSleep::wokeFromButton()) {
+    // Keep the sample ages right across the interactive session
+    services::power::DutyCycle(dutyCycle).onEarlyWake(
+        services::power::DeepSleep::store(),
+        services::power::DeepSleep::sleptMs());
+  }
+
+  // Re-pairing needs a factory reset (and restart), so a configured device
+  // never brings BLE up during this boot
+  if (common::service::get<services::config::IConfigManager>()
+          ->isConfigured()) {
+    common::service::get<services::bluetooth::IPairingManager>()
+        ->releaseControllerMemory();
+  }
+
   setupScreens();
   setupStates();
   setupAppCallbacks();
+  setupTasks();
+  setupEventBus();
 
   _screenManager.navigateTo("splash");
   delay(1500);
 
   tryConnectNetwork();
   initMqttCallbacks();
-  _stateMachine.transitionTo("normal", *this);
+  _stateMachine.transitionTo(StateId::Normal, *this);
+  startNetworkTask();
   LOG_INFO("[APP] Ready");
 }
 
-void App::run() {
-  common::service::get<services::button::IButtonHandler>()->poll();
-  _stateMachine.update(*this);
-  common::service::get<services::network::INetworkService>()
-      ->maintain_connection();
-  common::service::get<services::mqtt::IMQTTService>()->update();
-
-  if (!_pendingTransition.empty()) {
-    std::string nextState = _pendingTransition;
-    _pendingTransition.clear();
+void App::setupTasks() {
+  using services::button::IButtonHandler;
+
+  // Budgets are the expected worst case; longer runs show up as overruns
+  _scheduler.addPeriodic(
+      "button", 20,
+      []() { common::service::get<IButtonHandler>()->poll(); }, 1000);
+  _scheduler.addPeriodic(
+      "state", 50, [this]() { _stateMachine.update(*this); }, 5000);
+  _transitionTask = _scheduler.addEvent(
+      "transition", 10, [this]() { applyPendingTransition(); }, 50000);
+  _sensorTask = _scheduler.addPeriodic(
+      "sensors", SENSOR_PERIOD_MS, [this]() { sampleSensors(); }, 20000);
+  _commandTask = _scheduler.addEvent(
+      "commands", 20, [this]() { dispatchCommands(); }, 20000);
+  _scheduler.addPeriodic(
+      "dosing", DOSING_PERIOD_MS,
+      []() { common::service::get<services::pump::IDoser>()->update(); },
+      20000);
+  _screenTask = _scheduler.addEvent(
+      "screen", 20, [this]() { applyRequestedScreen(); }, 50000);
+  _restartTask = _scheduler.addEvent("restart", 1000,
+                                     [this]() { restartIfQuiet(); });
+  _scheduler.addPeriodic("power", 1000, [this]() { checkDutyCycleIdle(); });
+  _scheduler.addPeriodic("stats", 5 * 60 * 1000, [this]() {
+    logTaskStats(_scheduler);
+    logBusStats();
+  });
+
+  // signal() from another task (or a callback) cuts the idle wait short
+  _loopTask = xTaskGetCurrentTaskHandle();
+  _scheduler.setWakeHook([this]() {
+    if (_loopTask != nullptr) {
+      xTaskNotifyGive(_loopTask);
+    }
+  });
+
+  setupNetworkTasks();
+}
+
+void App::setupNetworkTasks() {
+  using services::network::INetworkService;
+
+  _networkScheduler.addPeriodic(
+      "network", 100,
+      []() { common::service::get<INetworkService>()->maintain_connection(); },
+      2000);
+  _networkScheduler.addPeriodic(
+      "mqtt", 50, [this]() { pollMqtt(); }, 20000);
+  _provisioningTask = _networkScheduler.addEvent(
+      "provision", 100, [this]() { provisionWifi(); });
+  _timeSyncTask = _networkScheduler.addEvent("sntp", 100, []() {
+    common::service::get<services::timesync::ITimeService>()->start();
+  });
+  _metricsTask = _networkScheduler.addPeriodic(
+      "metrics", METRICS_PERIOD_MS, [this]() { publishMetrics(); }, 50000);
+  _networkScheduler.addPeriodic(
+      "health", HEALTH_PERIOD_MS, [this]() { sampleHealth(); }, 5000);
+  _sleepTask = _networkScheduler.addEvent("sleep", 100,
+                                          [this]() { enterRequestedSleep(); });
+  _networkScheduler.addPeriodic("stats", 5 * 60 * 1000,
+                                [this]() { logTaskStats(_networkScheduler); });
+
+  _networkScheduler.setWakeHook([this]() {
+    if (_networkTask != nullptr) {
+      xTaskNotifyGive(_networkTask);
+    }
+  });
+}
+
+void App::startNetworkTask() {
+  // Same priority as the loop task; they sit on different cores, so a
+  // stalled TCP write never delays the pump or the screen
+  BaseType_t created = xTaskCreatePinnedToCore(
+      &App::networkTaskMain, "network", NETWORK_TASK_STACK, this,
+      uxTaskPriorityGet(NULL), &_networkTask, NETWORK_CORE);
+  if (created != pdPASS) {
+    LOG_ERROR("[APP] Failed to start network task");
+    _networkTask = nullptr;
+  }
+}
+
+void App::networkTaskMain(void *arg) {
+  auto *app = static_cast<App *>(arg);
+  while (true) {
+    uint64_t start = esp_timer_get_time();
+    uint32_t idleMs = app->_networkScheduler.runOnce();
+    metrics::networkLoopUs.record(
+        static_cast<uint32_t>(esp_timer_get_time() - start));
+    if (idleMs > 0) {
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(idleMs));
+    }
+  }
+}
+
+void App::applyPendingTransition() {
+  if (_pendingTransition != StateId::None) {
+    StateId nextState = _pendingTransition;
+    _pendingTransition = StateId::None;
     _stateMachine.transitionTo(nextState, *this);
   }
+}
+
+void App::checkDutyCycleIdle() {
+  if (_sleepRequested || millis() - _lastActivityMs < INTERACTIVE_WINDOW_MS ||
+      _stateMachine.currentStateId() != StateId::Normal) {
+    return;
+  }
+  // Sleeping would cut a dose mid-pulse or an OTA mid-write; check again in
+  // a second
+  if (common::service::get<services::pump::IDoser>()->isRunning() ||
+      _otaInProgress.load()) {
+    return;
+  }
+
+  auto dutyCycle = common::service::get<services::config::IConfigManager>()
+                       ->getDutyCycleConfig();
+  if (dutyCycle.enabled) {
+    // WiFi and MQTT belong to the network task: it closes them and sleeps.
+    // Until then no command or rule may start a dose.
+    _scheduler.setEnabled(_commandTask, false);
+    _scheduler.setEnabled(_sensorTask, false);
+    _sleepRequested = true;
+    _networkScheduler.signal(_sleepTask);
+  }
+  _lastActivityMs = millis();
+}
+
+void App::sampleSensors() {
+  auto sensorManager =
+      common::service::get<services::captors::ISensorManager>();
+  auto readings = sensorManager->read();
+  _bus.publish<events::SensorUpdate>(readings);
+  uint32_t nowSec = ruleClockSec();
+  waterFromRule(_rules.evaluate(readings, nowSec), nowSec);
+}
+
+void App::restartIfQuiet() {
+  // A restart mid-dose would leave the pump state unknown, one during
+  // pairing or a reset would lose the user's input
+  if (common::service::get<services::pump::IDoser>()->isRunning() ||
+      _stateMachine.currentStateId() != StateId::Normal) {
+    LOG_INFO("[HEALTH] Restart deferred, device busy");
+    return;
+  }
+  LOG_WARN("[HEALTH] Heap or stack critical, restarting");
+  restart();
+}
+
+uint32_t App::uptimeSec() {
+  return static_cast<uint32_t>(esp_timer_get_time() / 1000000);
+}
+
+uint32_t App::ruleClockSec() const {
+  return _dutyCycleWake ? services::power::DeepSleep::store().elapsedSec
+                        : uptimeSec();
+}
+
+void App::waterFromRule(const services::rules::WateringDecision &decision,
+                        uint32_t nowSec) {
+  if (!decision.water) {
+    return;
+  }
+
+  auto doser = common::service::get<services::pump::IDoser>();
+  char msg[80];
+  if (doser->reservoirDry()) {
+    // Running the pump dry damages it; a manual pump_water clears the flag
+    snprintf(msg, sizeof(msg), "[APP] Rule %d skipped: reservoir dry",
+             decision.rule);
+    LOG_WARN(msg);
+    return;
+  }
+
+  snprintf(msg, sizeof(msg), "[APP] Rule %d: watering %u ml", decision.rule,
+           static_cast<unsigned>(decision.amountMl));
+  LOG_INFO(msg);
+
+  services::pump::DoseRequest request;
+  request.amountMl = decision.amountMl;
+  request.targetPct = decision.targetPct;
+  auto started = doser->start(request);
+  if (started.failed()) {
+    snprintf(msg, sizeof(msg), "[APP] Rule watering refused: %s",
+             started.error().message().c_str());
+    LOG_WARN(msg);
+    return;
+  }
+  // Only a dose that actually started holds the rule back for its cycle
+  _rules.noteWatering(nowSec);
+}
+
+void App::publishDoseReport(const services::pump::DoseReport &report) {
+  DiagnosticMessage message;
+  int length = snprintf(
+      message.json, sizeof(message.json),
+      "{\"type\":\"watering\",\"outcome\":\"%s\",\"deliveredMl\":%u,"
+      "\"pumpOnMs\":%lu,\"startPct\":%.1f,\"endPct\":%.1f}",
+      services::pump::to_string(report.outcome),
+      static_cast<unsigned>(report.deliveredMl),
+      static_cast<unsigned long>(report.pumpOnMs),
+      std::isnan(report.startPct) ? -1.0f : report.startPct,
+      std::isnan(report.endPct) ? -1.0f : report.endPct);
+  message.length = static_cast<size_t>(length);
+  if (!_diagnostics.push(message)) {
+    LOG_WARN("[APP] Watering report not published");
+  }
+}
+
+void App::applyRules(const services::config::WateringRules &rules) {
+  auto sensorManager =
+      common::service::get<services::captors::ISensorManager>();
+  auto configManager = common::service::get<services::config::IConfigManager>();
+
+  auto result = _rules.configure(rules, sensorManager->channels());
+  if (result.succeed()) {
+    result = configManager->saveWateringRules(rules);
+  }
 
-  delay(10);
+  DiagnosticMessage message;
+  int length;
+  char msg[96];
+  if (result.failed()) {
+    snprintf(msg, sizeof(msg), "[APP] Watering rules rejected: %s",
+             result.error().message().c_str());
+    LOG_WARN(msg);
+    length = snprintf(message.json, sizeof(message.json),
+                      "{\"type\":\"rules\",\"ok\":false,\"error\":\"%s\"}",
+                      result.error().message().c_str());
+  } else {
+    snprintf(msg, sizeof(msg), "[APP] %u watering rules active",
+             static_cast<unsigned>(rules.count));
+    LOG_INFO(msg);
+    length = snprintf(message.json, sizeof(message.json),
+                      "{\"type\":\"rules\",\"ok\":true,\"count\":%u}",
+                      static_cast<unsigned>(rules.count));
+  }
+  message.length = static_cast<size_t>(length);
+  if (!_diagnostics.push(message)) {
+    LOG_WARN("[APP] Rules result not published");
+  }
+}
+
+void App::dispatchCommands() {
+  auto mqttCommandHandler =
+      common::service::get<services::mqtt::IMqttCommandHandler>();
+  services::mqtt::Command cmd;
+  while (_commands.pop(cmd)) {
+    // A server talking to the device keeps it awake like a button press
+    _lastActivityMs = millis();
+    if (cmd.type == services::mqtt::CommandType::GetStateTrace) {
+      publishStateTrace();
+      continue;
+    }
+    if (cmd.type == services::mqtt::CommandType::Calibrate) {
+      runCalibration(cmd.calibration, false);
+      continue;
+    }
+    if (cmd.type == services::mqtt::CommandType::SetRules) {
+      applyRules(cmd.rules);
+      continue;
+    }
+    mqttCommandHandler->handle(cmd);
+  }
+
+  services::captors::calibration::CalibrationRequest request;
+  while (_calibrations.pop(request)) {
+    runCalibration(request, true);
+  }
+
+  // BLE characteristics are only touched here, never from the network task
+  ProvisioningResult result;
+  while (_provisioningResults.pop(result)) {
+    auto pairMgr = common::service::get<services::bluetooth::IPairingManager>();
+    pairMgr->notifyWifiConfigured(result.connected);
+    if (!result.connected) {
+      pairMgr->setState(services::bluetooth::PairingState::AWAITING_WIFI_CONFIG);
+    } else if (!result.ipAddress.empty()) {
+      pairMgr->setIpAddress(result.ipAddress);
+    }
+  }
+}
+
+void App::runCalibration(
+    const services::captors::calibration::CalibrationRequest &request,
+    bool fromBle) {
+  namespace calibration = services::captors::calibration;
+  auto sensorManager =
+      common::service::get<services::captors::ISensorManager>();
+  auto configManager = common::service::get<services::config::IConfigManager>();
+
+  auto outcome =
+      calibration::run(sensorManager.get(), configManager.get(), request);
+
+  char msg[96];
+  if (outcome.failed()) {
+    snprintf(msg, sizeof(msg), "[APP] Calibration %s %s failed: %s",
+             calibration::to_string(request.sensor),
+             calibration::pointName(request),
+             outcome.error().message().c_str());
+    LOG_WARN(msg);
+  } else {
+    snprintf(msg, sizeof(msg), "[APP] Calibration %s %s: adc %.1f",
+             calibration::to_string(request.sensor),
+             calibration::pointName(request), outcome.value());
+    LOG_INFO(msg);
+  }
+
+  // Answer where the request came from: BLE characteristic or diag topic
+  DiagnosticMessage message;
+  message.length = calibration::toJson(request, outcome, message.json,
+                                       sizeof(message.json));
+  if (message.length == 0) {
+    return;
+  }
+  if (fromBle) {
+    common::service::get<services::bluetooth::IPairingManager>()
+        ->notifyCalibration(std::string(message.json, message.length));
+  } else if (!_diagnostics.push(message)) {
+    LOG_WARN("[APP] Calibration result not published");
+  }
+}
+
+void App::publishStateTrace() {
+  // The trace belongs to the control task; serialize here, publish there
+  DiagnosticMessage message;
+  message.length = _stateMachine.trace().toJson(
+      message.json, sizeof(message.json), _stateMachine.currentStateId(),
+      millis());
+  if (message.length == 0 || !_diagnostics.push(message)) {
+    LOG_WARN("[APP] State trace not published");
+  }
+}
+
+void App::showScreen(const char *screenId) {
+  _requestedScreen.store(screenId);
+  _scheduler.signal(_screenTask);
+}
+
+void App::applyRequestedScreen() {
+  bool statusChanged = false;
+  ui::screens::NormalScreen::Status status;
+  while (_statusUpdates.pop(status)) {
+    _normalScreen->setStatus(status);
+    statusChanged = true;
+  }
+
+  const char *screenId = _requestedScreen.exchange(nullptr);
+  uint64_t start = esp_timer_get_time();
+  if (screenId != nullptr) {
+    _screenManager.navigateTo(screenId);
+    _screenManager.render();
+  } else if (statusChanged && _screenManager.currentScreenId() == "normal") {
+    _screenManager.render();
+  } else {
+    return;
+  }
+  metrics::uiRenderUs.record(static_cast<uint32_t>(esp_timer_get_time() - start));
+}
+
+void App::pollMqtt() {
+  services::mqtt::SensorReading reading;
+  while (_readings.pop(reading)) {
+    _latestReading = reading;
+  }
+  common::service::get<services::timesync::ITimeService>()->update();
+  auto mqttService = common::service::get<services::mqtt::IMQTTService>();
+  mqttService->update();
+
+  DiagnosticMessage message;
+  while (_diagnostics.pop(message)) {
+    mqttService->publish_diagnostics(message.json, message.length);
+  }
+
+  bool connected = mqttService->is_connected();
+  if (connected != _mqttWasConnected) {
+    _mqttWasConnected = connected;
+    if (connected) {
+      _bus.publish<events::MqttConnected>();
+    } else {
+      _bus.publish<events::MqttDisconnected>();
+    }
+  }
+}
+
+void App::publishMetrics() {
+  auto mqttService = common::service::get<services::mqtt::IMQTTService>();
+  if (!mqttService->is_connected()) {
+    // Keep the histograms for the next snapshot instead of draining them
+    return;
+  }
+
+  metrics::busDropped.set(static_cast<int32_t>(_bus.stats().dropped));
+
+  // Network task only; static keeps 2 KB off its stack
+  static char json[services::mqtt::IMQTTService::MAX_PAYLOAD_SIZE];
+  size_t length = common::metrics::Registry::writeJson(json, sizeof(json));
+  if (length == 0) {
+    LOG_WARN("[APP] Metrics snapshot does not fit, not published");
+    return;
+  }
+  // A failed publish keeps the histograms for the next snapshot
+  if (mqttService->publish_metrics(json, length).succeed()) {
+    common::metrics::Registry::commitHistograms();
+  }
+}
+
+void App::enterRequestedSleep() {
+  common::service::get<services::mqtt::IMQTTService>()->set_enabled(false);
+  common::service::get<services::network::INetworkService>()->disconnect();
+
+  auto dutyCycle = common::service::get<services::config::IConfigManager>()
+                       ->getDutyCycleConfig();
+  enterDutyCycleSleep(services::power::DutyCycle(dutyCycle));
+}
+
+void App::sampleHealth() {
+  using namespace services::health;
+  auto stackFree = [](TaskHandle_t task) {
+    // ESP-IDF reports the high-water mark in bytes
+    return task != nullptr
+               ? static_cast<uint32_t>(uxTaskGetStackHighWaterMark(task))
+               : HealthSample::UNKNOWN;
+  };
+
+  HealthSample sample;
+  sample.timeSec = uptimeSec();
+  sample.freeBytes = heap_caps_get_free_size(MALLOC_CAP_8BIT);
+  sample.largestBlockBytes = heap_caps_get_largest_free_block(MALLOC_CAP_8BIT);
+  sample.minFreeBytes = heap_caps_get_minimum_free_size(MALLOC_CAP_8BIT);
+  sample.stackFreeBytes[static_cast<size_t>(WatchedTask::Control)] =
+      stackFree(_loopTask);
+  sample.stackFreeBytes[static_cast<size_t>(WatchedTask::EventLoop)] =
+      stackFree(_eventLoopTask.load(std::memory_order_relaxed));
+  sample.stackFreeBytes[static_cast<size_t>(WatchedTask::Network)] =
+      stackFree(xTaskGetCurrentTaskHandle());
+
+  HealthLevel previousLevel = _health.report().level;
+  bool restartWasDue = _health.report().restartDue;
+  const HealthReport &report = _health.update(sample);
+
+  metrics::heapFree.set(static_cast<int32_t>(sample.freeBytes));
+  metrics::heapLargestBlock.set(static_cast<int32_t>(sample.largestBlockBytes));
+  metrics::heapMinFree.set(static_cast<int32_t>(sample.minFreeBytes));
+  metrics::heapFragmentation.set(report.fragmentationPct);
+  metrics::heapTrend.set(report.trendBytesPerHour);
+  metrics::controlStackFree.set(static_cast<int32_t>(
+      sample.stackFreeBytes[static_cast<size_t>(WatchedTask::Control)]));
+  metrics::eventLoopStackFree.set(static_cast<int32_t>(
+      sample.stackFreeBytes[static_cast<size_t>(WatchedTask::EventLoop)]));
+  metrics::networkStackFree.set(static_cast<int32_t>(
+      sample.stackFreeBytes[static_cast<size_t>(WatchedTask::Network)]));
+  metrics::healthLevel.set(static_cast<int32_t>(report.level));
+
+  // Report changes only; the metrics snapshot carries the steady state
+  if (report.level != previousLevel || report.restartDue != restartWasDue) {
+    char msg[112];
+    snprintf(msg, sizeof(msg),
+             "[HEALTH] %s: free=%lu largest=%lu frag=%u%% stack %s=%lu",
+             to_string(report.level),
+             static_cast<unsigned long>(sample.freeBytes),
+             static_cast<unsigned long>(sample.largestBlockBytes),
+             static_cast<unsigned>(report.fragmentationPct),
+             to_string(report.tightestStack),
+             static_cast<unsigned long>(
+                 sample.stackFreeBytes[static_cast<size_t>(report.tightestStack)]));
+    if (report.level == HealthLevel::Ok) {
+      LOG_INFO(msg);
+    } else {
+      LOG_WARN(msg);
+    }
+
+    char json[320];
+    size_t length = toJson(sample, report, json, sizeof(json));
+    auto mqttService = common::service::get<services::mqtt::IMQTTService>();
+    if (length > 0 && mqttService->is_connected()) {
+      mqttService->publish_diagnostics(json, length);
+    }
+  }
+
+  if (report.restartDue) {
+    // The control task knows whether a dose is running; it restarts when
+    // idle, otherwise the next sample asks again
+    _scheduler.signal(_restartTask);
+  }
+}
+
+void App::provisionWifi() {
+  ProvisioningRequest request;
+  if (!_provisioning.pop(request)) {
+    return;
+  }
+
+  auto cfgMgr = common::service::get<services::config::IConfigManager>();
+  auto netMgr = common::service::get<services::network::INetworkService>();
+
+  // Saved before connecting so initMqttCallbacks() uses the new broker
+  if (!request.mqtt.host.empty()) {
+    cfgMgr->saveMqttConfig(request.mqtt.host, request.mqtt.port);
+    if (!request.mqtt.username.empty()) {
+      cfgMgr->saveMqttCredentials(request.mqtt.username, request.mqtt.password);
+    }
+  }
+
+  const auto &creds = request.wifi;
+  cfgMgr->saveWifiCredentials(creds.ssid, creds.password);
+  netMgr->set_credentials(creds.ssid, creds.password);
+  auto result = netMgr->connect();
+
+  ProvisioningResult outcome{result.succeed(), {}};
+  if (result.succeed()) {
+    LOG_INFO("[APP] WiFi connected via BLE config");
+    cfgMgr->setConfigured(true);
+
+    auto ipResult = netMgr->get_ip_address();
+    if (ipResult.succeed()) {
+      outcome.ipAddress = ipResult.value();
+    }
+
+    initMqttCallbacks();
+  } else {
+    LOG_INFO("[APP] WiFi connection failed - showing error screen");
+    showScreen("wifi_error");
+  }
+
+  // The pairing manager belongs to the control task
+  if (!_provisioningResults.push(outcome)) {
+    LOG_WARN("[APP] Provisioning result dropped");
+  }
+  _scheduler.signal(_commandTask);
+}
+
+void App::logTaskStats(const common::scheduler::Scheduler &scheduler) {
+  for (common::scheduler::TaskId id = 0; id < scheduler.taskCount(); id++) {
+    const auto &stats = scheduler.stats(id);
+    char msg[128];
+    snprintf(msg, sizeof(msg),
+             "[SCHED] %-10s runs=%lu avg=%luus max=%luus overruns=%lu "
+             "misses=%lu",
+             scheduler.name(id), static_cast<unsigned long>(stats.runs),
+             static_cast<unsigned long>(stats.averageRunUs()),
+             static_cast<unsigned long>(stats.maxRunUs),
+             static_cast<unsigned long>(stats.overruns),
+             static_cast<unsigned long>(stats.deadlineMisses));
+    if (stats.overruns > 0 || stats.deadlineMisses > 0) {
+      LOG_WARN(msg);
+    } else {
+      LOG_DEBUG(msg);
+    }
+  }
+}
+
+void App::logBusStats() const {
+  // Counters are written by the app_loop task; a torn read only skews a log
+  auto busStats = _bus.stats();
+  char msg[128];
+  snprintf(msg, sizeof(msg), "[BUS] published=%lu dropped=%lu doorbell_fail=%lu",
+           static_cast<unsigned long>(busStats.published),
+           static_cast<unsigned long>(busStats.dropped),
+           static_cast<unsigned long>(busStats.doorbellFailures));
+  if (busStats.dropped > 0) {
+    LOG_WARN(msg);
+  } else {
+    LOG_DEBUG(msg);
+  }
+
+  for (common::event::SubscriberId id = 0; id < _bus.subscriberCount(); id++) {
+    const auto &stats = _bus.subscriberStats(id);
+    snprintf(msg, sizeof(msg),
+             "[BUS] %-6s deliveries=%lu avg=%luus max=%luus handler_max=%luus",
+             _bus.subscriberName(id), static_cast<unsigned long>(stats.deliveries),
+             static_cast<unsigned long>(stats.averageLatencyUs()),
+             static_cast<unsigned long>(stats.maxLatencyUs),
+             static_cast<unsigned long>(stats.maxHandlerUs));
+    LOG_DEBUG(msg);
+  }
+}
+
+void App::run() {
+  uint64_t start = esp_timer_get_time();
+  uint32_t idleMs = _scheduler.runOnce();
+  metrics::controlLoopUs.record(static_cast<uint32_t>(esp_timer_get_time() - start));
+  if (idleMs > 0) {
+    // Block until the next release instead of polling every 10 ms; the idle
+    // task gets the CPU, which is where automatic light sleep kicks in when
+    // power management is enabled
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(idleMs));
+  }
+}
+
+void App::runDutyCycleWake(const services::config::DutyCycleConfig &config) {
+  auto sensorManager =
+      common::service::get<services::captors::ISensorManager>();
+  services::power::DutyCycle dutyCycle(config, sensorManager->channels());
+  auto &store = services::power::DeepSleep::store();
+
+  auto readings = sensorManager->read();
+  auto reason =
+      dutyCycle.onWake(store, readings, services::power::DeepSleep::sleptMs());
+
+  // Rules keep watering while offline; their clock is the store's
+  _dutyCycleWake = true;
+  auto &ruleState = services::power::DeepSleep::ruleState();
+  _rules.restore(ruleState);
+  waterFromRule(_rules.evaluate(readings, store.elapsedSec), store.elapsedSec);
+
+  // No scheduler on this path: finish the dose before sleeping
+  auto doser = common::service::get<services::pump::IDoser>();
+  while (doser->isRunning()) {
+    doser->update();
+    delay(DOSING_PERIOD_MS);
+  }
+  ruleState = _rules.state();
+
+  if (reason != services::power::UploadReason::None) {
+    char msg[80];
+    snprintf(msg, sizeof(msg), "[POWER] Uploading %u samples (%s)",
+             static_cast<unsigned>(store.count),
+             services::power::to_string(reason));
+    LOG_INFO(msg);
+
+    size_t published = uploadSampleBatch(store);
+    if (published == store.count) {
+      dutyCycle.onUploaded(store);
+    } else {
+      snprintf(msg, sizeof(msg),
+               "[POWER] Upload failed after %u samples, keeping %u",
+               static_cast<unsigned>(published),
+               static_cast<unsigned>(store.count - published));
+      LOG_INFO(msg);
+      dutyCycle.onPartialUpload(store, published);
+    }
+  }
+
+  // The network task is not running on this path
+  common::service::get<services::network::INetworkService>()->disconnect();
+  enterDutyCycleSleep(dutyCycle);
+}
+
+size_t App::uploadSampleBatch(const services::power::RtcSampleStore &store) {
+  auto networkManager =
+      common::service::get<services::network::INetworkService>();
+  auto mqttService = common::service::get<services::mqtt::IMQTTService>();
+
+  auto timeService = common::service::get<services::timesync::ITimeService>();
+
+  tryConnectNetwork();
+  if (!networkManager->connect().succeed()) {
+    return 0;
+  }
+  // Every wake is a fresh boot: ask for the time while MQTT connects
+  timeService->start();
+
+  initMqttCallbacks();
+  if (!mqttService->connect().succeed()) {
+    return 0;
+  }
+
+  uint32_t syncStart = millis();
+  while (!timeService->isSynced() && millis() - syncStart < SNTP_WAIT_MS) {
+    timeService->update();
+    delay(10);
+  }
+  uint32_t now = timeService->unixTimeAt(millis());
+
+  for (size_t i = 0; i < store.count; i++) {
+    services::mqtt::SensorReading reading;
+    reading.readings = store.samples[i].unpack();
+    reading.ageSec = services::power::DutyCycle::ageSec(store, i);
+    reading.timestamp = now != 0 ? now - reading.ageSec : 0;
+    if (!mqttService->publish_reading(reading).succeed()) {
+      // The first i are on the broker; resending them would duplicate them
+      return i;
+    }
+  }
+
+  // Commands sent while asleep are not queued (clean session); give the
+  // server a short window to react to the fresh data instead
+  uint32_t windowStart = millis();
+  while (millis() - windowStart < COMMAND_WINDOW_MS) {
+    mqttService->update();
+    delay(10);
+  }
+
+  mqttService->set_enabled(false);
+  return store.count;
+}
+
+void App::enterDutyCycleSleep(const services::power::DutyCycle &dutyCycle) {
+  uint32_t awakeMs = millis();
+  uint64_t sleepUs = dutyCycle.sleepDurationUs(awakeMs);
+  dutyCycle.onSleep(services::power::DeepSleep::store(), awakeMs);
+
+  char msg[64];
+  snprintf(msg, sizeof(msg), "[POWER] Deep sleep for %lu s",
+           static_cast<unsigned long>(sleepUs / 1000000ULL));
+  LOG_INFO(msg);
+  Serial.flush();
+
+  services::power::DeepSleep::sleepFor(sleepUs, BUTTON_LEFT_PIN);
 }
 
 void App::shutdown() { LOG_INFO("[APP] Shutdown"); }
 
+void App::restart() {
+  LOG_INFO("[APP] Restarting...");
+  Serial.flush();
+  ESP.restart();
+}
+
 common::patterns::Result<void>
-App::perform_ota_update(const std::string &firmware_url) {
+App::perform_ota_update(const services::ota::Manifest &manifest) {
   LOG_INFO("[APP] Starting OTA update...");
+  _otaInProgress.store(true);
+  _bus.publish<events::OtaStarted>();
   services::ota::UpdateOrchestrator orchestrator;
-  auto result = orchestrator.update_from_url(firmware_url);
+  orchestrator.set_progress_callback(
+      [this](const services::ota::UpdateProgress &progress) {
+        _bus.publish<events::OtaProgress>(events::OtaTransfer{
+            static_cast<uint32_t>(progress.bytes),
+            static_cast<uint32_t>(progress.total), progress.bytes_per_sec});
+      });
+  auto result = orchestrator.update(manifest);
   if (result.succeed()) {
+    _bus.publish<events::OtaCompleted>();
     LOG_INFO("[APP] OTA update complete, restarting...");
     delay(1000);
     ESP.restart();
   } else {
+    _otaInProgress.store(false);
+    _bus.publish<events::OtaFailed>();
     LOG_INFO("[APP] OTA update failed");
   }
   return result;
@@ -291,8 +1174,9 @@ esp_err_t App::on(int32_t event_id, esp_event_handler_t handler,
 
 esp_err_t App::emit(int32_t event_id, void *event_data,
                     size_t event_data_size) const {
+  // Never block the caller; typed events should go through bus() instead
   return esp_event_post_to(_event_loop, common::APP_EVENTS, event_id,
-                           event_data, event_data_size, portMAX_DELAY);
+                           event_data, event_data_size, 0);
 }
 
 } // namespace plant_nanny
\ No newline at end of file
@@ -0,0 +1,35 @@
+#include "libs/plant_nanny/metrics/FirmwareMetrics.h"
+
+namespace plant_nanny::metrics
+{
+    Counter mqttConnects{"mqtt.connects"};
+    Counter mqttConnectFailures{"mqtt.connect_failed"};
+    Counter mqttPublished{"mqtt.published"};
+    Counter mqttPublishFailures{"mqtt.publish_failed"};
+    Counter mqttCommands{"mqtt.commands"};
+    Histogram mqttPublishUs{"mqtt.publish_us", {1000, 5000, 20000, 100000, 500000}};
+
+    Counter wifiConnects{"wifi.connects"};
+    Counter wifiDisconnects{"wifi.disconnects"};
+    Histogram wifiConnectMs{"wifi.connect_ms", {500, 1000, 2000, 5000, 10000, 30000}};
+
+    Counter sensorReadFailures{"sensors.read_failed"};
+    Histogram sensorReadUs{"sensors.read_us", {1000, 5000, 10000, 20000, 50000}};
+
+    Histogram controlLoopUs{"control.loop_us", {1000, 5000, 20000, 50000, 100000}};
+    Histogram networkLoopUs{"network.loop_us", {1000, 10000, 100000, 1000000, 5000000}};
+    Histogram uiRenderUs{"ui.render_us", {5000, 20000, 50000, 100000, 200000}};
+
+    Gauge heapFree{"heap.free"};
+    Gauge heapLargestBlock{"heap.largest_block"};
+    Gauge heapMinFree{"heap.min_free"};
+    Gauge heapFragmentation{"heap.fragmentation_pct"};
+    Gauge heapTrend{"heap.trend_bph"};
+    Gauge controlStackFree{"stack.control_free"};
+    Gauge eventLoopStackFree{"stack.event_loop_free"};
+    Gauge networkStackFree{"stack.network_free"};
+    Gauge healthLevel{"health.level"};
+
+    Gauge busDropped{"bus.dropped"};
+
+} // namespace plant_nanny::metrics
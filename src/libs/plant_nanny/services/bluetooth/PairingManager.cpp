@@ -4,6 +4,8 @@
 #include <Arduino.h>
 #include <NimBLEDevice.h>
 #include <WiFi.h>
+#include <Preferences.h>
+#include <esp_bt.h>
 #include "libs/common/logger/Log.h"
 #include "libs/common/service/Accessor.h"
 
@@ -12,6 +14,7 @@ namespace plant_nanny::services::bluetooth
     namespace
     {
         constexpr uint16_t DEFAULT_MQTT_PORT = 1883;
+        constexpr const char* BOND_NVS_NAMESPACE = "nimble_bond";  // NimBLE bond store
     }
 
     // Factory functions declared in callbacks file
@@ -29,8 +32,9 @@ namespace plant_nanny::services::bluetooth
         , _initialized(false)
         , _pairingStartTime(0)
     {
-        initialize();
-        
+        // NimBLE is brought up by startPairing(), not here: outside pairing
+        // its host and controller memory stays free
+
         // Get device ID from ConfigManager if available
         auto configManager = common::service::get<config::IConfigManager>();
         if (configManager.is_available())
@@ -42,11 +46,7 @@ namespace plant_nanny::services::bluetooth
 
     PairingManager::~PairingManager()
     {
-        if (_initialized)
-        {
-            stopPairing();
-            NimBLEDevice::deinit(true);
-        }
+        stopPairing();
         delete _pServerCallbacks;
         _pServerCallbacks = nullptr;
         delete _pCharCallbacks;
@@ -82,10 +82,10 @@ namespace plant_nanny::services::bluetooth
         }
     }
 
-    void PairingManager::processMqttConfig()
+    bool PairingManager::readMqttConfig(MqttConfig& config)
     {
         std::string mqttHost = _chars.mqttHost ? _chars.mqttHost->getValue() : "";
-        if (mqttHost.empty()) return;
+        if (mqttHost.empty()) return false;
 
         std::string mqttPortStr = _chars.mqttPort ? _chars.mqttPort->getValue() : "";
         std::string mqttUsername = _chars.mqttUsername ? _chars.mqttUsername->getValue() : "";
@@ -99,14 +99,120 @@ namespace plant_nanny::services::bluetooth
         snprintf(mqttMsg, sizeof(mqttMsg), "[BLE] MQTT config: %s:%d user=%s", 
             mqttHost.c_str(), mqttPort, mqttUsername.c_str());
         LOG_INFO(mqttMsg);
-        
-        onMqttConfigReceived(mqttHost, mqttPort, mqttUsername, mqttPassword);
+
+        config = MqttConfig{mqttHost, mqttPort, mqttUsername, mqttPassword};
+        return true;
+    }
+
+    void PairingManager::handleProvisioningChunk(const uint8_t* data, size_t length)
+    {
+        uint8_t index = length > 0 ? data[0] : 0;
+        ProvisioningStatus status = _provisioningAssembler.feed(data, length);
+        if (status == ProvisioningStatus::Complete)
+        {
+            status = applyProvisioning();
+        }
+
+        if (status != ProvisioningStatus::Continue)
+        {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "[BLE] Provisioning frame: %s", to_string(status));
+            if (status == ProvisioningStatus::Complete)
+            {
+                LOG_INFO(msg);
+            }
+            else
+            {
+                LOG_WARN(msg);
+            }
+        }
+
+        notifyProvisioningStatus(status, index);
+    }
+
+    ProvisioningStatus PairingManager::applyProvisioning()
+    {
+        auto decoded = ProvisioningCodec::decode(_provisioningAssembler.frame(), _provisioningAssembler.frameSize());
+        if (decoded.failed())
+        {
+            return ProvisioningStatus::BadTlv;
+        }
+        const ProvisioningMessage& message = decoded.value();
+
+        if (_state == PairingState::ADVERTISING || _state == PairingState::AWAITING_PIN)
+        {
+            if (!verifyPin(message.pin))
+            {
+                setConfigStatus(Status::PIN_INVALID);
+                return ProvisioningStatus::Rejected;
+            }
+            setState(PairingState::AWAITING_WIFI_CONFIG);
+            setConfigStatus(Status::PIN_OK);
+        }
+        else if (_state != PairingState::AWAITING_WIFI_CONFIG)
+        {
+            return ProvisioningStatus::Rejected;
+        }
+
+        if (message.wifiSsid.empty() || message.wifiPassword.empty())
+        {
+            return ProvisioningStatus::BadTlv;
+        }
+
+        if (!message.serverId.empty() && _chars.serverId)
+        {
+            _chars.serverId->setValue(message.serverId);
+        }
+        MqttConfig mqtt;
+        if (!message.mqttHost.empty())
+        {
+            uint16_t port = message.mqttPort != 0 ? message.mqttPort : DEFAULT_MQTT_PORT;
+            mqtt = MqttConfig{message.mqttHost, port, message.mqttUsername, message.mqttPassword};
+        }
+        handOver(WifiCredentials{message.wifiSsid, message.wifiPassword}, mqtt);
+        return ProvisioningStatus::Complete;
+    }
+
+    void PairingManager::notifyProvisioningStatus(ProvisioningStatus status, uint8_t index)
+    {
+        if (!_chars.provisioning)
+        {
+            return;
+        }
+
+        const uint8_t ack[2] = {static_cast<uint8_t>(status), index};
+        _chars.provisioning->setValue(ack, sizeof(ack));
+        if (_pServer && _pServer->getConnectedCount() > 0)
+        {
+            _chars.provisioning->notify();
+        }
     }
 
     void PairingManager::processCredentials(const std::string& ssid, const std::string& pass)
     {
-        processMqttConfig();
-        handleWifiCredentials(ssid, pass);
+        MqttConfig mqtt;
+        readMqttConfig(mqtt);
+        handOver(WifiCredentials{ssid, pass}, mqtt);
+    }
+
+    void PairingManager::handOver(const WifiCredentials& wifi, const MqttConfig& mqtt)
+    {
+        LOG_INFO("[BLE] Processing WiFi credentials");
+        _state = PairingState::CONFIGURING_WIFI;
+        if (!_receivedConfigs.push(ReceivedConfig{wifi, mqtt}))
+        {
+            LOG_WARN("[BLE] WiFi configuration already pending, ignoring");
+        }
+    }
+
+    void PairingManager::deliverConfig(const WifiCredentials& wifi, const MqttConfig& mqtt)
+    {
+        // MQTT first: the WiFi handler connects and then starts MQTT
+        if (!mqtt.host.empty())
+        {
+            onMqttConfigReceived(mqtt.host, mqtt.port, mqtt.username, mqtt.password);
+        }
+        onWifiCredentialsReceived(wifi.ssid, wifi.password);
     }
 
     void PairingManager::setupServices()
@@ -180,7 +286,8 @@ namespace plant_nanny::services::bluetooth
 
         _chars.wifiNetworks = pConfigService->createCharacteristic(
             WIFI_NETWORKS_CHAR_UUID,
-            NIMBLE_PROPERTY::READ
+            NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::NOTIFY,
+            WIFI_NETWORKS_JSON_SIZE
         );
         _chars.wifiNetworks->setValue("[]");
 
@@ -190,6 +297,21 @@ namespace plant_nanny::services::bluetooth
         );
         _chars.pin->setCallbacks(_pCharCallbacks);
 
+        _chars.provisioning = pConfigService->createCharacteristic(
+            PROVISIONING_CHAR_UUID,
+            NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::WRITE_NR | NIMBLE_PROPERTY::NOTIFY,
+            PROVISIONING_CHUNK_SIZE
+        );
+        _chars.provisioning->setCallbacks(_pCharCallbacks);
+
+        _chars.calibration = pConfigService->createCharacteristic(
+            CALIBRATION_CHAR_UUID,
+            NIMBLE_PROPERTY::READ | NIMBLE_PROPERTY::WRITE | NIMBLE_PROPERTY::NOTIFY,
+            CALIBRATION_RESULT_SIZE
+        );
+        _chars.calibration->setCallbacks(_pCharCallbacks);
+        _chars.calibration->setValue("");
+
         pConfigService->start();
 
         NimBLEService* pDevInfoService = _pServer->createService("180A");
@@ -209,19 +331,80 @@ namespace plant_nanny::services::bluetooth
         {
             return common::patterns::Result<void>::success();
         }
+        if (_controllerReleased)
+        {
+            return common::patterns::Result<void>::failure(
+                common::patterns::Error("BLE controller memory released, restart required"));
+        }
+
+        _heapStats.beforeInit = ESP.getFreeHeap();
 
         NimBLEDevice::init(DEVICE_NAME);
         NimBLEDevice::setSecurityAuth(false, false, false);
         NimBLEDevice::setSecurityIOCap(BLE_HS_IO_NO_INPUT_OUTPUT);
+        NimBLEDevice::setMTU(ATT_MTU);
 
         _initialized = true;
         _state = PairingState::IDLE;
+        _heapStats.afterInit = ESP.getFreeHeap();
 
-        LOG_INFO("[BLE] Pairing manager initialized");
+        char msg[80];
+        snprintf(msg, sizeof(msg), "[BLE] Stack up, heap %lu -> %lu B",
+                 static_cast<unsigned long>(_heapStats.beforeInit),
+                 static_cast<unsigned long>(_heapStats.afterInit));
+        LOG_INFO(msg);
 
         return common::patterns::Result<void>::success();
     }
 
+    void PairingManager::deinitialize()
+    {
+        if (!_initialized)
+        {
+            return;
+        }
+
+        // Deletes the server, services and characteristics
+        NimBLEDevice::deinit(true);
+        _pServer = nullptr;
+        _chars = BleCharacteristics{};
+        _initialized = false;
+        _heapStats.afterDeinit = ESP.getFreeHeap();
+
+        char msg[80];
+        snprintf(msg, sizeof(msg), "[BLE] Stack down, heap %lu B (+%ld B)",
+                 static_cast<unsigned long>(_heapStats.afterDeinit),
+                 static_cast<long>(_heapStats.afterDeinit) - static_cast<long>(_heapStats.afterInit));
+        LOG_INFO(msg);
+    }
+
+    void PairingManager::releaseControllerMemory()
+    {
+        if (_controllerReleased)
+        {
+            return;
+        }
+        stopPairing();
+
+        uint32_t before = ESP.getFreeHeap();
+        esp_err_t err = esp_bt_controller_mem_release(ESP_BT_MODE_BTDM);
+        if (err != ESP_OK)
+        {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "[BLE] Controller memory release failed: %d", err);
+            LOG_WARN(msg);
+            return;
+        }
+
+        _controllerReleased = true;
+        _heapStats.afterRelease = ESP.getFreeHeap();
+
+        char msg[80];
+        snprintf(msg, sizeof(msg), "[BLE] Controller memory released, heap %lu -> %lu B",
+                 static_cast<unsigned long>(before), static_cast<unsigned long>(_heapStats.afterRelease));
+        LOG_INFO(msg);
+    }
+
     common::patterns::Result<void> PairingManager::startPairing()
     {
         if (!_initialized)
@@ -235,6 +418,7 @@ namespace plant_nanny::services::bluetooth
 
         _currentPin = generatePin();
         _pairingStartTime = millis();
+        _provisioningAssembler.reset();
         
         char msg[50];
         snprintf(msg, sizeof(msg), "[BLE] Starting pairing with PIN: %s", _currentPin.c_str());
@@ -242,9 +426,12 @@ namespace plant_nanny::services::bluetooth
 
         _pServer = NimBLEDevice::createServer();
         
-        delete _pServerCallbacks;
-        _pServerCallbacks = createServerCallbacks(*this);
-        _pServer->setCallbacks(_pServerCallbacks);
+        // Kept across deinit(): the server would otherwise delete them with itself
+        if (!_pServerCallbacks)
+        {
+            _pServerCallbacks = createServerCallbacks(*this);
+        }
+        _pServer->setCallbacks(_pServerCallbacks, false);
 
         if (!_pCharCallbacks)
         {
@@ -275,33 +462,46 @@ namespace plant_nanny::services::bluetooth
 
     common::patterns::Result<void> PairingManager::stopPairing()
     {
-        if (_state == PairingState::IDLE)
+        if (_state != PairingState::IDLE && _initialized)
         {
-            return common::patterns::Result<void>::success();
-        }
+            NimBLEDevice::getAdvertising()->stop();
 
-        NimBLEDevice::getAdvertising()->stop();
-        
-        if (_pServer && _pServer->getConnectedCount() > 0)
-        {
-            _pServer->disconnect(0);
-        }
+            if (_pServer && _pServer->getConnectedCount() > 0)
+            {
+                _pServer->disconnect(0);
+            }
 
-        _state = PairingState::IDLE;
-        _currentPin = "";
+            if (_scanChannel != 0)
+            {
+                WiFi.scanDelete();
+                _scanChannel = 0;
+            }
 
-        LOG_INFO("[BLE] Pairing stopped");
+            _state = PairingState::IDLE;
+            _currentPin = "";
 
+            LOG_INFO("[BLE] Pairing stopped");
+        }
+
+        deinitialize();
         return common::patterns::Result<void>::success();
     }
 
     void PairingManager::update()
     {
+        ReceivedConfig received;
+        while (_receivedConfigs.pop(received))
+        {
+            deliverConfig(received.wifi, received.mqtt);
+        }
+
         if (_state == PairingState::IDLE || _state == PairingState::PAIRED)
         {
             return;
         }
 
+        pollWifiScan();
+
         if (_pairingStartTime > 0 && (millis() - _pairingStartTime) > PAIRING_TIMEOUT_MS)
         {
             LOG_INFO("[BLE] Pairing timeout");
@@ -339,13 +539,9 @@ namespace plant_nanny::services::bluetooth
                         LOG_INFO("[BLE] WiFi credentials received");
                         _state = PairingState::CONFIGURING_WIFI;
                         
-                        processMqttConfig();
-
-                        if (_wifiConfigCallback)
-                        {
-                            WifiCredentials creds{ssid, pass};
-                            _wifiConfigCallback(creds);
-                        }
+                        MqttConfig mqtt;
+                        readMqttConfig(mqtt);
+                        deliverConfig(WifiCredentials{ssid, pass}, mqtt);
 
                         _chars.wifiSsid->setValue("");
                         _chars.wifiPass->setValue("");
@@ -379,18 +575,6 @@ namespace plant_nanny::services::bluetooth
         }
     }
 
-    void PairingManager::handleWifiCredentials(const std::string& ssid, const std::string& password)
-    {
-        LOG_INFO("[BLE] Processing WiFi credentials");
-        _state = PairingState::CONFIGURING_WIFI;
-        
-        if (_wifiConfigCallback)
-        {
-            WifiCredentials creds{ssid, password};
-            _wifiConfigCallback(creds);
-        }
-    }
-
     void PairingManager::onWifiCredentialsReceived(const std::string& ssid, const std::string& password)
     {
         if (_wifiConfigCallback)
@@ -410,14 +594,37 @@ namespace plant_nanny::services::bluetooth
         }
     }
 
+    void PairingManager::onCalibrationRequested(const std::string& request)
+    {
+        if (_calibrationCallback)
+        {
+            _calibrationCallback(request);
+        }
+    }
+
+    void PairingManager::notifyCalibration(const std::string& result)
+    {
+        if (!_chars.calibration)
+        {
+            return;
+        }
+        _chars.calibration->setValue(result);
+        if (_pServer && _pServer->getConnectedCount() > 0)
+        {
+            _chars.calibration->notify();
+        }
+    }
+
     common::patterns::Result<void> PairingManager::unpair()
     {
         stopPairing();
-        
-        int numBonds = NimBLEDevice::getNumBonds();
-        for (int i = 0; i < numBonds; i++)
+
+        // The stack is down outside pairing: clear the bond store directly
+        Preferences bonds;
+        if (bonds.begin(BOND_NVS_NAMESPACE, false))
         {
-            NimBLEDevice::deleteBond(NimBLEDevice::getBondedAddress(0));
+            bonds.clear();
+            bonds.end();
         }
 
         _state = PairingState::IDLE;
@@ -469,77 +676,76 @@ namespace plant_nanny::services::bluetooth
     void PairingManager::scanWifiNetworks()
     {
         LOG_INFO("[BLE] Scanning for WiFi networks...");
-        int numNetworks = WiFi.scanNetworks(false, false, false, 300);
-        
-        if (numNetworks < 0)
+        _scanResults.clear();
+        publishWifiNetworks();
+        startChannelScan(SCAN_FIRST_CHANNEL);
+    }
+
+    void PairingManager::startChannelScan(uint8_t channel)
+    {
+        for (; channel <= SCAN_LAST_CHANNEL; channel++)
         {
-            LOG_INFO("[BLE] WiFi scan failed");
-            if (_chars.wifiNetworks)
+            int16_t result = WiFi.scanNetworks(true, false, false, SCAN_MS_PER_CHANNEL, channel);
+            if (result == WIFI_SCAN_RUNNING || result >= 0)
             {
-                _chars.wifiNetworks->setValue("[]");
+                _scanChannel = channel;
+                return;
             }
-            return;
+
+            char msg[48];
+            snprintf(msg, sizeof(msg), "[BLE] WiFi scan of channel %u failed", channel);
+            LOG_WARN(msg);
         }
 
+        _scanChannel = 0;
         char msg[48];
-        snprintf(msg, sizeof(msg), "[BLE] Found %d networks", numNetworks);
+        snprintf(msg, sizeof(msg), "[BLE] WiFi scan done, %u networks", static_cast<unsigned>(_scanResults.size()));
         LOG_INFO(msg);
+    }
+
+    void PairingManager::pollWifiScan()
+    {
+        if (_scanChannel == 0)
+        {
+            return;
+        }
 
-        std::string json = "[";
-        int count = 0;
-        const int maxNetworks = 10;
+        int16_t found = WiFi.scanComplete();
+        if (found == WIFI_SCAN_RUNNING)
+        {
+            return;
+        }
 
-        for (int i = 0; i < numNetworks && count < maxNetworks; i++)
+        bool changed = false;
+        for (int16_t i = 0; i < found; i++)
         {
             String ssid = WiFi.SSID(i);
-            if (ssid.length() == 0)
-            {
-                continue;
-            }
+            changed |= _scanResults.add(ssid.c_str(), ssid.length(), static_cast<int8_t>(WiFi.RSSI(i)));
+        }
+        WiFi.scanDelete();
 
-            bool duplicate = false;
-            for (int j = 0; j < i; j++)
-            {
-                if (WiFi.SSID(j) == ssid)
-                {
-                    duplicate = true;
-                    break;
-                }
-            }
-            if (duplicate) continue;
+        if (changed)
+        {
+            publishWifiNetworks();
+        }
 
-            if (count > 0)
-            {
-                json += ",";
-            }
+        startChannelScan(_scanChannel + 1);
+    }
 
-            json += "\"";
-            for (size_t c = 0; c < ssid.length(); c++)
-            {
-                if (ssid[c] == '"')
-                {
-                    json += "\\\"";
-                }
-                else if (ssid[c] == '\\')
-                {
-                    json += "\\\\";
-                }
-                else
-                {
-                    json += ssid[c];
-                }
-            }
-            json += "\"";
-            count++;
+    void PairingManager::publishWifiNetworks()
+    {
+        if (_scanResults.toJson(_networksJson, sizeof(_networksJson)) == 0)
+        {
+            return;
         }
-        json += "]";
-
-        WiFi.scanDelete();
 
         if (_chars.wifiNetworks)
         {
-            _chars.wifiNetworks->setValue(json);
-            LOG_INFO("[BLE] WiFi networks list updated");
+            _chars.wifiNetworks->setValue(reinterpret_cast<const uint8_t*>(_networksJson), strlen(_networksJson));
+            if (_pServer && _pServer->getConnectedCount() > 0)
+            {
+                _chars.wifiNetworks->notify();
+            }
         }
     }
 
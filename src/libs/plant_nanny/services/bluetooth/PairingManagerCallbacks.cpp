@@ -16,6 +16,15 @@ namespace plant_nanny::services::bluetooth
         void onWrite(NimBLECharacteristic* pCharacteristic, NimBLEConnInfo& connInfo) override
         {
             std::string uuid = pCharacteristic->getUUID().toString();
+
+            // Binary and carries secrets: never logged
+            if (uuid == PairingManager::PROVISIONING_CHAR_UUID)
+            {
+                NimBLEAttValue chunk = pCharacteristic->getValue();
+                _manager.handleProvisioningChunk(chunk.data(), chunk.size());
+                return;
+            }
+
             std::string value = pCharacteristic->getValue();
 
             char msg[128];
@@ -31,6 +40,10 @@ namespace plant_nanny::services::bluetooth
             {
                 handleWifiPassWrite(value);
             }
+            else if (uuid == PairingManager::CALIBRATION_CHAR_UUID)
+            {
+                handleCalibrationWrite(value);
+            }
         }
 
     private:
@@ -52,6 +65,19 @@ namespace plant_nanny::services::bluetooth
             }
         }
 
+        void handleCalibrationWrite(const std::string& request)
+        {
+            // Only once the PIN proved the user is next to the device
+            auto state = _manager.getState();
+            if (state != PairingState::AWAITING_WIFI_CONFIG && state != PairingState::CONFIGURING_WIFI &&
+                state != PairingState::PAIRED)
+            {
+                _manager.notifyCalibration("{\"type\":\"calibration\",\"ok\":false,\"error\":\"PIN required\"}");
+                return;
+            }
+            _manager.onCalibrationRequested(request);
+        }
+
         void handleWifiPassWrite(const std::string& password)
         {
             if (_manager.getState() != PairingState::AWAITING_WIFI_CONFIG) return;
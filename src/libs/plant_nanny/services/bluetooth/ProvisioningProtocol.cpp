@@ -0,0 +1,249 @@
+#include "libs/plant_nanny/services/bluetooth/ProvisioningProtocol.h"
+#include "libs/common/utils/Crc.h"
+#include <cstring>
+
+namespace plant_nanny::services::bluetooth
+{
+    namespace
+    {
+        uint16_t readU16(const uint8_t* p) { return static_cast<uint16_t>(p[0] | (p[1] << 8)); }
+
+        uint32_t readU32(const uint8_t* p)
+        {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        void writeU16(uint8_t* p, uint16_t value)
+        {
+            p[0] = static_cast<uint8_t>(value);
+            p[1] = static_cast<uint8_t>(value >> 8);
+        }
+
+        void writeU32(uint8_t* p, uint32_t value)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                p[i] = static_cast<uint8_t>(value >> (8 * i));
+            }
+        }
+
+        /**
+         * @brief Appends TLV records to a body, remembers if anything did not fit
+         */
+        struct TlvWriter
+        {
+            uint8_t* out;
+            size_t capacity;
+            size_t used = 0;
+            bool overflow = false;
+
+            void put(ProvisioningField type, const void* value, size_t length)
+            {
+                if (length > UINT8_MAX || used + 2 + length > capacity)
+                {
+                    overflow = true;
+                    return;
+                }
+                out[used++] = static_cast<uint8_t>(type);
+                out[used++] = static_cast<uint8_t>(length);
+                std::memcpy(out + used, value, length);
+                used += length;
+            }
+
+            void put(ProvisioningField type, const std::string& value)
+            {
+                if (!value.empty())
+                {
+                    put(type, value.data(), value.size());
+                }
+            }
+        };
+    }
+
+    const char* to_string(ProvisioningStatus status)
+    {
+        switch (status)
+        {
+            case ProvisioningStatus::Continue:   return "continue";
+            case ProvisioningStatus::Complete:   return "complete";
+            case ProvisioningStatus::OutOfOrder: return "out_of_order";
+            case ProvisioningStatus::TooLarge:   return "too_large";
+            case ProvisioningStatus::BadFrame:   return "bad_frame";
+            case ProvisioningStatus::BadCrc:     return "bad_crc";
+            case ProvisioningStatus::BadTlv:     return "bad_tlv";
+            case ProvisioningStatus::Rejected:   return "rejected";
+            default:                             return "unknown";
+        }
+    }
+
+    size_t ProvisioningCodec::encode(const ProvisioningMessage& message, uint8_t* out, size_t capacity)
+    {
+        if (out == nullptr || capacity < HEADER_SIZE + CRC_SIZE)
+        {
+            return 0;
+        }
+
+        size_t bodyCapacity = capacity - HEADER_SIZE - CRC_SIZE;
+        TlvWriter body{out + HEADER_SIZE, bodyCapacity < MAX_BODY_SIZE ? bodyCapacity : MAX_BODY_SIZE};
+        body.put(ProvisioningField::Pin, message.pin);
+        body.put(ProvisioningField::WifiSsid, message.wifiSsid);
+        body.put(ProvisioningField::WifiPassword, message.wifiPassword);
+        body.put(ProvisioningField::MqttHost, message.mqttHost);
+        if (message.mqttPort != 0)
+        {
+            uint8_t port[2];
+            writeU16(port, message.mqttPort);
+            body.put(ProvisioningField::MqttPort, port, sizeof(port));
+        }
+        body.put(ProvisioningField::MqttUsername, message.mqttUsername);
+        body.put(ProvisioningField::MqttPassword, message.mqttPassword);
+        body.put(ProvisioningField::ServerId, message.serverId);
+        if (body.overflow)
+        {
+            return 0;
+        }
+
+        writeU16(out, MAGIC);
+        out[2] = VERSION;
+        out[3] = 0;
+        writeU16(out + 4, static_cast<uint16_t>(body.used));
+
+        size_t crcOffset = HEADER_SIZE + body.used;
+        writeU32(out + crcOffset, common::utils::Crc32::compute(out, crcOffset));
+        return crcOffset + CRC_SIZE;
+    }
+
+    bool ProvisioningCodec::readHeader(const uint8_t* header, size_t& bodyLength)
+    {
+        bodyLength = readU16(header + 4);
+        return readU16(header) == MAGIC && header[2] == VERSION && bodyLength <= MAX_BODY_SIZE;
+    }
+
+    bool ProvisioningCodec::checkCrc(const uint8_t* frame, size_t length)
+    {
+        if (length < HEADER_SIZE + CRC_SIZE)
+        {
+            return false;
+        }
+        size_t crcOffset = length - CRC_SIZE;
+        return common::utils::Crc32::compute(frame, crcOffset) == readU32(frame + crcOffset);
+    }
+
+    common::patterns::Result<ProvisioningMessage> ProvisioningCodec::decode(const uint8_t* frame, size_t length)
+    {
+        using ResultType = common::patterns::Result<ProvisioningMessage>;
+
+        size_t bodyLength = 0;
+        if (frame == nullptr || length < HEADER_SIZE + CRC_SIZE || !readHeader(frame, bodyLength) ||
+            HEADER_SIZE + bodyLength + CRC_SIZE != length)
+        {
+            return ResultType::failure(common::patterns::Error("Provisioning frame malformed"));
+        }
+
+        ProvisioningMessage message;
+        const uint8_t* p = frame + HEADER_SIZE;
+        const uint8_t* end = frame + length - CRC_SIZE;
+        while (p < end)
+        {
+            if (end - p < 2 || end - p - 2 < p[1])
+            {
+                return ResultType::failure(common::patterns::Error("Provisioning record truncated"));
+            }
+
+            auto type = static_cast<ProvisioningField>(p[0]);
+            size_t size = p[1];
+            const char* value = reinterpret_cast<const char*>(p + 2);
+            switch (type)
+            {
+                case ProvisioningField::Pin:          message.pin.assign(value, size); break;
+                case ProvisioningField::WifiSsid:     message.wifiSsid.assign(value, size); break;
+                case ProvisioningField::WifiPassword: message.wifiPassword.assign(value, size); break;
+                case ProvisioningField::MqttHost:     message.mqttHost.assign(value, size); break;
+                case ProvisioningField::MqttUsername: message.mqttUsername.assign(value, size); break;
+                case ProvisioningField::MqttPassword: message.mqttPassword.assign(value, size); break;
+                case ProvisioningField::ServerId:     message.serverId.assign(value, size); break;
+                case ProvisioningField::MqttPort:
+                    if (size != 2)
+                    {
+                        return ResultType::failure(common::patterns::Error("Provisioning MQTT port malformed"));
+                    }
+                    message.mqttPort = readU16(p + 2);
+                    break;
+                default:
+                    break;  // Newer field, skip
+            }
+            p += 2 + size;
+        }
+
+        return ResultType::success(message);
+    }
+
+    void ProvisioningAssembler::reset()
+    {
+        _received = 0;
+        _expected = 0;
+        _nextIndex = 0;
+        _active = false;
+    }
+
+    ProvisioningStatus ProvisioningAssembler::feed(const uint8_t* chunk, size_t length)
+    {
+        if (chunk == nullptr || length < 2)
+        {
+            reset();
+            return ProvisioningStatus::BadFrame;
+        }
+
+        uint8_t index = chunk[0];
+        if (index == 0)
+        {
+            reset();
+            _active = true;
+        }
+        else if (!_active || index != _nextIndex)
+        {
+            reset();
+            return ProvisioningStatus::OutOfOrder;
+        }
+
+        const uint8_t* data = chunk + 1;
+        size_t size = length - 1;
+        if (_received + size > sizeof(_frame))
+        {
+            reset();
+            return ProvisioningStatus::TooLarge;
+        }
+        std::memcpy(_frame + _received, data, size);
+        _received += size;
+        _nextIndex = static_cast<uint8_t>(index + 1);
+
+        if (_expected == 0 && _received >= ProvisioningCodec::HEADER_SIZE)
+        {
+            size_t body = 0;
+            if (!ProvisioningCodec::readHeader(_frame, body))
+            {
+                reset();
+                return ProvisioningStatus::BadFrame;
+            }
+            _expected = ProvisioningCodec::HEADER_SIZE + body + ProvisioningCodec::CRC_SIZE;
+        }
+
+        if (_expected == 0 || _received < _expected)
+        {
+            return ProvisioningStatus::Continue;
+        }
+
+        _active = false;
+        if (_received > _expected)
+        {
+            return ProvisioningStatus::BadFrame;
+        }
+        if (!ProvisioningCodec::checkCrc(_frame, _received))
+        {
+            return ProvisioningStatus::BadCrc;
+        }
+        return ProvisioningStatus::Complete;
+    }
+
+} // namespace plant_nanny::services::bluetooth
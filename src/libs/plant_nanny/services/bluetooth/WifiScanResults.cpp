@@ -0,0 +1,176 @@
+#include "libs/plant_nanny/services/bluetooth/WifiScanResults.h"
+#include <cstring>
+
+namespace plant_nanny::services::bluetooth
+{
+    uint32_t WifiScanResults::hash(const char* ssid, size_t length)
+    {
+        // FNV-1a
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < length; i++)
+        {
+            h ^= static_cast<uint8_t>(ssid[i]);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    void WifiScanResults::clear()
+    {
+        memset(_slots, EMPTY, sizeof(_slots));
+        _count = 0;
+    }
+
+    int WifiScanResults::find(const char* ssid, size_t length) const
+    {
+        for (size_t probe = hash(ssid, length) & (HASH_SLOTS - 1); _slots[probe] != EMPTY;
+             probe = (probe + 1) & (HASH_SLOTS - 1))
+        {
+            const Network& network = _networks[_slots[probe]];
+            if (strlen(network.ssid) == length && memcmp(network.ssid, ssid, length) == 0)
+            {
+                return _slots[probe];
+            }
+        }
+        return -1;
+    }
+
+    void WifiScanResults::insertSlot(const char* ssid, size_t length, uint8_t index)
+    {
+        size_t probe = hash(ssid, length) & (HASH_SLOTS - 1);
+        while (_slots[probe] != EMPTY)
+        {
+            probe = (probe + 1) & (HASH_SLOTS - 1);
+        }
+        _slots[probe] = index;
+    }
+
+    void WifiScanResults::rebuildSlots()
+    {
+        // Open addressing has no cheap delete; with CAPACITY entries a rebuild is cheaper
+        memset(_slots, EMPTY, sizeof(_slots));
+        for (size_t i = 0; i < _count; i++)
+        {
+            const Network& network = _networks[_order[i]];
+            insertSlot(network.ssid, strlen(network.ssid), _order[i]);
+        }
+    }
+
+    void WifiScanResults::moveUp(size_t position)
+    {
+        uint8_t index = _order[position];
+        while (position > 0 && _networks[_order[position - 1]].rssi < _networks[index].rssi)
+        {
+            _order[position] = _order[position - 1];
+            position--;
+        }
+        _order[position] = index;
+    }
+
+    bool WifiScanResults::add(const char* ssid, size_t length, int8_t rssi)
+    {
+        length = strnlen(ssid, length);
+        if (length == 0 || length > MAX_SSID_LENGTH)
+        {
+            return false;
+        }
+
+        int known = find(ssid, length);
+        if (known >= 0)
+        {
+            if (rssi <= _networks[known].rssi)
+            {
+                return false;
+            }
+            _networks[known].rssi = rssi;
+            for (size_t position = 0; position < _count; position++)
+            {
+                if (_order[position] == known)
+                {
+                    moveUp(position);
+                    break;
+                }
+            }
+            return true;
+        }
+
+        uint8_t index;
+        bool evicted = false;
+        if (_count < CAPACITY)
+        {
+            index = static_cast<uint8_t>(_count);
+            _order[_count++] = index;
+        }
+        else
+        {
+            // Full: replace the weakest if the new one is stronger
+            index = _order[_count - 1];
+            if (rssi <= _networks[index].rssi)
+            {
+                return false;
+            }
+            evicted = true;
+        }
+
+        Network& network = _networks[index];
+        memcpy(network.ssid, ssid, length);
+        network.ssid[length] = '\0';
+        network.rssi = rssi;
+
+        if (evicted)
+        {
+            rebuildSlots();
+        }
+        else
+        {
+            insertSlot(ssid, length, index);
+        }
+        moveUp(_count - 1);
+        return true;
+    }
+
+    size_t WifiScanResults::toJson(char* buffer, size_t bufferSize) const
+    {
+        if (bufferSize < 3)
+        {
+            return 0;
+        }
+
+        size_t used = 0;
+        buffer[used++] = '[';
+        for (size_t i = 0; i < _count; i++)
+        {
+            const char* ssid = at(i).ssid;
+
+            // Worst case: every byte escaped, plus quotes, comma and the closing "]\0"
+            size_t needed = 2 * strlen(ssid) + 3 + 2;
+            if (used + needed > bufferSize)
+            {
+                break;
+            }
+
+            if (i > 0)
+            {
+                buffer[used++] = ',';
+            }
+            buffer[used++] = '"';
+            for (const char* c = ssid; *c; c++)
+            {
+                if (static_cast<uint8_t>(*c) < 0x20)
+                {
+                    continue;  // Control characters are not valid in JSON strings
+                }
+                if (*c == '"' || *c == '\\')
+                {
+                    buffer[used++] = '\\';
+                }
+                buffer[used++] = *c;
+            }
+            buffer[used++] = '"';
+        }
+        buffer[used++] = ']';
+        buffer[used] = '\0';
+        return used;
+    }
+
+} // namespace plant_nanny::services::bluetooth
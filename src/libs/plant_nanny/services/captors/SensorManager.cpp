@@ -1,4 +1,5 @@
 #include "libs/plant_nanny/services/captors/SensorManager.h"
+#include "libs/plant_nanny/metrics/FirmwareMetrics.h"
 #include <Arduino.h>
 #include <cmath>
 
@@ -10,12 +11,14 @@ SensorManager::SensorManager()
     auto config = SensorManagerConfig::defaultConfig();
     initialize(config.pins);
     configureThermistor(config.thermistorConfig);
+    configureFilters(config.filters);
 }
 
 SensorManager::SensorManager(const SensorManagerConfig& config)
 {
     initialize(config.pins);
     configureThermistor(config.thermistorConfig);
+    configureFilters(config.filters);
 }
 
 void SensorManager::initialize()
@@ -31,10 +34,16 @@ void SensorManager::initialize(const SensorPins& pins)
     pinMode(_pins.powerPin, OUTPUT);
     digitalWrite(_pins.powerPin, LOW);
     
-    // Initialize sensors WITHOUT power control (we manage it here)
     _temperature.initialize(_pins.thermistorPin);
     _luminosity.initialize(_pins.ldrPin);
     _humidity.initialize(_pins.humidityPin);
+
+    // One DMA pattern samples every channel round-robin
+    _adc.reset();
+    _channels.clear();
+    _temperatureChannel = addChannel(channels::TEMPERATURE, _pins.thermistorPin, _temperature);
+    _humidityChannel = addChannel(channels::SOIL_HUMIDITY, _pins.humidityPin, _humidity);
+    _luminosityChannel = addChannel(channels::LUMINOSITY, _pins.ldrPin, _luminosity);
     
     _initialized = true;
 }
@@ -44,29 +53,127 @@ void SensorManager::configureThermistor(const temperature::ThermistorConfig& con
     _temperature.configure(config);
 }
 
-SensorData SensorManager::read()
+int SensorManager::addChannel(const ChannelInfo& info, uint8_t pin, const IAdcConverter& converter,
+                              const filter::FilterConfig& filter)
 {
-    SensorData data;
-    
-    if (!_initialized)
+    if (_channels.size() >= MAX_SENSOR_CHANNELS || _channels.find(info.key) != SensorChannels::NONE)
     {
-        data.valid = false;
-        return data;
+        return SensorChannels::NONE;
     }
-    
+
+    int adcSlot = _adc.addPin(pin);
+    if (adcSlot == adc::AdcSampleBuffer::INVALID_SLOT)
+    {
+        return SensorChannels::NONE;
+    }
+
+    int index = _channels.add(info);
+    AdcChannel& source = _sources[index];
+    source.adcSlot = adcSlot;
+    source.converter = &converter;
+    source.filter.configure(filter);
+    return index;
+}
+
+void SensorManager::configureFilters(const SensorFilters& filters)
+{
+    if (_temperatureChannel != SensorChannels::NONE)
+        _sources[_temperatureChannel].filter.configure(filters.temperature);
+    if (_luminosityChannel != SensorChannels::NONE)
+        _sources[_luminosityChannel].filter.configure(filters.luminosity);
+    if (_humidityChannel != SensorChannels::NONE)
+        _sources[_humidityChannel].filter.configure(filters.humidity);
+}
+
+common::patterns::Result<void> SensorManager::acquire()
+{
     // Power on sensors
     digitalWrite(_pins.powerPin, HIGH);
-    delay(50);  // Warm-up time
+    delay(WARMUP_MS);
     
-    // Read all sensors
-    data.temperatureC = _temperature.read();
-    data.luminosityPct = _luminosity.read();
-    data.humidityPct = _humidity.read();
+    auto acquired = _adc.acquire(SAMPLES_PER_CHANNEL, ACQUIRE_TIMEOUT_MS);
     
     // Power off sensors
     digitalWrite(_pins.powerPin, LOW);
+    return acquired;
+}
+
+void SensorManager::applyCalibration(const config::SensorCalibration& calibration)
+{
+    _humidity.calibrate(calibration.humidity);
+    _luminosity.calibrate(calibration.luminosity);
+
+    // Values before and after are on different scales, do not blend them
+    if (_humidityChannel != SensorChannels::NONE)
+        _sources[_humidityChannel].filter.reset();
+    if (_luminosityChannel != SensorChannels::NONE)
+        _sources[_luminosityChannel].filter.reset();
+}
+
+common::patterns::Result<float> SensorManager::readAdc(int channel)
+{
+    if (!_initialized || channel < 0 || static_cast<size_t>(channel) >= _channels.size())
+    {
+        return common::patterns::Result<float>::failure(common::patterns::Error("Unknown sensor channel"));
+    }
+
+    auto acquired = acquire();
+    if (acquired.failed())
+    {
+        return common::patterns::Result<float>::failure(acquired.error());
+    }
+
+    float value = _adc.average(_sources[channel].adcSlot);
+    if (std::isnan(value))
+    {
+        return common::patterns::Result<float>::failure(common::patterns::Error("No ADC sample"));
+    }
+    return common::patterns::Result<float>::success(value);
+}
+
+common::patterns::Result<float> SensorManager::readUnfiltered(int channel)
+{
+    auto adcValue = readAdc(channel);
+    if (adcValue.failed())
+    {
+        return adcValue;
+    }
+    return common::patterns::Result<float>::success(_sources[channel].converter->convert(adcValue.value()));
+}
+
+SensorReadings SensorManager::read()
+{
+    SensorReadings data;
+    data.count = static_cast<uint8_t>(_channels.size());
     
-    data.valid = !std::isnan(data.temperatureC) || !std::isnan(data.luminosityPct) || !std::isnan(data.humidityPct);
+    if (!_initialized)
+    {
+        data.valid = false;
+        return data;
+    }
+    
+    uint32_t start = micros();
+    if (acquire().failed())
+    {
+        metrics::sensorReadFailures.increment();
+        data.valid = false;
+        return data;
+    }
+    data.acquiredMs = millis();
+    
+    // A reading with a missing channel would let a broken probe look like dry soil
+    data.valid = data.count > 0;
+    for (size_t i = 0; i < _channels.size(); i++)
+    {
+        AdcChannel& source = _sources[i];
+        data.values[i] = source.filter.apply(source.converter->convert(_adc.average(source.adcSlot)));
+        data.valid = data.valid && !std::isnan(data.values[i]);
+    }
+    if (!data.valid)
+    {
+        metrics::sensorReadFailures.increment();
+    }
+    metrics::sensorReadUs.record(micros() - start);
     
     return data;
 }
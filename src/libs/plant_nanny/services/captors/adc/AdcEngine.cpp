@@ -0,0 +1,155 @@
+#include "libs/plant_nanny/services/captors/adc/AdcEngine.h"
+#include "libs/common/utils/EspError.h"
+#include "libs/common/logger/Log.h"
+#include <Arduino.h>
+#include <driver/adc.h>
+#include <esp_adc_cal.h>
+
+namespace plant_nanny::services::captors::adc
+{
+
+AdcEngine::AdcEngine()
+{
+    // Only reads eFuse, the ADC itself is not touched
+    esp_adc_cal_characteristics_t characteristics = {};
+    esp_adc_cal_value_t source = esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12,
+                                                          DEFAULT_VREF_MV, &characteristics);
+    if (source == ESP_ADC_CAL_VAL_DEFAULT_VREF)
+    {
+        LOG_WARN("[ADC] No eFuse calibration, using raw conversions");
+        return;
+    }
+
+    _linearization.build([&characteristics](uint32_t raw)
+                         { return esp_adc_cal_raw_to_voltage(raw, &characteristics); });
+    LOG_INFO(source == ESP_ADC_CAL_VAL_EFUSE_TP ? "[ADC] Corrected with eFuse two-point calibration"
+                                                : "[ADC] Corrected with eFuse Vref");
+}
+
+AdcEngine::~AdcEngine()
+{
+    stop();
+}
+
+int AdcEngine::addPin(uint8_t gpio)
+{
+    int8_t channel = digitalPinToAnalogChannel(gpio);
+    if (channel < 0)
+    {
+        return AdcSampleBuffer::INVALID_SLOT;
+    }
+    return _buffer.addChannel(static_cast<uint8_t>(channel));
+}
+
+void AdcEngine::reset()
+{
+    stop();
+    _buffer.reset();
+}
+
+common::patterns::Result<void> AdcEngine::start()
+{
+    size_t channelCount = _buffer.channelCount();
+    if (channelCount == 0)
+    {
+        return common::patterns::Result<void>::failure(common::patterns::Error("No ADC channel configured"));
+    }
+
+    adc_digi_init_config_t init = {};
+    init.max_store_buf_size = STORE_SIZE;
+    init.conv_num_each_intr = FRAME_SIZE;
+    adc_digi_pattern_config_t pattern[AdcSampleBuffer::MAX_CHANNELS] = {};
+    for (size_t i = 0; i < channelCount; i++)
+    {
+        uint8_t channel = _buffer.channel(static_cast<int>(i));
+        init.adc1_chan_mask |= BIT(channel);
+        pattern[i].atten = ADC_ATTEN_DB_11;  // Same 0-3.3 V range analogRead used
+        pattern[i].channel = channel;
+        pattern[i].unit = 0;                 // ADC1
+        pattern[i].bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+    }
+
+    auto result = common::utils::EspError::to_result(adc_digi_initialize(&init), "adc_digi_initialize");
+    if (result.failed())
+    {
+        return result;
+    }
+    _running = true;
+
+    adc_digi_configuration_t config = {};
+    config.conv_limit_en = true;  // Required by the ESP32 controller
+    config.conv_limit_num = 250;
+    config.pattern_num = channelCount;
+    config.adc_pattern = pattern;
+    config.sample_freq_hz = SAMPLE_FREQ_HZ;
+    config.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    config.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+
+    result = common::utils::EspError::to_result(adc_digi_controller_configure(&config), "adc_digi_controller_configure");
+    if (result.succeed())
+    {
+        result = common::utils::EspError::to_result(adc_digi_start(), "adc_digi_start");
+    }
+    if (result.failed())
+    {
+        stop();
+    }
+    return result;
+}
+
+void AdcEngine::stop()
+{
+    if (!_running)
+    {
+        return;
+    }
+    adc_digi_stop();
+    adc_digi_deinitialize();
+    _running = false;
+}
+
+common::patterns::Result<void> AdcEngine::acquire(size_t samplesPerChannel, uint32_t timeoutMs)
+{
+    if (samplesPerChannel > AdcSampleBuffer::CAPACITY)
+    {
+        samplesPerChannel = AdcSampleBuffer::CAPACITY;
+    }
+
+    _buffer.clear();
+    auto result = start();
+    if (result.failed())
+    {
+        return result;
+    }
+
+    // The task blocks on the driver until a frame is complete, no polling
+    uint32_t startedAt = millis();
+    while (!_buffer.filled(samplesPerChannel))
+    {
+        uint32_t elapsed = millis() - startedAt;
+        if (elapsed >= timeoutMs)
+        {
+            result = common::patterns::Result<void>::failure(common::patterns::Error("ADC acquisition timed out"));
+            break;
+        }
+
+        uint32_t length = 0;
+        esp_err_t err = adc_digi_read_bytes(_frame, FRAME_SIZE, &length, timeoutMs - elapsed);
+        if (err == ESP_ERR_TIMEOUT)
+        {
+            continue;
+        }
+        // ESP_ERR_INVALID_STATE: the driver buffer overflowed, the frame is still valid
+        if (err != ESP_OK && err != ESP_ERR_INVALID_STATE)
+        {
+            result = common::utils::EspError::to_result(err, "adc_digi_read_bytes");
+            break;
+        }
+        _buffer.decode(_frame, length);
+    }
+
+    stop();
+    return result;
+}
+
+}
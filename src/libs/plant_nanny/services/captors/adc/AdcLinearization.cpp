@@ -0,0 +1,35 @@
+#include "libs/plant_nanny/services/captors/adc/AdcLinearization.h"
+#include <algorithm>
+#include <cmath>
+
+namespace plant_nanny::services::captors::adc
+{
+
+void AdcLinearization::build(const Characteristic &rawToMillivolts, float supplyMv)
+{
+    float countsPerMv = RAW_MAX / supplyMv;
+    for (size_t i = 0; i <= SEGMENTS; i++)
+    {
+        // The last point sits on RAW_MAX, one count short of the segment grid
+        uint32_t raw = std::min<uint32_t>(static_cast<uint32_t>(i * SEGMENT_WIDTH), RAW_MAX);
+        _points[i] = rawToMillivolts(raw) * countsPerMv;
+    }
+    _built = true;
+}
+
+float AdcLinearization::apply(float raw) const
+{
+    if (!_built || std::isnan(raw))
+    {
+        return raw;
+    }
+
+    raw = std::clamp(raw, 0.0f, static_cast<float>(RAW_MAX));
+    size_t segment = std::min(static_cast<size_t>(raw / SEGMENT_WIDTH), SEGMENTS - 1);
+    float lower = segment * SEGMENT_WIDTH;
+    float upper = std::min((segment + 1) * SEGMENT_WIDTH, static_cast<float>(RAW_MAX));
+    float fraction = (raw - lower) / (upper - lower);
+    return _points[segment] + fraction * (_points[segment + 1] - _points[segment]);
+}
+
+}
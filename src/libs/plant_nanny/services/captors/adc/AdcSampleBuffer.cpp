@@ -0,0 +1,133 @@
+#include "libs/plant_nanny/services/captors/adc/AdcSampleBuffer.h"
+#include <cmath>
+
+namespace plant_nanny::services::captors::adc
+{
+
+int AdcSampleBuffer::addChannel(uint8_t adcChannel)
+{
+    // ADC1 only: ADC2 is unavailable while WiFi is on and has no DMA on the ESP32
+    if (adcChannel > 7 || _channelCount >= MAX_CHANNELS || find(adcChannel) != nullptr)
+    {
+        return INVALID_SLOT;
+    }
+
+    _channels[_channelCount] = Channel{};
+    _channels[_channelCount].adcChannel = adcChannel;
+    return static_cast<int>(_channelCount++);
+}
+
+void AdcSampleBuffer::reset()
+{
+    _channelCount = 0;
+}
+
+void AdcSampleBuffer::clear()
+{
+    for (size_t i = 0; i < _channelCount; i++)
+    {
+        _channels[i].head = 0;
+        _channels[i].count = 0;
+    }
+}
+
+AdcSampleBuffer::Channel *AdcSampleBuffer::find(uint8_t adcChannel)
+{
+    for (size_t i = 0; i < _channelCount; i++)
+    {
+        if (_channels[i].adcChannel == adcChannel)
+        {
+            return &_channels[i];
+        }
+    }
+    return nullptr;
+}
+
+void AdcSampleBuffer::push(uint8_t adcChannel, uint16_t value)
+{
+    Channel *channel = find(adcChannel);
+    if (channel == nullptr)
+    {
+        return;
+    }
+
+    channel->samples[channel->head] = value;
+    channel->head = (channel->head + 1) % CAPACITY;
+    if (channel->count < CAPACITY)
+    {
+        channel->count++;
+    }
+}
+
+size_t AdcSampleBuffer::decode(const uint8_t *frame, size_t length)
+{
+    size_t accepted = 0;
+    for (size_t i = 0; i + 1 < length; i += 2)
+    {
+        uint16_t entry = static_cast<uint16_t>(frame[i] | (frame[i + 1] << 8));
+        uint8_t adcChannel = static_cast<uint8_t>(entry >> 12);
+        Channel *channel = find(adcChannel);
+        if (channel != nullptr)
+        {
+            push(adcChannel, entry & 0x0FFF);
+            accepted++;
+        }
+    }
+    return accepted;
+}
+
+size_t AdcSampleBuffer::count(int slot) const
+{
+    if (slot < 0 || static_cast<size_t>(slot) >= _channelCount)
+    {
+        return 0;
+    }
+    return _channels[slot].count;
+}
+
+bool AdcSampleBuffer::filled(size_t minSamples) const
+{
+    for (size_t i = 0; i < _channelCount; i++)
+    {
+        if (_channels[i].count < minSamples)
+        {
+            return false;
+        }
+    }
+    return _channelCount > 0;
+}
+
+float AdcSampleBuffer::average(int slot) const
+{
+    size_t n = count(slot);
+    if (n == 0)
+    {
+        return NAN;
+    }
+
+    uint32_t sum = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        sum += _channels[slot].samples[i];
+    }
+    return static_cast<float>(sum) / static_cast<float>(n);
+}
+
+size_t AdcSampleBuffer::copy(int slot, uint16_t *out, size_t maxCount) const
+{
+    size_t n = count(slot);
+    if (n > maxCount)
+    {
+        n = maxCount;
+    }
+
+    const Channel &channel = _channels[slot];
+    size_t start = (channel.head + CAPACITY - n) % CAPACITY;
+    for (size_t i = 0; i < n; i++)
+    {
+        out[i] = channel.samples[(start + i) % CAPACITY];
+    }
+    return n;
+}
+
+}
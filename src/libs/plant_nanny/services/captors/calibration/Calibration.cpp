@@ -0,0 +1,180 @@
+#include "libs/plant_nanny/services/captors/calibration/Calibration.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace plant_nanny::services::captors::calibration
+{
+namespace
+{
+    struct PointName
+    {
+        CalibrationSensor sensor;
+        CalibrationPoint point;
+        const char *name;
+    };
+
+    constexpr PointName POINT_NAMES[] = {
+        {CalibrationSensor::Humidity, CalibrationPoint::Zero, "dry"},
+        {CalibrationSensor::Humidity, CalibrationPoint::Full, "wet"},
+        {CalibrationSensor::Luminosity, CalibrationPoint::Zero, "dark"},
+        {CalibrationSensor::Luminosity, CalibrationPoint::Full, "bright"},
+    };
+
+    constexpr float ADC_MAX = 4095.0f;
+
+    config::TwoPointCalibration &pointsOf(config::SensorCalibration &calibration, CalibrationSensor sensor)
+    {
+        return sensor == CalibrationSensor::Humidity ? calibration.humidity : calibration.luminosity;
+    }
+}
+
+bool parse(const char *sensor, const char *point, CalibrationRequest &request)
+{
+    CalibrationSensor parsed;
+    if (strcmp(sensor, "humidity") == 0)
+    {
+        parsed = CalibrationSensor::Humidity;
+    }
+    else if (strcmp(sensor, "luminosity") == 0)
+    {
+        parsed = CalibrationSensor::Luminosity;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (strcmp(point, "reset") == 0)
+    {
+        request = {parsed, CalibrationPoint::Reset};
+        return true;
+    }
+    for (const auto &entry : POINT_NAMES)
+    {
+        if (entry.sensor == parsed && strcmp(point, entry.name) == 0)
+        {
+            request = {parsed, entry.point};
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parse(const std::string &text, CalibrationRequest &request)
+{
+    size_t separator = text.find(':');
+    if (separator == std::string::npos)
+    {
+        return false;
+    }
+    return parse(text.substr(0, separator).c_str(), text.substr(separator + 1).c_str(), request);
+}
+
+const char *to_string(CalibrationSensor sensor)
+{
+    return sensor == CalibrationSensor::Humidity ? "humidity" : "luminosity";
+}
+
+const char *pointName(const CalibrationRequest &request)
+{
+    for (const auto &entry : POINT_NAMES)
+    {
+        if (entry.sensor == request.sensor && entry.point == request.point)
+        {
+            return entry.name;
+        }
+    }
+    return "reset";
+}
+
+const ChannelInfo &channelOf(CalibrationSensor sensor)
+{
+    return sensor == CalibrationSensor::Humidity ? channels::SOIL_HUMIDITY : channels::LUMINOSITY;
+}
+
+common::patterns::Result<config::SensorCalibration> record(config::SensorCalibration calibration,
+                                                           const CalibrationRequest &request, float adc)
+{
+    using ResultType = common::patterns::Result<config::SensorCalibration>;
+
+    config::TwoPointCalibration &points = pointsOf(calibration, request.sensor);
+    if (request.point == CalibrationPoint::Reset)
+    {
+        points = config::TwoPointCalibration{};
+        return ResultType::success(calibration);
+    }
+
+    if (std::isnan(adc) || adc < 0.0f || adc > ADC_MAX)
+    {
+        return ResultType::failure(common::patterns::Error("ADC value out of range"));
+    }
+
+    bool zero = request.point == CalibrationPoint::Zero;
+    float other = zero ? points.fullAdc : points.zeroAdc;
+    if (!std::isnan(other) && std::fabs(adc - other) < MIN_SPAN)
+    {
+        return ResultType::failure(common::patterns::Error("Calibration points too close"));
+    }
+
+    (zero ? points.zeroAdc : points.fullAdc) = adc;
+    return ResultType::success(calibration);
+}
+
+common::patterns::Result<float> run(ISensorManager &sensors, config::IConfigManager &config,
+                                    const CalibrationRequest &request)
+{
+    using ResultType = common::patterns::Result<float>;
+
+    float adc = NAN;
+    if (request.point != CalibrationPoint::Reset)
+    {
+        int channel = sensors.channels().find(channelOf(request.sensor).key);
+        auto sampled = sensors.readAdc(channel);
+        if (sampled.failed())
+        {
+            return sampled;
+        }
+        adc = sampled.value();
+    }
+
+    auto recorded = record(config.getSensorCalibration(), request, adc);
+    if (recorded.failed())
+    {
+        return ResultType::failure(recorded.error());
+    }
+    auto saved = config.saveSensorCalibration(recorded.value());
+    if (saved.failed())
+    {
+        return ResultType::failure(saved.error());
+    }
+
+    sensors.applyCalibration(recorded.value());
+    return ResultType::success(adc);
+}
+
+size_t toJson(const CalibrationRequest &request, const common::patterns::Result<float> &outcome,
+              char *out, size_t capacity)
+{
+    int length;
+    if (outcome.failed())
+    {
+        length = snprintf(out, capacity,
+                          "{\"type\":\"calibration\",\"sensor\":\"%s\",\"point\":\"%s\",\"ok\":false,\"error\":\"%s\"}",
+                          to_string(request.sensor), pointName(request), outcome.error().message().c_str());
+    }
+    else if (std::isnan(outcome.value()))
+    {
+        length = snprintf(out, capacity, "{\"type\":\"calibration\",\"sensor\":\"%s\",\"point\":\"%s\",\"ok\":true}",
+                          to_string(request.sensor), pointName(request));
+    }
+    else
+    {
+        length = snprintf(out, capacity,
+                          "{\"type\":\"calibration\",\"sensor\":\"%s\",\"point\":\"%s\",\"ok\":true,\"adc\":%.1f}",
+                          to_string(request.sensor), pointName(request), outcome.value());
+    }
+    return length > 0 && static_cast<size_t>(length) < capacity ? static_cast<size_t>(length) : 0;
+}
+
+}
@@ -1,5 +1,4 @@
 #include "libs/plant_nanny/services/captors/humidity/Humidity.h"
-#include <Arduino.h>
 #include <cmath>
 
 namespace plant_nanny::services::captors::humidity
@@ -8,65 +7,27 @@ namespace plant_nanny::services::captors::humidity
 void Humidity::initialize(uint8_t adcPin)
 {
     _adcPin = adcPin;
-    _hasPowerControl = false;
-    
-    analogReadResolution(12);
-    analogSetAttenuation(ADC_11db);
-    
     _initialized = true;
 }
 
-void Humidity::initialize(uint8_t adcPin, uint8_t powerPin)
-{
-    _adcPin = adcPin;
-    _powerPin = powerPin;
-    _hasPowerControl = true;
-    
-    pinMode(_powerPin, OUTPUT);
-    digitalWrite(_powerPin, LOW);
-    
-    analogReadResolution(12);
-    analogSetAttenuation(ADC_11db);
-    
-    _initialized = true;
-}
-
-void Humidity::powerOn()
+void Humidity::calibrate(int dryValue, int wetValue)
 {
-    if (_hasPowerControl)
-    {
-        digitalWrite(_powerPin, HIGH);
-        delay(WARMUP_MS);
-    }
+    _dryValue = dryValue;
+    _wetValue = wetValue;
 }
 
-void Humidity::powerOff()
+void Humidity::calibrate(const config::TwoPointCalibration& points)
 {
-    if (_hasPowerControl)
-    {
-        digitalWrite(_powerPin, LOW);
-    }
+    calibrate(points.hasZero() ? static_cast<int>(std::lround(points.zeroAdc)) : DEFAULT_DRY_VALUE,
+              points.hasFull() ? static_cast<int>(std::lround(points.fullAdc)) : DEFAULT_WET_VALUE);
 }
 
-int Humidity::readAdc()
+float Humidity::convert(float adcValue) const
 {
-    long sum = 0;
-    for (int i = 0; i < NUM_SAMPLES; i++)
+    if (!_initialized || std::isnan(adcValue))
     {
-        sum += analogRead(_adcPin);
-        delay(2);
+        return NAN;
     }
-    return static_cast<int>(sum / NUM_SAMPLES);
-}
-
-void Humidity::calibrate(int dryValue, int wetValue)
-{
-    _dryValue = dryValue;
-    _wetValue = wetValue;
-}
-
-float Humidity::adcToHumidity(int adcValue)
-{
     if (adcValue < 0)
     {
         return 0.0f;
@@ -80,13 +41,13 @@ float Humidity::adcToHumidity(int adcValue)
     {
         // Higher ADC = less humidity (typical capacitive sensor)
         // Map from [wetValue, dryValue] to [100%, 0%]
-        humidity = 100.0f * static_cast<float>(_dryValue - adcValue) / static_cast<float>(_dryValue - _wetValue);
+        humidity = 100.0f * (_dryValue - adcValue) / static_cast<float>(_dryValue - _wetValue);
     }
     else
     {
         // Higher ADC = more humidity
         // Map from [dryValue, wetValue] to [0%, 100%]
-        humidity = 100.0f * static_cast<float>(adcValue - _dryValue) / static_cast<float>(_wetValue - _dryValue);
+        humidity = 100.0f * (adcValue - _dryValue) / static_cast<float>(_wetValue - _dryValue);
     }
     
     // Clamp to 0-100 range
@@ -96,18 +57,4 @@ float Humidity::adcToHumidity(int adcValue)
     return humidity;
 }
 
-float Humidity::read()
-{
-    if (!_initialized)
-    {
-        return NAN;
-    }
-    
-    powerOn();
-    int adcValue = readAdc();
-    powerOff();
-    
-    return adcToHumidity(adcValue);
 }
-
-}
\ No newline at end of file
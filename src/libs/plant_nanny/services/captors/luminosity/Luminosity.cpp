@@ -1,5 +1,4 @@
 #include "libs/plant_nanny/services/captors/luminosity/Luminosity.h"
-#include <Arduino.h>
 #include <cmath>
 
 namespace plant_nanny::services::captors::luminosity
@@ -8,74 +7,54 @@ namespace plant_nanny::services::captors::luminosity
 void Luminosity::initialize(uint8_t adcPin)
 {
     _adcPin = adcPin;
-    _hasPowerControl = false;
-    
-    analogReadResolution(12);
-    analogSetAttenuation(ADC_11db);
-    
     _initialized = true;
 }
 
-void Luminosity::initialize(uint8_t adcPin, uint8_t powerPin)
+void Luminosity::calibrate(int darkValue, int brightValue)
 {
-    _adcPin = adcPin;
-    _powerPin = powerPin;
-    _hasPowerControl = true;
-    
-    pinMode(_powerPin, OUTPUT);
-    digitalWrite(_powerPin, LOW);
-    
-    analogReadResolution(12);
-    analogSetAttenuation(ADC_11db);
-    
-    _initialized = true;
+    _darkValue = static_cast<float>(darkValue);
+    _brightValue = static_cast<float>(brightValue);
+    _calibrated = true;
 }
 
-void Luminosity::powerOn()
+void Luminosity::calibrate(const config::TwoPointCalibration& points)
 {
-    if (_hasPowerControl)
+    if (!points.hasZero() && !points.hasFull())
     {
-        digitalWrite(_powerPin, HIGH);
-        delay(WARMUP_MS);
+        _calibrated = false;
+        return;
     }
+    int dark = _invertReading ? ADC_MAX : 0;
+    int bright = _invertReading ? 0 : ADC_MAX;
+    calibrate(points.hasZero() ? static_cast<int>(std::lround(points.zeroAdc)) : dark,
+              points.hasFull() ? static_cast<int>(std::lround(points.fullAdc)) : bright);
 }
 
-void Luminosity::powerOff()
+float Luminosity::convert(float adcValue) const
 {
-    if (_hasPowerControl)
+    if (!_initialized || std::isnan(adcValue))
     {
-        digitalWrite(_powerPin, LOW);
-    }
-}
-
-int Luminosity::readAdc()
-{
-    long sum = 0;
-    for (int i = 0; i < NUM_SAMPLES; i++)
-    {
-        sum += analogRead(_adcPin);
-        delay(2);
+        return NAN;
     }
-    return static_cast<int>(sum / NUM_SAMPLES);
-}
-
-float Luminosity::adcToLuminosity(int adcValue)
-{
     if (adcValue < 0)
     {
         return 0.0f;
     }
     
     float luminosity;
-    if (_invertReading)
+    if (_calibrated)
+    {
+        luminosity = 100.0f * (adcValue - _darkValue) / (_brightValue - _darkValue);
+    }
+    else if (_invertReading)
     {
         // Higher ADC = less light (LDR between ADC and GND with pull-up)
-        luminosity = 100.0f * (1.0f - static_cast<float>(adcValue) / ADC_MAX);
+        luminosity = 100.0f * (1.0f - adcValue / ADC_MAX);
     }
     else
     {
         // Higher ADC = more light (LDR between VCC and ADC with pull-down)
-        luminosity = 100.0f * static_cast<float>(adcValue) / ADC_MAX;
+        luminosity = 100.0f * adcValue / ADC_MAX;
     }
     
     // Clamp to 0-100 range
@@ -85,18 +64,4 @@ float Luminosity::adcToLuminosity(int adcValue)
     return luminosity;
 }
 
-float Luminosity::read()
-{
-    if (!_initialized)
-    {
-        return NAN;
-    }
-    
-    powerOn();
-    int adcValue = readAdc();
-    powerOff();
-    
-    return adcToLuminosity(adcValue);
-}
-
 }
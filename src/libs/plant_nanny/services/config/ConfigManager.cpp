@@ -8,6 +8,14 @@ namespace plant_nanny::services::config
 {
     static Preferences preferences;
 
+    namespace
+    {
+        // Keys used before sections were stored as versioned blobs
+        constexpr const char* LEGACY_KEYS[] = {
+            "wifi_ssid", "wifi_pass", "configured", "device_id",
+            "mqtt_host", "mqtt_port", "mqtt_user", "mqtt_pass"};
+    }
+
     ConfigManager::ConfigManager()
         : _initialized(false)
     {
@@ -28,23 +36,147 @@ namespace plant_nanny::services::config
         }
 
         _initialized = true;
+
+        loadSection(_device);
+        loadSection(_link);
+        loadSection(_network);
+        loadSection(_mqtt);
+        loadSection(_plant);
+        loadSection(_power);
+        loadSection(_dosing);
+        loadSection(_calibration);
+        loadSection(_rules);
+        migrateLegacyKeys();
+
         LOG_INFO("[CONFIG] Manager initialized");
         return common::patterns::Result<void>::success();
     }
 
-    common::patterns::Result<void> ConfigManager::factoryReset()
+    common::patterns::Result<void> ConfigManager::ensureInitialized()
     {
-        if (!_initialized)
+        if (_initialized)
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
+            return common::patterns::Result<void>::success();
+        }
+        return initialize();
+    }
+
+    template <typename Section>
+    void ConfigManager::loadSection(CachedSection<Section>& cache)
+    {
+        using Codec = SectionCodec<Section>;
+
+        uint8_t slotA[Codec::BLOB_SIZE];
+        uint8_t slotB[Codec::BLOB_SIZE];
+        size_t lengthA = preferences.isKey(Section::KEY_A) ? preferences.getBytes(Section::KEY_A, slotA, sizeof(slotA)) : 0;
+        size_t lengthB = preferences.isKey(Section::KEY_B) ? preferences.getBytes(Section::KEY_B, slotB, sizeof(slotB)) : 0;
+
+        cache = CachedSection<Section>{};
+        if (lengthA == 0 && lengthB == 0)
+        {
+            return;
+        }
+
+        auto loaded = Codec::select(slotA, lengthA, slotB, lengthB);
+        if (loaded.failed())
+        {
+            char msg[96];
+            snprintf(msg, sizeof(msg), "[CONFIG] Section %s unreadable, using defaults: %s",
+                     Section::KEY_A, loaded.error().message().c_str());
+            LOG_ERROR(msg);
+            return;
+        }
+
+        cache.data = loaded.value().data;
+        cache.sequence = loaded.value().sequence;
+        cache.slot = loaded.value().slot;
+        cache.stored = true;
+    }
+
+    template <typename Section>
+    common::patterns::Result<void> ConfigManager::storeSection(CachedSection<Section>& cache)
+    {
+        using Codec = SectionCodec<Section>;
+
+        // Always overwrite the older copy so the current one survives a torn write
+        Slot target = (cache.stored && cache.slot == Slot::A) ? Slot::B : Slot::A;
+        const char* key = target == Slot::A ? Section::KEY_A : Section::KEY_B;
+
+        uint8_t buffer[Codec::BLOB_SIZE];
+        size_t length = Codec::encode(cache.data, cache.sequence + 1, buffer, sizeof(buffer));
+        if (length == 0 || preferences.putBytes(key, buffer, length) != length)
+        {
+            return common::patterns::Result<void>::failure(
+                common::patterns::Error(std::string("Failed to write config section ") + key));
+        }
+
+        cache.sequence++;
+        cache.slot = target;
+        cache.stored = true;
+        return common::patterns::Result<void>::success();
+    }
+
+    void ConfigManager::migrateLegacyKeys()
+    {
+        bool hasLegacy = false;
+        for (const char* key : LEGACY_KEYS)
+        {
+            hasLegacy = hasLegacy || preferences.isKey(key);
+        }
+        if (!hasLegacy)
+        {
+            return;
+        }
+
+        LOG_INFO("[CONFIG] Migrating legacy per-key settings");
+
+        if (!_device.stored)
+        {
+            setField(_device.data.wifiSsid, preferences.getString("wifi_ssid", "").c_str());
+            setField(_device.data.wifiPassword, preferences.getString("wifi_pass", "").c_str());
+            setField(_device.data.deviceId, preferences.getString("device_id", "").c_str());
+            _device.data.configured = preferences.getBool("configured", false) ? 1 : 0;
+            storeSection(_device);
+        }
+
+        if (!_mqtt.stored)
+        {
+            setField(_mqtt.data.host, preferences.getString("mqtt_host", "").c_str());
+            setField(_mqtt.data.username, preferences.getString("mqtt_user", "").c_str());
+            setField(_mqtt.data.password, preferences.getString("mqtt_pass", "").c_str());
+            _mqtt.data.port = preferences.getUShort("mqtt_port", 1883);
+            storeSection(_mqtt);
+        }
+
+        if (_device.stored && _mqtt.stored)
+        {
+            for (const char* key : LEGACY_KEYS)
             {
-                return initResult;
+                preferences.remove(key);
             }
+            LOG_INFO("[CONFIG] Legacy settings migrated");
+        }
+    }
+
+    common::patterns::Result<void> ConfigManager::factoryReset()
+    {
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
+        {
+            return initResult;
         }
 
         LOG_INFO("[CONFIG] Performing factory reset...");
         preferences.clear();
+        _device = CachedSection<DeviceSection>{};
+        _link = CachedSection<LinkSection>{};
+        _network = CachedSection<NetworkSection>{};
+        _mqtt = CachedSection<MqttSection>{};
+        _plant = CachedSection<PlantSection>{};
+        _power = CachedSection<PowerSection>{};
+        _dosing = CachedSection<DosingSection>{};
+        _calibration = CachedSection<CalibrationSection>{};
+        _rules = CachedSection<RulesSection>{};
         LOG_INFO("[CONFIG] Factory reset complete");
         return common::patterns::Result<void>::success();
     }
@@ -53,175 +185,216 @@ namespace plant_nanny::services::config
         const std::string& ssid, 
         const std::string& password)
     {
-        if (!_initialized)
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
-            {
-                return initResult;
-            }
+            return initResult;
         }
 
-        preferences.putString("wifi_ssid", ssid.c_str());
-        preferences.putString("wifi_pass", password.c_str());
-        LOG_INFO("[CONFIG] WiFi credentials saved");
-        return common::patterns::Result<void>::success();
+        bool networkChanged = getField(_device.data.wifiSsid) != ssid;
+
+        setField(_device.data.wifiSsid, ssid);
+        setField(_device.data.wifiPassword, password);
+        auto result = storeSection(_device);
+        if (result.succeed())
+        {
+            LOG_INFO("[CONFIG] WiFi credentials saved");
+        }
+
+        // A cached BSSID/lease from another network would only slow the next connect
+        if (networkChanged && _link.data.cache.valid())
+        {
+            _link.data.cache = WifiLinkCache{};
+            storeSection(_link);
+        }
+        return result;
+    }
+
+    common::patterns::Result<void> ConfigManager::saveWifiLinkCache(const WifiLinkCache& cache)
+    {
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
+        {
+            return initResult;
+        }
+
+        // Only touch flash when the association actually changed
+        if (_link.stored && _link.data.cache == cache)
+        {
+            return common::patterns::Result<void>::success();
+        }
+
+        _link.data.cache = cache;
+        return storeSection(_link);
+    }
+
+    common::patterns::Result<WifiLinkCache> ConfigManager::getWifiLinkCache()
+    {
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
+        {
+            return common::patterns::Result<WifiLinkCache>::failure(initResult.error());
+        }
+
+        if (!_link.data.cache.valid())
+        {
+            return common::patterns::Result<WifiLinkCache>::failure(
+                common::patterns::Error("No cached WiFi link"));
+        }
+
+        return common::patterns::Result<WifiLinkCache>::success(_link.data.cache);
+    }
+
+    common::patterns::Result<void> ConfigManager::saveNetworkConfig(const NetworkConfig& config)
+    {
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
+        {
+            return initResult;
+        }
+
+        _network.data.network = config;
+        auto result = storeSection(_network);
+        if (result.succeed())
+        {
+            LOG_INFO("[CONFIG] Network config saved");
+        }
+        return result;
+    }
+
+    NetworkConfig ConfigManager::getNetworkConfig()
+    {
+        ensureInitialized();
+        return _network.data.network;
     }
 
     common::patterns::Result<std::string> ConfigManager::getWifiSsid()
     {
-        if (!_initialized)
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
-            {
-                return common::patterns::Result<std::string>::failure(initResult.error());
-            }
+            return common::patterns::Result<std::string>::failure(initResult.error());
         }
 
-        String ssid = preferences.getString("wifi_ssid", "");
-        if (ssid.length() == 0)
+        std::string ssid = getField(_device.data.wifiSsid);
+        if (ssid.empty())
         {
             return common::patterns::Result<std::string>::failure(
                 common::patterns::Error("WiFi SSID not configured"));
         }
 
-        return common::patterns::Result<std::string>::success(std::string(ssid.c_str()));
+        return common::patterns::Result<std::string>::success(ssid);
     }
 
     common::patterns::Result<std::string> ConfigManager::getWifiPassword()
     {
-        if (!_initialized)
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
-            {
-                return common::patterns::Result<std::string>::failure(initResult.error());
-            }
+            return common::patterns::Result<std::string>::failure(initResult.error());
         }
 
-        String password = preferences.getString("wifi_pass", "");
-        return common::patterns::Result<std::string>::success(std::string(password.c_str()));
+        return common::patterns::Result<std::string>::success(getField(_device.data.wifiPassword));
     }
 
     bool ConfigManager::isConfigured()
     {
-        if (!_initialized)
-        {
-            initialize();
-        }
-
-        return preferences.getBool("configured", false);
+        ensureInitialized();
+        return _device.data.configured != 0;
     }
 
     common::patterns::Result<void> ConfigManager::setConfigured(bool configured)
     {
-        if (!_initialized)
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
-            {
-                return initResult;
-            }
+            return initResult;
         }
 
-        preferences.putBool("configured", configured);
-        return common::patterns::Result<void>::success();
+        _device.data.configured = configured ? 1 : 0;
+        return storeSection(_device);
     }
 
     common::patterns::Result<void> ConfigManager::saveMqttConfig(const std::string& host, uint16_t port)
     {
-        if (!_initialized)
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
-            {
-                return initResult;
-            }
+            return initResult;
         }
 
-        preferences.putString("mqtt_host", host.c_str());
-        preferences.putUShort("mqtt_port", port);
-        LOG_INFO("[CONFIG] MQTT config saved");
-        return common::patterns::Result<void>::success();
+        setField(_mqtt.data.host, host);
+        _mqtt.data.port = port;
+        auto result = storeSection(_mqtt);
+        if (result.succeed())
+        {
+            LOG_INFO("[CONFIG] MQTT config saved");
+        }
+        return result;
     }
 
     common::patterns::Result<void> ConfigManager::saveMqttCredentials(const std::string& username, const std::string& password)
     {
-        if (!_initialized)
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
-            {
-                return initResult;
-            }
+            return initResult;
         }
 
-        preferences.putString("mqtt_user", username.c_str());
-        preferences.putString("mqtt_pass", password.c_str());
-        LOG_INFO("[CONFIG] MQTT credentials saved");
-        return common::patterns::Result<void>::success();
+        setField(_mqtt.data.username, username);
+        setField(_mqtt.data.password, password);
+        auto result = storeSection(_mqtt);
+        if (result.succeed())
+        {
+            LOG_INFO("[CONFIG] MQTT credentials saved");
+        }
+        return result;
     }
 
     common::patterns::Result<std::string> ConfigManager::getMqttHost()
     {
-        if (!_initialized)
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
-            {
-                return common::patterns::Result<std::string>::failure(initResult.error());
-            }
+            return common::patterns::Result<std::string>::failure(initResult.error());
         }
 
-        String host = preferences.getString("mqtt_host", "");
-        if (host.length() == 0)
+        std::string host = getField(_mqtt.data.host);
+        if (host.empty())
         {
             return common::patterns::Result<std::string>::failure(
                 common::patterns::Error("MQTT host not configured"));
         }
 
-        return common::patterns::Result<std::string>::success(std::string(host.c_str()));
+        return common::patterns::Result<std::string>::success(host);
     }
 
     uint16_t ConfigManager::getMqttPort()
     {
-        if (!_initialized)
-        {
-            initialize();
-        }
-
-        return preferences.getUShort("mqtt_port", 1883);
+        ensureInitialized();
+        return _mqtt.data.port;
     }
 
     common::patterns::Result<std::string> ConfigManager::getMqttUsername()
     {
-        if (!_initialized)
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
-            {
-                return common::patterns::Result<std::string>::failure(initResult.error());
-            }
+            return common::patterns::Result<std::string>::failure(initResult.error());
         }
 
-        String username = preferences.getString("mqtt_user", "");
-        return common::patterns::Result<std::string>::success(std::string(username.c_str()));
+        return common::patterns::Result<std::string>::success(getField(_mqtt.data.username));
     }
 
     common::patterns::Result<std::string> ConfigManager::getMqttPassword()
     {
-        if (!_initialized)
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
-            {
-                return common::patterns::Result<std::string>::failure(initResult.error());
-            }
+            return common::patterns::Result<std::string>::failure(initResult.error());
         }
 
-        String password = preferences.getString("mqtt_pass", "");
-        return common::patterns::Result<std::string>::success(std::string(password.c_str()));
+        return common::patterns::Result<std::string>::success(getField(_mqtt.data.password));
     }
 
     bool ConfigManager::isMqttConfigured()
@@ -230,30 +403,137 @@ namespace plant_nanny::services::config
         return hostResult.succeed() && !hostResult.value().empty();
     }
 
-    std::string ConfigManager::getDeviceId()
+    common::patterns::Result<void> ConfigManager::savePlantThresholds(const PlantThresholds& thresholds)
+    {
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
+        {
+            return initResult;
+        }
+
+        _plant.data.thresholds = thresholds;
+        auto result = storeSection(_plant);
+        if (result.succeed())
+        {
+            LOG_INFO("[CONFIG] Plant thresholds saved");
+        }
+        return result;
+    }
+
+    PlantThresholds ConfigManager::getPlantThresholds()
+    {
+        ensureInitialized();
+        return _plant.data.thresholds;
+    }
+
+    common::patterns::Result<void> ConfigManager::saveDutyCycleConfig(const DutyCycleConfig& config)
+    {
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
+        {
+            return initResult;
+        }
+
+        _power.data.dutyCycle = config;
+        auto result = storeSection(_power);
+        if (result.succeed())
+        {
+            LOG_INFO("[CONFIG] Duty cycle config saved");
+        }
+        return result;
+    }
+
+    DutyCycleConfig ConfigManager::getDutyCycleConfig()
+    {
+        ensureInitialized();
+        return _power.data.dutyCycle;
+    }
+
+    common::patterns::Result<void> ConfigManager::saveDosingConfig(const DosingConfig& config)
+    {
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
+        {
+            return initResult;
+        }
+
+        _dosing.data.dosing = config;
+        auto result = storeSection(_dosing);
+        if (result.succeed())
+        {
+            LOG_INFO("[CONFIG] Dosing config saved");
+        }
+        return result;
+    }
+
+    DosingConfig ConfigManager::getDosingConfig()
+    {
+        ensureInitialized();
+        return _dosing.data.dosing;
+    }
+
+    common::patterns::Result<void> ConfigManager::saveSensorCalibration(const SensorCalibration& calibration)
+    {
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
+        {
+            return initResult;
+        }
+
+        _calibration.data.calibration = calibration;
+        auto result = storeSection(_calibration);
+        if (result.succeed())
+        {
+            LOG_INFO("[CONFIG] Sensor calibration saved");
+        }
+        return result;
+    }
+
+    SensorCalibration ConfigManager::getSensorCalibration()
     {
-        if (!_initialized)
+        ensureInitialized();
+        return _calibration.data.calibration;
+    }
+
+    common::patterns::Result<void> ConfigManager::saveWateringRules(const WateringRules& rules)
+    {
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
+        {
+            return initResult;
+        }
+
+        _rules.data.rules = rules;
+        auto result = storeSection(_rules);
+        if (result.succeed())
         {
-            initialize();
+            LOG_INFO("[CONFIG] Watering rules saved");
         }
+        return result;
+    }
 
-        String deviceId = preferences.getString("device_id", "");
-        return std::string(deviceId.c_str());
+    WateringRules ConfigManager::getWateringRules()
+    {
+        ensureInitialized();
+        return _rules.data.rules;
+    }
+
+    std::string ConfigManager::getDeviceId()
+    {
+        ensureInitialized();
+        return getField(_device.data.deviceId);
     }
 
     common::patterns::Result<void> ConfigManager::setDeviceId(const std::string& deviceId)
     {
-        if (!_initialized)
+        auto initResult = ensureInitialized();
+        if (!initResult.succeed())
         {
-            auto initResult = initialize();
-            if (!initResult.succeed())
-            {
-                return initResult;
-            }
+            return initResult;
         }
 
-        preferences.putString("device_id", deviceId.c_str());
-        return common::patterns::Result<void>::success();
+        setField(_device.data.deviceId, deviceId);
+        return storeSection(_device);
     }
 
     std::string ConfigManager::generateUUID()
@@ -0,0 +1,70 @@
+#include "libs/plant_nanny/services/config/ConfigSchema.h"
+#include "libs/common/utils/Crc.h"
+
+namespace plant_nanny::services::config
+{
+    namespace
+    {
+        uint32_t computeCrc(BlobHeader header, const uint8_t *payload)
+        {
+            header.crc = 0;
+            uint32_t crc = common::utils::Crc32::compute(&header, sizeof(header));
+            return common::utils::Crc32::compute(payload, header.length, crc);
+        }
+    }
+
+    size_t BlobCodec::encode(uint16_t version, uint32_t sequence,
+                             const void *payload, uint16_t length,
+                             uint8_t *out, size_t capacity)
+    {
+        if (out == nullptr || capacity < HEADER_SIZE + length)
+        {
+            return 0;
+        }
+
+        BlobHeader header;
+        header.magic = MAGIC;
+        header.version = version;
+        header.length = length;
+        header.sequence = sequence;
+
+        std::memcpy(out + HEADER_SIZE, payload, length);
+        header.crc = computeCrc(header, out + HEADER_SIZE);
+        std::memcpy(out, &header, HEADER_SIZE);
+
+        return HEADER_SIZE + length;
+    }
+
+    common::patterns::Result<BlobHeader> BlobCodec::decode(const uint8_t *data, size_t length)
+    {
+        if (data == nullptr || length < HEADER_SIZE)
+        {
+            return common::patterns::Result<BlobHeader>::failure(
+                common::patterns::Error("Config blob too short"));
+        }
+
+        BlobHeader header;
+        std::memcpy(&header, data, HEADER_SIZE);
+
+        if (header.magic != MAGIC)
+        {
+            return common::patterns::Result<BlobHeader>::failure(
+                common::patterns::Error("Config blob has bad magic"));
+        }
+
+        if (HEADER_SIZE + header.length > length)
+        {
+            return common::patterns::Result<BlobHeader>::failure(
+                common::patterns::Error("Config blob truncated"));
+        }
+
+        if (computeCrc(header, data + HEADER_SIZE) != header.crc)
+        {
+            return common::patterns::Result<BlobHeader>::failure(
+                common::patterns::Error("Config blob CRC mismatch"));
+        }
+
+        return common::patterns::Result<BlobHeader>::success(header);
+    }
+
+} // namespace plant_nanny::services::config
@@ -0,0 +1,240 @@
+#include "libs/plant_nanny/services/health/HealthMonitor.h"
+#include <cstdio>
+
+namespace plant_nanny::services::health
+{
+    const char *to_string(WatchedTask task)
+    {
+        switch (task)
+        {
+        case WatchedTask::Control:
+            return "control";
+        case WatchedTask::EventLoop:
+            return "app_loop";
+        case WatchedTask::Network:
+            return "network";
+        default:
+            return "unknown";
+        }
+    }
+
+    const char *to_string(HealthLevel level)
+    {
+        switch (level)
+        {
+        case HealthLevel::Ok:
+            return "ok";
+        case HealthLevel::Warning:
+            return "warning";
+        case HealthLevel::Critical:
+            return "critical";
+        default:
+            return "unknown";
+        }
+    }
+
+    namespace
+    {
+        void raise(HealthReport &report, HealthLevel level, uint8_t flag)
+        {
+            if (level > report.level)
+            {
+                report.level = level;
+            }
+            report.flags |= flag;
+        }
+    }
+
+    HealthMonitor::HealthMonitor(const HealthThresholds &thresholds)
+        : _thresholds(thresholds)
+    {
+    }
+
+    void HealthMonitor::addTrendPoint(uint32_t timeSec, uint32_t freeBytes)
+    {
+        if (_trendCount > 0)
+        {
+            size_t last = (_trendNext + TREND_POINTS - 1) % TREND_POINTS;
+            if (timeSec - _trendTimes[last] < _thresholds.trendIntervalSec)
+            {
+                return;
+            }
+        }
+        _trendTimes[_trendNext] = timeSec;
+        _trendFree[_trendNext] = freeBytes;
+        _trendNext = (_trendNext + 1) % TREND_POINTS;
+        if (_trendCount < TREND_POINTS)
+        {
+            _trendCount++;
+        }
+    }
+
+    int32_t HealthMonitor::trendBytesPerHour() const
+    {
+        // Least squares over the window; times relative to the oldest point
+        size_t oldest = (_trendNext + TREND_POINTS - _trendCount) % TREND_POINTS;
+        double n = static_cast<double>(_trendCount);
+        double sumX = 0, sumY = 0, sumXY = 0, sumXX = 0;
+        for (size_t i = 0; i < _trendCount; i++)
+        {
+            size_t index = (oldest + i) % TREND_POINTS;
+            double x = static_cast<double>(_trendTimes[index] - _trendTimes[oldest]);
+            double y = static_cast<double>(_trendFree[index]);
+            sumX += x;
+            sumY += y;
+            sumXY += x * y;
+            sumXX += x * x;
+        }
+        double denominator = n * sumXX - sumX * sumX;
+        if (denominator <= 0)
+        {
+            return 0;
+        }
+        double perHour = (n * sumXY - sumX * sumY) / denominator * 3600.0;
+        if (perHour > INT32_MAX)
+        {
+            return INT32_MAX;
+        }
+        if (perHour < INT32_MIN)
+        {
+            return INT32_MIN;
+        }
+        return static_cast<int32_t>(perHour);
+    }
+
+    const HealthReport &HealthMonitor::update(const HealthSample &sample)
+    {
+        HealthReport report;
+
+        if (sample.largestBlockBytes < sample.freeBytes)
+        {
+            report.fragmentationPct = static_cast<uint8_t>(
+                100 - static_cast<uint64_t>(sample.largestBlockBytes) * 100 / sample.freeBytes);
+        }
+
+        if (sample.freeBytes < _thresholds.freeCriticalBytes)
+        {
+            raise(report, HealthLevel::Critical, flags::LOW_HEAP);
+        }
+        else if (sample.freeBytes < _thresholds.freeWarnBytes)
+        {
+            raise(report, HealthLevel::Warning, flags::LOW_HEAP);
+        }
+
+        // Enough free heap is useless if no single allocation fits
+        if (sample.largestBlockBytes < _thresholds.largestBlockCriticalBytes)
+        {
+            raise(report, HealthLevel::Critical, flags::FRAGMENTED);
+        }
+        else if (sample.largestBlockBytes < _thresholds.largestBlockWarnBytes)
+        {
+            raise(report, HealthLevel::Warning, flags::FRAGMENTED);
+        }
+
+        uint32_t tightest = HealthSample::UNKNOWN;
+        for (size_t i = 0; i < WATCHED_TASK_COUNT; i++)
+        {
+            if (sample.stackFreeBytes[i] < tightest)
+            {
+                tightest = sample.stackFreeBytes[i];
+                report.tightestStack = static_cast<WatchedTask>(i);
+            }
+        }
+        if (tightest < _thresholds.stackCriticalBytes)
+        {
+            raise(report, HealthLevel::Critical, flags::LOW_STACK);
+        }
+        else if (tightest < _thresholds.stackWarnBytes)
+        {
+            raise(report, HealthLevel::Warning, flags::LOW_STACK);
+        }
+
+        addTrendPoint(sample.timeSec, sample.freeBytes);
+        report.trendValid = _trendCount == TREND_POINTS;
+        if (report.trendValid)
+        {
+            report.trendBytesPerHour = trendBytesPerHour();
+            if (report.trendBytesPerHour < -_thresholds.leakWarnBytesPerHour)
+            {
+                raise(report, HealthLevel::Warning, flags::LEAKING);
+            }
+        }
+
+        if (report.level == HealthLevel::Critical)
+        {
+            if (_criticalStreak < UINT8_MAX)
+            {
+                _criticalStreak++;
+            }
+        }
+        else
+        {
+            _criticalStreak = 0;
+        }
+        report.restartDue = _thresholds.restartWhenCritical &&
+                            _criticalStreak >= _thresholds.criticalSamplesBeforeRestart;
+
+        _report = report;
+        return _report;
+    }
+
+    size_t toJson(const HealthSample &sample, const HealthReport &report, char *buffer, size_t capacity)
+    {
+        static constexpr struct
+        {
+            uint8_t flag;
+            const char *name;
+        } FLAG_NAMES[] = {
+            {flags::LOW_HEAP, "low_heap"},
+            {flags::FRAGMENTED, "fragmented"},
+            {flags::LEAKING, "leaking"},
+            {flags::LOW_STACK, "low_stack"},
+        };
+
+        char flagList[64] = "";
+        size_t flagLength = 0;
+        for (const auto &entry : FLAG_NAMES)
+        {
+            if ((report.flags & entry.flag) != 0)
+            {
+                flagLength += snprintf(flagList + flagLength, sizeof(flagList) - flagLength, "%s\"%s\"",
+                                       flagLength > 0 ? "," : "", entry.name);
+            }
+        }
+
+        // -1: stack not known (task not started)
+        long stacks[WATCHED_TASK_COUNT];
+        for (size_t i = 0; i < WATCHED_TASK_COUNT; i++)
+        {
+            stacks[i] = sample.stackFreeBytes[i] == HealthSample::UNKNOWN ? -1 : static_cast<long>(sample.stackFreeBytes[i]);
+        }
+
+        // null until the trend window is full
+        char trend[16] = "null";
+        if (report.trendValid)
+        {
+            snprintf(trend, sizeof(trend), "%ld", static_cast<long>(report.trendBytesPerHour));
+        }
+
+        int length = snprintf(buffer, capacity,
+                              "{\"type\":\"health\",\"level\":\"%s\",\"flags\":[%s],\"free\":%lu,"
+                              "\"largestBlock\":%lu,\"minFree\":%lu,\"fragPct\":%u,\"trendBph\":%s,"
+                              "\"stack\":{\"%s\":%ld,\"%s\":%ld,\"%s\":%ld},\"restart\":%s}",
+                              to_string(report.level), flagList,
+                              static_cast<unsigned long>(sample.freeBytes),
+                              static_cast<unsigned long>(sample.largestBlockBytes),
+                              static_cast<unsigned long>(sample.minFreeBytes),
+                              static_cast<unsigned>(report.fragmentationPct),
+                              trend,
+                              to_string(WatchedTask::Control), stacks[0],
+                              to_string(WatchedTask::EventLoop), stacks[1],
+                              to_string(WatchedTask::Network), stacks[2],
+                              report.restartDue ? "true" : "false");
+        if (length < 0 || static_cast<size_t>(length) >= capacity)
+        {
+            return 0;
+        }
+        return static_cast<size_t>(length);
+    }
+
+} // namespace plant_nanny::services::health
@@ -1,9 +1,97 @@
 #include "libs/plant_nanny/services/mqtt/MQTTService.h"
 #include "libs/common/logger/Log.h"
+#include "libs/plant_nanny/metrics/FirmwareMetrics.h"
 #include <Arduino.h>
 #include <ArduinoJson.h>
+#include <WiFi.h>
 
 namespace plant_nanny::services::mqtt {
+namespace {
+// Returns nullptr when the manifest is usable, else what is wrong with it
+const char *parse_ota_manifest(const JsonDocument &doc,
+                               ota::Manifest &manifest) {
+  using common::utils::Sha256;
+
+  manifest.url = doc["url"] | "";
+  manifest.window_bits = doc["window"] | manifest.window_bits;
+  manifest.lookahead_bits = doc["lookahead"] | manifest.lookahead_bits;
+  // Refuse up front rather than download an image esp_ota_end rejects
+  if (!ota::parse_compression(doc["compression"] | "", manifest.compression)) {
+    return "unsupported compression";
+  }
+
+  const char *sha256 = doc["sha256"] | "";
+  if (sha256[0] != '\0') {
+    Sha256::Digest digest;
+    if (!Sha256::from_hex(sha256, digest)) {
+      return "malformed sha256";
+    }
+    manifest.sha256 = digest;
+  }
+
+  JsonObjectConst delta = doc["delta"];
+  if (!delta.isNull()) {
+    manifest.delta = true;
+    manifest.source_size = delta["source_size"] | 0u;
+    if (manifest.source_size == 0 ||
+        !Sha256::from_hex(delta["source_sha256"] | "",
+                          manifest.source_sha256)) {
+      return "malformed delta source";
+    }
+    if (!manifest.sha256) {
+      return "delta without sha256";
+    }
+  }
+  return nullptr;
+}
+
+// Shape only; channel keys and bounds are checked by RuleEngine::validate
+const char *parse_rules(const JsonDocument &doc, config::WateringRules &rules) {
+  JsonArrayConst list = doc["rules"];
+  if (list.isNull()) {
+    return "missing rules";
+  }
+  if (list.size() > config::WateringRules::MAX_RULES) {
+    return "too many rules";
+  }
+
+  rules = config::WateringRules{};
+  for (JsonObjectConst item : list) {
+    config::WateringRule &rule = rules.rules[rules.count++];
+    // Out of range on purpose when missing or too large, validate rejects 0
+    uint32_t waterMl = item["waterMl"] | 0u;
+    rule.waterAmountMl = waterMl > UINT16_MAX ? 0 : waterMl;
+    rule.minCycleSec = item["minCycleSec"] | rule.minCycleSec;
+
+    JsonArrayConst when = item["when"];
+    if (when.isNull() || when.size() == 0 ||
+        when.size() > config::WateringRule::MAX_CONDITIONS) {
+      return "rule needs 1 to 3 conditions";
+    }
+    for (JsonObjectConst test : when) {
+      config::RuleCondition &condition =
+          rule.conditions[rule.conditionCount++];
+      const char *channel = test["channel"] | "";
+      if (strlen(channel) >= sizeof(condition.channel)) {
+        return "channel key too long";
+      }
+      strcpy(condition.channel, channel);
+      condition.hysteresis = test["hysteresis"] | 0.0f;
+      if (test["below"].is<float>()) {
+        condition.comparison = config::RuleComparison::Below;
+        condition.threshold = test["below"].as<float>();
+      } else if (test["above"].is<float>()) {
+        condition.comparison = config::RuleComparison::Above;
+        condition.threshold = test["above"].as<float>();
+      } else {
+        return "condition needs below or above";
+      }
+    }
+  }
+  return nullptr;
+}
+} // namespace
+
 // Static instance for callback wrapper
 MQTTService *MQTTService::instance_ = nullptr;
 
@@ -51,7 +139,7 @@ MQTTService::initialize(const std::string &device_id,
   mqtt_client_.setKeepAlive(60);
   mqtt_client_.setSocketTimeout(MQTT_TIMEOUT_MS / 1000);
   mqtt_client_.setCallback(mqtt_callback_wrapper);
-  mqtt_client_.setBufferSize(512);
+  mqtt_client_.setBufferSize(MQTT_BUFFER_SIZE);
 
   initialized_ = true;
 
@@ -78,6 +166,10 @@ void MQTTService::set_command_callback(CommandCallback callback) {
   command_callback_ = callback;
 }
 
+void MQTTService::set_channels(const captors::SensorChannels &channels) {
+  channels_ = &channels;
+}
+
 void MQTTService::set_publish_interval(unsigned long interval_ms) {
   publish_interval_ms_ = (interval_ms < 1000) ? 1000 : interval_ms;
 }
@@ -114,6 +206,28 @@ std::string MQTTService::build_status_topic() const {
   return "devices/" + device_id_ + "/status";
 }
 
+std::string MQTTService::build_diag_topic() const {
+  return "devices/" + device_id_ + "/diag";
+}
+
+std::string MQTTService::build_channels_topic() const {
+  return "devices/" + device_id_ + "/channels";
+}
+
+std::string MQTTService::build_metrics_topic() const {
+  return "devices/" + device_id_ + "/metrics";
+}
+
+bool MQTTService::publish_payload(const std::string &topic,
+                                  const char *payload, size_t length) {
+  uint32_t start = micros();
+  bool sent = mqtt_client_.publish(
+      topic.c_str(), reinterpret_cast<const uint8_t *>(payload), length, false);
+  metrics::mqttPublishUs.record(micros() - start);
+  (sent ? metrics::mqttPublished : metrics::mqttPublishFailures).increment();
+  return sent;
+}
+
 void MQTTService::subscribe_to_commands() {
   std::string command_topic = build_command_topic();
 
@@ -149,6 +263,7 @@ void MQTTService::handle_message(char *topic, byte *payload,
   if (cmd.type == CommandType::Unknown) {
     return;
   }
+  metrics::mqttCommands.increment();
 
   // Handle SendNow directly - force immediate sensor reading
   if (cmd.type == CommandType::SendNow) {
@@ -189,6 +304,7 @@ Command MQTTService::parse_command(const char *payload, unsigned int length) {
     cmd.type = CommandType::PumpWater;
     cmd.durationMs = doc["durationMs"] | 0;
     cmd.amountMl = doc["amountMl"] | 0;
+    cmd.targetPct = doc["targetPct"] | NAN;
 
     char msg[64];
     snprintf(msg, sizeof(msg),
@@ -206,13 +322,80 @@ Command MQTTService::parse_command(const char *payload, unsigned int length) {
 
     // Apply interval change directly
     set_publish_interval(cmd.intervalMs);
+  } else if (strcmp(action, "set_power_mode") == 0) {
+    cmd.type = CommandType::SetPowerMode;
+    cmd.lowPower = doc["lowPower"] | false;
+    cmd.sleepSec = doc["sleepSec"] | 0;
+    cmd.uploadEvery = doc["uploadEvery"] | 0;
+
+    char msg[80];
+    snprintf(msg, sizeof(msg),
+             "[MQTT] Received command: set_power_mode (%s, %ds, every %d)",
+             cmd.lowPower ? "low power" : "always on", cmd.sleepSec,
+             cmd.uploadEvery);
+    LOG_INFO(msg);
+  } else if (strcmp(action, "set_dosing") == 0) {
+    cmd.type = CommandType::SetDosing;
+    cmd.flowMlPerSec = doc["flowMlPerSec"] | 0.0f;
+    cmd.measuredMl = doc["measuredMl"] | 0.0f;
+    cmd.durationMs = doc["durationMs"] | 0;
+    cmd.pulseMl = doc["pulseMl"] | 0;
+    cmd.soakSec = doc["soakSec"] | 0;
+    LOG_INFO("[MQTT] Received command: set_dosing");
+  } else if (strcmp(action, "set_network") == 0) {
+    cmd.type = CommandType::SetNetwork;
+    cmd.reuseLease = doc["reuseLease"] | true;
+    LOG_INFO("[MQTT] Received command: set_network");
   } else if (strcmp(action, "restart") == 0) {
     cmd.type = CommandType::Restart;
     LOG_INFO("[MQTT] Received command: restart");
+  } else if (strcmp(action, "get_state_trace") == 0) {
+    cmd.type = CommandType::GetStateTrace;
+    LOG_INFO("[MQTT] Received command: get_state_trace");
+  } else if (strcmp(action, "get_metrics") == 0) {
+    cmd.type = CommandType::GetMetrics;
+    LOG_INFO("[MQTT] Received command: get_metrics");
+  } else if (strcmp(action, "calibrate") == 0) {
+    cmd.type = CommandType::Calibrate;
+    const char *sensor = doc["sensor"] | "";
+    const char *point = doc["point"] | "";
+    char msg[80];
+    if (captors::calibration::parse(sensor, point, cmd.calibration)) {
+      snprintf(msg, sizeof(msg), "[MQTT] Received command: calibrate (%s %s)",
+               sensor, point);
+      LOG_INFO(msg);
+    } else {
+      cmd.type = CommandType::Unknown;
+      snprintf(msg, sizeof(msg), "[MQTT] Rejected calibrate: %s %s", sensor,
+               point);
+      LOG_ERROR(msg);
+    }
+  } else if (strcmp(action, "set_rules") == 0) {
+    cmd.type = CommandType::SetRules;
+    const char *problem = parse_rules(doc, cmd.rules);
+    char msg[80];
+    if (problem != nullptr) {
+      cmd.type = CommandType::Unknown;
+      snprintf(msg, sizeof(msg), "[MQTT] Rejected set_rules: %s", problem);
+      LOG_ERROR(msg);
+    } else {
+      snprintf(msg, sizeof(msg), "[MQTT] Received command: set_rules (%u)",
+               static_cast<unsigned>(cmd.rules.count));
+      LOG_INFO(msg);
+    }
   } else if (strcmp(action, "ota_update") == 0) {
     cmd.type = CommandType::OtaUpdate;
-    cmd.otaUrl = doc["url"] | "";
-    LOG_INFO("[MQTT] Received command: ota_update");
+    const char *problem = parse_ota_manifest(doc, cmd.otaManifest);
+    if (problem != nullptr) {
+      cmd.type = CommandType::Unknown;
+      char msg[80];
+      snprintf(msg, sizeof(msg), "[MQTT] Rejected ota_update: %s", problem);
+      LOG_ERROR(msg);
+    } else {
+      LOG_INFO(cmd.otaManifest.delta
+                   ? "[MQTT] Received command: ota_update (delta)"
+                   : "[MQTT] Received command: ota_update");
+    }
   } else {
     char msg[64];
     snprintf(msg, sizeof(msg), "[MQTT] Unknown command action: %s", action);
@@ -252,11 +435,14 @@ bool MQTTService::attempt_connect() {
   }
 
   if (connected) {
+    metrics::mqttConnects.increment();
     LOG_INFO("[MQTT] Connected to broker");
     publish_status("online");
+    publish_channels();
     subscribe_to_commands();
     return true;
   } else {
+    metrics::mqttConnectFailures.increment();
     char error_msg[64];
     snprintf(error_msg, sizeof(error_msg), "[MQTT] Connection failed, rc=%d",
              mqtt_client_.state());
@@ -301,6 +487,26 @@ void MQTTService::publish_status(const char *status) {
   mqtt_client_.publish(topic.c_str(), payload, true);
 }
 
+void MQTTService::publish_channels() {
+  // Retained so the server knows how to store and display the data fields
+  StaticJsonDocument<768> doc;
+  JsonArray list = doc["channels"].to<JsonArray>();
+  for (size_t i = 0; i < channels_->size(); i++) {
+    const captors::ChannelInfo &info = (*channels_)[i];
+    JsonObject entry = list.add<JsonObject>();
+    entry["key"] = info.key;
+    entry["name"] = info.name;
+    entry["unit"] = info.unit;
+    entry["decimals"] = info.decimals;
+  }
+
+  char payload[640];
+  size_t len = serializeJson(doc, payload, sizeof(payload));
+  std::string topic = build_channels_topic();
+  mqtt_client_.publish(topic.c_str(),
+                       reinterpret_cast<const uint8_t *>(payload), len, true);
+}
+
 common::patterns::Result<void>
 MQTTService::publish_reading(const SensorReading &reading) {
   if (!is_connected()) {
@@ -308,21 +514,23 @@ MQTTService::publish_reading(const SensorReading &reading) {
         common::patterns::Error("Not connected to MQTT broker"));
   }
 
-  StaticJsonDocument<256> doc;
-  doc["temperatureC"] = reading.temperatureC;
-  doc["humidityPct"] = reading.humidityPct;
-  doc["luminosityPct"] = reading.luminosityPct;
-  doc["ts"] = static_cast<unsigned long>(time(nullptr));
+  StaticJsonDocument<384> doc;
+  for (size_t i = 0; i < channels_->size(); i++) {
+    doc[(*channels_)[i].key] = reading.readings.get(static_cast<int>(i));
+  }
+  // No ts rather than a 1970 one: the server then falls back to arrival time
+  if (reading.timestamp != 0) {
+    doc["ts"] = reading.timestamp;
+  }
   doc["uptime"] = millis() / 1000;
+  if (reading.ageSec > 0) {
+    doc["age"] = reading.ageSec;
+  }
 
-  char payload[256];
+  char payload[384];
   size_t len = serializeJson(doc, payload, sizeof(payload));
 
-  std::string topic = build_data_topic();
-
-  if (mqtt_client_.publish(topic.c_str(),
-                           reinterpret_cast<const uint8_t *>(payload), len,
-                           false)) {
+  if (publish_payload(build_data_topic(), payload, len)) {
     LOG_INFO("[MQTT] Sensor reading published");
     return common::patterns::Result<void>::success();
   }
@@ -331,6 +539,36 @@ MQTTService::publish_reading(const SensorReading &reading) {
       common::patterns::Error("Failed to publish sensor reading"));
 }
 
+common::patterns::Result<void>
+MQTTService::publish_diagnostics(const char *json, size_t length) {
+  if (!is_connected()) {
+    return common::patterns::Result<void>::failure(
+        common::patterns::Error("Not connected to MQTT broker"));
+  }
+
+  if (publish_payload(build_diag_topic(), json, length)) {
+    return common::patterns::Result<void>::success();
+  }
+
+  return common::patterns::Result<void>::failure(
+      common::patterns::Error("Failed to publish diagnostics"));
+}
+
+common::patterns::Result<void>
+MQTTService::publish_metrics(const char *json, size_t length) {
+  if (!is_connected()) {
+    return common::patterns::Result<void>::failure(
+        common::patterns::Error("Not connected to MQTT broker"));
+  }
+
+  if (publish_payload(build_metrics_topic(), json, length)) {
+    return common::patterns::Result<void>::success();
+  }
+
+  return common::patterns::Result<void>::failure(
+      common::patterns::Error("Failed to publish metrics"));
+}
+
 void MQTTService::force_send_reading() {
   if (reading_callback_) {
     LOG_INFO("[MQTT] Force sending sensor reading");
@@ -348,6 +586,10 @@ void MQTTService::update() {
   uint32_t now = millis();
 
   if (!is_connected()) {
+    // A broker connect blocks on the TCP timeout; pointless without a link
+    if (WiFi.status() != WL_CONNECTED) {
+      return;
+    }
     if (now - last_reconnect_attempt_ >= RECONNECT_INTERVAL_MS) {
       last_reconnect_attempt_ = now;
       attempt_connect();
@@ -1,15 +1,19 @@
 #include "libs/plant_nanny/services/mqtt/MqttCommandHandler.h"
 #include "libs/plant_nanny/services/mqtt/MQTTService.h"
-#include "libs/plant_nanny/services/pump/IPump.h"
+#include "libs/plant_nanny/services/pump/IDoser.h"
+#include "libs/plant_nanny/services/pump/Pump.h"
+#include "libs/plant_nanny/services/config/IConfigManager.h"
+#include "libs/plant_nanny/services/power/DutyCycle.h"
 #include "libs/common/logger/Log.h"
 #include <Arduino.h>
+#include <algorithm>
 #include "libs/common/service/Accessor.h"
 
 namespace plant_nanny::services::mqtt
 {
 
 MqttCommandHandler::MqttCommandHandler()
-    : _pump(&common::service::get<pump::IPump>().get())
+    : _doser(&common::service::get<pump::IDoser>().get())
 {
 }
 
@@ -18,15 +22,16 @@ void MqttCommandHandler::handle(const Command& cmd)
     switch (cmd.type)
     {
         case CommandType::OtaUpdate:
-            if (!cmd.otaUrl.empty())
+            if (!cmd.otaManifest.url.empty())
             {
-                char msg[128];
-                snprintf(msg, sizeof(msg), "[MQTT_CMD] OTA command received: %s", cmd.otaUrl.c_str());
+                char msg[160];
+                snprintf(msg, sizeof(msg), "[MQTT_CMD] OTA command received: %s (%s)",
+                         cmd.otaManifest.url.c_str(), ota::to_string(cmd.otaManifest.compression));
                 LOG_INFO(msg);
                 
                 if (_otaCallback)
                 {
-                    _otaCallback(cmd.otaUrl);
+                    _otaCallback(cmd.otaManifest);
                 }
             }
             break;
@@ -39,21 +44,107 @@ void MqttCommandHandler::handle(const Command& cmd)
             
         case CommandType::PumpWater:
             {
-                char msg[64];
-                snprintf(msg, sizeof(msg), "[MQTT_CMD] Pump water command received (%dms)", cmd.durationMs);
+                pump::DoseRequest request;
+                request.durationMs = cmd.durationMs > 0 ? static_cast<uint32_t>(cmd.durationMs) : 0;
+                request.amountMl = cmd.amountMl > 0 ? static_cast<uint16_t>(std::min(cmd.amountMl, UINT16_MAX)) : 0;
+                request.targetPct = cmd.targetPct;
+                if (request.durationMs == 0 && request.amountMl == 0)
+                {
+                    request.durationMs = DEFAULT_WATERING_MS;
+                }
+
+                char msg[96];
+                snprintf(msg, sizeof(msg), "[MQTT_CMD] Pump water command received (%lums, %uml)",
+                         static_cast<unsigned long>(request.durationMs), static_cast<unsigned>(request.amountMl));
                 LOG_INFO(msg);
-                
-                if (_pump)
+
+                // Runs on the control task through IDoser::update()
+                auto result = _doser->start(request);
+                if (result.failed())
                 {
-                    _pump->activate();
-                    delay(cmd.durationMs > 0 ? cmd.durationMs : 5000);
-                    _pump->deactivate();
+                    snprintf(msg, sizeof(msg), "[MQTT_CMD] Watering refused: %s", result.error().message().c_str());
+                    LOG_ERROR(msg);
                 }
-                
-                LOG_INFO("[MQTT_CMD] Pump water completed");
             }
             break;
-            
+
+        case CommandType::SetDosing:
+            {
+                auto configManager = common::service::get<config::IConfigManager>();
+                config::DosingConfig dosing = configManager->getDosingConfig();
+                if (cmd.flowMlPerSec > 0.0f)
+                {
+                    dosing.flowMlPerSec = cmd.flowMlPerSec;
+                }
+                else if (cmd.measuredMl > 0.0f && cmd.durationMs > 0)
+                {
+                    // Timed pump_water run whose output was measured in a jug
+                    float flow = pump::DosingController::flowFromRun(cmd.measuredMl, cmd.durationMs,
+                                                                     pump::Pump::SOFT_START_MS);
+                    if (flow <= 0.0f)
+                    {
+                        LOG_ERROR("[MQTT_CMD] Pump calibration rejected: run too short");
+                        break;
+                    }
+                    dosing.flowMlPerSec = flow;
+                }
+                if (cmd.pulseMl > 0)
+                {
+                    dosing.pulseMl = static_cast<uint16_t>(std::min(cmd.pulseMl, UINT16_MAX));
+                }
+                if (cmd.soakSec > 0)
+                {
+                    dosing.soakSec = static_cast<uint32_t>(cmd.soakSec);
+                }
+                configManager->saveDosingConfig(dosing);
+                _doser->configure(dosing);
+
+                char msg[96];
+                snprintf(msg, sizeof(msg), "[MQTT_CMD] Dosing: %.1f ml/s, %u ml pulses, %lus soak",
+                         dosing.flowMlPerSec, static_cast<unsigned>(dosing.pulseMl),
+                         static_cast<unsigned long>(dosing.soakSec));
+                LOG_INFO(msg);
+            }
+            break;
+
+        case CommandType::SetPowerMode:
+            {
+                auto configManager = common::service::get<config::IConfigManager>();
+                config::DutyCycleConfig dutyCycle = configManager->getDutyCycleConfig();
+                dutyCycle.enabled = cmd.lowPower;
+                if (cmd.sleepSec > 0)
+                {
+                    dutyCycle.sleepIntervalSec = static_cast<uint32_t>(cmd.sleepSec);
+                }
+                if (cmd.uploadEvery > 0)
+                {
+                    dutyCycle.uploadEveryWakes = static_cast<uint16_t>(cmd.uploadEvery);
+                }
+                configManager->saveDutyCycleConfig(dutyCycle);
+
+                auto estimate = power::EnergyModel::estimate(dutyCycle);
+                char msg[128];
+                snprintf(msg, sizeof(msg),
+                         "[MQTT_CMD] Power mode: %s (est. %.2f mA, %.1f uploads/h)",
+                         dutyCycle.enabled ? "duty cycle" : "always on",
+                         dutyCycle.enabled ? estimate.averageCurrentMa : estimate.alwaysOnCurrentMa,
+                         estimate.uploadsPerHour);
+                LOG_INFO(msg);
+            }
+            break;
+
+        case CommandType::SetNetwork:
+            {
+                // Read on the next connect, so nothing to restart
+                auto configManager = common::service::get<config::IConfigManager>();
+                config::NetworkConfig network = configManager->getNetworkConfig();
+                network.reuseIpLease = cmd.reuseLease;
+                configManager->saveNetworkConfig(network);
+                LOG_INFO(network.reuseIpLease ? "[MQTT_CMD] IP lease reuse enabled"
+                                              : "[MQTT_CMD] IP lease reuse disabled");
+            }
+            break;
+
         default:
             break;
     }
@@ -0,0 +1,171 @@
+#include "libs/plant_nanny/services/network/ConnectionStateMachine.h"
+
+namespace plant_nanny::services::network
+{
+    ConnectionStateMachine::ConnectionStateMachine(BackoffPolicy policy, RandomSource random)
+        : _policy(policy), _random(std::move(random))
+    {
+    }
+
+    void ConnectionStateMachine::setEnabled(bool enabled)
+    {
+        _enabled = enabled;
+        if (!enabled)
+        {
+            bool wasConnected = _state == ConnectionState::Connected;
+            _state = ConnectionState::Idle;
+            _failures = 0;
+            if (wasConnected && _callback)
+            {
+                _callback(false);
+            }
+        }
+    }
+
+    void ConnectionStateMachine::retryNow(uint32_t now)
+    {
+        if (_state == ConnectionState::Backoff)
+        {
+            _retryAt = now;
+        }
+    }
+
+    void ConnectionStateMachine::enter(ConnectionState state, uint32_t now)
+    {
+        ConnectionState previous = _state;
+        _state = state;
+        _stateSince = now;
+
+        if (!_callback)
+        {
+            return;
+        }
+        if (state == ConnectionState::Connected)
+        {
+            _callback(true);
+        }
+        else if (previous == ConnectionState::Connected)
+        {
+            _callback(false);
+        }
+    }
+
+    uint32_t ConnectionStateMachine::baseDelayMs(uint32_t failures) const
+    {
+        uint32_t delay = _policy.initialDelayMs;
+        for (uint32_t i = 1; i < failures && delay < _policy.maxDelayMs; i++)
+        {
+            delay *= 2;
+        }
+        return delay < _policy.maxDelayMs ? delay : _policy.maxDelayMs;
+    }
+
+    void ConnectionStateMachine::scheduleRetry(uint32_t now)
+    {
+        uint32_t delay = baseDelayMs(_failures);
+
+        if (_random && _policy.jitterPct > 0)
+        {
+            uint32_t spread = delay * _policy.jitterPct / 100;
+            if (spread > 0)
+            {
+                // Uniform in [delay - spread, delay + spread]
+                delay = delay - spread + (_random() % (2 * spread + 1));
+            }
+        }
+
+        _retryAt = now + delay;
+        enter(ConnectionState::Backoff, now);
+    }
+
+    ConnectionAction ConnectionStateMachine::beginAttempt(uint32_t now)
+    {
+        enter(ConnectionState::Connecting, now);
+        _attemptStart = now;
+        _fastAttempt = _fastPathAvailable;
+        return _fastAttempt ? ConnectionAction::BeginFastConnect : ConnectionAction::BeginConnect;
+    }
+
+    void ConnectionStateMachine::linkUp(uint32_t now)
+    {
+        if (_state == ConnectionState::Connecting)
+        {
+            _stats.lastConnectMs = now - _attemptStart;
+            _stats.lastConnectFast = _fastAttempt;
+            if (_fastAttempt)
+            {
+                _stats.fastConnects++;
+            }
+        }
+        _stats.connects++;
+        _failures = 0;
+        _fastAttempt = false;
+        enter(ConnectionState::Connected, now);
+    }
+
+    ConnectionAction ConnectionStateMachine::tick(uint32_t now, bool linkUp)
+    {
+        if (!_enabled)
+        {
+            return ConnectionAction::None;
+        }
+
+        switch (_state)
+        {
+        case ConnectionState::Idle:
+            if (linkUp)
+            {
+                this->linkUp(now);
+                return ConnectionAction::None;
+            }
+            return beginAttempt(now);
+
+        case ConnectionState::Connecting:
+            if (linkUp)
+            {
+                this->linkUp(now);
+                return ConnectionAction::None;
+            }
+            if (_fastAttempt && now - _stateSince >= _policy.fastConnectTimeoutMs)
+            {
+                // Cached AP/channel did not answer: scan within the same attempt
+                _fastAttempt = false;
+                _stats.fastFallbacks++;
+                _stateSince = now;
+                return ConnectionAction::BeginConnect;
+            }
+            if (now - _stateSince >= _policy.connectTimeoutMs)
+            {
+                _failures++;
+                _stats.failures++;
+                _fastAttempt = false;
+                scheduleRetry(now);
+                return ConnectionAction::AbortConnect;
+            }
+            return ConnectionAction::None;
+
+        case ConnectionState::Connected:
+            if (!linkUp)
+            {
+                _failures = 0;
+                scheduleRetry(now);
+            }
+            return ConnectionAction::None;
+
+        case ConnectionState::Backoff:
+            if (linkUp)
+            {
+                this->linkUp(now);
+                return ConnectionAction::None;
+            }
+            if (static_cast<int32_t>(now - _retryAt) >= 0)
+            {
+                return beginAttempt(now);
+            }
+            return ConnectionAction::None;
+        }
+
+        return ConnectionAction::None;
+    }
+
+} // namespace plant_nanny::services::network
@@ -1,13 +1,79 @@
 #include "libs/plant_nanny/services/network/Manager.h"
 #include "libs/common/utils/LogMacros.h"
+#include "libs/plant_nanny/metrics/FirmwareMetrics.h"
 #include <WiFi.h>
 #include <HTTPClient.h>
+#include <esp_random.h>
+#include <esp_netif.h>
+#include <esp_netif_net_stack.h>
+#include <lwip/dhcp.h>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
 
 namespace plant_nanny::services::network
 {
+    namespace
+    {
+        // 2020-01-01: an earlier system time was never set by SNTP
+        constexpr time_t MIN_SYNCED_TIME = 1577836800;
+
+        // Unix time, 0 before the first SNTP sync. The system clock keeps
+        // running through deep sleep but restarts on power loss.
+        uint32_t synced_time_sec()
+        {
+            time_t now = time(nullptr);
+            return now >= MIN_SYNCED_TIME ? static_cast<uint32_t>(now) : 0;
+        }
+
+        // Lease time granted by the DHCP server, 0 if unknown
+        uint32_t dhcp_lease_sec()
+        {
+            esp_netif_t *sta = esp_netif_get_handle_from_ifkey("WIFI_STA_DEF");
+            if (sta == nullptr)
+            {
+                return 0;
+            }
+            auto *lwip_netif = static_cast<struct netif *>(esp_netif_get_netif_impl(sta));
+            if (lwip_netif == nullptr)
+            {
+                return 0;
+            }
+            struct dhcp *client = netif_dhcp_data(lwip_netif);
+            return client != nullptr ? client->offered_t0_lease : 0;
+        }
+    }
+
     Manager::Manager()
-        : logger_(common::service::get<common::logger::Logger>()), last_connection_attempt_(0)
+        : logger_(common::service::get<common::logger::Logger>()),
+          config_(common::service::get<config::IConfigManager>()),
+          state_machine_(BackoffPolicy{}, []() { return esp_random(); })
     {
+        state_machine_.setCallback([this](bool connected)
+        {
+            if (connected)
+            {
+                const ConnectionStats &stats = state_machine_.stats();
+                metrics::wifiConnects.increment();
+                metrics::wifiConnectMs.record(stats.lastConnectMs);
+                char msg[64];
+                snprintf(msg, sizeof(msg), "WiFi connected in %lu ms (%s)",
+                         static_cast<unsigned long>(stats.lastConnectMs),
+                         stats.lastConnectFast ? "fast" : "scan");
+                LOG_IF_AVAILABLE(logger_, info, msg);
+                fast_attempt_active_ = false;
+                store_link_cache();
+            }
+            else
+            {
+                metrics::wifiDisconnects.increment();
+                LOG_IF_AVAILABLE(logger_, info, "WiFi connection lost");
+            }
+            if (connection_callback_)
+            {
+                connection_callback_(connected);
+            }
+        });
         LOG_IF_AVAILABLE(logger_, info, "Network Manager initialized");
     }
 
@@ -15,51 +81,173 @@ namespace plant_nanny::services::network
     {
         ssid_ = ssid;
         password_ = password;
+
+        // Restart from Idle so the next tick associates with the new network
+        state_machine_.setEnabled(false);
+        load_link_cache();
+        state_machine_.setEnabled(!ssid_.empty());
         LOG_IF_AVAILABLE(logger_, info, "WiFi credentials configured");
     }
 
-    bool Manager::attempt_connection()
+    void Manager::set_connection_callback(ConnectionCallback callback)
     {
-        if (ssid_.empty())
+        connection_callback_ = std::move(callback);
+    }
+
+    ConnectionState Manager::get_connection_state() const
+    {
+        return state_machine_.state();
+    }
+
+    ConnectionStats Manager::get_connection_stats() const
+    {
+        return state_machine_.stats();
+    }
+
+    void Manager::load_link_cache()
+    {
+        link_cache_ = config::WifiLinkCache{};
+        if (config_.is_available())
         {
-            LOG_IF_AVAILABLE(logger_, error, "WiFi credentials not set");
-            return false;
+            auto cached = config_->getWifiLinkCache();
+            if (cached.succeed())
+            {
+                link_cache_ = cached.value();
+            }
+        }
+        state_machine_.setFastPathAvailable(link_cache_.valid());
+    }
+
+    void Manager::store_link_cache()
+    {
+        const uint8_t *bssid = WiFi.BSSID();
+        if (bssid == nullptr)
+        {
+            return;
         }
 
+        config::WifiLinkCache cache;
+        memcpy(cache.bssid, bssid, sizeof(cache.bssid));
+        cache.channel = static_cast<uint8_t>(WiFi.channel());
+        config::NetworkConfig network = network_config();
+        uint32_t now = synced_time_sec();
+        if (network.reuseIpLease && static_ip_applied_)
+        {
+            // No DHCP ran: still the old lease, which keeps aging
+            cache.ip = link_cache_.ip;
+            cache.gateway = link_cache_.gateway;
+            cache.subnet = link_cache_.subnet;
+            cache.dns = link_cache_.dns;
+            cache.leaseAcquiredSec = link_cache_.leaseAcquiredSec;
+            cache.leaseSec = link_cache_.leaseSec;
+        }
+        else if (network.reuseIpLease && now != 0)
+        {
+            // Without a wall clock the lease age could not be told after a sleep
+            cache.ip = static_cast<uint32_t>(WiFi.localIP());
+            cache.gateway = static_cast<uint32_t>(WiFi.gatewayIP());
+            cache.subnet = static_cast<uint32_t>(WiFi.subnetMask());
+            cache.dns = static_cast<uint32_t>(WiFi.dnsIP());
+            cache.leaseAcquiredSec = now;
+            cache.leaseSec = dhcp_lease_sec();
+            if (cache.leaseSec == 0)
+            {
+                cache.leaseSec = network.defaultLeaseSec;
+            }
+        }
+
+        link_cache_ = cache;
+        state_machine_.setFastPathAvailable(cache.valid());
+        if (config_.is_available())
+        {
+            config_->saveWifiLinkCache(cache);
+        }
+    }
+
+    config::NetworkConfig Manager::network_config()
+    {
+        return config_.is_available() ? config_->getNetworkConfig() : config::NetworkConfig{};
+    }
+
+    void Manager::begin_connection()
+    {
         LOG_IF_AVAILABLE(logger_, info, "Attempting WiFi connection...");
         WiFi.mode(WIFI_STA);
-        WiFi.begin(ssid_.c_str(), password_.c_str());
-
-        uint32_t start_time = millis();
-        while (WiFi.status() != WL_CONNECTED && (millis() - start_time) < 10000)
+        WiFi.setAutoReconnect(false);  // Retries are driven by the state machine
+        if (fast_attempt_active_)
+        {
+            // Fast path fell back: drop the half-open association first
+            WiFi.disconnect();
+            fast_attempt_active_ = false;
+        }
+        if (static_ip_applied_)
         {
-            delay(500);
+            // Negotiate a fresh DHCP lease on the full scan path
+            WiFi.config(IPAddress(0u), IPAddress(0u), IPAddress(0u));
+            static_ip_applied_ = false;
         }
+        WiFi.begin(ssid_.c_str(), password_.c_str());
+    }
 
-        if (WiFi.status() == WL_CONNECTED)
+    void Manager::begin_fast_connection()
+    {
+        LOG_IF_AVAILABLE(logger_, info, "Attempting WiFi fast reconnect...");
+        WiFi.mode(WIFI_STA);
+        WiFi.setAutoReconnect(false);
+        fast_attempt_active_ = true;
+        if (network_config().reuseIpLease && link_cache_.leaseFresh(synced_time_sec()))
         {
-            LOG_IF_AVAILABLE(logger_, info, "WiFi connected");
-            return true;
+            WiFi.config(IPAddress(link_cache_.ip), IPAddress(link_cache_.gateway),
+                        IPAddress(link_cache_.subnet), IPAddress(link_cache_.dns));
+            static_ip_applied_ = true;
         }
-        else
+        else if (static_ip_applied_)
         {
-            LOG_IF_AVAILABLE(logger_, error, "WiFi connection failed");
-            return false;
+            // Lease past its half-life (or reuse turned off): ask DHCP again
+            WiFi.config(IPAddress(0u), IPAddress(0u), IPAddress(0u));
+            static_ip_applied_ = false;
         }
+        // Known channel + BSSID skips the all-channel probe scan
+        WiFi.begin(ssid_.c_str(), password_.c_str(), link_cache_.channel, link_cache_.bssid);
     }
 
     common::patterns::Result<void> Manager::connect()
     {
-        if (attempt_connection())
+        if (ssid_.empty())
+        {
+            LOG_IF_AVAILABLE(logger_, error, "WiFi credentials not set");
+            return common::patterns::Result<void>::failure(
+                common::patterns::Error("WiFi credentials not set"));
+        }
+
+        // Blocking variant for callers that need the outcome (BLE provisioning).
+        // Regular reconnects go through maintain_connection() and never block.
+        state_machine_.setEnabled(true);
+        state_machine_.retryNow(millis());
+
+        while (true)
         {
-            return common::patterns::Result<void>::success();
+            maintain_connection();
+
+            ConnectionState state = state_machine_.state();
+            if (state == ConnectionState::Connected)
+            {
+                return common::patterns::Result<void>::success();
+            }
+            if (state == ConnectionState::Backoff)
+            {
+                break;  // Attempt timed out
+            }
+            delay(100);
         }
+
         return common::patterns::Result<void>::failure(
             common::patterns::Error("Failed to connect to WiFi"));
     }
 
     void Manager::disconnect()
     {
+        state_machine_.setEnabled(false);
         WiFi.disconnect();
         LOG_IF_AVAILABLE(logger_, info, "WiFi disconnected");
     }
@@ -71,19 +259,23 @@ namespace plant_nanny::services::network
 
     void Manager::maintain_connection()
     {
-        if (ssid_.empty())
+        switch (state_machine_.tick(millis(), is_connected()))
         {
-            return;
-        }
+        case ConnectionAction::BeginConnect:
+            begin_connection();
+            break;
 
-        uint32_t current_time = millis();
+        case ConnectionAction::BeginFastConnect:
+            begin_fast_connection();
+            break;
 
-        if (!is_connected() &&
-            (current_time - last_connection_attempt_) >= RECONNECT_INTERVAL_MS)
-        {
-            last_connection_attempt_ = current_time;
-            LOG_IF_AVAILABLE(logger_, info, "Attempting to reconnect...");
-            attempt_connection();
+        case ConnectionAction::AbortConnect:
+            LOG_IF_AVAILABLE(logger_, error, "WiFi connection attempt timed out");
+            WiFi.disconnect();
+            break;
+
+        case ConnectionAction::None:
+            break;
         }
     }
 
@@ -110,7 +302,8 @@ namespace plant_nanny::services::network
     common::patterns::Result<void> Manager::download_file(
         const std::string &url,
         std::function<bool(const uint8_t *, size_t)> chunk_handler,
-        std::function<void(size_t, size_t)> progress_callback)
+        std::function<void(size_t, size_t)> progress_callback,
+        size_t offset)
     {
         if (!is_connected())
         {
@@ -120,9 +313,15 @@ namespace plant_nanny::services::network
 
         HTTPClient http;
         http.begin(url.c_str());
+        if (offset > 0)
+        {
+            char range[32];
+            snprintf(range, sizeof(range), "bytes=%lu-", static_cast<unsigned long>(offset));
+            http.addHeader("Range", range);
+        }
 
         int httpCode = http.GET();
-        if (httpCode != HTTP_CODE_OK)
+        if (httpCode != HTTP_CODE_OK && !(offset > 0 && httpCode == HTTP_CODE_PARTIAL_CONTENT))
         {
             http.end();
             LOG_IF_AVAILABLE(logger_, error, "HTTP GET failed");
@@ -130,45 +329,79 @@ namespace plant_nanny::services::network
                 common::patterns::Error("HTTP GET failed with code: " + std::to_string(httpCode)));
         }
 
-        int total_length = http.getSize();
-        size_t downloaded = 0;
+        // A server ignoring Range sends the whole file again: skip what we already have
+        size_t skip = httpCode == HTTP_CODE_OK ? offset : 0;
+        int content_length = http.getSize();
+        size_t total = content_length < 0 ? 0 : static_cast<size_t>(content_length) + offset - skip;
+        size_t position = offset - skip;
 
         WiFiClient *stream = http.getStreamPtr();
-        uint8_t buffer[512];
+        uint8_t buffer[DOWNLOAD_READ_SIZE];
+        uint32_t last_data_ms = millis();
 
-        LOG_IF_AVAILABLE(logger_, info, "Starting download...");
+        LOG_IF_AVAILABLE(logger_, info, offset > 0 ? "Resuming download..." : "Starting download...");
 
-        while (http.connected() && (total_length > 0 || total_length == -1))
+        while (total == 0 || position < total)
         {
-            size_t available = stream->available();
-            if (available)
+            size_t wanted = total == 0 ? sizeof(buffer) : std::min(sizeof(buffer), total - position);
+            int read_len = stream->available() > 0 ? stream->read(buffer, wanted) : 0;
+            if (read_len <= 0)
             {
-                size_t read_len = stream->readBytes(buffer, std::min(available, sizeof(buffer)));
-
-                if (!chunk_handler(buffer, read_len))
+                if (!http.connected())
+                {
+                    break;
+                }
+                if (millis() - last_data_ms > DOWNLOAD_STALL_TIMEOUT_MS)
                 {
                     http.end();
-                    LOG_IF_AVAILABLE(logger_, error, "Chunk handler failed");
-                    return common::patterns::Result<void>::failure(
-                        common::patterns::Error("Chunk handler returned false"));
+                    LOG_IF_AVAILABLE(logger_, error, "Download stalled");
+                    return common::patterns::Result<void>::failure(common::patterns::Error("Download stalled"));
                 }
+                delay(1);  // Only waits while the socket is empty
+                continue;
+            }
+            last_data_ms = millis();
 
-                downloaded += read_len;
+            const uint8_t *data = buffer;
+            size_t length = static_cast<size_t>(read_len);
+            if (skip > 0)
+            {
+                size_t skipped = std::min(skip, length);
+                skip -= skipped;
+                position += skipped;
+                data += skipped;
+                length -= skipped;
+            }
+            if (length == 0)
+            {
+                continue;
+            }
 
-                if (progress_callback)
-                {
-                    progress_callback(downloaded, total_length);
-                }
+            if (!chunk_handler(data, length))
+            {
+                http.end();
+                LOG_IF_AVAILABLE(logger_, error, "Chunk handler failed");
+                return common::patterns::Result<void>::failure(
+                    common::patterns::Error("Chunk handler returned false"));
+            }
 
-                if (total_length > 0 && downloaded >= static_cast<size_t>(total_length))
-                {
-                    break;
-                }
+            position += length;
+            if (progress_callback)
+            {
+                progress_callback(position, total);
             }
-            delay(1);
         }
 
         http.end();
+        if (total > 0 && position < total)
+        {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "Connection lost at %lu of %lu bytes",
+                     static_cast<unsigned long>(position), static_cast<unsigned long>(total));
+            LOG_IF_AVAILABLE(logger_, warning, msg);
+            return common::patterns::Result<void>::failure(common::patterns::Error(msg));
+        }
+
         LOG_IF_AVAILABLE(logger_, info, "Download completed");
         return common::patterns::Result<void>::success();
     }
@@ -0,0 +1,179 @@
+#include "libs/plant_nanny/services/ota/DeltaPatcher.h"
+#include <algorithm>
+#include <cstring>
+
+namespace plant_nanny::services::ota
+{
+    namespace
+    {
+        uint32_t read_u32(const uint8_t *p)
+        {
+            return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                   (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        }
+
+        common::patterns::Result<void> corrupt(const char *message)
+        {
+            return common::patterns::Result<void>::failure(common::patterns::Error(message));
+        }
+    }
+
+    DeltaPatcher::DeltaPatcher(size_t source_size, SourceReader source, Sink sink)
+        : source_size_(source_size), source_(std::move(source)), sink_(std::move(sink))
+    {
+    }
+
+    common::patterns::Result<void> DeltaPatcher::parse_header()
+    {
+        uint16_t magic = static_cast<uint16_t>(pending_[0] | (pending_[1] << 8));
+        if (magic != MAGIC || pending_[2] != VERSION)
+            return corrupt("Not a delta patch");
+        if (read_u32(pending_ + 4) != source_size_)
+            return corrupt("Delta patch built for another source image");
+
+        target_size_ = read_u32(pending_ + 8);
+        field_ = Field::Control;
+        return common::patterns::Result<void>::success();
+    }
+
+    common::patterns::Result<void> DeltaPatcher::parse_control()
+    {
+        diff_left_ = read_u32(pending_);
+        extra_left_ = read_u32(pending_ + 4);
+        seek_ = static_cast<int32_t>(read_u32(pending_ + 8));
+
+        if (diff_left_ > source_size_ - cursor_)
+            return corrupt("Delta patch reads past the source image");
+        if (diff_left_ + extra_left_ > target_size_ - bytes_out_)
+            return corrupt("Delta patch writes past its target size");
+
+        if (diff_left_ > 0)
+        {
+            field_ = Field::Diff;
+            return common::patterns::Result<void>::success();
+        }
+        if (extra_left_ > 0)
+        {
+            field_ = Field::Extra;
+            return common::patterns::Result<void>::success();
+        }
+        return end_record();
+    }
+
+    common::patterns::Result<void> DeltaPatcher::end_record()
+    {
+        int64_t cursor = static_cast<int64_t>(cursor_) + seek_;
+        if (cursor < 0 || cursor > static_cast<int64_t>(source_size_))
+            return corrupt("Delta patch seeks outside the source image");
+
+        cursor_ = static_cast<size_t>(cursor);
+        field_ = Field::Control;
+        return common::patterns::Result<void>::success();
+    }
+
+    common::patterns::Result<void> DeltaPatcher::load_source(size_t offset)
+    {
+        source_block_offset_ = offset;
+        source_block_length_ = std::min(BLOCK_SIZE, source_size_ - offset);
+        return source_(offset, source_block_, source_block_length_);
+    }
+
+    common::patterns::Result<void> DeltaPatcher::flush()
+    {
+        if (output_length_ == 0)
+            return common::patterns::Result<void>::success();
+
+        size_t length = output_length_;
+        output_length_ = 0;
+        return sink_(output_, length);
+    }
+
+    common::patterns::Result<void> DeltaPatcher::feed(const uint8_t *data, size_t length)
+    {
+        while (length > 0)
+        {
+            common::patterns::Result<void> result = common::patterns::Result<void>::success();
+
+            if (field_ == Field::Header || field_ == Field::Control)
+            {
+                if (field_ == Field::Control && pending_length_ == 0 && bytes_out_ == target_size_)
+                    return corrupt("Delta patch continues past its target");
+
+                size_t needed = field_ == Field::Header ? HEADER_SIZE : CONTROL_SIZE;
+                size_t n = std::min(length, needed - pending_length_);
+                memcpy(pending_ + pending_length_, data, n);
+                pending_length_ += n;
+                data += n;
+                length -= n;
+
+                if (pending_length_ == needed)
+                {
+                    pending_length_ = 0;
+                    result = field_ == Field::Header ? parse_header() : parse_control();
+                }
+            }
+            else
+            {
+                // Work in spans bounded by the input, the record, the output block and the source block
+                size_t n = std::min({length, field_ == Field::Diff ? diff_left_ : extra_left_,
+                                     BLOCK_SIZE - output_length_});
+                if (field_ == Field::Diff)
+                {
+                    if (cursor_ < source_block_offset_ || cursor_ >= source_block_offset_ + source_block_length_)
+                    {
+                        result = load_source(cursor_);
+                        if (result.failed())
+                            return result;
+                    }
+                    n = std::min(n, source_block_offset_ + source_block_length_ - cursor_);
+
+                    const uint8_t *source = source_block_ + (cursor_ - source_block_offset_);
+                    for (size_t i = 0; i < n; i++)
+                    {
+                        output_[output_length_ + i] = static_cast<uint8_t>(data[i] + source[i]);
+                    }
+                    cursor_ += n;
+                    diff_left_ -= n;
+                }
+                else
+                {
+                    memcpy(output_ + output_length_, data, n);
+                    extra_left_ -= n;
+                }
+
+                output_length_ += n;
+                bytes_out_ += n;
+                data += n;
+                length -= n;
+
+                if (output_length_ == BLOCK_SIZE)
+                {
+                    result = flush();
+                    if (result.failed())
+                        return result;
+                }
+
+                if (field_ == Field::Diff && diff_left_ == 0)
+                {
+                    field_ = Field::Extra;
+                }
+                if (field_ == Field::Extra && extra_left_ == 0)
+                {
+                    result = end_record();
+                }
+            }
+
+            if (result.failed())
+                return result;
+        }
+        return common::patterns::Result<void>::success();
+    }
+
+    common::patterns::Result<void> DeltaPatcher::finish()
+    {
+        if (field_ != Field::Control || pending_length_ != 0 || bytes_out_ != target_size_)
+            return corrupt("Delta patch truncated");
+        return flush();
+    }
+
+} // namespace plant_nanny::services::ota
@@ -0,0 +1,117 @@
+#include "libs/plant_nanny/services/ota/HeatshrinkDecoder.h"
+
+namespace plant_nanny::services::ota
+{
+    bool HeatshrinkDecoder::supports(uint8_t window_bits, uint8_t lookahead_bits)
+    {
+        return window_bits >= MIN_WINDOW_BITS && window_bits <= MAX_WINDOW_BITS &&
+               lookahead_bits >= MIN_LOOKAHEAD_BITS && lookahead_bits < window_bits;
+    }
+
+    HeatshrinkDecoder::HeatshrinkDecoder(uint8_t window_bits, uint8_t lookahead_bits, Sink sink)
+        : window_bits_(window_bits), lookahead_bits_(lookahead_bits), sink_(std::move(sink)),
+          window_(std::make_unique<uint8_t[]>(size_t{1} << window_bits))
+    {
+    }
+
+    uint16_t HeatshrinkDecoder::take(uint8_t count)
+    {
+        bit_count_ -= count;
+        return static_cast<uint16_t>((bits_ >> bit_count_) & ((1u << count) - 1));
+    }
+
+    bool HeatshrinkDecoder::push(uint8_t byte)
+    {
+        window_[bytes_out_ & ((size_t{1} << window_bits_) - 1)] = byte;
+        bytes_out_++;
+        output_[output_length_++] = byte;
+        return output_length_ == OUTPUT_BUFFER_SIZE;
+    }
+
+    common::patterns::Result<void> HeatshrinkDecoder::flush()
+    {
+        if (output_length_ == 0)
+            return common::patterns::Result<void>::success();
+
+        size_t length = output_length_;
+        output_length_ = 0;
+        return sink_(output_, length);
+    }
+
+    common::patterns::Result<void> HeatshrinkDecoder::feed(const uint8_t *data, size_t length)
+    {
+        const size_t mask = (size_t{1} << window_bits_) - 1;
+
+        for (size_t i = 0; i < length; i++)
+        {
+            bits_ = (bits_ << 8) | data[i];
+            bit_count_ += 8;
+
+            while (true)
+            {
+                uint8_t needed = field_ == Field::Tag       ? 1
+                                 : field_ == Field::Literal ? 8
+                                 : field_ == Field::Offset  ? window_bits_
+                                                            : lookahead_bits_;
+                if (bit_count_ < needed)
+                    break;
+
+                uint16_t value = take(needed);
+                switch (field_)
+                {
+                case Field::Tag:
+                    field_ = value ? Field::Literal : Field::Offset;
+                    break;
+
+                case Field::Literal:
+                    field_ = Field::Tag;
+                    if (push(static_cast<uint8_t>(value)))
+                    {
+                        auto result = flush();
+                        if (result.failed())
+                            return result;
+                    }
+                    break;
+
+                case Field::Offset:
+                    offset_ = value + 1;
+                    field_ = Field::Count;
+                    break;
+
+                case Field::Count:
+                    field_ = Field::Tag;
+                    if (offset_ > bytes_out_)
+                    {
+                        return common::patterns::Result<void>::failure(
+                            common::patterns::Error("Compressed image references data before its start"));
+                    }
+                    for (uint32_t n = 0; n <= value; n++)
+                    {
+                        if (push(window_[(bytes_out_ - offset_) & mask]))
+                        {
+                            auto result = flush();
+                            if (result.failed())
+                                return result;
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+        return common::patterns::Result<void>::success();
+    }
+
+    common::patterns::Result<void> HeatshrinkDecoder::finish()
+    {
+        // The encoder zero-pads the last byte; those bits may read as a tag 0
+        bool padding_only = bit_count_ < 8 && (bits_ & ((1u << bit_count_) - 1)) == 0 &&
+                            (field_ == Field::Tag || field_ == Field::Offset);
+        if (!padding_only)
+        {
+            return common::patterns::Result<void>::failure(
+                common::patterns::Error("Compressed image truncated"));
+        }
+        return flush();
+    }
+
+} // namespace plant_nanny::services::ota
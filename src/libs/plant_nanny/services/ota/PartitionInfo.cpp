@@ -1,4 +1,5 @@
 #include "libs/plant_nanny/services/ota/PartitionInfo.h"
+#include "libs/common/utils/EspError.h"
 #include "esp_ota_ops.h"
 
 namespace plant_nanny::services::ota
@@ -34,4 +35,33 @@ namespace plant_nanny::services::ota
         return common::patterns::Result<const esp_partition_t *>::success(partition);
     }
 
+    common::patterns::Result<void> PartitionInfo::read(const esp_partition_t *partition, size_t offset, void *out, size_t length)
+    {
+        if (partition == nullptr)
+            return common::patterns::Result<void>::failure(common::patterns::Error("No partition to read"));
+
+        return common::utils::EspError::to_result(esp_partition_read(partition, offset, out, length),
+                                                  "Failed to read partition");
+    }
+
+    common::patterns::Result<common::utils::Sha256::Digest> PartitionInfo::hash(const esp_partition_t *partition, size_t length)
+    {
+        using ResultType = common::patterns::Result<common::utils::Sha256::Digest>;
+
+        if (partition == nullptr || length > partition->size)
+            return ResultType::failure(common::patterns::Error("Hash range outside the partition"));
+
+        common::utils::Sha256 sha;
+        uint8_t block[512];
+        for (size_t offset = 0; offset < length; offset += sizeof(block))
+        {
+            size_t chunk = length - offset < sizeof(block) ? length - offset : sizeof(block);
+            auto result = read(partition, offset, block, chunk);
+            if (result.failed())
+                return ResultType::failure(result.error());
+            sha.update(block, chunk);
+        }
+        return ResultType::success(sha.finish());
+    }
+
 } // namespace plant_nanny::services::ota
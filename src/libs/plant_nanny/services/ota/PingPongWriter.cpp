@@ -0,0 +1,122 @@
+#include "libs/plant_nanny/services/ota/PingPongWriter.h"
+#include <algorithm>
+#include <cstring>
+
+#ifndef NATIVE_TEST
+#include <esp_pthread.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace plant_nanny::services::ota
+{
+    PingPongWriter::PingPongWriter(size_t buffer_size, Sink sink)
+        : buffer_size_(buffer_size > 0 ? buffer_size : DEFAULT_BUFFER_SIZE), sink_(std::move(sink))
+    {
+        buffers_[0] = std::make_unique<uint8_t[]>(buffer_size_);
+        buffers_[1] = std::make_unique<uint8_t[]>(buffer_size_);
+
+#ifndef NATIVE_TEST
+        // std::thread maps to a FreeRTOS task; size it for esp_ota_write and the decoders
+        esp_pthread_cfg_t cfg = esp_pthread_get_default_config();
+        cfg.stack_size = WRITER_STACK;
+        cfg.thread_name = "ota_writer";
+        cfg.prio = uxTaskPriorityGet(NULL);
+        esp_pthread_set_cfg(&cfg);
+#endif
+        writer_ = std::thread(&PingPongWriter::run, this);
+    }
+
+    PingPongWriter::~PingPongWriter()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            ready_index_ = -1;  // Drop what was not written, the update is being abandoned
+            stop_ = true;
+        }
+        changed_.notify_all();
+        writer_.join();
+    }
+
+    void PingPongWriter::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true)
+        {
+            changed_.wait(lock, [this] { return ready_index_ >= 0 || stop_; });
+            if (ready_index_ < 0)
+                return;
+
+            int index = ready_index_;
+            size_t length = ready_length_;
+            ready_index_ = -1;
+            writing_ = true;
+            bool failed = error_.has_value();
+            lock.unlock();
+
+            // Once the sink failed the rest of the image is meaningless
+            auto result = failed ? common::patterns::Result<void>::success() : sink_(buffers_[index].get(), length);
+
+            lock.lock();
+            writing_ = false;
+            if (result.failed() && !error_)
+                error_ = result.error();
+            changed_.notify_all();
+        }
+    }
+
+    common::patterns::Result<void> PingPongWriter::hand_over()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        // The other buffer is ours again once the writer has finished with it
+        changed_.wait(lock, [this] { return (ready_index_ < 0 && !writing_) || error_; });
+        if (error_)
+            return common::patterns::Result<void>::failure(*error_);
+
+        ready_index_ = fill_index_;
+        ready_length_ = fill_length_;
+        lock.unlock();
+        changed_.notify_all();
+
+        fill_index_ ^= 1;
+        fill_length_ = 0;
+        return common::patterns::Result<void>::success();
+    }
+
+    common::patterns::Result<void> PingPongWriter::write(const uint8_t *data, size_t length)
+    {
+        while (length > 0)
+        {
+            size_t n = std::min(length, buffer_size_ - fill_length_);
+            memcpy(buffers_[fill_index_].get() + fill_length_, data, n);
+            fill_length_ += n;
+            data += n;
+            length -= n;
+
+            if (fill_length_ == buffer_size_)
+            {
+                auto result = hand_over();
+                if (result.failed())
+                    return result;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        return error_ ? common::patterns::Result<void>::failure(*error_) : common::patterns::Result<void>::success();
+    }
+
+    common::patterns::Result<void> PingPongWriter::flush()
+    {
+        if (fill_length_ > 0)
+        {
+            auto result = hand_over();
+            if (result.failed())
+                return result;
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        changed_.wait(lock, [this] { return ready_index_ < 0 && !writing_; });
+        return error_ ? common::patterns::Result<void>::failure(*error_) : common::patterns::Result<void>::success();
+    }
+
+} // namespace plant_nanny::services::ota
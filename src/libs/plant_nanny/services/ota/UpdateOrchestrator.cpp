@@ -1,16 +1,42 @@
 #include "libs/plant_nanny/services/ota/UpdateOrchestrator.h"
+#include "libs/plant_nanny/services/ota/DeltaPatcher.h"
+#include "libs/plant_nanny/services/ota/HeatshrinkDecoder.h"
+#include "libs/plant_nanny/services/ota/PartitionInfo.h"
 #include "libs/common/utils/LogMacros.h"
+#include <thread>
 
 namespace plant_nanny::services::ota
 {
-    UpdateOrchestrator::UpdateOrchestrator()
-        : logger_(common::service::get<common::logger::Logger>()), ota_manager_(std::make_unique<ota::Manager>()), network_service_(common::service::get<network::INetworkService>()), bytes_downloaded_(0), total_bytes_(0)
+    UpdateOrchestrator::UpdateOrchestrator(const UpdateOptions &options)
+        : logger_(common::service::get<common::logger::Logger>()), ota_manager_(std::make_unique<ota::Manager>()), network_service_(common::service::get<network::INetworkService>()), options_(options), bytes_downloaded_(0), total_bytes_(0)
     {
         LOG_IF_AVAILABLE(logger_, info, "OTA Update Orchestrator initialized");
     }
 
     common::patterns::Result<void> UpdateOrchestrator::update_from_url(const std::string &firmware_url)
     {
+        Manifest manifest;
+        manifest.url = firmware_url;
+        return update(manifest);
+    }
+
+    common::patterns::Result<void> UpdateOrchestrator::update(const Manifest &manifest)
+    {
+        if (manifest.compression == Compression::Heatshrink &&
+            !HeatshrinkDecoder::supports(manifest.window_bits, manifest.lookahead_bits))
+        {
+            LOG_IF_AVAILABLE(logger_, error, "Unsupported heatshrink parameters");
+            return common::patterns::Result<void>::failure(
+                common::patterns::Error("Unsupported heatshrink parameters"));
+        }
+
+        if (manifest.delta && !manifest.sha256)
+        {
+            LOG_IF_AVAILABLE(logger_, error, "Delta update without result hash");
+            return common::patterns::Result<void>::failure(
+                common::patterns::Error("Delta update requires the result sha256"));
+        }
+
         if (!network_service_->is_connected())
         {
             LOG_IF_AVAILABLE(logger_, error, "Network not connected");
@@ -18,6 +44,24 @@ namespace plant_nanny::services::ota
                 common::patterns::Error("Network not connected"));
         }
 
+        // A patch only rebuilds the right image from the exact source it was made against
+        const esp_partition_t *running = PartitionInfo::get_running_partition();
+        if (manifest.delta)
+        {
+            auto source_hash = PartitionInfo::hash(running, manifest.source_size);
+            if (source_hash.failed())
+            {
+                LOG_IF_AVAILABLE(logger_, error, "Failed to hash running image");
+                return common::patterns::Result<void>::failure(source_hash.error());
+            }
+            if (source_hash.value() != manifest.source_sha256)
+            {
+                LOG_IF_AVAILABLE(logger_, error, "Running image does not match the delta source");
+                return common::patterns::Result<void>::failure(
+                    common::patterns::Error("Running image does not match the delta source"));
+            }
+        }
+
         LOG_IF_AVAILABLE(logger_, info, "Starting OTA update from URL");
 
         auto start_result = ota_manager_->start_update();
@@ -30,26 +74,80 @@ namespace plant_nanny::services::ota
         bytes_downloaded_ = 0;
         total_bytes_ = 0;
 
-        auto download_result = network_service_->download_file(
-            firmware_url,
-            [this](const uint8_t *data, size_t length) -> bool
-            {
-                auto write_result = ota_manager_->write_chunk(data, length);
-                if (write_result.failed())
+        // download -> [heatshrink] -> [delta patch] -> hash + flash
+        common::utils::Sha256 image_hash;
+        auto write_image = [&](const uint8_t *data, size_t length)
+        {
+            image_hash.update(data, length);
+            return ota_manager_->write_chunk(data, length);
+        };
+
+        std::unique_ptr<DeltaPatcher> patcher;
+        if (manifest.delta)
+        {
+            patcher = std::make_unique<DeltaPatcher>(
+                manifest.source_size,
+                [running](size_t offset, uint8_t *out, size_t length)
+                { return PartitionInfo::read(running, offset, out, length); },
+                write_image);
+        }
+        auto write_patched = [&](const uint8_t *data, size_t length)
+        { return patcher ? patcher->feed(data, length) : write_image(data, length); };
+
+        // Compressed images are inflated block by block, never held in RAM
+        std::unique_ptr<HeatshrinkDecoder> decoder;
+        if (manifest.compression == Compression::Heatshrink)
+        {
+            decoder = std::make_unique<HeatshrinkDecoder>(manifest.window_bits, manifest.lookahead_bits, write_patched);
+        }
+
+        // The reader keeps the socket drained while the writer thread decodes and flashes
+        PingPongWriter pipeline(options_.buffer_size,
+                                [&](const uint8_t *data, size_t length)
+                                { return decoder ? decoder->feed(data, length) : write_patched(data, length); });
+
+        size_t received = 0;
+        bool sink_failed = false;
+        started_at_ = reported_at_ = std::chrono::steady_clock::now();
+
+        common::patterns::Result<void> download_result = common::patterns::Result<void>::success();
+        for (uint8_t attempt = 0;; ++attempt)
+        {
+            // Everything received so far went through the pipeline, so the stream picks up
+            // where it stopped. For plain images this is OTAState::bytes_written() once flushed.
+            download_result = network_service_->download_file(
+                manifest.url,
+                [&](const uint8_t *data, size_t length) -> bool
                 {
-                    LOG_IF_AVAILABLE(logger_, error, "Failed to write OTA chunk");
-                    ota_manager_->abort_update();
-                    return false;
-                }
-                return true;
-            },
-            [this](size_t downloaded, size_t total)
-            {
-                bytes_downloaded_ = downloaded;
-                total_bytes_ = total;
-                if (total > 0 && downloaded % 10240 == 0)
-                    LOG_IF_AVAILABLE(logger_, debug, "OTA progress");
-            });
+                    if (pipeline.write(data, length).failed())
+                    {
+                        sink_failed = true;
+                        return false;
+                    }
+                    received += length;
+                    return true;
+                },
+                [this](size_t downloaded, size_t total)
+                { report_progress(downloaded, total); },
+                received);
+
+            if (!download_result.failed() || sink_failed || attempt >= options_.resume_attempts)
+                break;
+
+            LOG_IF_AVAILABLE(logger_, warning, "OTA download interrupted, resuming");
+            std::this_thread::sleep_for(std::chrono::milliseconds(options_.resume_delay_ms));
+            if (!network_service_->is_connected())
+                break;
+        }
+
+        // The writer has to be idle before the image is finished or abandoned
+        auto flush_result = pipeline.flush();
+        if (flush_result.failed())
+        {
+            LOG_IF_AVAILABLE(logger_, error, "Failed to write OTA chunk");
+            ota_manager_->abort_update();
+            return flush_result;
+        }
 
         if (download_result.failed())
         {
@@ -58,6 +156,40 @@ namespace plant_nanny::services::ota
             return download_result;
         }
 
+        // Without a Content-Length the last chunk was not recognisable as the end
+        if (total_bytes_ == 0)
+            report_progress(received, received);
+
+        if (decoder)
+        {
+            auto finish_result = decoder->finish();
+            if (finish_result.failed())
+            {
+                LOG_IF_AVAILABLE(logger_, error, "Compressed image incomplete");
+                ota_manager_->abort_update();
+                return finish_result;
+            }
+        }
+
+        if (patcher)
+        {
+            auto finish_result = patcher->finish();
+            if (finish_result.failed())
+            {
+                LOG_IF_AVAILABLE(logger_, error, "Delta patch incomplete");
+                ota_manager_->abort_update();
+                return finish_result;
+            }
+        }
+
+        if (manifest.sha256 && image_hash.finish() != *manifest.sha256)
+        {
+            LOG_IF_AVAILABLE(logger_, error, "Image hash mismatch");
+            ota_manager_->abort_update();
+            return common::patterns::Result<void>::failure(
+                common::patterns::Error("OTA image hash mismatch"));
+        }
+
         auto finalize_result = ota_manager_->finalize_update();
         if (finalize_result.failed())
         {
@@ -69,6 +201,26 @@ namespace plant_nanny::services::ota
         return common::patterns::Result<void>::success();
     }
 
+    void UpdateOrchestrator::report_progress(size_t downloaded, size_t total)
+    {
+        bytes_downloaded_ = downloaded;
+        total_bytes_ = total;
+        if (!progress_callback_)
+            return;
+
+        auto now = std::chrono::steady_clock::now();
+        bool done = total > 0 && downloaded >= total;
+        if (!done && now - reported_at_ < std::chrono::milliseconds(options_.progress_interval_ms))
+            return;
+        reported_at_ = now;
+
+        auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - started_at_).count();
+        UpdateProgress progress{downloaded, total, 0};
+        if (elapsed_ms > 0)
+            progress.bytes_per_sec = static_cast<uint32_t>(downloaded * 1000ULL / elapsed_ms);
+        progress_callback_(progress);
+    }
+
     uint8_t UpdateOrchestrator::get_progress() const
     {
         return total_bytes_ == 0 ? 0 : static_cast<uint8_t>((bytes_downloaded_ * 100) / total_bytes_);
@@ -0,0 +1,79 @@
+#include "libs/plant_nanny/services/power/DeepSleep.h"
+#include <esp_attr.h>
+#include <esp_sleep.h>
+#include <sys/time.h>
+
+namespace plant_nanny::services::power
+{
+    namespace
+    {
+        // constinit: no constructor may run at boot and wipe the buffer
+        RTC_DATA_ATTR constinit RtcSampleStore s_store{};
+        RTC_DATA_ATTR constinit rules::RuleState s_ruleState{};
+        RTC_DATA_ATTR constinit int64_t s_sleepStartUs = 0;
+        RTC_DATA_ATTR constinit uint64_t s_plannedSleepUs = 0;
+
+        // Keeps counting through deep sleep, unlike millis()
+        int64_t clockUs()
+        {
+            struct timeval now;
+            gettimeofday(&now, nullptr);
+            return static_cast<int64_t>(now.tv_sec) * 1000000 + now.tv_usec;
+        }
+    }
+
+    bool DeepSleep::wokeFromTimer()
+    {
+        return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_TIMER;
+    }
+
+    bool DeepSleep::wokeFromButton()
+    {
+        return esp_sleep_get_wakeup_cause() == ESP_SLEEP_WAKEUP_EXT0;
+    }
+
+    uint32_t DeepSleep::sleptMs()
+    {
+        switch (esp_sleep_get_wakeup_cause())
+        {
+        case ESP_SLEEP_WAKEUP_TIMER:
+            return static_cast<uint32_t>(s_plannedSleepUs / 1000);
+        case ESP_SLEEP_WAKEUP_EXT0:
+        {
+            int64_t sleptUs = clockUs() - s_sleepStartUs;
+            if (sleptUs < 0)
+            {
+                return 0;
+            }
+            // Never more than planned: the timer would have fired first
+            uint64_t boundedUs = static_cast<uint64_t>(sleptUs) < s_plannedSleepUs ? sleptUs : s_plannedSleepUs;
+            return static_cast<uint32_t>(boundedUs / 1000);
+        }
+        default:
+            return 0;
+        }
+    }
+
+    RtcSampleStore& DeepSleep::store()
+    {
+        return s_store;
+    }
+
+    rules::RuleState& DeepSleep::ruleState()
+    {
+        return s_ruleState;
+    }
+
+    void DeepSleep::sleepFor(uint64_t durationUs, int wakePin)
+    {
+        s_sleepStartUs = clockUs();
+        s_plannedSleepUs = durationUs;
+        esp_sleep_enable_timer_wakeup(durationUs);
+        if (wakePin >= 0)
+        {
+            esp_sleep_enable_ext0_wakeup(static_cast<gpio_num_t>(wakePin), 0);
+        }
+        esp_deep_sleep_start();
+    }
+
+} // namespace plant_nanny::services::power
@@ -0,0 +1,313 @@
+#include "libs/plant_nanny/services/power/DutyCycle.h"
+#include "libs/common/utils/Crc.h"
+#include <cmath>
+#include <cstring>
+
+namespace plant_nanny::services::power
+{
+    namespace
+    {
+        int16_t toFixed(float value)
+        {
+            if (std::isnan(value))
+            {
+                return PackedSample::MISSING;
+            }
+            float scaled = std::round(value * 100.0f);
+            if (scaled > INT16_MAX) return INT16_MAX;
+            if (scaled <= INT16_MIN) return INT16_MIN + 1;
+            return static_cast<int16_t>(scaled);
+        }
+
+        float fromFixed(int16_t value)
+        {
+            return value == PackedSample::MISSING ? NAN : static_cast<float>(value) / 100.0f;
+        }
+
+        bool movedBy(int16_t current, int16_t reference, float delta)
+        {
+            if (delta <= 0.0f || current == PackedSample::MISSING || reference == PackedSample::MISSING)
+            {
+                return false;
+            }
+            return std::fabs(fromFixed(current) - fromFixed(reference)) >= delta;
+        }
+    }
+
+    const char* to_string(UploadReason reason)
+    {
+        switch (reason)
+        {
+        case UploadReason::None: return "none";
+        case UploadReason::FirstSample: return "first sample";
+        case UploadReason::Interval: return "interval";
+        case UploadReason::Threshold: return "threshold";
+        case UploadReason::BufferFull: return "buffer full";
+        }
+        return "unknown";
+    }
+
+    PackedSample PackedSample::pack(const captors::SensorReadings& data, uint32_t elapsedSec)
+    {
+        PackedSample sample;
+        sample.elapsedSec = elapsedSec;
+        sample.count = data.count;
+        if (data.valid)
+        {
+            for (size_t i = 0; i < data.count; i++)
+            {
+                sample.valuesx100[i] = toFixed(data.values[i]);
+            }
+        }
+        return sample;
+    }
+
+    captors::SensorReadings PackedSample::unpack() const
+    {
+        captors::SensorReadings data;
+        data.count = count;
+        for (size_t i = 0; i < count && i < captors::MAX_SENSOR_CHANNELS; i++)
+        {
+            data.values[i] = fromFixed(valuesx100[i]);
+            data.valid = data.valid || valuesx100[i] != MISSING;
+        }
+        return data;
+    }
+
+    DutyCycle::DutyCycle(const DutyCycleConfig& config, const captors::SensorChannels& channels)
+        : _config(config)
+    {
+        const struct
+        {
+            const char* key;
+            float delta;
+        } deltas[] = {
+            {captors::channels::TEMPERATURE.key, config.temperatureDeltaC},
+            {captors::channels::SOIL_HUMIDITY.key, config.humidityDeltaPct},
+            {captors::channels::LUMINOSITY.key, config.luminosityDeltaPct},
+        };
+        for (const auto& entry : deltas)
+        {
+            int index = channels.find(entry.key);
+            if (index != captors::SensorChannels::NONE)
+            {
+                _deltas[index] = entry.delta;
+            }
+        }
+
+        if (_config.uploadEveryWakes == 0)
+        {
+            _config.uploadEveryWakes = 1;
+        }
+        if (_config.sleepIntervalSec == 0)
+        {
+            _config.sleepIntervalSec = 1;
+        }
+    }
+
+    void DutyCycle::reset(RtcSampleStore& store)
+    {
+        // memset rather than assignment: padding bytes are covered by the CRC
+        memset(static_cast<void*>(&store), 0, sizeof(store));
+        store.reference = PackedSample{};
+        store.magic = RtcSampleStore::MAGIC;
+        seal(store);
+    }
+
+    bool DutyCycle::isValid(const RtcSampleStore& store)
+    {
+        return store.magic == RtcSampleStore::MAGIC &&
+               store.count <= RtcSampleStore::CAPACITY &&
+               store.crc == common::utils::Crc32::compute(&store, offsetof(RtcSampleStore, crc));
+    }
+
+    void DutyCycle::seal(RtcSampleStore& store)
+    {
+        store.crc = common::utils::Crc32::compute(&store, offsetof(RtcSampleStore, crc));
+    }
+
+    bool DutyCycle::crossesThreshold(const RtcSampleStore& store, const PackedSample& sample) const
+    {
+        const PackedSample& ref = store.reference;
+        for (size_t i = 0; i < sample.count && i < captors::MAX_SENSOR_CHANNELS; i++)
+        {
+            if (movedBy(sample.valuesx100[i], ref.valuesx100[i], _deltas[i]))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void DutyCycle::addElapsed(RtcSampleStore& store, uint32_t ms)
+    {
+        uint64_t totalMs = static_cast<uint64_t>(store.elapsedMs) + ms;
+        store.elapsedSec += static_cast<uint32_t>(totalMs / 1000);
+        store.elapsedMs = static_cast<uint16_t>(totalMs % 1000);
+    }
+
+    UploadReason DutyCycle::onWake(RtcSampleStore& store, const captors::SensorReadings& data, uint32_t sleptMs) const
+    {
+        if (!isValid(store))
+        {
+            reset(store);
+        }
+        else
+        {
+            addElapsed(store, sleptMs);
+        }
+
+        store.wakeCount++;
+        store.wakesSinceUpload++;
+
+        if (store.count == RtcSampleStore::CAPACITY)
+        {
+            // Uploads keep failing: keep the newest data
+            memmove(&store.samples[0], &store.samples[1],
+                    (RtcSampleStore::CAPACITY - 1) * sizeof(PackedSample));
+            store.count--;
+            store.droppedSamples++;
+        }
+
+        PackedSample sample = PackedSample::pack(data, store.elapsedSec);
+        store.samples[store.count++] = sample;
+
+        if (store.retryPending && store.wakesSinceUpload < _config.uploadEveryWakes)
+        {
+            // The link was down: the reasons below still hold, but a radio
+            // session on every wake would drain the battery
+            seal(store);
+            return UploadReason::None;
+        }
+
+        UploadReason reason = UploadReason::None;
+        if (!store.hasReference)
+        {
+            reason = UploadReason::FirstSample;
+        }
+        else if (crossesThreshold(store, sample))
+        {
+            reason = UploadReason::Threshold;
+        }
+        else if (store.wakesSinceUpload >= _config.uploadEveryWakes)
+        {
+            reason = UploadReason::Interval;
+        }
+        else if (store.count == RtcSampleStore::CAPACITY)
+        {
+            reason = UploadReason::BufferFull;
+        }
+
+        seal(store);
+        return reason;
+    }
+
+    void DutyCycle::onEarlyWake(RtcSampleStore& store, uint32_t sleptMs) const
+    {
+        if (isValid(store))
+        {
+            addElapsed(store, sleptMs);
+            seal(store);
+        }
+    }
+
+    void DutyCycle::onSleep(RtcSampleStore& store, uint32_t awakeMs) const
+    {
+        if (isValid(store))
+        {
+            addElapsed(store, awakeMs);
+            seal(store);
+        }
+    }
+
+    void DutyCycle::onUploaded(RtcSampleStore& store) const
+    {
+        if (store.count > 0)
+        {
+            store.reference = store.samples[store.count - 1];
+            store.hasReference = true;
+        }
+        store.count = 0;
+        store.wakesSinceUpload = 0;
+        store.retryPending = false;
+        seal(store);
+    }
+
+    void DutyCycle::onUploadFailed(RtcSampleStore& store) const
+    {
+        // Keep the batch, retry after another uploadEveryWakes wakes
+        store.wakesSinceUpload = 0;
+        store.retryPending = true;
+        store.uploadFailures++;
+        seal(store);
+    }
+
+    void DutyCycle::onPartialUpload(RtcSampleStore& store, size_t published) const
+    {
+        if (published >= store.count)
+        {
+            onUploaded(store);
+            return;
+        }
+        if (published > 0)
+        {
+            // Those reached the broker; sending them again would duplicate them
+            store.reference = store.samples[published - 1];
+            store.hasReference = true;
+            memmove(&store.samples[0], &store.samples[published],
+                    (store.count - published) * sizeof(PackedSample));
+            store.count -= published;
+        }
+        onUploadFailed(store);
+    }
+
+    uint32_t DutyCycle::ageSec(const RtcSampleStore& store, size_t index)
+    {
+        if (store.count == 0 || index >= store.count)
+        {
+            return 0;
+        }
+        return store.elapsedSec - store.samples[index].elapsedSec;
+    }
+
+    uint64_t DutyCycle::sleepDurationUs(uint32_t awakeMs) const
+    {
+        uint64_t periodUs = static_cast<uint64_t>(_config.sleepIntervalSec) * 1000000ULL;
+        uint64_t awakeUs = static_cast<uint64_t>(awakeMs) * 1000ULL;
+        if (awakeUs + MIN_SLEEP_US >= periodUs)
+        {
+            return MIN_SLEEP_US;
+        }
+        return periodUs - awakeUs;
+    }
+
+    EnergyEstimate EnergyModel::estimate(const DutyCycleConfig& config, const PowerProfile& profile)
+    {
+        EnergyEstimate estimate;
+
+        float periodMs = static_cast<float>(config.sleepIntervalSec > 0 ? config.sleepIntervalSec : 1) * 1000.0f;
+        uint32_t wakesPerUpload = config.uploadEveryWakes > 0 ? config.uploadEveryWakes : 1;
+        if (wakesPerUpload > RtcSampleStore::CAPACITY)
+        {
+            wakesPerUpload = RtcSampleStore::CAPACITY;
+        }
+
+        // Charge per wake period, upload cost amortized over the batch
+        float uploadShareMs = static_cast<float>(profile.uploadActiveMs) / wakesPerUpload;
+        float activeMs = static_cast<float>(profile.sampleActiveMs) + uploadShareMs;
+        float sleepMs = periodMs > activeMs ? periodMs - activeMs : 0.0f;
+        float chargeMaMs = profile.sampleActiveMs * profile.sampleCurrentMa +
+                           uploadShareMs * profile.uploadCurrentMa +
+                           sleepMs * profile.deepSleepCurrentMa;
+
+        estimate.averageCurrentMa = chargeMaMs / (activeMs > periodMs ? activeMs : periodMs);
+        estimate.alwaysOnCurrentMa = profile.alwaysOnCurrentMa;
+        estimate.samplesPerHour = 3600000.0f / periodMs;
+        estimate.uploadsPerHour = estimate.samplesPerHour / wakesPerUpload;
+        estimate.uplinkBytesPerHour = estimate.samplesPerHour * profile.bytesPerSample +
+                                      estimate.uploadsPerHour * profile.bytesPerUpload;
+        estimate.worstCaseLatencySec = (wakesPerUpload - 1) * periodMs / 1000.0f;
+        return estimate;
+    }
+
+} // namespace plant_nanny::services::power
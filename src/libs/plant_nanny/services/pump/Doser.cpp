@@ -0,0 +1,101 @@
+#include "libs/plant_nanny/services/pump/Doser.h"
+#include "libs/plant_nanny/services/pump/Pump.h"
+#include "libs/plant_nanny/services/config/IConfigManager.h"
+#include "libs/common/service/Accessor.h"
+#include <Arduino.h>
+#include <cmath>
+
+namespace plant_nanny::services::pump
+{
+
+Doser::Doser()
+    : _pump(&common::service::get<IPump>().get()),
+      _sensors(&common::service::get<captors::ISensorManager>().get())
+{
+    configure(common::service::get<config::IConfigManager>()->getDosingConfig());
+}
+
+void Doser::configure(const DosingConfig& config)
+{
+    _controller.configure(config, Pump::SOFT_START_MS);
+}
+
+float Doser::readHumidity()
+{
+    // Unfiltered: the filter would lag the rise, and dose samples do not belong in telemetry
+    int channel = _sensors->channels().find(captors::channels::SOIL_HUMIDITY.key);
+    auto humidity = _sensors->readUnfiltered(channel);
+    return humidity.succeed() ? humidity.value() : NAN;
+}
+
+common::patterns::Result<void> Doser::start(const DoseRequest& request)
+{
+    auto result = _controller.start(request, readHumidity(), millis());
+    if (result.failed())
+    {
+        return result;
+    }
+
+    if (_callback)
+    {
+        _callback(true, _controller.report());
+    }
+    if (!_controller.running())
+    {
+        complete();
+        return result;
+    }
+    _pump->activate();
+    return result;
+}
+
+void Doser::update()
+{
+    if (!_controller.running())
+    {
+        return;
+    }
+
+    bool pumpOn = _controller.update(millis(), [this]() { return readHumidity(); });
+    if (pumpOn != _pump->isActive())
+    {
+        _pump->setActive(pumpOn);
+    }
+    if (!_controller.running())
+    {
+        complete();
+    }
+}
+
+void Doser::abort()
+{
+    if (!_controller.running())
+    {
+        return;
+    }
+    _controller.abort(millis());
+    complete();
+}
+
+void Doser::complete()
+{
+    _pump->deactivate();
+
+    const DoseReport& report = _controller.report();
+    // Only a closed-loop dose can tell; a dose that moved the soil clears the flag
+    if (report.outcome == DoseOutcome::DryReservoir)
+    {
+        _reservoirDry = true;
+    }
+    else if (report.deliveredMl > 0 && report.endPct >= report.startPct + _controller.config().minRisePct)
+    {
+        _reservoirDry = false;
+    }
+
+    if (_callback)
+    {
+        _callback(false, report);
+    }
+}
+
+} // namespace plant_nanny::services::pump
@@ -0,0 +1,164 @@
+#include "libs/plant_nanny/services/pump/DosingController.h"
+#include <algorithm>
+
+namespace plant_nanny::services::pump
+{
+    namespace
+    {
+        using common::patterns::Error;
+        using common::patterns::Result;
+    }
+
+    const char *to_string(DoseOutcome outcome)
+    {
+        switch (outcome)
+        {
+        case DoseOutcome::Delivered: return "delivered";
+        case DoseOutcome::TargetReached: return "target_reached";
+        case DoseOutcome::DryReservoir: return "dry_reservoir";
+        case DoseOutcome::Aborted: return "aborted";
+        }
+        return "unknown";
+    }
+
+    void DosingController::configure(const DosingConfig &config, uint32_t rampMs)
+    {
+        _config = config;
+        _rampMs = rampMs;
+    }
+
+    Result<void> DosingController::start(const DoseRequest &request, float humidityPct, uint32_t nowMs)
+    {
+        if (running())
+        {
+            return Result<void>::failure(Error("Dose already running"));
+        }
+        if (request.durationMs == 0 && request.amountMl == 0)
+        {
+            return Result<void>::failure(Error("Empty dose"));
+        }
+        if (!(_config.flowMlPerSec > 0.0f))
+        {
+            return Result<void>::failure(Error("Pump flow not calibrated"));
+        }
+
+        _request = request;
+        _report = DoseReport{};
+        _report.startPct = humidityPct;
+
+        // Soil already wet enough: nothing to pump
+        if (request.durationMs == 0 && !std::isnan(request.targetPct) && humidityPct >= request.targetPct)
+        {
+            finish(DoseOutcome::TargetReached, humidityPct);
+            return Result<void>::success();
+        }
+
+        startPulse(nowMs);
+        return Result<void>::success();
+    }
+
+    void DosingController::startPulse(uint32_t nowMs)
+    {
+        if (_request.durationMs > 0)
+        {
+            _pulseMs = _request.durationMs;
+            float effectiveMs = static_cast<float>(_pulseMs) - _rampMs / 2.0f;
+            _pulseMl = static_cast<uint16_t>(std::max(0.0f, std::round(_config.flowMlPerSec * effectiveMs / 1000.0f)));
+        }
+        else
+        {
+            uint16_t remaining = _request.amountMl - _report.deliveredMl;
+            _pulseMl = _config.pulseMl > 0 ? std::min(_config.pulseMl, remaining) : remaining;
+            _pulseMs = static_cast<uint32_t>(std::round(_pulseMl * 1000.0f / _config.flowMlPerSec)) + _rampMs / 2;
+        }
+
+        _phase = Phase::Pumping;
+        _phaseStartMs = nowMs;
+    }
+
+    void DosingController::finish(DoseOutcome outcome, float humidityPct)
+    {
+        _phase = Phase::Idle;
+        _report.outcome = outcome;
+        _report.endPct = humidityPct;
+    }
+
+    bool DosingController::update(uint32_t nowMs, const HumidityReader &readHumidity)
+    {
+        const uint32_t elapsedMs = nowMs - _phaseStartMs;
+
+        switch (_phase)
+        {
+        case Phase::Idle:
+            return false;
+
+        case Phase::Pumping:
+            if (elapsedMs < _pulseMs)
+            {
+                return true;
+            }
+            _report.deliveredMl += _pulseMl;
+            _report.pumpOnMs += _pulseMs;
+            if (_request.durationMs > 0 || _report.deliveredMl >= _request.amountMl)
+            {
+                finish(DoseOutcome::Delivered, readHumidity());
+                return false;
+            }
+            _phase = Phase::Soaking;
+            _phaseStartMs = nowMs;
+            return false;
+
+        case Phase::Soaking:
+        {
+            if (elapsedMs < _config.soakSec * 1000)
+            {
+                return false;
+            }
+
+            float humidity = readHumidity();
+            if (!std::isnan(humidity))
+            {
+                if (!std::isnan(_request.targetPct) && humidity >= _request.targetPct)
+                {
+                    finish(DoseOutcome::TargetReached, humidity);
+                    return false;
+                }
+                if (_report.deliveredMl >= _config.dryCheckMl && !std::isnan(_report.startPct) &&
+                    humidity - _report.startPct < _config.minRisePct)
+                {
+                    finish(DoseOutcome::DryReservoir, humidity);
+                    return false;
+                }
+            }
+            startPulse(nowMs);
+            return true;
+        }
+        }
+        return false;
+    }
+
+    void DosingController::abort(uint32_t nowMs)
+    {
+        if (_phase == Phase::Pumping && _pulseMs > 0)
+        {
+            uint32_t onMs = std::min(nowMs - _phaseStartMs, _pulseMs);
+            _report.deliveredMl += static_cast<uint16_t>(static_cast<uint64_t>(_pulseMl) * onMs / _pulseMs);
+            _report.pumpOnMs += onMs;
+        }
+        if (running())
+        {
+            finish(DoseOutcome::Aborted, NAN);
+        }
+    }
+
+    float DosingController::flowFromRun(float measuredMl, uint32_t durationMs, uint32_t rampMs)
+    {
+        float effectiveMs = static_cast<float>(durationMs) - rampMs / 2.0f;
+        if (!(measuredMl > 0.0f) || effectiveMs <= 0.0f)
+        {
+            return 0.0f;
+        }
+        return measuredMl * 1000.0f / effectiveMs;
+    }
+
+} // namespace plant_nanny::services::pump
@@ -1,24 +1,55 @@
 #include "libs/plant_nanny/services/pump/Pump.h"
 #include <Arduino.h>
+#include <driver/ledc.h>
 
 namespace plant_nanny::services::pump
 {
 
+namespace
+{
+    // Last low-speed channel and timer, clear of what Arduino's ledcSetup hands out first
+    constexpr ledc_mode_t PWM_MODE = LEDC_LOW_SPEED_MODE;
+    constexpr ledc_timer_t PWM_TIMER = LEDC_TIMER_3;
+    constexpr ledc_channel_t PWM_CHANNEL = LEDC_CHANNEL_7;
+    constexpr ledc_timer_bit_t PWM_RESOLUTION = LEDC_TIMER_10_BIT;
+    constexpr uint32_t FULL_DUTY = (1u << PWM_RESOLUTION) - 1;
+}
+
 Pump::Pump(uint8_t controlPin) : _controlPin(controlPin), _active(false)
 {
-    pinMode(_controlPin, OUTPUT);
-    digitalWrite(_controlPin, LOW);
+    ledc_timer_config_t timer = {};
+    timer.speed_mode = PWM_MODE;
+    timer.duty_resolution = PWM_RESOLUTION;
+    timer.timer_num = PWM_TIMER;
+    timer.freq_hz = PWM_FREQUENCY_HZ;
+    timer.clk_cfg = LEDC_AUTO_CLK;
+    ledc_timer_config(&timer);
+
+    ledc_channel_config_t channel = {};
+    channel.gpio_num = _controlPin;
+    channel.speed_mode = PWM_MODE;
+    channel.channel = PWM_CHANNEL;
+    channel.intr_type = LEDC_INTR_DISABLE;
+    channel.timer_sel = PWM_TIMER;
+    channel.duty = 0;
+    channel.hpoint = 0;
+    ledc_channel_config(&channel);
+
+    // Already installed is fine, fades only need the service once
+    ledc_fade_func_install(0);
 }
 
 void Pump::activate()
 {
-    digitalWrite(_controlPin, HIGH);
+    ledc_set_fade_with_time(PWM_MODE, PWM_CHANNEL, FULL_DUTY, SOFT_START_MS);
+    ledc_fade_start(PWM_MODE, PWM_CHANNEL, LEDC_FADE_NO_WAIT);
     _active = true;
 }
 
 void Pump::deactivate()
 {
-    digitalWrite(_controlPin, LOW);
+    // Waits for a ramp still in progress (at most SOFT_START_MS)
+    ledc_set_duty_and_update(PWM_MODE, PWM_CHANNEL, 0, 0);
     _active = false;
 }
 
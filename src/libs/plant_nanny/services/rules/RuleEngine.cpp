@@ -0,0 +1,150 @@
+#include "libs/plant_nanny/services/rules/RuleEngine.h"
+#include <cmath>
+#include <cstring>
+
+namespace plant_nanny::services::rules
+{
+    namespace
+    {
+        using common::patterns::Error;
+        using common::patterns::Result;
+
+        bool terminated(const char (&field)[sizeof(RuleCondition::channel)])
+        {
+            return memchr(field, '\0', sizeof(field)) != nullptr;
+        }
+
+        float humidityTarget(const WateringRule &rule)
+        {
+            for (size_t c = 0; c < rule.conditionCount; c++)
+            {
+                const RuleCondition &condition = rule.conditions[c];
+                if (condition.comparison == RuleComparison::Below &&
+                    strcmp(condition.channel, captors::channels::SOIL_HUMIDITY.key) == 0)
+                {
+                    return condition.threshold + condition.hysteresis;
+                }
+            }
+            return NAN;
+        }
+    }
+
+    Result<void> RuleEngine::validate(const WateringRules &rules, const captors::SensorChannels &channels)
+    {
+        if (rules.count > WateringRules::MAX_RULES)
+        {
+            return Result<void>::failure(Error("Too many rules"));
+        }
+
+        for (size_t r = 0; r < rules.count; r++)
+        {
+            const WateringRule &rule = rules.rules[r];
+            if (rule.conditionCount == 0 || rule.conditionCount > WateringRule::MAX_CONDITIONS)
+            {
+                return Result<void>::failure(Error("Rule needs 1 to 3 conditions"));
+            }
+            if (rule.waterAmountMl == 0 || rule.waterAmountMl > MAX_WATER_ML)
+            {
+                return Result<void>::failure(Error("Water amount out of range"));
+            }
+            if (rule.minCycleSec < MIN_CYCLE_SEC)
+            {
+                return Result<void>::failure(Error("Cycle shorter than 15 min"));
+            }
+
+            for (size_t c = 0; c < rule.conditionCount; c++)
+            {
+                const RuleCondition &condition = rule.conditions[c];
+                if (!terminated(condition.channel) || channels.find(condition.channel) == captors::SensorChannels::NONE)
+                {
+                    return Result<void>::failure(Error("Unknown channel in rule"));
+                }
+                if (!std::isfinite(condition.threshold) || !std::isfinite(condition.hysteresis) ||
+                    condition.hysteresis < 0.0f)
+                {
+                    return Result<void>::failure(Error("Invalid threshold or hysteresis"));
+                }
+            }
+        }
+        return Result<void>::success();
+    }
+
+    Result<void> RuleEngine::configure(const WateringRules &rules, const captors::SensorChannels &channels)
+    {
+        auto valid = validate(rules, channels);
+        if (valid.failed())
+        {
+            return valid;
+        }
+
+        _rules = rules;
+        for (size_t r = 0; r < _rules.count; r++)
+        {
+            for (size_t c = 0; c < _rules.rules[r].conditionCount; c++)
+            {
+                _channels[r][c] = static_cast<int8_t>(channels.find(_rules.rules[r].conditions[c].channel));
+            }
+            _state.active[r] = 0;
+        }
+        return Result<void>::success();
+    }
+
+    bool RuleEngine::updateCondition(const RuleCondition &condition, float value, bool active)
+    {
+        if (condition.comparison == RuleComparison::Below)
+        {
+            return active ? value <= condition.threshold + condition.hysteresis : value < condition.threshold;
+        }
+        return active ? value >= condition.threshold - condition.hysteresis : value > condition.threshold;
+    }
+
+    WateringDecision RuleEngine::evaluate(const captors::SensorReadings &readings, uint32_t nowSec)
+    {
+        if (_state.hasWatered && nowSec < _state.lastWateringSec)
+        {
+            _state.hasWatered = false;
+        }
+
+        WateringDecision decision;
+        for (size_t r = 0; r < _rules.count; r++)
+        {
+            const WateringRule &rule = _rules.rules[r];
+            bool allActive = true;
+            for (size_t c = 0; c < rule.conditionCount; c++)
+            {
+                const uint8_t bit = static_cast<uint8_t>(1u << c);
+                float value = readings.valid ? readings.get(_channels[r][c]) : NAN;
+                if (std::isnan(value))
+                {
+                    // Latch kept as is, but no watering on a missing reading
+                    allActive = false;
+                    continue;
+                }
+
+                if (updateCondition(rule.conditions[c], value, (_state.active[r] & bit) != 0))
+                {
+                    _state.active[r] |= bit;
+                }
+                else
+                {
+                    _state.active[r] &= static_cast<uint8_t>(~bit);
+                    allActive = false;
+                }
+            }
+
+            bool cycleElapsed = !_state.hasWatered || nowSec - _state.lastWateringSec >= rule.minCycleSec;
+            if (allActive && cycleElapsed && !decision.water)
+            {
+                decision = {true, static_cast<int>(r), rule.waterAmountMl, humidityTarget(rule)};
+            }
+        }
+        return decision;
+    }
+
+    void RuleEngine::noteWatering(uint32_t nowSec)
+    {
+        _state.hasWatered = true;
+        _state.lastWateringSec = nowSec;
+    }
+
+} // namespace plant_nanny::services::rules
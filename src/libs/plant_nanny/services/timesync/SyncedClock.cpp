@@ -0,0 +1,71 @@
+#include "libs/plant_nanny/services/timesync/SyncedClock.h"
+
+namespace plant_nanny::services::timesync
+{
+    int64_t SyncedClock::appliedSlew(uint64_t monotonicMs) const
+    {
+        if (_slewMs == 0 || monotonicMs <= _slewStartMs)
+        {
+            return 0;
+        }
+        int64_t budget = static_cast<int64_t>((monotonicMs - _slewStartMs) / SLEW_DIVISOR);
+        if (_slewMs > 0)
+        {
+            return budget < _slewMs ? budget : _slewMs;
+        }
+        return -budget > _slewMs ? -budget : _slewMs;
+    }
+
+    bool SyncedClock::sync(uint64_t monotonicMs, int64_t unixMs)
+    {
+        if (unixMs < MIN_VALID_UNIX_MS)
+        {
+            return false;
+        }
+
+        int64_t errorMs = 0;
+        if (!_status.synced)
+        {
+            _offsetMs = unixMs - static_cast<int64_t>(monotonicMs);
+            _status.synced = true;
+        }
+        else
+        {
+            // Fold what was already slewed in, then measure against the result
+            _offsetMs += appliedSlew(monotonicMs);
+            _slewMs = 0;
+            errorMs = unixMs - (static_cast<int64_t>(monotonicMs) + _offsetMs);
+            if (errorMs > STEP_THRESHOLD_MS || errorMs < -STEP_THRESHOLD_MS)
+            {
+                _offsetMs += errorMs;
+                _status.stepCount++;
+            }
+            else
+            {
+                _slewMs = errorMs;
+                _slewStartMs = monotonicMs;
+            }
+        }
+
+        _status.syncCount++;
+        _status.lastErrorMs = static_cast<int32_t>(errorMs);
+        _status.lastSyncMs = monotonicMs;
+        return true;
+    }
+
+    int64_t SyncedClock::unixMs(uint64_t monotonicMs) const
+    {
+        if (!_status.synced)
+        {
+            return 0;
+        }
+        return static_cast<int64_t>(monotonicMs) + _offsetMs + appliedSlew(monotonicMs);
+    }
+
+    uint64_t SyncedClock::widen(uint32_t stampMs, uint64_t nowMs)
+    {
+        uint32_t ageMs = static_cast<uint32_t>(nowMs) - stampMs;
+        return ageMs <= nowMs ? nowMs - ageMs : 0;
+    }
+
+} // namespace plant_nanny::services::timesync
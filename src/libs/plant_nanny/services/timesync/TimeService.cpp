@@ -0,0 +1,96 @@
+#include "libs/plant_nanny/services/timesync/TimeService.h"
+#include "libs/common/logger/Log.h"
+#include <esp_sntp.h>
+#include <esp_timer.h>
+#include <sys/time.h>
+#include <cstdio>
+
+namespace plant_nanny::services::timesync
+{
+
+TimeService* TimeService::instance_ = nullptr;
+
+TimeService::TimeService()
+{
+    instance_ = this;
+}
+
+TimeService::~TimeService()
+{
+    if (_started)
+    {
+        sntp_stop();
+    }
+    instance_ = nullptr;
+}
+
+void TimeService::onTimeSync(struct timeval* tv)
+{
+    if (instance_ == nullptr || tv == nullptr)
+    {
+        return;
+    }
+    // Pair the answer with the monotonic clock right away; update() may run much later
+    SyncSample sample{static_cast<uint64_t>(esp_timer_get_time() / 1000),
+                      static_cast<int64_t>(tv->tv_sec) * 1000 + tv->tv_usec / 1000};
+    instance_->_samples.push(sample);
+}
+
+void TimeService::start()
+{
+    if (_started)
+    {
+        // New link: ask now instead of waiting for the next poll
+        sntp_restart();
+        return;
+    }
+
+    sntp_setoperatingmode(SNTP_OPMODE_POLL);
+    sntp_setservername(0, SNTP_SERVER);
+    sntp_set_sync_interval(SYNC_INTERVAL_MS);
+    sntp_set_time_sync_notification_cb(&TimeService::onTimeSync);
+    sntp_init();
+    _started = true;
+    LOG_INFO("[TIME] SNTP started");
+}
+
+void TimeService::update()
+{
+    SyncSample sample;
+    while (_samples.pop(sample))
+    {
+        bool first = !_clock.synced();
+        uint32_t steps = _clock.status().stepCount;
+        if (!_clock.sync(sample.monotonicMs, sample.unixMs))
+        {
+            LOG_WARN("[TIME] Implausible time from server, ignored");
+            continue;
+        }
+
+        char msg[80];
+        if (first)
+        {
+            snprintf(msg, sizeof(msg), "[TIME] Synced: %lld", static_cast<long long>(sample.unixMs / 1000));
+        }
+        else
+        {
+            snprintf(msg, sizeof(msg), "[TIME] Resynced, error %ld ms%s",
+                     static_cast<long>(_clock.status().lastErrorMs),
+                     _clock.status().stepCount != steps ? " (stepped)" : "");
+        }
+        LOG_INFO(msg);
+    }
+}
+
+uint64_t TimeService::monotonicMs() const
+{
+    return static_cast<uint64_t>(esp_timer_get_time() / 1000);
+}
+
+uint32_t TimeService::unixTimeAt(uint32_t stampMs) const
+{
+    int64_t unixMs = _clock.unixMs(SyncedClock::widen(stampMs, monotonicMs()));
+    return static_cast<uint32_t>(unixMs / 1000);
+}
+
+} // namespace plant_nanny::services::timesync
@@ -2,18 +2,30 @@
 
 namespace plant_nanny
 {
+    StateMachine::StateMachine(StateClock clock)
+        : _clock(std::move(clock))
+    {
+    }
+
     void StateMachine::registerState(std::shared_ptr<IAppState> state)
     {
-        if (state)
+        if (state && index(state->id()) < STATE_COUNT && state->id() != StateId::None)
         {
-            _states[state->id()] = state;
+            _states[index(state->id())] = std::move(state);
         }
     }
 
-    bool StateMachine::transitionTo(const std::string& stateId, AppContext& context)
+    bool StateMachine::transitionTo(StateId stateId, AppContext& context, TransitionCause cause)
     {
-        auto it = _states.find(stateId);
-        if (it == _states.end())
+        TransitionRecord record;
+        record.atMs = now();
+        record.from = _currentStateId;
+        record.to = stateId;
+        record.cause = cause;
+        record.accepted = isAllowed(_currentStateId, stateId) && _states[index(stateId)] != nullptr;
+        _trace.record(record);
+
+        if (!record.accepted)
         {
             return false;
         }
@@ -23,7 +35,9 @@ namespace plant_nanny
             _currentState->onExit(context);
         }
 
-        _currentState = it->second;
+        _timeoutArmed = false;
+        _enterAt = record.atMs;
+        _currentState = _states[index(stateId)].get();
         _currentStateId = stateId;
         _currentState->onEnter(context);
 
@@ -37,19 +51,38 @@ namespace plant_nanny
             return;
         }
 
-        std::string nextState = _currentState->handleButton(context, event);
-        if (!nextState.empty() && nextState != _currentStateId)
+        StateId nextState = _currentState->handleButton(context, event);
+        if (nextState != StateId::None && nextState != _currentStateId)
         {
-            transitionTo(nextState, context);
+            transitionTo(nextState, context, TransitionCause::Button);
         }
     }
 
     void StateMachine::update(AppContext& context)
     {
-        if (_currentState)
+        if (!_currentState)
+        {
+            return;
+        }
+
+        _currentState->update(context);
+
+        // Wrap-safe: millis() rolls over after ~49 days
+        if (_timeoutArmed && static_cast<int32_t>(now() - _timeoutAt) >= 0)
         {
-            _currentState->update(context);
+            _timeoutArmed = false;
+            StateId nextState = _currentState->onTimeout(context);
+            if (nextState != StateId::None && nextState != _currentStateId)
+            {
+                transitionTo(nextState, context, TransitionCause::Timeout);
+            }
         }
     }
 
+    void StateMachine::armTimeout(uint32_t delayMs)
+    {
+        _timeoutAt = now() + delayMs;
+        _timeoutArmed = true;
+    }
+
 } // namespace plant_nanny
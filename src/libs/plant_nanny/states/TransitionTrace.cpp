@@ -0,0 +1,75 @@
+#include "libs/plant_nanny/states/TransitionTrace.h"
+#include <cstdio>
+
+namespace plant_nanny
+{
+    const char* to_string(TransitionCause cause)
+    {
+        switch (cause)
+        {
+            case TransitionCause::Request: return "request";
+            case TransitionCause::Button:  return "button";
+            case TransitionCause::Timeout: return "timeout";
+            default:                       return "unknown";
+        }
+    }
+
+    void TransitionTrace::record(const TransitionRecord& record)
+    {
+        _records[_next] = record;
+        _next = (_next + 1) % CAPACITY;
+        _total++;
+        if (!record.accepted)
+        {
+            _rejected++;
+        }
+    }
+
+    const TransitionRecord& TransitionTrace::at(size_t i) const
+    {
+        size_t oldest = _total < CAPACITY ? 0 : _next;
+        return _records[(oldest + i) % CAPACITY];
+    }
+
+    size_t TransitionTrace::toJson(char* buffer, size_t bufferSize, StateId current, uint32_t nowMs) const
+    {
+        size_t used = 0;
+        auto append = [&](int written) {
+            if (written < 0 || used + static_cast<size_t>(written) >= bufferSize)
+            {
+                used = bufferSize;  // Mark as overflowed
+                return false;
+            }
+            used += static_cast<size_t>(written);
+            return true;
+        };
+
+        if (bufferSize == 0 ||
+            !append(snprintf(buffer, bufferSize,
+                             "{\"type\":\"state_trace\",\"now\":%lu,\"current\":\"%s\",\"total\":%lu,\"rejected\":%lu,\"transitions\":[",
+                             static_cast<unsigned long>(nowMs), to_string(current),
+                             static_cast<unsigned long>(_total), static_cast<unsigned long>(_rejected))))
+        {
+            return 0;
+        }
+
+        for (size_t i = 0; i < size(); i++)
+        {
+            const TransitionRecord& r = at(i);
+            if (!append(snprintf(buffer + used, bufferSize - used,
+                                 "%s{\"t\":%lu,\"from\":\"%s\",\"to\":\"%s\",\"cause\":\"%s\",\"ok\":%s}",
+                                 i > 0 ? "," : "", static_cast<unsigned long>(r.atMs), to_string(r.from),
+                                 to_string(r.to), to_string(r.cause), r.accepted ? "true" : "false")))
+            {
+                return 0;
+            }
+        }
+
+        if (!append(snprintf(buffer + used, bufferSize - used, "]}")))
+        {
+            return 0;
+        }
+        return used;
+    }
+
+} // namespace plant_nanny
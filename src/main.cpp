@@ -1,4 +1,5 @@
 #include <Arduino.h>
+#include <esp_sleep.h>
 #include "libs/plant_nanny/App.h"
 
 plant_nanny::App app;
@@ -6,7 +7,11 @@ plant_nanny::App app;
 void setup()
 {
     Serial.begin(115200);
-    delay(1000);
+    // Give the serial monitor time to attach, except on duty-cycle timer wakes
+    if (esp_sleep_get_wakeup_cause() != ESP_SLEEP_WAKEUP_TIMER)
+    {
+        delay(1000);
+    }
     
     app.initialize();
 }
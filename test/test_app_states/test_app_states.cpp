@@ -0,0 +1,329 @@
+#include <unity.h>
+#include "libs/common/service/Registry.h"
+#include "libs/plant_nanny/states/StateMachine.h"
+#include "libs/plant_nanny/states/NormalState.h"
+#include "libs/plant_nanny/states/PairingState.h"
+#include "libs/plant_nanny/states/ResettingState.h"
+#include "testing/libs/plant_nanny/services/config/MockConfigManager.h"
+#include "testing/libs/plant_nanny/services/bluetooth/MockPairingManager.h"
+#include <memory>
+#include <string>
+
+using namespace plant_nanny;
+using services::button::ButtonEvent;
+using testing::mocks::MockConfigManager;
+using testing::mocks::MockPairingManager;
+
+namespace
+{
+    uint32_t fake_now_ms = 0;
+
+    class RecordingScreen : public ui::IScreen
+    {
+    public:
+        void render() override {}
+    };
+
+    /**
+     * @brief AppContext wired to a real StateMachine and a fake clock
+     *
+     * requestTransition() is applied on the next tick, like App does.
+     */
+    class TestContext : public AppContext
+    {
+    public:
+        ui::ScreenManager screens;
+        ui::screens::PairingScreen pairing;
+        StateMachine machine{[]() { return fake_now_ms; }};
+        std::string pin;
+        StateId requested = StateId::None;
+        int restarts = 0;
+
+        TestContext()
+        {
+            for (const char *id : {"normal", "pairing", "success", "reset", "already_paired"})
+            {
+                screens.registerScreen(id, std::make_shared<RecordingScreen>());
+            }
+            machine.registerState(std::make_shared<states::NormalState>());
+            machine.registerState(std::make_shared<states::PairingState>());
+            machine.registerState(std::make_shared<states::ResettingState>());
+        }
+
+        ui::ScreenManager &screenManager() override { return screens; }
+        void setCurrentPin(const std::string &value) override { pin = value; }
+        const std::string &currentPin() const override { return pin; }
+        ui::screens::PairingScreen &pairingScreen() override { return pairing; }
+        void requestTransition(StateId stateId) override { requested = stateId; }
+        void armStateTimeout(uint32_t delayMs) override { machine.armTimeout(delayMs); }
+        void restart() override { restarts++; }
+
+        void tick()
+        {
+            machine.update(*this);
+            if (requested != StateId::None)
+            {
+                StateId next = requested;
+                requested = StateId::None;
+                machine.transitionTo(next, *this);
+            }
+        }
+
+        // Advance the fake clock in 50 ms state-task ticks
+        void advance(uint32_t ms)
+        {
+            for (uint32_t elapsed = 0; elapsed < ms; elapsed += 50)
+            {
+                fake_now_ms += 50;
+                tick();
+            }
+        }
+
+        const std::string &screen() const { return screens.currentScreenId(); }
+    };
+
+    MockConfigManager *config = nullptr;
+    MockPairingManager *pairingManager = nullptr;
+}
+
+void setUp(void)
+{
+    fake_now_ms = 1000;
+    common::service::DefaultRegistry::create();
+    config = new MockConfigManager();
+    pairingManager = new MockPairingManager();
+    common::service::add<services::config::IConfigManager>(*config);
+    common::service::add<services::bluetooth::IPairingManager>(*pairingManager);
+}
+
+void tearDown(void)
+{
+    common::service::remove<services::config::IConfigManager>();
+    common::service::remove<services::bluetooth::IPairingManager>();
+    delete config;
+    delete pairingManager;
+}
+
+void test_normal_state_enters_normal_screen()
+{
+    TestContext context;
+    TEST_ASSERT_TRUE(context.machine.transitionTo(StateId::Normal, context));
+    TEST_ASSERT_EQUAL_STRING("normal", context.screen().c_str());
+    TEST_ASSERT_EQUAL_UINT32(1000, context.machine.enterAt());
+    TEST_ASSERT_FALSE(context.machine.timeoutArmed());
+}
+
+void test_normal_state_buttons()
+{
+    TestContext context;
+    context.machine.transitionTo(StateId::Normal, context);
+
+    context.machine.handleButton(context, ButtonEvent::LEFT_SHORT_PRESS);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Normal);
+
+    context.machine.handleButton(context, ButtonEvent::LEFT_LONG_PRESS);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Pairing);
+}
+
+void test_pairing_state_starts_pairing_and_shows_pin()
+{
+    TestContext context;
+    context.machine.transitionTo(StateId::Normal, context);
+    context.machine.transitionTo(StateId::Pairing, context);
+
+    TEST_ASSERT_EQUAL(1, pairingManager->starts);
+    TEST_ASSERT_EQUAL_STRING("pairing", context.screen().c_str());
+    TEST_ASSERT_EQUAL_STRING("123456", context.pin.c_str());
+    TEST_ASSERT_FALSE(context.machine.timeoutArmed());
+
+    context.advance(200);
+    TEST_ASSERT_EQUAL(4, pairingManager->updates);
+}
+
+void test_pairing_state_cancel_button_stops_pairing()
+{
+    TestContext context;
+    context.machine.transitionTo(StateId::Normal, context);
+    context.machine.transitionTo(StateId::Pairing, context);
+
+    context.machine.handleButton(context, ButtonEvent::LEFT_SHORT_PRESS);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Normal);
+    TEST_ASSERT_EQUAL(1, pairingManager->stops);
+    TEST_ASSERT_EQUAL_STRING("", context.pin.c_str());
+}
+
+void test_pairing_state_already_paired_returns_after_deadline()
+{
+    config->configured = true;
+    TestContext context;
+    context.machine.transitionTo(StateId::Normal, context);
+    context.machine.transitionTo(StateId::Pairing, context);
+
+    TEST_ASSERT_EQUAL(0, pairingManager->starts);
+    TEST_ASSERT_EQUAL_STRING("already_paired", context.screen().c_str());
+    TEST_ASSERT_EQUAL_UINT32(1000 + states::PairingState::ALREADY_PAIRED_SCREEN_MS,
+                             context.machine.timeoutAt());
+
+    context.advance(states::PairingState::ALREADY_PAIRED_SCREEN_MS - 50);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Pairing);
+
+    context.advance(50);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Normal);
+    const TransitionTrace &trace = context.machine.trace();
+    TEST_ASSERT_TRUE(trace.at(trace.size() - 1).cause == TransitionCause::Timeout);
+}
+
+void test_pairing_state_success_keeps_ble_serviced_until_deadline()
+{
+    TestContext context;
+    context.machine.transitionTo(StateId::Normal, context);
+    context.machine.transitionTo(StateId::Pairing, context);
+
+    pairingManager->completePairing(true);
+    context.advance(50);
+    TEST_ASSERT_EQUAL_STRING("success", context.screen().c_str());
+    TEST_ASSERT_TRUE(context.machine.timeoutArmed());
+
+    int updatesBefore = pairingManager->updates;
+    context.advance(states::PairingState::SUCCESS_SCREEN_MS - 50);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Pairing);
+    TEST_ASSERT_TRUE(pairingManager->updates - updatesBefore >= 90);
+
+    context.advance(50);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Normal);
+    TEST_ASSERT_EQUAL_STRING("normal", context.screen().c_str());
+    TEST_ASSERT_EQUAL(1, pairingManager->stops);
+}
+
+void test_pairing_state_releases_ble_memory_once_configured()
+{
+    TestContext context;
+    context.machine.transitionTo(StateId::Normal, context);
+
+    // Cancelled pairing: BLE may be needed again
+    context.machine.transitionTo(StateId::Pairing, context);
+    context.machine.handleButton(context, ButtonEvent::LEFT_SHORT_PRESS);
+    TEST_ASSERT_EQUAL(1, pairingManager->stops);
+    TEST_ASSERT_EQUAL(0, pairingManager->releases);
+
+    // Provisioned: the network task marks the device configured
+    context.machine.transitionTo(StateId::Pairing, context);
+    config->configured = true;
+    pairingManager->completePairing(true);
+    context.advance(states::PairingState::SUCCESS_SCREEN_MS + 50);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Normal);
+    TEST_ASSERT_EQUAL(2, pairingManager->stops);
+    TEST_ASSERT_EQUAL(1, pairingManager->releases);
+}
+
+void test_pairing_state_failure_returns_immediately()
+{
+    TestContext context;
+    context.machine.transitionTo(StateId::Normal, context);
+    context.machine.transitionTo(StateId::Pairing, context);
+
+    pairingManager->completePairing(false);
+    context.advance(50);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Normal);
+    TEST_ASSERT_FALSE(context.machine.timeoutArmed());
+}
+
+void test_pairing_state_deadline_disarmed_by_cancel()
+{
+    TestContext context;
+    context.machine.transitionTo(StateId::Normal, context);
+    context.machine.transitionTo(StateId::Pairing, context);
+    pairingManager->completePairing(true);
+    context.advance(50);
+
+    context.machine.handleButton(context, ButtonEvent::LEFT_SHORT_PRESS);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Normal);
+    TEST_ASSERT_FALSE(context.machine.timeoutArmed());
+
+    uint32_t transitions = context.machine.trace().total();
+    context.advance(states::PairingState::SUCCESS_SCREEN_MS);
+    TEST_ASSERT_EQUAL_UINT32(transitions, context.machine.trace().total());
+}
+
+void test_resetting_state_resets_then_restarts_after_deadline()
+{
+    config->configured = true;
+    TestContext context;
+    context.machine.transitionTo(StateId::Normal, context);
+    context.machine.handleButton(context, ButtonEvent::RIGHT_LONG_PRESS);
+
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Resetting);
+    TEST_ASSERT_EQUAL_STRING("reset", context.screen().c_str());
+    TEST_ASSERT_EQUAL(1, config->factoryResets);
+    TEST_ASSERT_FALSE(config->configured);
+    TEST_ASSERT_EQUAL(1, pairingManager->unpairs);
+    TEST_ASSERT_EQUAL(0, context.restarts);
+
+    context.advance(states::ResettingState::RESET_SCREEN_MS - 50);
+    TEST_ASSERT_EQUAL(0, context.restarts);
+    context.advance(50);
+    TEST_ASSERT_EQUAL(1, context.restarts);
+
+    // Fires once
+    context.advance(1000);
+    TEST_ASSERT_EQUAL(1, context.restarts);
+}
+
+void test_state_deadline_survives_clock_wrap()
+{
+    fake_now_ms = UINT32_MAX - 1000;
+    config->configured = true;
+    TestContext context;
+    context.machine.transitionTo(StateId::Normal, context);
+    context.machine.transitionTo(StateId::Pairing, context);
+
+    context.advance(1000);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Pairing);
+    context.advance(states::PairingState::ALREADY_PAIRED_SCREEN_MS);
+    TEST_ASSERT_TRUE(context.machine.currentStateId() == StateId::Normal);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_normal_state_enters_normal_screen);
+    RUN_TEST(test_normal_state_buttons);
+    RUN_TEST(test_pairing_state_starts_pairing_and_shows_pin);
+    RUN_TEST(test_pairing_state_cancel_button_stops_pairing);
+    RUN_TEST(test_pairing_state_already_paired_returns_after_deadline);
+    RUN_TEST(test_pairing_state_success_keeps_ble_serviced_until_deadline);
+    RUN_TEST(test_pairing_state_releases_ble_memory_once_configured);
+    RUN_TEST(test_pairing_state_failure_returns_immediately);
+    RUN_TEST(test_pairing_state_deadline_disarmed_by_cancel);
+    RUN_TEST(test_resetting_state_resets_then_restarts_after_deadline);
+    RUN_TEST(test_state_deadline_survives_clock_wrap);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_normal_state_enters_normal_screen);
+    RUN_TEST(test_normal_state_buttons);
+    RUN_TEST(test_pairing_state_starts_pairing_and_shows_pin);
+    RUN_TEST(test_pairing_state_cancel_button_stops_pairing);
+    RUN_TEST(test_pairing_state_already_paired_returns_after_deadline);
+    RUN_TEST(test_pairing_state_success_keeps_ble_serviced_until_deadline);
+    RUN_TEST(test_pairing_state_releases_ble_memory_once_configured);
+    RUN_TEST(test_pairing_state_failure_returns_immediately);
+    RUN_TEST(test_pairing_state_deadline_disarmed_by_cancel);
+    RUN_TEST(test_resetting_state_resets_then_restarts_after_deadline);
+    RUN_TEST(test_state_deadline_survives_clock_wrap);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,254 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/captors/calibration/Calibration.h"
+#include "libs/plant_nanny/services/captors/adc/AdcLinearization.h"
+#include "libs/plant_nanny/services/captors/humidity/Humidity.h"
+#include "libs/plant_nanny/services/captors/luminosity/Luminosity.h"
+#include "testing/libs/plant_nanny/services/config/MockConfigManager.h"
+#include <cmath>
+#include <cstring>
+
+using namespace plant_nanny::services::captors;
+using namespace plant_nanny::services::captors::calibration;
+using plant_nanny::services::captors::adc::AdcLinearization;
+using plant_nanny::services::config::SensorCalibration;
+using plant_nanny::services::config::TwoPointCalibration;
+
+namespace
+{
+    /**
+     * Sensor manager whose ADC reads whatever the test puts in front of the probe
+     */
+    class FakeSensors : public ISensorManager
+    {
+    public:
+        float adc[MAX_SENSOR_CHANNELS] = {NAN, NAN, NAN, NAN, NAN, NAN};
+        SensorCalibration applied;
+        int applies = 0;
+
+        void initialize() override {}
+        void initialize(const SensorPins &) override {}
+        void configureThermistor(const temperature::ThermistorConfig &) override {}
+        SensorReadings read() override { return {}; }
+        const SensorChannels &channels() const override { return SensorChannels::defaults(); }
+
+        common::patterns::Result<float> readAdc(int channel) override
+        {
+            if (channel < 0 || std::isnan(adc[channel]))
+            {
+                return common::patterns::Result<float>::failure(common::patterns::Error("No ADC sample"));
+            }
+            return common::patterns::Result<float>::success(adc[channel]);
+        }
+
+        common::patterns::Result<float> readUnfiltered(int channel) override { return readAdc(channel); }
+
+        void applyCalibration(const SensorCalibration &calibration) override
+        {
+            applied = calibration;
+            applies++;
+        }
+
+        void present(const ChannelInfo &channel, float value) { adc[channels().find(channel.key)] = value; }
+    };
+
+    CalibrationRequest request(const char *sensor, const char *point)
+    {
+        CalibrationRequest parsed;
+        TEST_ASSERT_TRUE(parse(sensor, point, parsed));
+        return parsed;
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_parse_accepts_sensor_specific_points()
+{
+    CalibrationRequest parsed;
+    TEST_ASSERT_TRUE(parse("humidity", "wet", parsed));
+    TEST_ASSERT_TRUE(parsed.sensor == CalibrationSensor::Humidity);
+    TEST_ASSERT_TRUE(parsed.point == CalibrationPoint::Full);
+
+    TEST_ASSERT_TRUE(parse(std::string("luminosity:dark"), parsed));
+    TEST_ASSERT_TRUE(parsed.sensor == CalibrationSensor::Luminosity);
+    TEST_ASSERT_TRUE(parsed.point == CalibrationPoint::Zero);
+    TEST_ASSERT_EQUAL_STRING("dark", pointName(parsed));
+
+    TEST_ASSERT_TRUE(parse("luminosity", "reset", parsed));
+    TEST_ASSERT_TRUE(parsed.point == CalibrationPoint::Reset);
+
+    TEST_ASSERT_FALSE(parse("humidity", "bright", parsed));
+    TEST_ASSERT_FALSE(parse("temperature", "dry", parsed));
+    TEST_ASSERT_FALSE(parse(std::string("humidity"), parsed));
+}
+
+void test_record_keeps_other_point_and_rejects_narrow_span()
+{
+    SensorCalibration calibration;
+    auto dry = record(calibration, request("humidity", "dry"), 3210.0f);
+    TEST_ASSERT_TRUE(dry.succeed());
+    TEST_ASSERT_EQUAL_FLOAT(3210.0f, dry.value().humidity.zeroAdc);
+    TEST_ASSERT_FALSE(dry.value().humidity.hasFull());
+    TEST_ASSERT_FALSE(dry.value().luminosity.hasZero());
+
+    // Probe not moved between both captures
+    TEST_ASSERT_TRUE(record(dry.value(), request("humidity", "wet"), 3210.0f - MIN_SPAN / 2).failed());
+    TEST_ASSERT_TRUE(record(dry.value(), request("humidity", "wet"), NAN).failed());
+    TEST_ASSERT_TRUE(record(dry.value(), request("humidity", "wet"), 5000.0f).failed());
+
+    auto wet = record(dry.value(), request("humidity", "wet"), 1320.0f);
+    TEST_ASSERT_TRUE(wet.succeed());
+    TEST_ASSERT_EQUAL_FLOAT(3210.0f, wet.value().humidity.zeroAdc);
+    TEST_ASSERT_EQUAL_FLOAT(1320.0f, wet.value().humidity.fullAdc);
+
+    auto reset = record(wet.value(), request("humidity", "reset"), NAN);
+    TEST_ASSERT_TRUE(reset.succeed());
+    TEST_ASSERT_FALSE(reset.value().humidity.hasZero());
+    TEST_ASSERT_FALSE(reset.value().humidity.hasFull());
+}
+
+void test_run_captures_persists_and_applies()
+{
+    FakeSensors sensors;
+    testing::mocks::MockConfigManager config;
+
+    sensors.present(channels::SOIL_HUMIDITY, 2900.0f);
+    auto dry = run(sensors, config, request("humidity", "dry"));
+    TEST_ASSERT_TRUE(dry.succeed());
+    TEST_ASSERT_EQUAL_FLOAT(2900.0f, dry.value());
+
+    sensors.present(channels::SOIL_HUMIDITY, 1100.0f);
+    TEST_ASSERT_TRUE(run(sensors, config, request("humidity", "wet")).succeed());
+
+    TEST_ASSERT_EQUAL(2, config.calibrationSaves);
+    TEST_ASSERT_EQUAL_FLOAT(2900.0f, config.calibration.humidity.zeroAdc);
+    TEST_ASSERT_EQUAL_FLOAT(1100.0f, config.calibration.humidity.fullAdc);
+    TEST_ASSERT_EQUAL(2, sensors.applies);
+    TEST_ASSERT_EQUAL_FLOAT(1100.0f, sensors.applied.humidity.fullAdc);
+}
+
+void test_run_failure_leaves_calibration_untouched()
+{
+    FakeSensors sensors;
+    testing::mocks::MockConfigManager config;
+    config.calibration.luminosity.zeroAdc = 150.0f;
+
+    // Disconnected LDR: no sample
+    TEST_ASSERT_TRUE(run(sensors, config, request("luminosity", "bright")).failed());
+
+    sensors.present(channels::LUMINOSITY, 200.0f);
+    auto tooClose = run(sensors, config, request("luminosity", "bright"));
+    TEST_ASSERT_TRUE(tooClose.failed());
+
+    TEST_ASSERT_EQUAL(0, config.calibrationSaves);
+    TEST_ASSERT_EQUAL(0, sensors.applies);
+    TEST_ASSERT_FALSE(config.calibration.luminosity.hasFull());
+
+    char json[160];
+    size_t length = toJson(request("luminosity", "bright"), tooClose, json, sizeof(json));
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"ok\":false"));
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"point\":\"bright\""));
+}
+
+void test_humidity_uses_captured_points()
+{
+    humidity::Humidity probe;
+    probe.initialize(32);
+
+    // This unit reads lower than the typical probe in both conditions
+    TwoPointCalibration points;
+    points.zeroAdc = 3300.0f;
+    points.fullAdc = 1100.0f;
+    probe.calibrate(points);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, probe.convert(3300.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, probe.convert(2200.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, probe.convert(1100.0f));
+
+    // Only the dry point captured: wet stays at the default
+    probe.calibrate(TwoPointCalibration{3300.0f, NAN});
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, probe.convert(humidity::Humidity::DEFAULT_WET_VALUE));
+}
+
+void test_luminosity_uses_captured_points()
+{
+    luminosity::Luminosity ldr;
+    ldr.initialize(36);
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, ldr.convert(4095.0f / 2));
+
+    ldr.calibrate(TwoPointCalibration{400.0f, 2400.0f});
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 0.0f, ldr.convert(300.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, ldr.convert(1400.0f));
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 100.0f, ldr.convert(3000.0f));
+
+    // Reset: back to the full-scale map
+    ldr.calibrate(TwoPointCalibration{});
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 50.0f, ldr.convert(4095.0f / 2));
+}
+
+void test_linearization_corrects_gain_offset_and_bend()
+{
+    AdcLinearization linearization;
+    TEST_ASSERT_EQUAL_FLOAT(1234.0f, linearization.apply(1234.0f));  // Identity until built
+
+    // Chip reading 60 mV high at zero, 3 % low in gain, flattening above 2.6 V
+    auto characteristic = [](uint32_t raw) -> uint32_t
+    {
+        double mv = 60.0 + raw * 3300.0 / 4095.0 * 1.03;
+        if (mv > 2600.0)
+        {
+            mv = 2600.0 + (mv - 2600.0) * 1.4;
+        }
+        return static_cast<uint32_t>(std::lround(mv));
+    };
+    linearization.build(characteristic);
+    TEST_ASSERT_TRUE(linearization.built());
+
+    float worst = 0.0f;
+    for (uint32_t raw = 0; raw <= AdcLinearization::RAW_MAX; raw += 7)
+    {
+        float expected = characteristic(raw) * 4095.0f / AdcLinearization::SUPPLY_MV;
+        worst = std::fmax(worst, std::fabs(linearization.apply(static_cast<float>(raw)) - expected));
+    }
+    // Only the knee falls between two table points
+    TEST_ASSERT_TRUE(worst < 8.0f);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 60.0f * 4095.0f / 3300.0f, linearization.apply(0.0f));
+    TEST_ASSERT_TRUE(std::isnan(linearization.apply(NAN)));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_parse_accepts_sensor_specific_points);
+    RUN_TEST(test_record_keeps_other_point_and_rejects_narrow_span);
+    RUN_TEST(test_run_captures_persists_and_applies);
+    RUN_TEST(test_run_failure_leaves_calibration_untouched);
+    RUN_TEST(test_humidity_uses_captured_points);
+    RUN_TEST(test_luminosity_uses_captured_points);
+    RUN_TEST(test_linearization_corrects_gain_offset_and_bend);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_parse_accepts_sensor_specific_points);
+    RUN_TEST(test_record_keeps_other_point_and_rejects_narrow_span);
+    RUN_TEST(test_run_captures_persists_and_applies);
+    RUN_TEST(test_run_failure_leaves_calibration_untouched);
+    RUN_TEST(test_humidity_uses_captured_points);
+    RUN_TEST(test_luminosity_uses_captured_points);
+    RUN_TEST(test_linearization_corrects_gain_offset_and_bend);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,245 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/captors/adc/AdcSampleBuffer.h"
+#include "libs/plant_nanny/services/captors/temperature/Temperature.h"
+#include "libs/plant_nanny/services/captors/humidity/Humidity.h"
+#include "libs/plant_nanny/services/captors/luminosity/Luminosity.h"
+#include "libs/plant_nanny/services/captors/IAdcConverter.h"
+#include "libs/plant_nanny/services/captors/SensorChannel.h"
+#include <cmath>
+#include <vector>
+
+using plant_nanny::services::captors::adc::AdcSampleBuffer;
+using namespace plant_nanny::services::captors;
+
+namespace
+{
+    // One ADC_DIGI_OUTPUT_FORMAT_TYPE1 entry as the DMA writes it
+    void entry(std::vector<uint8_t> &frame, uint8_t channel, uint16_t value)
+    {
+        uint16_t word = static_cast<uint16_t>((channel << 12) | (value & 0x0FFF));
+        frame.push_back(static_cast<uint8_t>(word & 0xFF));
+        frame.push_back(static_cast<uint8_t>(word >> 8));
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_adc_buffer_decodes_round_robin_frame()
+{
+    AdcSampleBuffer buffer;
+    int thermistor = buffer.addChannel(5);  // GPIO 33
+    int ldr = buffer.addChannel(0);         // GPIO 36
+    int soil = buffer.addChannel(4);        // GPIO 32
+
+    std::vector<uint8_t> frame;
+    for (int i = 0; i < 8; i++)
+    {
+        entry(frame, 5, 2000 + i);
+        entry(frame, 0, 100);
+        entry(frame, 4, 4095);
+    }
+
+    TEST_ASSERT_EQUAL(24, buffer.decode(frame.data(), frame.size()));
+    TEST_ASSERT_EQUAL(8, buffer.count(thermistor));
+    TEST_ASSERT_EQUAL_FLOAT(2003.5f, buffer.average(thermistor));
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, buffer.average(ldr));
+    TEST_ASSERT_EQUAL_FLOAT(4095.0f, buffer.average(soil));
+    TEST_ASSERT_TRUE(buffer.filled(8));
+    TEST_ASSERT_FALSE(buffer.filled(9));
+}
+
+void test_adc_buffer_ignores_unregistered_channels()
+{
+    AdcSampleBuffer buffer;
+    int slot = buffer.addChannel(5);
+
+    std::vector<uint8_t> frame;
+    entry(frame, 6, 1234);
+    entry(frame, 5, 42);
+    frame.push_back(0xAB);  // Odd trailing byte is not a conversion
+
+    TEST_ASSERT_EQUAL(1, buffer.decode(frame.data(), frame.size()));
+    TEST_ASSERT_EQUAL(1, buffer.count(slot));
+    TEST_ASSERT_EQUAL_FLOAT(42.0f, buffer.average(slot));
+}
+
+void test_adc_buffer_keeps_latest_samples()
+{
+    AdcSampleBuffer buffer;
+    int slot = buffer.addChannel(0);
+
+    for (uint16_t i = 0; i < AdcSampleBuffer::CAPACITY + 10; i++)
+    {
+        buffer.push(0, i);
+    }
+
+    TEST_ASSERT_EQUAL(AdcSampleBuffer::CAPACITY, buffer.count(slot));
+    uint16_t samples[AdcSampleBuffer::CAPACITY];
+    TEST_ASSERT_EQUAL(AdcSampleBuffer::CAPACITY, buffer.copy(slot, samples, AdcSampleBuffer::CAPACITY));
+    TEST_ASSERT_EQUAL(10, samples[0]);
+    TEST_ASSERT_EQUAL(AdcSampleBuffer::CAPACITY + 9, samples[AdcSampleBuffer::CAPACITY - 1]);
+
+    // Fewer requested: the most recent ones, oldest first
+    TEST_ASSERT_EQUAL(2, buffer.copy(slot, samples, 2));
+    TEST_ASSERT_EQUAL(AdcSampleBuffer::CAPACITY + 8, samples[0]);
+    TEST_ASSERT_EQUAL(AdcSampleBuffer::CAPACITY + 9, samples[1]);
+
+    buffer.clear();
+    TEST_ASSERT_EQUAL(0, buffer.count(slot));
+    TEST_ASSERT_TRUE(std::isnan(buffer.average(slot)));
+}
+
+void test_adc_buffer_channel_limits()
+{
+    AdcSampleBuffer buffer;
+    TEST_ASSERT_EQUAL(AdcSampleBuffer::INVALID_SLOT, buffer.addChannel(8));  // ADC2 range
+    TEST_ASSERT_EQUAL(0, buffer.addChannel(0));
+    TEST_ASSERT_EQUAL(AdcSampleBuffer::INVALID_SLOT, buffer.addChannel(0));
+    TEST_ASSERT_EQUAL(1, buffer.addChannel(1));
+    TEST_ASSERT_EQUAL(2, buffer.addChannel(2));
+    TEST_ASSERT_EQUAL(3, buffer.addChannel(3));
+    TEST_ASSERT_EQUAL(AdcSampleBuffer::INVALID_SLOT, buffer.addChannel(4));
+
+    TEST_ASSERT_EQUAL(0, buffer.count(AdcSampleBuffer::INVALID_SLOT));
+    TEST_ASSERT_TRUE(std::isnan(buffer.average(AdcSampleBuffer::INVALID_SLOT)));
+
+    buffer.reset();
+    TEST_ASSERT_EQUAL(0, buffer.channelCount());
+    TEST_ASSERT_FALSE(buffer.filled(0));
+}
+
+void test_temperature_converts_midscale_to_nominal()
+{
+    temperature::Temperature sensor;
+    temperature::ThermistorConfig config;
+    config.seriesResistance = config.nominalResistance;
+    sensor.initialize(33);
+    sensor.configure(config);
+
+    // Equal resistances put the divider at half scale
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 25.0f, sensor.convert(4095.0f / 2.0f));
+    TEST_ASSERT_TRUE(sensor.convert(1500.0f) < 25.0f);  // Lower voltage: higher NTC resistance, colder
+    TEST_ASSERT_TRUE(std::isnan(sensor.convert(5.0f)));
+    TEST_ASSERT_TRUE(std::isnan(sensor.convert(NAN)));
+}
+
+void test_converters_need_initialization()
+{
+    temperature::Temperature temperature;
+    humidity::Humidity humidity;
+    luminosity::Luminosity luminosity;
+
+    TEST_ASSERT_TRUE(std::isnan(temperature.convert(2000.0f)));
+    TEST_ASSERT_TRUE(std::isnan(humidity.convert(2000.0f)));
+    TEST_ASSERT_TRUE(std::isnan(luminosity.convert(2000.0f)));
+}
+
+void test_humidity_maps_calibration_range()
+{
+    humidity::Humidity sensor;
+    sensor.initialize(32);
+    sensor.calibrate(3000, 1000);
+
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, sensor.convert(3000.0f));
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, sensor.convert(1000.0f));
+    TEST_ASSERT_EQUAL_FLOAT(25.0f, sensor.convert(2500.0f));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, sensor.convert(4095.0f));
+}
+
+void test_luminosity_uses_fractional_average()
+{
+    luminosity::Luminosity sensor;
+    sensor.initialize(36);
+
+    TEST_ASSERT_EQUAL_FLOAT(50.0f, sensor.convert(2047.5f));
+    sensor.setInverted(true);
+    TEST_ASSERT_EQUAL_FLOAT(100.0f, sensor.convert(0.0f));
+}
+
+void test_channel_registry_rejects_duplicates_and_overflow()
+{
+    SensorChannels list;
+    TEST_ASSERT_EQUAL(0, list.add(channels::TEMPERATURE));
+    TEST_ASSERT_EQUAL(SensorChannels::NONE, list.add(channels::TEMPERATURE));
+    TEST_ASSERT_EQUAL(1, list.add({"co2Ppm", "CO2", "ppm", 0}));
+    TEST_ASSERT_EQUAL(1, list.find("co2Ppm"));
+    TEST_ASSERT_EQUAL(SensorChannels::NONE, list.find(channels::LUMINOSITY.key));
+
+    const char *keys[] = {"a", "b", "c", "d", "e"};
+    for (const char *key : keys)
+    {
+        list.add({key, key, "", 0});
+    }
+    TEST_ASSERT_EQUAL(MAX_SENSOR_CHANNELS, list.size());
+    TEST_ASSERT_EQUAL_STRING("d", list[MAX_SENSOR_CHANNELS - 1].key);
+    TEST_ASSERT_EQUAL(SensorChannels::NONE, list.find("e"));
+}
+
+void test_channel_readings_default_to_missing()
+{
+    SensorReadings readings;
+    TEST_ASSERT_EQUAL(0, readings.count);
+    TEST_ASSERT_TRUE(std::isnan(readings.get(0)));
+
+    readings.set(2, 41.5f);
+    TEST_ASSERT_EQUAL(3, readings.count);
+    TEST_ASSERT_TRUE(std::isnan(readings.get(1)));
+    TEST_ASSERT_EQUAL_FLOAT(41.5f, readings.get(2));
+    TEST_ASSERT_TRUE(std::isnan(readings.get(SensorChannels::NONE)));
+
+    readings.set(MAX_SENSOR_CHANNELS, 1.0f);  // Out of range, ignored
+    TEST_ASSERT_EQUAL(3, readings.count);
+}
+
+void test_linear_converter_for_extra_channels()
+{
+    LinearConverter converter(0.5f, -10.0f);
+    const IAdcConverter &generic = converter;
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, generic.convert(100.0f));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_adc_buffer_decodes_round_robin_frame);
+    RUN_TEST(test_adc_buffer_ignores_unregistered_channels);
+    RUN_TEST(test_adc_buffer_keeps_latest_samples);
+    RUN_TEST(test_adc_buffer_channel_limits);
+    RUN_TEST(test_temperature_converts_midscale_to_nominal);
+    RUN_TEST(test_converters_need_initialization);
+    RUN_TEST(test_humidity_maps_calibration_range);
+    RUN_TEST(test_luminosity_uses_fractional_average);
+    RUN_TEST(test_channel_registry_rejects_duplicates_and_overflow);
+    RUN_TEST(test_channel_readings_default_to_missing);
+    RUN_TEST(test_linear_converter_for_extra_channels);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_adc_buffer_decodes_round_robin_frame);
+    RUN_TEST(test_adc_buffer_ignores_unregistered_channels);
+    RUN_TEST(test_adc_buffer_keeps_latest_samples);
+    RUN_TEST(test_adc_buffer_channel_limits);
+    RUN_TEST(test_temperature_converts_midscale_to_nominal);
+    RUN_TEST(test_converters_need_initialization);
+    RUN_TEST(test_humidity_maps_calibration_range);
+    RUN_TEST(test_luminosity_uses_fractional_average);
+    RUN_TEST(test_channel_registry_rejects_duplicates_and_overflow);
+    RUN_TEST(test_channel_readings_default_to_missing);
+    RUN_TEST(test_linear_converter_for_extra_channels);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
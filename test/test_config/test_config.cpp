@@ -0,0 +1,286 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/config/ConfigSchema.h"
+#include "libs/common/utils/Crc.h"
+#include <cstring>
+
+using namespace plant_nanny::services::config;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace
+{
+    // Version 1 of a test section
+    struct SampleSectionV1
+    {
+        static constexpr uint16_t VERSION = 1;
+        uint32_t interval = 10;
+        static void migrate(SampleSectionV1 &, uint16_t) {}
+    };
+
+    // Version 3 appends fields; v1 -> v2 adds `limit`, v2 -> v3 derives `scaled`
+    struct SampleSectionV3
+    {
+        static constexpr uint16_t VERSION = 3;
+        uint32_t interval = 10;
+        uint32_t limit = 0;
+        uint32_t scaled = 0;
+
+        static void migrate(SampleSectionV3 &section, uint16_t fromVersion)
+        {
+            if (fromVersion == 1)
+            {
+                section.limit = 99;
+            }
+            else if (fromVersion == 2)
+            {
+                section.scaled = section.interval * 1000;
+            }
+        }
+    };
+}
+
+void test_crc32_known_vector()
+{
+    const char *text = "123456789";
+    TEST_ASSERT_EQUAL_UINT32(0xCBF43926u, common::utils::Crc32::compute(text, 9));
+}
+
+void test_crc32_incremental()
+{
+    const char *text = "123456789";
+    uint32_t crc = common::utils::Crc32::compute(text, 4);
+    crc = common::utils::Crc32::compute(text + 4, 5, crc);
+    TEST_ASSERT_EQUAL_UINT32(0xCBF43926u, crc);
+}
+
+void test_section_roundtrip()
+{
+    MqttSection section;
+    setField(section.host, "broker.local");
+    section.port = 8883;
+
+    uint8_t buffer[SectionCodec<MqttSection>::BLOB_SIZE];
+    size_t length = SectionCodec<MqttSection>::encode(section, 7, buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL(sizeof(buffer), length);
+
+    auto decoded = SectionCodec<MqttSection>::decode(buffer, length);
+    TEST_ASSERT_TRUE(decoded.succeed());
+    TEST_ASSERT_EQUAL_STRING("broker.local", getField(decoded.value().data.host).c_str());
+    TEST_ASSERT_EQUAL(8883, decoded.value().data.port);
+    TEST_ASSERT_EQUAL_UINT32(7, decoded.value().sequence);
+}
+
+void test_section_rejects_corruption()
+{
+    PlantSection section;
+    uint8_t buffer[SectionCodec<PlantSection>::BLOB_SIZE];
+    size_t length = SectionCodec<PlantSection>::encode(section, 1, buffer, sizeof(buffer));
+
+    buffer[length - 1] ^= 0x01;
+    TEST_ASSERT_TRUE(SectionCodec<PlantSection>::decode(buffer, length).failed());
+}
+
+void test_section_rejects_truncation()
+{
+    PlantSection section;
+    uint8_t buffer[SectionCodec<PlantSection>::BLOB_SIZE];
+    size_t length = SectionCodec<PlantSection>::encode(section, 1, buffer, sizeof(buffer));
+
+    TEST_ASSERT_TRUE(SectionCodec<PlantSection>::decode(buffer, length - 1).failed());
+    TEST_ASSERT_TRUE(SectionCodec<PlantSection>::decode(buffer, 4).failed());
+}
+
+void test_encode_rejects_small_buffer()
+{
+    PlantSection section;
+    uint8_t buffer[8];
+    TEST_ASSERT_EQUAL(0, SectionCodec<PlantSection>::encode(section, 1, buffer, sizeof(buffer)));
+}
+
+void test_section_migrates_forward()
+{
+    SampleSectionV1 old;
+    old.interval = 5;
+    uint8_t buffer[SectionCodec<SampleSectionV1>::BLOB_SIZE];
+    size_t length = SectionCodec<SampleSectionV1>::encode(old, 3, buffer, sizeof(buffer));
+
+    auto decoded = SectionCodec<SampleSectionV3>::decode(buffer, length);
+    TEST_ASSERT_TRUE(decoded.succeed());
+    TEST_ASSERT_EQUAL_UINT32(5, decoded.value().data.interval);
+    TEST_ASSERT_EQUAL_UINT32(99, decoded.value().data.limit);
+    TEST_ASSERT_EQUAL_UINT32(5000, decoded.value().data.scaled);
+}
+
+void test_section_rejects_newer_version()
+{
+    SampleSectionV3 newer;
+    uint8_t buffer[SectionCodec<SampleSectionV3>::BLOB_SIZE];
+    size_t length = SectionCodec<SampleSectionV3>::encode(newer, 1, buffer, sizeof(buffer));
+
+    TEST_ASSERT_TRUE(SectionCodec<SampleSectionV1>::decode(buffer, length).failed());
+}
+
+void test_select_prefers_newest_slot()
+{
+    PlantSection first;
+    first.thresholds.waterAmountMl = 100;
+    PlantSection second;
+    second.thresholds.waterAmountMl = 250;
+
+    uint8_t a[SectionCodec<PlantSection>::BLOB_SIZE];
+    uint8_t b[SectionCodec<PlantSection>::BLOB_SIZE];
+    size_t lengthA = SectionCodec<PlantSection>::encode(first, 4, a, sizeof(a));
+    size_t lengthB = SectionCodec<PlantSection>::encode(second, 5, b, sizeof(b));
+
+    auto selected = SectionCodec<PlantSection>::select(a, lengthA, b, lengthB);
+    TEST_ASSERT_TRUE(selected.succeed());
+    TEST_ASSERT_TRUE(selected.value().slot == Slot::B);
+    TEST_ASSERT_EQUAL(250, selected.value().data.thresholds.waterAmountMl);
+}
+
+void test_select_falls_back_on_torn_write()
+{
+    PlantSection first;
+    first.thresholds.waterAmountMl = 100;
+    PlantSection second;
+    second.thresholds.waterAmountMl = 250;
+
+    uint8_t a[SectionCodec<PlantSection>::BLOB_SIZE];
+    uint8_t b[SectionCodec<PlantSection>::BLOB_SIZE];
+    size_t lengthA = SectionCodec<PlantSection>::encode(first, 4, a, sizeof(a));
+    size_t lengthB = SectionCodec<PlantSection>::encode(second, 5, b, sizeof(b));
+    b[BlobCodec::HEADER_SIZE] ^= 0xFF;
+
+    auto selected = SectionCodec<PlantSection>::select(a, lengthA, b, lengthB);
+    TEST_ASSERT_TRUE(selected.succeed());
+    TEST_ASSERT_TRUE(selected.value().slot == Slot::A);
+    TEST_ASSERT_EQUAL(100, selected.value().data.thresholds.waterAmountMl);
+}
+
+void test_select_handles_sequence_wrap()
+{
+    PlantSection older;
+    older.thresholds.waterAmountMl = 100;
+    PlantSection newer;
+    newer.thresholds.waterAmountMl = 250;
+
+    uint8_t a[SectionCodec<PlantSection>::BLOB_SIZE];
+    uint8_t b[SectionCodec<PlantSection>::BLOB_SIZE];
+    size_t lengthA = SectionCodec<PlantSection>::encode(newer, 0, a, sizeof(a));
+    size_t lengthB = SectionCodec<PlantSection>::encode(older, 0xFFFFFFFFu, b, sizeof(b));
+
+    auto selected = SectionCodec<PlantSection>::select(a, lengthA, b, lengthB);
+    TEST_ASSERT_TRUE(selected.succeed());
+    TEST_ASSERT_TRUE(selected.value().slot == Slot::A);
+}
+
+void test_select_fails_when_both_invalid()
+{
+    uint8_t empty[4] = {};
+    TEST_ASSERT_TRUE(SectionCodec<PlantSection>::select(empty, 0, empty, sizeof(empty)).failed());
+}
+
+void test_set_field_truncates()
+{
+    char field[5];
+    setField(field, "abcdefgh");
+    TEST_ASSERT_EQUAL_STRING("abcd", getField(field).c_str());
+}
+
+void test_link_lease_fresh_until_half_life()
+{
+    WifiLinkCache cache;
+    cache.channel = 6;
+    cache.ip = 0x0A01A8C0;
+    cache.leaseAcquiredSec = 1700000000;
+    cache.leaseSec = 3600;
+
+    TEST_ASSERT_TRUE(cache.leaseFresh(1700000000));
+    TEST_ASSERT_TRUE(cache.leaseFresh(1700000000 + 1799));
+    TEST_ASSERT_FALSE(cache.leaseFresh(1700000000 + 1800));
+    // Clock reset by a power loss, or never synced
+    TEST_ASSERT_FALSE(cache.leaseFresh(1699999999));
+    TEST_ASSERT_FALSE(cache.leaseFresh(0));
+
+    cache.ip = 0;
+    TEST_ASSERT_FALSE(cache.leaseFresh(1700000000));
+}
+
+void test_link_section_v1_lease_not_reused()
+{
+    // Layout written before the lease age was stored
+    struct LinkCacheV1
+    {
+        uint8_t bssid[6] = {1, 2, 3, 4, 5, 6};
+        uint8_t channel = 11;
+        uint32_t ip = 0x0A01A8C0;
+        uint32_t gateway = 0x0101A8C0;
+        uint32_t subnet = 0x00FFFFFF;
+        uint32_t dns = 0x0101A8C0;
+    } old;
+
+    uint8_t buffer[SectionCodec<LinkSection>::BLOB_SIZE];
+    size_t length = BlobCodec::encode(1, 2, &old, sizeof(old), buffer, sizeof(buffer));
+    auto decoded = SectionCodec<LinkSection>::decode(buffer, length);
+    TEST_ASSERT_TRUE(decoded.succeed());
+
+    const WifiLinkCache &cache = decoded.value().data.cache;
+    TEST_ASSERT_TRUE(cache.valid());
+    TEST_ASSERT_EQUAL_UINT8(11, cache.channel);
+    TEST_ASSERT_EQUAL_UINT32(0x0A01A8C0, cache.ip);
+    TEST_ASSERT_FALSE(cache.leaseFresh(1700000000));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_crc32_known_vector);
+    RUN_TEST(test_crc32_incremental);
+    RUN_TEST(test_section_roundtrip);
+    RUN_TEST(test_section_rejects_corruption);
+    RUN_TEST(test_section_rejects_truncation);
+    RUN_TEST(test_encode_rejects_small_buffer);
+    RUN_TEST(test_section_migrates_forward);
+    RUN_TEST(test_section_rejects_newer_version);
+    RUN_TEST(test_select_prefers_newest_slot);
+    RUN_TEST(test_select_falls_back_on_torn_write);
+    RUN_TEST(test_select_handles_sequence_wrap);
+    RUN_TEST(test_select_fails_when_both_invalid);
+    RUN_TEST(test_set_field_truncates);
+    RUN_TEST(test_link_lease_fresh_until_half_life);
+    RUN_TEST(test_link_section_v1_lease_not_reused);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_crc32_known_vector);
+    RUN_TEST(test_crc32_incremental);
+    RUN_TEST(test_section_roundtrip);
+    RUN_TEST(test_section_rejects_corruption);
+    RUN_TEST(test_section_rejects_truncation);
+    RUN_TEST(test_encode_rejects_small_buffer);
+    RUN_TEST(test_section_migrates_forward);
+    RUN_TEST(test_section_rejects_newer_version);
+    RUN_TEST(test_select_prefers_newest_slot);
+    RUN_TEST(test_select_falls_back_on_torn_write);
+    RUN_TEST(test_select_handles_sequence_wrap);
+    RUN_TEST(test_select_fails_when_both_invalid);
+    RUN_TEST(test_set_field_truncates);
+    RUN_TEST(test_link_lease_fresh_until_half_life);
+    RUN_TEST(test_link_section_v1_lease_not_reused);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,284 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/pump/DosingController.h"
+#include <cmath>
+
+using namespace plant_nanny::services::pump;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace
+{
+    constexpr uint32_t STEP_MS = 100;
+
+    /**
+     * Pot fed by the pump: water seeps into the soil around the probe with a
+     * first-order lag, each ml raising the humidity by pctPerMl
+     */
+    struct SoilModel
+    {
+        float humidityPct = 30.0f;
+        float reservoirMl = 2000.0f;
+        float flowMlPerSec = 20.0f;
+        float pctPerMl = 0.05f;
+        float seepTauSec = 10.0f;
+
+        float pumpedMl = 0.0f;
+        float inTransitMl = 0.0f;
+        uint32_t pumpOnMs = 0;
+
+        void step(bool pumpOn, uint32_t dtMs)
+        {
+            if (pumpOn)
+            {
+                float ml = std::fmin(flowMlPerSec * dtMs / 1000.0f, reservoirMl);
+                reservoirMl -= ml;
+                pumpedMl += ml;
+                inTransitMl += ml;
+                pumpOnMs += dtMs;
+            }
+            float seeped = inTransitMl * std::fmin(1.0f, dtMs / 1000.0f / seepTauSec);
+            inTransitMl -= seeped;
+            humidityPct = std::fmin(100.0f, humidityPct + seeped * pctPerMl);
+        }
+    };
+
+    DosingConfig config()
+    {
+        DosingConfig c;
+        c.flowMlPerSec = 20.0f;
+        c.pulseMl = 50;
+        c.soakSec = 30;
+        c.dryCheckMl = 150;
+        c.minRisePct = 1.0f;
+        return c;
+    }
+
+    /**
+     * Step controller and soil together until the dose ends
+     * @return Simulated time in ms
+     */
+    uint32_t run(DosingController &controller, SoilModel &soil, uint32_t limitMs = 30 * 60 * 1000)
+    {
+        uint32_t now = 0;
+        while (controller.running() && now < limitMs)
+        {
+            now += STEP_MS;
+            bool pumpOn = controller.update(now, [&soil]() { return soil.humidityPct; });
+            soil.step(pumpOn, STEP_MS);
+        }
+        return now;
+    }
+
+    DoseRequest amount(uint16_t ml, float targetPct = NAN)
+    {
+        DoseRequest request;
+        request.amountMl = ml;
+        request.targetPct = targetPct;
+        return request;
+    }
+}
+
+void test_delivers_amount_in_pulses_with_soaks()
+{
+    DosingController controller;
+    controller.configure(config());
+    SoilModel soil;
+
+    TEST_ASSERT_TRUE(controller.start(amount(200), soil.humidityPct, 0).succeed());
+    uint32_t elapsed = run(controller, soil);
+
+    const DoseReport &report = controller.report();
+    TEST_ASSERT_EQUAL(static_cast<int>(DoseOutcome::Delivered), static_cast<int>(report.outcome));
+    TEST_ASSERT_EQUAL(200, report.deliveredMl);
+    TEST_ASSERT_EQUAL_UINT32(10000, report.pumpOnMs);
+    TEST_ASSERT_FLOAT_WITHIN(2.0f, 200.0f, soil.pumpedMl);
+    // Four 2.5 s pulses with three 30 s soaks in between
+    TEST_ASSERT_UINT32_WITHIN(500, 100000, elapsed);
+    TEST_ASSERT_TRUE(report.endPct > report.startPct);
+}
+
+void test_stops_when_target_reached()
+{
+    DosingController controller;
+    controller.configure(config());
+    SoilModel soil;
+
+    // 0.05 %/ml: 30 % -> 35 % takes about 100 ml
+    TEST_ASSERT_TRUE(controller.start(amount(400, 35.0f), soil.humidityPct, 0).succeed());
+    run(controller, soil);
+
+    const DoseReport &report = controller.report();
+    TEST_ASSERT_EQUAL(static_cast<int>(DoseOutcome::TargetReached), static_cast<int>(report.outcome));
+    TEST_ASSERT_TRUE(report.deliveredMl >= 100);
+    TEST_ASSERT_TRUE(report.deliveredMl <= 150);
+    TEST_ASSERT_TRUE(soil.pumpedMl < 400.0f);
+}
+
+void test_already_wet_soil_is_not_watered()
+{
+    DosingController controller;
+    controller.configure(config());
+    SoilModel soil;
+    soil.humidityPct = 60.0f;
+
+    TEST_ASSERT_TRUE(controller.start(amount(200, 40.0f), soil.humidityPct, 0).succeed());
+    TEST_ASSERT_FALSE(controller.running());
+    TEST_ASSERT_EQUAL(static_cast<int>(DoseOutcome::TargetReached), static_cast<int>(controller.report().outcome));
+    TEST_ASSERT_EQUAL(0, controller.report().deliveredMl);
+}
+
+void test_flags_dry_reservoir()
+{
+    DosingController controller;
+    controller.configure(config());
+    SoilModel soil;
+    soil.reservoirMl = 0.0f;
+
+    TEST_ASSERT_TRUE(controller.start(amount(400), soil.humidityPct, 0).succeed());
+    run(controller, soil);
+
+    const DoseReport &report = controller.report();
+    TEST_ASSERT_EQUAL(static_cast<int>(DoseOutcome::DryReservoir), static_cast<int>(report.outcome));
+    // Gave up after dryCheckMl instead of running the pump dry for 400 ml
+    TEST_ASSERT_EQUAL(150, report.deliveredMl);
+    TEST_ASSERT_EQUAL_UINT32(7500, report.pumpOnMs);
+    TEST_ASSERT_UINT32_WITHIN(3 * STEP_MS, 7500, soil.pumpOnMs);
+}
+
+void test_runs_open_loop_without_humidity()
+{
+    DosingController controller;
+    controller.configure(config());
+
+    // Probe unplugged: the target cannot be checked, deliver the whole amount
+    TEST_ASSERT_TRUE(controller.start(amount(200, 35.0f), NAN, 0).succeed());
+    uint32_t now = 0;
+    while (controller.running())
+    {
+        now += STEP_MS;
+        controller.update(now, []() { return NAN; });
+    }
+
+    TEST_ASSERT_EQUAL(static_cast<int>(DoseOutcome::Delivered), static_cast<int>(controller.report().outcome));
+    TEST_ASSERT_EQUAL(200, controller.report().deliveredMl);
+}
+
+void test_timed_request_is_a_single_pulse()
+{
+    DosingController controller;
+    controller.configure(config());
+    SoilModel soil;
+
+    DoseRequest request;
+    request.durationMs = 5000;
+    TEST_ASSERT_TRUE(controller.start(request, soil.humidityPct, 0).succeed());
+    uint32_t elapsed = run(controller, soil);
+
+    TEST_ASSERT_EQUAL_UINT32(5000, controller.report().pumpOnMs);
+    TEST_ASSERT_EQUAL(100, controller.report().deliveredMl);
+    TEST_ASSERT_UINT32_WITHIN(STEP_MS, 5000, elapsed);
+}
+
+void test_soft_start_ramp_is_compensated()
+{
+    DosingController controller;
+    controller.configure(config(), 250);
+    SoilModel soil;
+
+    TEST_ASSERT_TRUE(controller.start(amount(50), soil.humidityPct, 0).succeed());
+    TEST_ASSERT_TRUE(controller.update(2600, []() { return NAN; }));
+    TEST_ASSERT_FALSE(controller.update(2625, []() { return NAN; }));
+    TEST_ASSERT_EQUAL_UINT32(2625, controller.report().pumpOnMs);
+
+    // 10 s run with the same ramp that delivered 195 ml
+    TEST_ASSERT_FLOAT_WITHIN(0.01f, 19.75f, DosingController::flowFromRun(195.0f, 10000, 250));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, DosingController::flowFromRun(0.0f, 10000, 250));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, DosingController::flowFromRun(100.0f, 100, 250));
+}
+
+void test_abort_counts_partial_pulse()
+{
+    DosingController controller;
+    controller.configure(config());
+
+    TEST_ASSERT_TRUE(controller.start(amount(200), 30.0f, 1000).succeed());
+    controller.update(2000, []() { return NAN; });
+    controller.abort(2250);
+
+    TEST_ASSERT_FALSE(controller.running());
+    TEST_ASSERT_EQUAL(static_cast<int>(DoseOutcome::Aborted), static_cast<int>(controller.report().outcome));
+    TEST_ASSERT_EQUAL(25, controller.report().deliveredMl);
+    TEST_ASSERT_EQUAL_UINT32(1250, controller.report().pumpOnMs);
+}
+
+void test_start_rejects_empty_busy_and_uncalibrated()
+{
+    DosingController controller;
+    controller.configure(config());
+
+    TEST_ASSERT_TRUE(controller.start(DoseRequest{}, 30.0f, 0).failed());
+    TEST_ASSERT_TRUE(controller.start(amount(100), 30.0f, 0).succeed());
+    TEST_ASSERT_TRUE(controller.start(amount(100), 30.0f, 0).failed());
+
+    DosingConfig uncalibrated = config();
+    uncalibrated.flowMlPerSec = 0.0f;
+    DosingController other;
+    other.configure(uncalibrated);
+    TEST_ASSERT_TRUE(other.start(amount(100), 30.0f, 0).failed());
+}
+
+void test_clock_wrap_during_pulse()
+{
+    DosingController controller;
+    controller.configure(config());
+
+    const uint32_t start = UINT32_MAX - 1000;
+    TEST_ASSERT_TRUE(controller.start(amount(50), NAN, start).succeed());
+    TEST_ASSERT_TRUE(controller.update(start + 2000, []() { return NAN; }));
+    TEST_ASSERT_FALSE(controller.update(start + 2500, []() { return NAN; }));
+    TEST_ASSERT_EQUAL(50, controller.report().deliveredMl);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_delivers_amount_in_pulses_with_soaks);
+    RUN_TEST(test_stops_when_target_reached);
+    RUN_TEST(test_already_wet_soil_is_not_watered);
+    RUN_TEST(test_flags_dry_reservoir);
+    RUN_TEST(test_runs_open_loop_without_humidity);
+    RUN_TEST(test_timed_request_is_a_single_pulse);
+    RUN_TEST(test_soft_start_ramp_is_compensated);
+    RUN_TEST(test_abort_counts_partial_pulse);
+    RUN_TEST(test_start_rejects_empty_busy_and_uncalibrated);
+    RUN_TEST(test_clock_wrap_during_pulse);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_delivers_amount_in_pulses_with_soaks);
+    RUN_TEST(test_stops_when_target_reached);
+    RUN_TEST(test_already_wet_soil_is_not_watered);
+    RUN_TEST(test_flags_dry_reservoir);
+    RUN_TEST(test_runs_open_loop_without_humidity);
+    RUN_TEST(test_timed_request_is_a_single_pulse);
+    RUN_TEST(test_soft_start_ramp_is_compensated);
+    RUN_TEST(test_abort_counts_partial_pulse);
+    RUN_TEST(test_start_rejects_empty_busy_and_uncalibrated);
+    RUN_TEST(test_clock_wrap_during_pulse);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
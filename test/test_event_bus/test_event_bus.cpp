@@ -0,0 +1,261 @@
+#include <unity.h>
+#include "libs/common/event/EventBus.h"
+#include <string>
+
+#ifdef NATIVE_TEST
+#include <thread>
+#endif
+
+using namespace common::event;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace
+{
+    uint64_t fake_now_us = 0;
+
+    Clock fake_clock()
+    {
+        fake_now_us = 0;
+        return []() { return fake_now_us; };
+    }
+
+    struct Reading
+    {
+        float value;
+        uint32_t index;
+    };
+
+    using ReadingEvent = Event<1, Reading>;
+    using OtherReadingEvent = Event<2, Reading>;
+    using PingEvent = Event<3, Empty>;
+}
+
+void test_event_bus_delivers_typed_payload()
+{
+    EventBus bus(fake_clock());
+    float received = 0.0f;
+    bus.subscribe<ReadingEvent>("reader", [&](const Reading &reading) { received = reading.value; });
+
+    TEST_ASSERT_TRUE(bus.publish<ReadingEvent>(Reading{21.5f, 0}));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, received);  // Nothing runs before dispatch
+
+    TEST_ASSERT_EQUAL(1, bus.dispatch());
+    TEST_ASSERT_EQUAL_FLOAT(21.5f, received);
+    TEST_ASSERT_EQUAL(0, bus.dispatch());
+}
+
+void test_event_bus_routes_by_event_id()
+{
+    EventBus bus(fake_clock());
+    int first = 0;
+    int second = 0;
+    int pings = 0;
+    bus.subscribe<ReadingEvent>("first", [&](const Reading &) { first++; });
+    bus.subscribe<OtherReadingEvent>("second", [&](const Reading &) { second++; });
+    bus.subscribe<PingEvent>("ping", [&](const Empty &) { pings++; });
+
+    bus.publish<OtherReadingEvent>(Reading{1.0f, 0});
+    bus.publish<PingEvent>();
+    bus.dispatch();
+
+    TEST_ASSERT_EQUAL(0, first);
+    TEST_ASSERT_EQUAL(1, second);
+    TEST_ASSERT_EQUAL(1, pings);
+}
+
+void test_event_bus_preserves_publication_order()
+{
+    EventBus bus(fake_clock());
+    std::string order;
+    bus.subscribe<ReadingEvent>("reader", [&](const Reading &reading) { order += std::to_string(reading.index); });
+    bus.subscribe<PingEvent>("ping", [&](const Empty &) { order += "p"; });
+
+    // Wrap the slot cursor so order cannot come from slot positions
+    for (uint32_t i = 0; i < EventBus::SLOT_COUNT - 2; i++)
+    {
+        bus.publish<PingEvent>();
+    }
+    bus.dispatch();
+    order.clear();
+
+    bus.publish<ReadingEvent>(Reading{0.0f, 1});
+    bus.publish<PingEvent>();
+    bus.publish<ReadingEvent>(Reading{0.0f, 2});
+    bus.publish<ReadingEvent>(Reading{0.0f, 3});
+    bus.dispatch();
+
+    TEST_ASSERT_EQUAL_STRING("1p23", order.c_str());
+}
+
+void test_event_bus_drops_when_slots_exhausted()
+{
+    EventBus bus(fake_clock());
+    int received = 0;
+    bus.subscribe<PingEvent>("ping", [&](const Empty &) { received++; });
+
+    for (size_t i = 0; i < EventBus::SLOT_COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(bus.publish<PingEvent>());
+    }
+    TEST_ASSERT_FALSE(bus.publish<PingEvent>());
+    TEST_ASSERT_EQUAL_UINT32(EventBus::SLOT_COUNT + 1, bus.stats().published + bus.stats().dropped);
+    TEST_ASSERT_EQUAL_UINT32(1, bus.stats().dropped);
+
+    bus.dispatch();
+    TEST_ASSERT_EQUAL(EventBus::SLOT_COUNT, received);
+    TEST_ASSERT_TRUE(bus.publish<PingEvent>());  // Slots released after delivery
+}
+
+void test_event_bus_doorbell_rings_once_per_dispatch()
+{
+    EventBus bus(fake_clock());
+    int rings = 0;
+    bus.setDoorbell([&]() { rings++; return true; });
+
+    bus.publish<PingEvent>();
+    bus.publish<PingEvent>();
+    TEST_ASSERT_EQUAL(1, rings);
+
+    bus.dispatch();
+    bus.publish<PingEvent>();
+    TEST_ASSERT_EQUAL(2, rings);
+}
+
+void test_event_bus_failed_doorbell_is_retried()
+{
+    EventBus bus(fake_clock());
+    bool accept = false;
+    int rings = 0;
+    bus.setDoorbell([&]() { rings++; return accept; });
+
+    bus.publish<PingEvent>();
+    TEST_ASSERT_EQUAL_UINT32(1, bus.stats().doorbellFailures);
+
+    accept = true;
+    bus.publish<PingEvent>();
+    TEST_ASSERT_EQUAL(2, rings);
+    TEST_ASSERT_EQUAL(2, bus.dispatch());
+}
+
+void test_event_bus_counts_subscriber_latency()
+{
+    EventBus bus(fake_clock());
+    SubscriberId slow = bus.subscribe<ReadingEvent>("slow", [](const Reading &) { fake_now_us += 300; });
+    SubscriberId next = bus.subscribe<ReadingEvent>("next", [](const Reading &) {});
+
+    fake_now_us = 1000;
+    bus.publish<ReadingEvent>(Reading{0.0f, 0});
+    fake_now_us = 1500;
+    bus.dispatch();
+
+    const SubscriberStats &slowStats = bus.subscriberStats(slow);
+    TEST_ASSERT_EQUAL_UINT32(1, slowStats.deliveries);
+    TEST_ASSERT_EQUAL_UINT32(500, slowStats.lastLatencyUs);
+    TEST_ASSERT_EQUAL_UINT32(300, slowStats.maxHandlerUs);
+
+    // Waits behind the slow handler
+    TEST_ASSERT_EQUAL_UINT32(800, bus.subscriberStats(next).lastLatencyUs);
+    TEST_ASSERT_EQUAL_STRING("next", bus.subscriberName(next));
+}
+
+void test_event_bus_dispatch_is_bounded()
+{
+    EventBus bus(fake_clock());
+    int rings = 0;
+    int received = 0;
+    bus.setDoorbell([&]() { rings++; return true; });
+    // A handler that republishes keeps the bus busy forever
+    bus.subscribe<PingEvent>("echo", [&](const Empty &) {
+        received++;
+        bus.publish<PingEvent>();
+    });
+
+    bus.publish<PingEvent>();
+    TEST_ASSERT_EQUAL(EventBus::SLOT_COUNT, bus.dispatch());
+    TEST_ASSERT_EQUAL(EventBus::SLOT_COUNT, received);
+    TEST_ASSERT_EQUAL(2, rings);  // Re-armed for the remaining event
+}
+
+void test_event_bus_rejects_when_subscriber_table_full()
+{
+    EventBus bus(fake_clock());
+    for (size_t i = 0; i < EventBus::MAX_SUBSCRIBERS; i++)
+    {
+        TEST_ASSERT_TRUE(bus.subscribe<PingEvent>("s", [](const Empty &) {}) != INVALID_SUBSCRIBER);
+    }
+    TEST_ASSERT_TRUE(bus.subscribe<PingEvent>("extra", [](const Empty &) {}) == INVALID_SUBSCRIBER);
+}
+
+#ifdef NATIVE_TEST
+void test_event_bus_concurrent_publishers()
+{
+    static EventBus bus([]() { return uint64_t{0}; });
+    static std::atomic<uint32_t> received{0};
+    bus.subscribe<ReadingEvent>("count", [](const Reading &) { received++; });
+
+    constexpr uint32_t PER_THREAD = 20000;
+    auto producer = []() {
+        for (uint32_t i = 0; i < PER_THREAD;)
+        {
+            if (bus.publish<ReadingEvent>(Reading{0.0f, i}))
+            {
+                i++;
+            }
+        }
+    };
+    std::thread a(producer);
+    std::thread b(producer);
+
+    while (received.load() < 2 * PER_THREAD)
+    {
+        bus.dispatch();
+    }
+    a.join();
+    b.join();
+
+    TEST_ASSERT_EQUAL_UINT32(2 * PER_THREAD, received.load());
+    TEST_ASSERT_EQUAL_UINT32(2 * PER_THREAD, bus.stats().published);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_event_bus_delivers_typed_payload);
+    RUN_TEST(test_event_bus_routes_by_event_id);
+    RUN_TEST(test_event_bus_preserves_publication_order);
+    RUN_TEST(test_event_bus_drops_when_slots_exhausted);
+    RUN_TEST(test_event_bus_doorbell_rings_once_per_dispatch);
+    RUN_TEST(test_event_bus_failed_doorbell_is_retried);
+    RUN_TEST(test_event_bus_counts_subscriber_latency);
+    RUN_TEST(test_event_bus_dispatch_is_bounded);
+    RUN_TEST(test_event_bus_rejects_when_subscriber_table_full);
+    RUN_TEST(test_event_bus_concurrent_publishers);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_event_bus_delivers_typed_payload);
+    RUN_TEST(test_event_bus_routes_by_event_id);
+    RUN_TEST(test_event_bus_preserves_publication_order);
+    RUN_TEST(test_event_bus_drops_when_slots_exhausted);
+    RUN_TEST(test_event_bus_doorbell_rings_once_per_dispatch);
+    RUN_TEST(test_event_bus_failed_doorbell_is_retried);
+    RUN_TEST(test_event_bus_counts_subscriber_latency);
+    RUN_TEST(test_event_bus_dispatch_is_bounded);
+    RUN_TEST(test_event_bus_rejects_when_subscriber_table_full);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
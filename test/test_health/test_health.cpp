@@ -0,0 +1,220 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/health/HealthMonitor.h"
+#include <cstring>
+
+using namespace plant_nanny::services::health;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace
+{
+    HealthSample healthySample(uint32_t timeSec)
+    {
+        HealthSample sample;
+        sample.timeSec = timeSec;
+        sample.freeBytes = 120000;
+        sample.largestBlockBytes = 60000;
+        sample.minFreeBytes = 100000;
+        sample.stackFreeBytes[0] = 3000;
+        sample.stackFreeBytes[1] = 1500;
+        sample.stackFreeBytes[2] = 4000;
+        return sample;
+    }
+}
+
+void test_healthy_sample_is_ok()
+{
+    HealthMonitor monitor;
+    const HealthReport &report = monitor.update(healthySample(0));
+
+    TEST_ASSERT_EQUAL(static_cast<int>(HealthLevel::Ok), static_cast<int>(report.level));
+    TEST_ASSERT_EQUAL_UINT8(0, report.flags);
+    TEST_ASSERT_EQUAL_UINT8(50, report.fragmentationPct);
+    TEST_ASSERT_EQUAL(static_cast<int>(WatchedTask::EventLoop), static_cast<int>(report.tightestStack));
+    TEST_ASSERT_FALSE(report.trendValid);
+    TEST_ASSERT_FALSE(report.restartDue);
+}
+
+void test_low_heap_levels()
+{
+    HealthMonitor monitor;
+    HealthSample sample = healthySample(0);
+    sample.freeBytes = 30000;
+    sample.largestBlockBytes = 20000;
+    TEST_ASSERT_EQUAL(static_cast<int>(HealthLevel::Warning), static_cast<int>(monitor.update(sample).level));
+    TEST_ASSERT_EQUAL_UINT8(flags::LOW_HEAP, monitor.report().flags);
+
+    sample.freeBytes = 12000;
+    sample.largestBlockBytes = 10000;
+    TEST_ASSERT_EQUAL(static_cast<int>(HealthLevel::Critical), static_cast<int>(monitor.update(sample).level));
+    TEST_ASSERT_EQUAL_UINT8(flags::LOW_HEAP | flags::FRAGMENTED, monitor.report().flags);
+}
+
+void test_fragmentation_with_plenty_free()
+{
+    HealthMonitor monitor;
+    HealthSample sample = healthySample(0);
+    sample.largestBlockBytes = 12000;
+    const HealthReport &report = monitor.update(sample);
+    TEST_ASSERT_EQUAL(static_cast<int>(HealthLevel::Warning), static_cast<int>(report.level));
+    TEST_ASSERT_EQUAL_UINT8(flags::FRAGMENTED, report.flags);
+    TEST_ASSERT_EQUAL_UINT8(90, report.fragmentationPct);
+
+    sample.largestBlockBytes = 4000;
+    TEST_ASSERT_EQUAL(static_cast<int>(HealthLevel::Critical), static_cast<int>(monitor.update(sample).level));
+}
+
+void test_low_stack_names_the_task()
+{
+    HealthMonitor monitor;
+    HealthSample sample = healthySample(0);
+    sample.stackFreeBytes[static_cast<size_t>(WatchedTask::Network)] = 200;
+    const HealthReport &report = monitor.update(sample);
+    TEST_ASSERT_EQUAL(static_cast<int>(HealthLevel::Critical), static_cast<int>(report.level));
+    TEST_ASSERT_EQUAL_UINT8(flags::LOW_STACK, report.flags);
+    TEST_ASSERT_EQUAL(static_cast<int>(WatchedTask::Network), static_cast<int>(report.tightestStack));
+    TEST_ASSERT_EQUAL_STRING("network", to_string(report.tightestStack));
+}
+
+void test_unknown_stack_is_ignored()
+{
+    HealthMonitor monitor;
+    HealthSample sample = healthySample(0);
+    for (auto &stack : sample.stackFreeBytes)
+    {
+        stack = HealthSample::UNKNOWN;
+    }
+    TEST_ASSERT_EQUAL_UINT8(0, monitor.update(sample).flags);
+}
+
+void test_trend_detects_leak()
+{
+    HealthThresholds thresholds;
+    HealthMonitor monitor(thresholds);
+    HealthSample sample = healthySample(0);
+
+    // One sample a minute, losing 100 bytes each: 6000 bytes per hour
+    for (uint32_t minute = 0; minute <= HealthMonitor::TREND_POINTS * 5; minute++)
+    {
+        sample.timeSec = minute * 60;
+        sample.freeBytes = 120000 - minute * 100;
+        monitor.update(sample);
+    }
+
+    const HealthReport &report = monitor.report();
+    TEST_ASSERT_TRUE(report.trendValid);
+    TEST_ASSERT_INT32_WITHIN(10, -6000, report.trendBytesPerHour);
+    TEST_ASSERT_EQUAL(static_cast<int>(HealthLevel::Warning), static_cast<int>(report.level));
+    TEST_ASSERT_EQUAL_UINT8(flags::LEAKING, report.flags);
+}
+
+void test_trend_ignores_stable_heap()
+{
+    HealthMonitor monitor;
+    HealthSample sample = healthySample(0);
+    for (uint32_t minute = 0; minute <= HealthMonitor::TREND_POINTS * 5; minute++)
+    {
+        // Allocation noise, no drift
+        sample.timeSec = minute * 60;
+        sample.freeBytes = 120000 + (minute % 2 == 0 ? 2000 : -2000);
+        monitor.update(sample);
+    }
+    TEST_ASSERT_TRUE(monitor.report().trendValid);
+    TEST_ASSERT_EQUAL(static_cast<int>(HealthLevel::Ok), static_cast<int>(monitor.report().level));
+}
+
+void test_restart_after_sustained_critical()
+{
+    HealthMonitor monitor;
+    HealthSample critical = healthySample(0);
+    critical.freeBytes = 10000;
+    critical.largestBlockBytes = 8000;
+
+    TEST_ASSERT_FALSE(monitor.update(critical).restartDue);
+    TEST_ASSERT_FALSE(monitor.update(critical).restartDue);
+    // A recovery resets the streak
+    TEST_ASSERT_FALSE(monitor.update(healthySample(120)).restartDue);
+    TEST_ASSERT_FALSE(monitor.update(critical).restartDue);
+    TEST_ASSERT_FALSE(monitor.update(critical).restartDue);
+    TEST_ASSERT_TRUE(monitor.update(critical).restartDue);
+}
+
+void test_restart_can_be_disabled()
+{
+    HealthThresholds thresholds;
+    thresholds.restartWhenCritical = false;
+    HealthMonitor monitor(thresholds);
+    HealthSample critical = healthySample(0);
+    critical.freeBytes = 10000;
+
+    for (int i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_FALSE(monitor.update(critical).restartDue);
+    }
+    TEST_ASSERT_EQUAL(static_cast<int>(HealthLevel::Critical), static_cast<int>(monitor.report().level));
+}
+
+void test_report_json()
+{
+    HealthMonitor monitor;
+    HealthSample sample = healthySample(0);
+    sample.largestBlockBytes = 12000;
+    sample.stackFreeBytes[static_cast<size_t>(WatchedTask::Network)] = 600;
+    sample.stackFreeBytes[static_cast<size_t>(WatchedTask::EventLoop)] = HealthSample::UNKNOWN;
+    const HealthReport &report = monitor.update(sample);
+
+    char json[320];
+    size_t length = toJson(sample, report, json, sizeof(json));
+    TEST_ASSERT_EQUAL(strlen(json), length);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"type\":\"health\",\"level\":\"warning\",\"flags\":[\"fragmented\",\"low_stack\"],"
+        "\"free\":120000,\"largestBlock\":12000,\"minFree\":100000,\"fragPct\":90,\"trendBph\":null,"
+        "\"stack\":{\"control\":3000,\"app_loop\":-1,\"network\":600},\"restart\":false}",
+        json);
+
+    TEST_ASSERT_EQUAL(0, toJson(sample, report, json, 32));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_healthy_sample_is_ok);
+    RUN_TEST(test_low_heap_levels);
+    RUN_TEST(test_fragmentation_with_plenty_free);
+    RUN_TEST(test_low_stack_names_the_task);
+    RUN_TEST(test_unknown_stack_is_ignored);
+    RUN_TEST(test_trend_detects_leak);
+    RUN_TEST(test_trend_ignores_stable_heap);
+    RUN_TEST(test_restart_after_sustained_critical);
+    RUN_TEST(test_restart_can_be_disabled);
+    RUN_TEST(test_report_json);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_healthy_sample_is_ok);
+    RUN_TEST(test_low_heap_levels);
+    RUN_TEST(test_fragmentation_with_plenty_free);
+    RUN_TEST(test_low_stack_names_the_task);
+    RUN_TEST(test_unknown_stack_is_ignored);
+    RUN_TEST(test_trend_detects_leak);
+    RUN_TEST(test_trend_ignores_stable_heap);
+    RUN_TEST(test_restart_after_sustained_critical);
+    RUN_TEST(test_restart_can_be_disabled);
+    RUN_TEST(test_report_json);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,248 @@
+#include <unity.h>
+#include "libs/common/metrics/Metrics.h"
+#include "libs/plant_nanny/services/mqtt/IMQTTService.h"
+#include <cstring>
+
+#ifdef NATIVE_TEST
+#include <thread>
+#endif
+
+using namespace common::metrics;
+using plant_nanny::services::mqtt::IMQTTService;
+
+METRIC_COUNTER(s_requests, "test.requests");
+METRIC_GAUGE(s_queueDepth, "test.queue_depth");
+METRIC_HISTOGRAM(s_latency, "test.latency_us", 100, 1000, 10000);
+
+void setUp(void)
+{
+    s_latency.drain();
+}
+
+void tearDown(void) {}
+
+void test_static_metrics_are_registered()
+{
+    TEST_ASSERT_TRUE(Registry::count() >= 3);
+    TEST_ASSERT_EQUAL_PTR(&s_requests, Registry::find("test.requests"));
+    TEST_ASSERT_EQUAL_PTR(&s_queueDepth, Registry::find("test.queue_depth"));
+    TEST_ASSERT_EQUAL_PTR(&s_latency, Registry::find("test.latency_us"));
+    TEST_ASSERT_NULL(Registry::find("test.missing"));
+    TEST_ASSERT_EQUAL(static_cast<int>(Kind::Histogram), static_cast<int>(Registry::find("test.latency_us")->kind()));
+}
+
+void test_counter_and_gauge()
+{
+    uint32_t before = s_requests.value();
+    s_requests.increment();
+    s_requests.increment(4);
+    TEST_ASSERT_EQUAL_UINT32(before + 5, s_requests.value());
+
+    s_queueDepth.set(-3);
+    TEST_ASSERT_EQUAL_INT32(-3, s_queueDepth.value());
+    s_queueDepth.set(7);
+    TEST_ASSERT_EQUAL_INT32(7, s_queueDepth.value());
+}
+
+void test_histogram_buckets_are_inclusive_upper_bounds()
+{
+    s_latency.record(0);
+    s_latency.record(100);
+    s_latency.record(101);
+    s_latency.record(10000);
+    s_latency.record(50000);
+
+    Histogram::Snapshot snapshot = s_latency.drain();
+    TEST_ASSERT_EQUAL_UINT32(2, snapshot.counts[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.counts[1]);
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.counts[2]);
+    TEST_ASSERT_EQUAL_UINT32(1, snapshot.counts[3]);
+    TEST_ASSERT_EQUAL_UINT32(5, snapshot.count);
+    TEST_ASSERT_EQUAL_UINT32(60201, snapshot.sum);
+    TEST_ASSERT_EQUAL_UINT32(50000, snapshot.max);
+}
+
+void test_histogram_drain_resets()
+{
+    s_latency.record(500);
+    TEST_ASSERT_EQUAL_UINT32(1, s_latency.drain().count);
+
+    Histogram::Snapshot empty = s_latency.drain();
+    TEST_ASSERT_EQUAL_UINT32(0, empty.count);
+    TEST_ASSERT_EQUAL_UINT32(0, empty.sum);
+    TEST_ASSERT_EQUAL_UINT32(0, empty.max);
+}
+
+void test_histogram_sum_saturates()
+{
+    s_latency.record(UINT32_MAX - 10);
+    s_latency.record(100);
+    Histogram::Snapshot snapshot = s_latency.drain();
+    TEST_ASSERT_EQUAL_UINT32(UINT32_MAX, snapshot.sum);
+    TEST_ASSERT_EQUAL_UINT32(2, snapshot.count);
+}
+
+void test_json_snapshot()
+{
+    s_queueDepth.set(2);
+    s_latency.record(50);
+    s_latency.record(2000);
+
+    // The firmware metrics are linked in as well
+    char json[IMQTTService::MAX_PAYLOAD_SIZE];
+    size_t length = Registry::writeJson(json, sizeof(json));
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_EQUAL(strlen(json), length);
+    TEST_ASSERT_EQUAL('{', json[0]);
+    TEST_ASSERT_EQUAL('}', json[length - 1]);
+
+    char expected[64];
+    snprintf(expected, sizeof(expected), "\"test.requests\":%lu", static_cast<unsigned long>(s_requests.value()));
+    TEST_ASSERT_NOT_NULL(strstr(json, expected));
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"g\":{"));
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"test.queue_depth\":2"));
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"test.latency_us\":{\"le\":[100,1000,10000],\"n\":[1,0,1,0],\"sum\":2050,\"max\":2000}"));
+
+    // Histograms are drained only once the snapshot is committed
+    TEST_ASSERT_EQUAL(length, Registry::writeJson(json, sizeof(json)));
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"test.latency_us\":{\"le\":[100,1000,10000],\"n\":[1,0,1,0],\"sum\":2050,\"max\":2000}"));
+    Registry::commitHistograms();
+    TEST_ASSERT_EQUAL_UINT32(0, s_latency.drain().count);
+}
+
+void test_json_snapshot_too_small()
+{
+    s_latency.record(500);
+
+    char json[16];
+    TEST_ASSERT_EQUAL(0, Registry::writeJson(json, sizeof(json)));
+    TEST_ASSERT_EQUAL(0, Registry::writeJson(nullptr, 0));
+
+    // A snapshot that was not written drains nothing
+    Histogram::Snapshot kept = s_latency.drain();
+    TEST_ASSERT_EQUAL_UINT32(1, kept.count);
+    TEST_ASSERT_EQUAL_UINT32(500, kept.max);
+}
+
+void test_commit_keeps_values_recorded_after_peek()
+{
+    s_latency.record(50);
+    Histogram::Snapshot peeked = s_latency.peek();
+    TEST_ASSERT_EQUAL_UINT32(1, peeked.count);
+
+    s_latency.record(5000);
+    s_latency.commit();
+
+    Histogram::Snapshot rest = s_latency.drain();
+    TEST_ASSERT_EQUAL_UINT32(1, rest.count);
+    TEST_ASSERT_EQUAL_UINT32(1, rest.counts[2]);
+    TEST_ASSERT_EQUAL_UINT32(5000, rest.sum);
+    TEST_ASSERT_EQUAL_UINT32(5000, rest.max);
+}
+
+void test_firmware_snapshot_fits_one_packet()
+{
+    // Every metric linked into the firmware at its widest: counters and
+    // gauges at their longest values, histograms with six-digit buckets and
+    // saturated sums, as a long interval would leave them
+    for (Metric *metric = Registry::first(); metric != nullptr; metric = metric->next())
+    {
+        switch (metric->kind())
+        {
+        case Kind::Counter:
+        {
+            auto *counter = static_cast<Counter *>(metric);
+            counter->increment(UINT32_MAX - counter->value());
+            break;
+        }
+        case Kind::Gauge:
+            static_cast<Gauge *>(metric)->set(INT32_MIN);
+            break;
+        case Kind::Histogram:
+        {
+            auto *histogram = static_cast<Histogram *>(metric);
+            for (size_t bucket = 0; bucket < histogram->bucketCount(); bucket++)
+            {
+                uint32_t value = bucket + 1 < histogram->bucketCount() ? histogram->bounds()[bucket] : UINT32_MAX;
+                for (int i = 0; i < 100000; i++)
+                {
+                    histogram->record(value);
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    char json[IMQTTService::MAX_PAYLOAD_SIZE];
+    size_t length = Registry::writeJson(json, sizeof(json));
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"mqtt.publish_us\":{"));
+    TEST_ASSERT_NOT_NULL(strstr(json, "\"stack.event_loop_free\":-2147483648"));
+    Registry::commitHistograms();
+}
+
+#ifdef NATIVE_TEST
+void test_concurrent_updates()
+{
+    uint32_t before = s_requests.value();
+    auto work = []() {
+        for (int i = 0; i < 10000; i++)
+        {
+            s_requests.increment();
+            s_latency.record(static_cast<uint32_t>(i % 2000));
+        }
+    };
+    std::thread a(work);
+    std::thread b(work);
+    a.join();
+    b.join();
+
+    TEST_ASSERT_EQUAL_UINT32(before + 20000, s_requests.value());
+    Histogram::Snapshot snapshot = s_latency.drain();
+    TEST_ASSERT_EQUAL_UINT32(20000, snapshot.count);
+    TEST_ASSERT_EQUAL_UINT32(1999, snapshot.max);
+    // Each thread records 0..1999 five times
+    TEST_ASSERT_EQUAL_UINT32(2 * 5 * 1999 * 2000 / 2, snapshot.sum);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_static_metrics_are_registered);
+    RUN_TEST(test_counter_and_gauge);
+    RUN_TEST(test_histogram_buckets_are_inclusive_upper_bounds);
+    RUN_TEST(test_histogram_drain_resets);
+    RUN_TEST(test_histogram_sum_saturates);
+    RUN_TEST(test_json_snapshot);
+    RUN_TEST(test_json_snapshot_too_small);
+    RUN_TEST(test_commit_keeps_values_recorded_after_peek);
+    RUN_TEST(test_firmware_snapshot_fits_one_packet);
+    RUN_TEST(test_concurrent_updates);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_static_metrics_are_registered);
+    RUN_TEST(test_counter_and_gauge);
+    RUN_TEST(test_histogram_buckets_are_inclusive_upper_bounds);
+    RUN_TEST(test_histogram_drain_resets);
+    RUN_TEST(test_histogram_sum_saturates);
+    RUN_TEST(test_json_snapshot);
+    RUN_TEST(test_json_snapshot_too_small);
+    RUN_TEST(test_commit_keeps_values_recorded_after_peek);
+    RUN_TEST(test_firmware_snapshot_fits_one_packet);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -39,6 +39,20 @@ void test_network_download_failure();
 void test_network_download_when_disconnected();
 void test_network_download_chunk_handler_rejects();
 
+// State machine tests (test_network_state_machine.cpp)
+void test_network_sm_idle_until_enabled();
+void test_network_sm_connects_without_blocking();
+void test_network_sm_timeout_enters_backoff();
+void test_network_sm_backoff_is_exponential_and_capped();
+void test_network_sm_jitter_stays_in_range();
+void test_network_sm_link_loss_reconnects();
+void test_network_sm_success_resets_failures();
+void test_network_sm_disable_reports_disconnect();
+void test_network_sm_fast_path_connects_first();
+void test_network_sm_fast_path_falls_back_to_scan();
+void test_network_sm_fast_path_retried_after_backoff();
+void test_network_mock_reports_connection_edges();
+
 #ifdef NATIVE_TEST
 int main(int argc, char **argv)
 {
@@ -65,6 +79,20 @@ int main(int argc, char **argv)
     RUN_TEST(test_network_download_when_disconnected);
     RUN_TEST(test_network_download_chunk_handler_rejects);
 
+    // State machine tests
+    RUN_TEST(test_network_sm_idle_until_enabled);
+    RUN_TEST(test_network_sm_connects_without_blocking);
+    RUN_TEST(test_network_sm_timeout_enters_backoff);
+    RUN_TEST(test_network_sm_backoff_is_exponential_and_capped);
+    RUN_TEST(test_network_sm_jitter_stays_in_range);
+    RUN_TEST(test_network_sm_link_loss_reconnects);
+    RUN_TEST(test_network_sm_success_resets_failures);
+    RUN_TEST(test_network_sm_disable_reports_disconnect);
+    RUN_TEST(test_network_sm_fast_path_connects_first);
+    RUN_TEST(test_network_sm_fast_path_falls_back_to_scan);
+    RUN_TEST(test_network_sm_fast_path_retried_after_backoff);
+    RUN_TEST(test_network_mock_reports_connection_edges);
+
     return UNITY_END();
 }
 #else
@@ -96,6 +124,20 @@ void setup()
     RUN_TEST(test_network_download_when_disconnected);
     RUN_TEST(test_network_download_chunk_handler_rejects);
 
+    // State machine tests
+    RUN_TEST(test_network_sm_idle_until_enabled);
+    RUN_TEST(test_network_sm_connects_without_blocking);
+    RUN_TEST(test_network_sm_timeout_enters_backoff);
+    RUN_TEST(test_network_sm_backoff_is_exponential_and_capped);
+    RUN_TEST(test_network_sm_jitter_stays_in_range);
+    RUN_TEST(test_network_sm_link_loss_reconnects);
+    RUN_TEST(test_network_sm_success_resets_failures);
+    RUN_TEST(test_network_sm_disable_reports_disconnect);
+    RUN_TEST(test_network_sm_fast_path_connects_first);
+    RUN_TEST(test_network_sm_fast_path_falls_back_to_scan);
+    RUN_TEST(test_network_sm_fast_path_retried_after_backoff);
+    RUN_TEST(test_network_mock_reports_connection_edges);
+
     UNITY_END();
 }
 
@@ -0,0 +1,219 @@
+#include "testing/network/helpers.h"
+#include "libs/plant_nanny/services/network/ConnectionStateMachine.h"
+#include <vector>
+
+using network::BackoffPolicy;
+using network::ConnectionAction;
+using network::ConnectionState;
+using network::ConnectionStateMachine;
+
+// ============================================================================
+// Connection State Machine Tests (fake clock, simulated link)
+// ============================================================================
+
+namespace
+{
+    BackoffPolicy test_policy()
+    {
+        BackoffPolicy policy;
+        policy.connectTimeoutMs = 1000;
+        policy.initialDelayMs = 100;
+        policy.maxDelayMs = 800;
+        policy.jitterPct = 0;
+        return policy;
+    }
+}
+
+void test_network_sm_idle_until_enabled()
+{
+    ConnectionStateMachine sm(test_policy());
+    TEST_ASSERT_TRUE(sm.tick(0, false) == ConnectionAction::None);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Idle);
+
+    sm.setEnabled(true);
+    TEST_ASSERT_TRUE(sm.tick(10, false) == ConnectionAction::BeginConnect);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Connecting);
+}
+
+void test_network_sm_connects_without_blocking()
+{
+    ConnectionStateMachine sm(test_policy());
+    sm.setEnabled(true);
+    sm.tick(0, false);
+
+    // Each tick returns immediately while the link comes up
+    TEST_ASSERT_TRUE(sm.tick(100, false) == ConnectionAction::None);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Connecting);
+    TEST_ASSERT_TRUE(sm.tick(200, true) == ConnectionAction::None);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Connected);
+}
+
+void test_network_sm_timeout_enters_backoff()
+{
+    ConnectionStateMachine sm(test_policy());
+    sm.setEnabled(true);
+    sm.tick(0, false);
+
+    TEST_ASSERT_TRUE(sm.tick(1000, false) == ConnectionAction::AbortConnect);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Backoff);
+    TEST_ASSERT_EQUAL_UINT32(1, sm.failures());
+    TEST_ASSERT_EQUAL_UINT32(1100, sm.retryAt());
+
+    TEST_ASSERT_TRUE(sm.tick(1099, false) == ConnectionAction::None);
+    TEST_ASSERT_TRUE(sm.tick(1100, false) == ConnectionAction::BeginConnect);
+}
+
+void test_network_sm_backoff_is_exponential_and_capped()
+{
+    ConnectionStateMachine sm(test_policy());
+    TEST_ASSERT_EQUAL_UINT32(100, sm.baseDelayMs(1));
+    TEST_ASSERT_EQUAL_UINT32(200, sm.baseDelayMs(2));
+    TEST_ASSERT_EQUAL_UINT32(400, sm.baseDelayMs(3));
+    TEST_ASSERT_EQUAL_UINT32(800, sm.baseDelayMs(4));
+    TEST_ASSERT_EQUAL_UINT32(800, sm.baseDelayMs(20));
+}
+
+void test_network_sm_jitter_stays_in_range()
+{
+    BackoffPolicy policy = test_policy();
+    policy.jitterPct = 50;
+
+    uint32_t values[] = {0, 1, 99, 100};
+    for (uint32_t value : values)
+    {
+        ConnectionStateMachine sm(policy, [value]() { return value; });
+        sm.setEnabled(true);
+        sm.tick(0, false);
+        sm.tick(1000, false);
+
+        uint32_t delay = sm.retryAt() - 1000;
+        TEST_ASSERT_GREATER_OR_EQUAL(50, delay);
+        TEST_ASSERT_LESS_OR_EQUAL(150, delay);
+    }
+}
+
+void test_network_sm_link_loss_reconnects()
+{
+    std::vector<bool> edges;
+    ConnectionStateMachine sm(test_policy());
+    sm.setCallback([&edges](bool connected) { edges.push_back(connected); });
+    sm.setEnabled(true);
+    sm.tick(0, false);
+    sm.tick(50, true);
+
+    TEST_ASSERT_TRUE(sm.tick(500, false) == ConnectionAction::None);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Backoff);
+    TEST_ASSERT_TRUE(sm.tick(600, false) == ConnectionAction::BeginConnect);
+    sm.tick(700, true);
+
+    TEST_ASSERT_EQUAL(3, edges.size());
+    TEST_ASSERT_TRUE(edges[0]);
+    TEST_ASSERT_FALSE(edges[1]);
+    TEST_ASSERT_TRUE(edges[2]);
+}
+
+void test_network_sm_success_resets_failures()
+{
+    ConnectionStateMachine sm(test_policy());
+    sm.setEnabled(true);
+    sm.tick(0, false);
+    sm.tick(1000, false);
+    sm.tick(1100, false);
+    sm.tick(2100, false);
+    TEST_ASSERT_EQUAL_UINT32(2, sm.failures());
+
+    sm.tick(2300, false);
+    sm.tick(2400, true);
+    TEST_ASSERT_EQUAL_UINT32(0, sm.failures());
+}
+
+void test_network_sm_disable_reports_disconnect()
+{
+    bool last = true;
+    ConnectionStateMachine sm(test_policy());
+    sm.setCallback([&last](bool connected) { last = connected; });
+    sm.setEnabled(true);
+    sm.tick(0, true);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Connected);
+
+    sm.setEnabled(false);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Idle);
+    TEST_ASSERT_FALSE(last);
+    TEST_ASSERT_TRUE(sm.tick(100, false) == ConnectionAction::None);
+}
+
+void test_network_sm_fast_path_connects_first()
+{
+    ConnectionStateMachine sm(test_policy());
+    sm.setFastPathAvailable(true);
+    sm.setEnabled(true);
+
+    TEST_ASSERT_TRUE(sm.tick(0, false) == ConnectionAction::BeginFastConnect);
+    TEST_ASSERT_TRUE(sm.tick(120, true) == ConnectionAction::None);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Connected);
+    TEST_ASSERT_EQUAL_UINT32(120, sm.stats().lastConnectMs);
+    TEST_ASSERT_TRUE(sm.stats().lastConnectFast);
+    TEST_ASSERT_EQUAL_UINT32(1, sm.stats().fastConnects);
+}
+
+void test_network_sm_fast_path_falls_back_to_scan()
+{
+    BackoffPolicy policy = test_policy();
+    policy.fastConnectTimeoutMs = 200;
+    ConnectionStateMachine sm(policy);
+    sm.setFastPathAvailable(true);
+    sm.setEnabled(true);
+
+    TEST_ASSERT_TRUE(sm.tick(0, false) == ConnectionAction::BeginFastConnect);
+    TEST_ASSERT_TRUE(sm.tick(199, false) == ConnectionAction::None);
+    TEST_ASSERT_TRUE(sm.tick(200, false) == ConnectionAction::BeginConnect);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Connecting);
+    TEST_ASSERT_EQUAL_UINT32(0, sm.failures());
+    TEST_ASSERT_EQUAL_UINT32(1, sm.stats().fastFallbacks);
+
+    // Scan path gets the full timeout from the fallback point
+    TEST_ASSERT_TRUE(sm.tick(1100, false) == ConnectionAction::None);
+    TEST_ASSERT_TRUE(sm.tick(1500, true) == ConnectionAction::None);
+    TEST_ASSERT_TRUE(sm.state() == ConnectionState::Connected);
+    TEST_ASSERT_EQUAL_UINT32(1500, sm.stats().lastConnectMs);
+    TEST_ASSERT_FALSE(sm.stats().lastConnectFast);
+}
+
+void test_network_sm_fast_path_retried_after_backoff()
+{
+    BackoffPolicy policy = test_policy();
+    policy.fastConnectTimeoutMs = 200;
+    ConnectionStateMachine sm(policy);
+    sm.setFastPathAvailable(true);
+    sm.setEnabled(true);
+
+    sm.tick(0, false);
+    sm.tick(200, false);
+    TEST_ASSERT_TRUE(sm.tick(1200, false) == ConnectionAction::AbortConnect);
+    TEST_ASSERT_EQUAL_UINT32(1, sm.stats().failures);
+
+    TEST_ASSERT_TRUE(sm.tick(1300, false) == ConnectionAction::BeginFastConnect);
+
+    TEST_ASSERT_TRUE(sm.tick(1500, false) == ConnectionAction::BeginConnect);
+    TEST_ASSERT_TRUE(sm.tick(2500, false) == ConnectionAction::AbortConnect);
+    TEST_ASSERT_EQUAL_UINT32(2, sm.stats().fastFallbacks);
+
+    // Cache invalidated: straight to a full scan
+    sm.setFastPathAvailable(false);
+    TEST_ASSERT_TRUE(sm.tick(2700, false) == ConnectionAction::BeginConnect);
+}
+
+void test_network_mock_reports_connection_edges()
+{
+    std::vector<bool> edges;
+    mock_network->set_connection_callback([&edges](bool connected) { edges.push_back(connected); });
+
+    mock_network->connect();
+    mock_network->connect();
+    mock_network->disconnect();
+
+    TEST_ASSERT_EQUAL(2, edges.size());
+    TEST_ASSERT_TRUE(edges[0]);
+    TEST_ASSERT_FALSE(edges[1]);
+    TEST_ASSERT_TRUE(mock_network->get_connection_state() == ConnectionState::Idle);
+}
@@ -0,0 +1,352 @@
+#include <unity.h>
+#include "libs/common/service/Registry.h"
+#include "libs/common/utils/Sha256.h"
+#include "libs/plant_nanny/services/ota/DeltaPatcher.h"
+#include "libs/plant_nanny/services/ota/Manifest.h"
+#include "libs/plant_nanny/services/ota/UpdateOrchestrator.h"
+#include "testing/libs/plant_nanny/services/network/MockINetworkService.h"
+#include "esp_ota_ops.h"
+#include <cstring>
+#include <vector>
+
+using namespace plant_nanny::services::ota;
+using common::utils::Sha256;
+using testing::mocks::MockNetworkConfig;
+using testing::mocks::MockNetworkService;
+
+namespace
+{
+    std::vector<uint8_t> sampleSource(size_t size)
+    {
+        std::vector<uint8_t> image(size);
+        uint32_t seed = 99;
+        for (auto &byte : image)
+        {
+            seed = seed * 1103515245u + 12345u;
+            byte = static_cast<uint8_t>(seed >> 16);
+        }
+        return image;
+    }
+
+    /**
+     * @brief Hand-assembles patches; records are added in target order
+     */
+    struct PatchBuilder
+    {
+        std::vector<uint8_t> out;
+
+        PatchBuilder(size_t source_size, size_t target_size)
+        {
+            put16(DeltaPatcher::MAGIC);
+            out.push_back(DeltaPatcher::VERSION);
+            out.push_back(0);
+            put32(static_cast<uint32_t>(source_size));
+            put32(static_cast<uint32_t>(target_size));
+        }
+
+        void put16(uint16_t value)
+        {
+            out.push_back(static_cast<uint8_t>(value));
+            out.push_back(static_cast<uint8_t>(value >> 8));
+        }
+
+        void put32(uint32_t value)
+        {
+            for (int i = 0; i < 4; i++)
+            {
+                out.push_back(static_cast<uint8_t>(value >> (8 * i)));
+            }
+        }
+
+        void record(const uint8_t *source, const uint8_t *target, size_t diff_length, size_t extra_length, int32_t seek)
+        {
+            put32(static_cast<uint32_t>(diff_length));
+            put32(static_cast<uint32_t>(extra_length));
+            put32(static_cast<uint32_t>(seek));
+            for (size_t i = 0; i < diff_length; i++)
+            {
+                out.push_back(static_cast<uint8_t>(target[i] - source[i]));
+            }
+            out.insert(out.end(), target + diff_length, target + diff_length + extra_length);
+        }
+    };
+
+    /**
+     * @brief A release that patches a few addresses, inserts a block and drops the tail
+     */
+    struct Release
+    {
+        std::vector<uint8_t> source;
+        std::vector<uint8_t> target;
+        std::vector<uint8_t> patch;
+
+        Release()
+        {
+            source = sampleSource(8192);
+
+            target.assign(source.begin(), source.begin() + 4000);
+            target[100] ^= 0x10;
+            target[101] += 3;
+            for (int i = 0; i < 64; i++)
+            {
+                target.push_back(static_cast<uint8_t>(i));
+            }
+            target.insert(target.end(), source.begin() + 4000, source.end() - 512);
+
+            PatchBuilder builder(source.size(), target.size());
+            builder.record(source.data(), target.data(), 4000, 64, 0);
+            builder.record(source.data() + 4000, target.data() + 4064, source.size() - 512 - 4000, 0, 0);
+            patch = builder.out;
+        }
+    };
+
+    struct Applied
+    {
+        bool ok = true;
+        std::vector<uint8_t> out;
+    };
+
+    Applied apply(const std::vector<uint8_t> &source, const std::vector<uint8_t> &patch, size_t chunk_size)
+    {
+        Applied applied;
+        DeltaPatcher patcher(
+            source.size(),
+            [&](size_t offset, uint8_t *out, size_t length)
+            {
+                TEST_ASSERT_TRUE(offset + length <= source.size());
+                memcpy(out, source.data() + offset, length);
+                return common::patterns::Result<void>::success();
+            },
+            [&](const uint8_t *data, size_t length)
+            {
+                applied.out.insert(applied.out.end(), data, data + length);
+                return common::patterns::Result<void>::success();
+            });
+
+        for (size_t offset = 0; offset < patch.size() && applied.ok; offset += chunk_size)
+        {
+            size_t length = std::min(chunk_size, patch.size() - offset);
+            applied.ok = patcher.feed(patch.data() + offset, length).succeed();
+        }
+        applied.ok = applied.ok && patcher.finish().succeed();
+        return applied;
+    }
+
+    MockNetworkService *network = nullptr;
+
+    void serve(const std::vector<uint8_t> &payload)
+    {
+        MockNetworkConfig config;
+        config.download_payload = payload;
+        network->test_update_config(config);
+        network->connect();
+    }
+}
+
+void setUp(void)
+{
+    common::service::DefaultRegistry::create();
+    network = new MockNetworkService();
+    common::service::add<plant_nanny::services::network::INetworkService>(*network);
+}
+
+void tearDown(void)
+{
+    common::service::remove<plant_nanny::services::network::INetworkService>();
+    delete network;
+}
+
+void test_sha256_known_vectors()
+{
+    char hex[Sha256::HEX_SIZE];
+    Sha256::to_hex(Sha256::compute("", 0), hex);
+    TEST_ASSERT_EQUAL_STRING("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855", hex);
+
+    Sha256::to_hex(Sha256::compute("abc", 3), hex);
+    TEST_ASSERT_EQUAL_STRING("ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", hex);
+
+    const char *two_blocks = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+    Sha256::to_hex(Sha256::compute(two_blocks, strlen(two_blocks)), hex);
+    TEST_ASSERT_EQUAL_STRING("248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1", hex);
+}
+
+void test_sha256_incremental_matches_one_shot()
+{
+    std::vector<uint8_t> data = sampleSource(1000);
+    Sha256 sha;
+    for (size_t offset = 0, step = 1; offset < data.size(); offset += step, step = step * 2 + 1)
+    {
+        sha.update(data.data() + offset, std::min(step, data.size() - offset));
+    }
+    TEST_ASSERT_TRUE(sha.finish() == Sha256::compute(data.data(), data.size()));
+}
+
+void test_sha256_hex_parsing()
+{
+    Sha256::Digest digest;
+    TEST_ASSERT_TRUE(Sha256::from_hex("BA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD", digest));
+    TEST_ASSERT_TRUE(digest == Sha256::compute("abc", 3));
+    TEST_ASSERT_FALSE(Sha256::from_hex("ba7816bf", digest));
+    TEST_ASSERT_FALSE(Sha256::from_hex("zz7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad", digest));
+}
+
+void test_delta_rebuilds_target_any_chunking()
+{
+    Release release;
+    TEST_ASSERT_TRUE(release.patch.size() > release.target.size());  // Raw diffs are mostly zeros: compress them
+
+    for (size_t chunk : {size_t{1}, size_t{13}, size_t{4096}, release.patch.size()})
+    {
+        Applied applied = apply(release.source, release.patch, chunk);
+        TEST_ASSERT_TRUE(applied.ok);
+        TEST_ASSERT_EQUAL(release.target.size(), applied.out.size());
+        TEST_ASSERT_EQUAL_MEMORY(release.target.data(), applied.out.data(), release.target.size());
+    }
+}
+
+void test_delta_rejects_patch_for_other_source()
+{
+    Release release;
+    release.source.pop_back();
+    TEST_ASSERT_FALSE(apply(release.source, release.patch, 512).ok);
+}
+
+void test_delta_rejects_reads_outside_source()
+{
+    std::vector<uint8_t> source = sampleSource(256);
+    std::vector<uint8_t> target(300, 0);
+
+    PatchBuilder past_end(source.size(), target.size());
+    past_end.record(source.data(), target.data(), 0, 0, 200);
+    std::vector<uint8_t> pad(100, 0);
+    past_end.record(pad.data(), target.data(), 100, 200, 0);  // 200 + 100 > 256
+    TEST_ASSERT_FALSE(apply(source, past_end.out, 64).ok);
+
+    PatchBuilder before_start(source.size(), target.size());
+    before_start.record(source.data(), target.data(), 0, 300, -1);
+    TEST_ASSERT_FALSE(apply(source, before_start.out, 64).ok);
+}
+
+void test_delta_rejects_truncated_or_overlong_patch()
+{
+    Release release;
+    std::vector<uint8_t> truncated(release.patch.begin(), release.patch.end() - 1);
+    TEST_ASSERT_FALSE(apply(release.source, truncated, 256).ok);
+
+    std::vector<uint8_t> overlong = release.patch;
+    overlong.push_back(0);
+    TEST_ASSERT_FALSE(apply(release.source, overlong, 256).ok);
+}
+
+#ifdef NATIVE_TEST
+// The orchestrator tests run against the mocked running partition and esp_ota_write
+
+namespace
+{
+    Manifest deltaManifest(const Release &release)
+    {
+        Manifest manifest;
+        manifest.url = "http://server/firmware.delta";
+        manifest.delta = true;
+        manifest.source_size = release.source.size();
+        manifest.source_sha256 = Sha256::compute(release.source.data(), release.source.size());
+        manifest.sha256 = Sha256::compute(release.target.data(), release.target.size());
+        return manifest;
+    }
+}
+
+void test_orchestrator_applies_delta_to_running_image()
+{
+    Release release;
+    mock_partition_contents = release.source;
+    serve(release.patch);
+
+    UpdateOrchestrator orchestrator;
+    TEST_ASSERT_TRUE(orchestrator.update(deltaManifest(release)).succeed());
+    TEST_ASSERT_EQUAL(release.target.size(), mock_ota_written.size());
+    TEST_ASSERT_EQUAL_MEMORY(release.target.data(), mock_ota_written.data(), release.target.size());
+}
+
+void test_orchestrator_checks_source_before_download()
+{
+    Release release;
+    mock_partition_contents = release.source;
+    mock_partition_contents[10] ^= 0xFF;  // Device runs another build
+    serve(release.patch);
+    mock_ota_written.clear();
+
+    UpdateOrchestrator orchestrator;
+    TEST_ASSERT_TRUE(orchestrator.update(deltaManifest(release)).failed());
+    TEST_ASSERT_EQUAL(0, mock_ota_written.size());
+}
+
+void test_orchestrator_checks_result_before_finalize()
+{
+    Release release;
+    mock_partition_contents = release.source;
+    serve(release.patch);
+
+    Manifest manifest = deltaManifest(release);
+    (*manifest.sha256)[0] ^= 0x01;
+
+    UpdateOrchestrator orchestrator;
+    TEST_ASSERT_TRUE(orchestrator.update(manifest).failed());
+
+    // Update slot released, the right manifest still goes through
+    TEST_ASSERT_TRUE(orchestrator.update(deltaManifest(release)).succeed());
+}
+
+void test_orchestrator_requires_result_hash_for_delta()
+{
+    Release release;
+    mock_partition_contents = release.source;
+    serve(release.patch);
+
+    Manifest manifest = deltaManifest(release);
+    manifest.sha256.reset();
+
+    UpdateOrchestrator orchestrator;
+    TEST_ASSERT_TRUE(orchestrator.update(manifest).failed());
+}
+#endif
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sha256_known_vectors);
+    RUN_TEST(test_sha256_incremental_matches_one_shot);
+    RUN_TEST(test_sha256_hex_parsing);
+    RUN_TEST(test_delta_rebuilds_target_any_chunking);
+    RUN_TEST(test_delta_rejects_patch_for_other_source);
+    RUN_TEST(test_delta_rejects_reads_outside_source);
+    RUN_TEST(test_delta_rejects_truncated_or_overlong_patch);
+    RUN_TEST(test_orchestrator_applies_delta_to_running_image);
+    RUN_TEST(test_orchestrator_checks_source_before_download);
+    RUN_TEST(test_orchestrator_checks_result_before_finalize);
+    RUN_TEST(test_orchestrator_requires_result_hash_for_delta);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_sha256_known_vectors);
+    RUN_TEST(test_sha256_incremental_matches_one_shot);
+    RUN_TEST(test_sha256_hex_parsing);
+    RUN_TEST(test_delta_rebuilds_target_any_chunking);
+    RUN_TEST(test_delta_rejects_patch_for_other_source);
+    RUN_TEST(test_delta_rejects_reads_outside_source);
+    RUN_TEST(test_delta_rejects_truncated_or_overlong_patch);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,238 @@
+#include <unity.h>
+#include "libs/common/service/Registry.h"
+#include "libs/plant_nanny/services/ota/PingPongWriter.h"
+#include "libs/plant_nanny/services/ota/UpdateOrchestrator.h"
+#include "testing/libs/plant_nanny/services/network/MockINetworkService.h"
+#include "esp_ota_ops.h"
+#include <vector>
+
+using namespace plant_nanny::services::ota;
+using testing::mocks::MockNetworkConfig;
+using testing::mocks::MockNetworkService;
+
+namespace
+{
+    std::vector<uint8_t> sampleImage(size_t size)
+    {
+        std::vector<uint8_t> image(size);
+        uint32_t state = 0x12345678;
+        for (auto &byte : image)
+        {
+            state = state * 1103515245 + 12345;
+            byte = static_cast<uint8_t>(state >> 16);
+        }
+        return image;
+    }
+
+    // Feeds data in chunks that do not line up with the buffers
+    std::vector<uint8_t> pipe(const std::vector<uint8_t> &data, size_t buffer_size, size_t chunk_size)
+    {
+        std::vector<uint8_t> out;
+        PingPongWriter writer(buffer_size,
+                              [&](const uint8_t *chunk, size_t length)
+                              {
+                                  TEST_ASSERT_TRUE(length <= buffer_size);
+                                  out.insert(out.end(), chunk, chunk + length);
+                                  return common::patterns::Result<void>::success();
+                              });
+
+        for (size_t offset = 0; offset < data.size(); offset += chunk_size)
+        {
+            size_t length = std::min(chunk_size, data.size() - offset);
+            TEST_ASSERT_TRUE(writer.write(data.data() + offset, length).succeed());
+        }
+        TEST_ASSERT_TRUE(writer.flush().succeed());
+        return out;
+    }
+
+    MockNetworkService *network = nullptr;
+
+    void serve(const std::vector<uint8_t> &payload, size_t drop_at = 0)
+    {
+        MockNetworkConfig config;
+        config.download_payload = payload;
+        config.download_chunk_size = 1460;
+        config.download_drop_at = drop_at;
+        network->test_update_config(config);
+        network->connect();
+    }
+
+    UpdateOptions testOptions()
+    {
+        UpdateOptions options;
+        options.buffer_size = 1024;
+        options.resume_delay_ms = 0;
+        options.progress_interval_ms = 0;
+        return options;
+    }
+}
+
+void setUp(void)
+{
+    common::service::DefaultRegistry::create();
+    network = new MockNetworkService();
+    common::service::add<plant_nanny::services::network::INetworkService>(*network);
+}
+
+void tearDown(void)
+{
+    common::service::remove<plant_nanny::services::network::INetworkService>();
+    delete network;
+}
+
+void test_pingpong_keeps_order_for_any_buffer_size()
+{
+    std::vector<uint8_t> data = sampleImage(10000);
+    const size_t buffer_sizes[] = {1, 7, 256, 4096, 20000};
+    const size_t chunk_sizes[] = {1, 100, 1460};
+    for (size_t buffer_size : buffer_sizes)
+    {
+        for (size_t chunk_size : chunk_sizes)
+        {
+            std::vector<uint8_t> out = pipe(data, buffer_size, chunk_size);
+            TEST_ASSERT_EQUAL(data.size(), out.size());
+            TEST_ASSERT_EQUAL_MEMORY(data.data(), out.data(), data.size());
+        }
+    }
+}
+
+void test_pingpong_flush_without_data()
+{
+    size_t calls = 0;
+    PingPongWriter writer(64,
+                          [&](const uint8_t *, size_t)
+                          {
+                              calls++;
+                              return common::patterns::Result<void>::success();
+                          });
+    TEST_ASSERT_TRUE(writer.flush().succeed());
+    TEST_ASSERT_EQUAL(0, calls);
+}
+
+void test_pingpong_reports_sink_error()
+{
+    size_t calls = 0;
+    PingPongWriter writer(16,
+                          [&](const uint8_t *, size_t)
+                          {
+                              calls++;
+                              return common::patterns::Result<void>::failure(common::patterns::Error("flash full"));
+                          });
+
+    std::vector<uint8_t> data = sampleImage(256);
+    bool failed = false;
+    for (size_t offset = 0; offset < data.size() && !failed; offset += 16)
+    {
+        failed = writer.write(data.data() + offset, 16).failed();
+    }
+    // The error surfaces on a later write at the latest, and on flush in any case
+    TEST_ASSERT_TRUE(writer.flush().failed());
+    TEST_ASSERT_EQUAL(1, calls);
+}
+
+#ifdef NATIVE_TEST
+// The orchestrator tests read back what reached the mocked esp_ota_write
+
+void test_orchestrator_resumes_after_connection_loss()
+{
+    std::vector<uint8_t> image = sampleImage(20000);
+    serve(image, 7000);
+
+    UpdateOrchestrator orchestrator(testOptions());
+    TEST_ASSERT_TRUE(orchestrator.update_from_url("http://server/firmware.bin").succeed());
+
+    const auto &offsets = network->test_download_offsets();
+    TEST_ASSERT_EQUAL(2, offsets.size());
+    TEST_ASSERT_EQUAL(0, offsets[0]);
+    TEST_ASSERT_EQUAL(7000, offsets[1]);
+    TEST_ASSERT_EQUAL(image.size(), mock_ota_written.size());
+    TEST_ASSERT_EQUAL_MEMORY(image.data(), mock_ota_written.data(), image.size());
+}
+
+void test_orchestrator_gives_up_without_resume_attempts()
+{
+    serve(sampleImage(20000), 7000);
+
+    UpdateOptions options = testOptions();
+    options.resume_attempts = 0;
+    UpdateOrchestrator orchestrator(options);
+    TEST_ASSERT_TRUE(orchestrator.update_from_url("http://server/firmware.bin").failed());
+    TEST_ASSERT_EQUAL(1, network->test_download_offsets().size());
+
+    // The slot was released
+    serve(sampleImage(1024));
+    TEST_ASSERT_TRUE(orchestrator.update_from_url("http://server/firmware.bin").succeed());
+}
+
+void test_orchestrator_verifies_resumed_image_hash()
+{
+    std::vector<uint8_t> image = sampleImage(12000);
+    serve(image, 5000);
+
+    Manifest manifest;
+    manifest.url = "http://server/firmware.bin";
+    manifest.sha256 = common::utils::Sha256::compute(image.data(), image.size());
+
+    UpdateOrchestrator orchestrator(testOptions());
+    TEST_ASSERT_TRUE(orchestrator.update(manifest).succeed());
+
+    // A byte off after the resume point fails verification
+    image[9000] ^= 0x01;
+    serve(image, 5000);
+    TEST_ASSERT_TRUE(orchestrator.update(manifest).failed());
+}
+
+void test_orchestrator_reports_throughput()
+{
+    std::vector<uint8_t> image = sampleImage(16384);
+    serve(image, 4000);
+
+    std::vector<UpdateProgress> reports;
+    UpdateOrchestrator orchestrator(testOptions());
+    orchestrator.set_progress_callback([&](const UpdateProgress &progress)
+                                       { reports.push_back(progress); });
+    TEST_ASSERT_TRUE(orchestrator.update_from_url("http://server/firmware.bin").succeed());
+
+    TEST_ASSERT_FALSE(reports.empty());
+    for (size_t i = 1; i < reports.size(); i++)
+    {
+        TEST_ASSERT_TRUE(reports[i].bytes >= reports[i - 1].bytes);
+    }
+    TEST_ASSERT_EQUAL(image.size(), reports.back().bytes);
+    TEST_ASSERT_EQUAL(image.size(), reports.back().total);
+    TEST_ASSERT_EQUAL(100, orchestrator.get_progress());
+}
+#endif
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pingpong_keeps_order_for_any_buffer_size);
+    RUN_TEST(test_pingpong_flush_without_data);
+    RUN_TEST(test_pingpong_reports_sink_error);
+    RUN_TEST(test_orchestrator_resumes_after_connection_loss);
+    RUN_TEST(test_orchestrator_gives_up_without_resume_attempts);
+    RUN_TEST(test_orchestrator_verifies_resumed_image_hash);
+    RUN_TEST(test_orchestrator_reports_throughput);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_pingpong_keeps_order_for_any_buffer_size);
+    RUN_TEST(test_pingpong_flush_without_data);
+    RUN_TEST(test_pingpong_reports_sink_error);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
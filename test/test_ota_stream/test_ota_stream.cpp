@@ -0,0 +1,395 @@
+#include <unity.h>
+#include "libs/common/service/Registry.h"
+#include "libs/plant_nanny/services/ota/HeatshrinkDecoder.h"
+#include "libs/plant_nanny/services/ota/Manifest.h"
+#include "libs/plant_nanny/services/ota/UpdateOrchestrator.h"
+#include "testing/libs/plant_nanny/services/network/MockINetworkService.h"
+#include "esp_ota_ops.h"
+#include <vector>
+
+using namespace plant_nanny::services::ota;
+using testing::mocks::MockNetworkConfig;
+using testing::mocks::MockNetworkService;
+
+namespace
+{
+    struct BitWriter
+    {
+        std::vector<uint8_t> out;
+        uint8_t current = 0;
+        uint8_t used = 0;
+
+        void put(uint32_t value, uint8_t bits)
+        {
+            for (int i = bits - 1; i >= 0; i--)
+            {
+                current = static_cast<uint8_t>((current << 1) | ((value >> i) & 1));
+                if (++used == 8)
+                {
+                    out.push_back(current);
+                    current = 0;
+                    used = 0;
+                }
+            }
+        }
+
+        std::vector<uint8_t> finish()
+        {
+            if (used > 0)
+            {
+                out.push_back(static_cast<uint8_t>(current << (8 - used)));  // Zero padding, like heatshrink
+            }
+            return out;
+        }
+    };
+
+    /**
+     * @brief Greedy encoder producing the same bitstream as `heatshrink -e -w <w> -l <l>`
+     */
+    std::vector<uint8_t> compress(const std::vector<uint8_t> &input, uint8_t window_bits, uint8_t lookahead_bits)
+    {
+        BitWriter writer;
+        const size_t window = size_t{1} << window_bits;
+        const size_t max_count = size_t{1} << lookahead_bits;
+
+        for (size_t pos = 0; pos < input.size();)
+        {
+            size_t best_length = 0;
+            size_t best_offset = 0;
+            for (size_t offset = 1; offset <= window && offset <= pos; offset++)
+            {
+                size_t length = 0;
+                while (length < max_count && pos + length < input.size() &&
+                       input[pos + length] == input[pos + length - offset])
+                {
+                    length++;
+                }
+                if (length > best_length)
+                {
+                    best_length = length;
+                    best_offset = offset;
+                }
+            }
+
+            if (best_length * 9 > 1u + window_bits + lookahead_bits)
+            {
+                writer.put(0, 1);
+                writer.put(static_cast<uint32_t>(best_offset - 1), window_bits);
+                writer.put(static_cast<uint32_t>(best_length - 1), lookahead_bits);
+                pos += best_length;
+            }
+            else
+            {
+                writer.put(1, 1);
+                writer.put(input[pos], 8);
+                pos++;
+            }
+        }
+        return writer.finish();
+    }
+
+    /**
+     * @brief Firmware-like content: repeated tables and strings mixed with noise
+     */
+    std::vector<uint8_t> sampleImage(size_t size)
+    {
+        std::vector<uint8_t> image;
+        uint32_t seed = 12345;
+        const char *text = "PlantNanny firmware string table ";
+        while (image.size() < size)
+        {
+            seed = seed * 1103515245u + 12345u;
+            switch ((seed >> 16) % 3)
+            {
+            case 0:
+                image.insert(image.end(), text, text + 33);
+                break;
+            case 1:
+                image.insert(image.end(), 48, 0xFF);
+                break;
+            default:
+                for (int i = 0; i < 40; i++)
+                {
+                    seed = seed * 1103515245u + 12345u;
+                    image.push_back(static_cast<uint8_t>(seed >> 16));
+                }
+                break;
+            }
+        }
+        image.resize(size);
+        return image;
+    }
+
+    std::vector<uint8_t> decompress(const std::vector<uint8_t> &compressed, uint8_t window_bits,
+                                    uint8_t lookahead_bits, size_t chunk_size, bool *ok = nullptr)
+    {
+        std::vector<uint8_t> out;
+        HeatshrinkDecoder decoder(window_bits, lookahead_bits,
+                                  [&](const uint8_t *data, size_t length)
+                                  {
+                                      TEST_ASSERT_TRUE(length <= HeatshrinkDecoder::OUTPUT_BUFFER_SIZE);
+                                      out.insert(out.end(), data, data + length);
+                                      return common::patterns::Result<void>::success();
+                                  });
+
+        bool succeeded = true;
+        for (size_t offset = 0; offset < compressed.size() && succeeded; offset += chunk_size)
+        {
+            size_t length = std::min(chunk_size, compressed.size() - offset);
+            succeeded = decoder.feed(compressed.data() + offset, length).succeed();
+        }
+        succeeded = succeeded && decoder.finish().succeed();
+        if (ok)
+        {
+            *ok = succeeded;
+        }
+        return out;
+    }
+
+    MockNetworkService *network = nullptr;
+
+    void serve(const std::vector<uint8_t> &payload)
+    {
+        MockNetworkConfig config;
+        config.download_payload = payload;
+        config.download_chunk_size = 512;
+        network->test_update_config(config);
+        network->connect();
+    }
+}
+
+void setUp(void)
+{
+    common::service::DefaultRegistry::create();
+    network = new MockNetworkService();
+    common::service::add<plant_nanny::services::network::INetworkService>(*network);
+}
+
+void tearDown(void)
+{
+    common::service::remove<plant_nanny::services::network::INetworkService>();
+    delete network;
+}
+
+void test_heatshrink_round_trip_any_chunking()
+{
+    std::vector<uint8_t> image = sampleImage(16 * 1024);
+    std::vector<uint8_t> compressed = compress(image, 8, 4);
+    TEST_ASSERT_TRUE(compressed.size() < image.size());
+
+    // Records straddle chunk boundaries at every split
+    for (size_t chunk : {size_t{1}, size_t{7}, size_t{512}, compressed.size()})
+    {
+        bool ok = false;
+        std::vector<uint8_t> out = decompress(compressed, 8, 4, chunk, &ok);
+        TEST_ASSERT_TRUE(ok);
+        TEST_ASSERT_EQUAL(image.size(), out.size());
+        TEST_ASSERT_EQUAL_MEMORY(image.data(), out.data(), image.size());
+    }
+}
+
+void test_heatshrink_default_parameters()
+{
+    Manifest manifest;
+    std::vector<uint8_t> image = sampleImage(8 * 1024);
+    std::vector<uint8_t> compressed = compress(image, manifest.window_bits, manifest.lookahead_bits);
+
+    bool ok = false;
+    std::vector<uint8_t> out = decompress(compressed, manifest.window_bits, manifest.lookahead_bits, 256, &ok);
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL(image.size(), out.size());
+    TEST_ASSERT_EQUAL_MEMORY(image.data(), out.data(), image.size());
+}
+
+void test_heatshrink_incompressible_data()
+{
+    std::vector<uint8_t> image;
+    uint32_t seed = 7;
+    for (int i = 0; i < 1000; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        image.push_back(static_cast<uint8_t>(seed >> 16));
+    }
+
+    bool ok = false;
+    std::vector<uint8_t> out = decompress(compress(image, 8, 4), 8, 4, 64, &ok);
+    TEST_ASSERT_TRUE(ok);
+    TEST_ASSERT_EQUAL_MEMORY(image.data(), out.data(), image.size());
+}
+
+void test_heatshrink_rejects_reference_before_start()
+{
+    BitWriter writer;
+    writer.put(0, 1);   // Back-reference as the very first record
+    writer.put(3, 8);
+    writer.put(1, 4);
+    std::vector<uint8_t> stream = writer.finish();
+
+    HeatshrinkDecoder decoder(8, 4, [](const uint8_t *, size_t)
+                              { return common::patterns::Result<void>::success(); });
+    TEST_ASSERT_TRUE(decoder.feed(stream.data(), stream.size()).failed());
+}
+
+void test_heatshrink_detects_truncated_stream()
+{
+    std::vector<uint8_t> image = sampleImage(2048);
+    std::vector<uint8_t> compressed = compress(image, 8, 4);
+    compressed.resize(compressed.size() / 2);
+
+    bool ok = true;
+    std::vector<uint8_t> out = decompress(compressed, 8, 4, 100, &ok);
+    TEST_ASSERT_TRUE(out.size() < image.size());
+
+    // Cutting the stream on a record boundary is indistinguishable from the end; mid-record is not
+    BitWriter writer;
+    writer.put(1, 1);
+    writer.put('A', 8);
+    writer.put(1, 1);
+    writer.put(0, 7);   // Literal cut after 7 of its 8 bits
+    std::vector<uint8_t> cut = writer.out;
+    TEST_ASSERT_EQUAL(2, cut.size());
+    decompress(cut, 8, 4, 1, &ok);
+    TEST_ASSERT_FALSE(ok);
+}
+
+void test_heatshrink_sink_error_stops_decoding()
+{
+    std::vector<uint8_t> image = sampleImage(4096);
+    std::vector<uint8_t> compressed = compress(image, 8, 4);
+
+    size_t calls = 0;
+    HeatshrinkDecoder decoder(8, 4, [&](const uint8_t *, size_t)
+                              {
+                                  calls++;
+                                  return common::patterns::Result<void>::failure(
+                                      common::patterns::Error("Flash write failed"));
+                              });
+    TEST_ASSERT_TRUE(decoder.feed(compressed.data(), compressed.size()).failed());
+    TEST_ASSERT_EQUAL(1, calls);
+}
+
+void test_heatshrink_supports_limits()
+{
+    TEST_ASSERT_TRUE(HeatshrinkDecoder::supports(10, 5));
+    TEST_ASSERT_TRUE(HeatshrinkDecoder::supports(HeatshrinkDecoder::MAX_WINDOW_BITS, 4));
+    TEST_ASSERT_FALSE(HeatshrinkDecoder::supports(HeatshrinkDecoder::MAX_WINDOW_BITS + 1, 4));
+    TEST_ASSERT_FALSE(HeatshrinkDecoder::supports(3, 2));
+    TEST_ASSERT_FALSE(HeatshrinkDecoder::supports(8, 8));
+}
+
+void test_parse_compression()
+{
+    Compression compression = Compression::Heatshrink;
+    TEST_ASSERT_TRUE(parse_compression("", compression));
+    TEST_ASSERT_TRUE(compression == Compression::None);
+    TEST_ASSERT_TRUE(parse_compression("heatshrink", compression));
+    TEST_ASSERT_TRUE(compression == Compression::Heatshrink);
+    TEST_ASSERT_FALSE(parse_compression("gzip", compression));
+}
+
+#ifdef NATIVE_TEST
+// The orchestrator tests read back what reached the mocked esp_ota_write
+
+void test_orchestrator_flashes_compressed_image()
+{
+    std::vector<uint8_t> image = sampleImage(32 * 1024);
+    Manifest manifest;
+    manifest.url = "http://server/firmware.bin.hs";
+    manifest.compression = Compression::Heatshrink;
+    serve(compress(image, manifest.window_bits, manifest.lookahead_bits));
+
+    UpdateOrchestrator orchestrator;
+    TEST_ASSERT_TRUE(orchestrator.update(manifest).succeed());
+    TEST_ASSERT_EQUAL(100, orchestrator.get_progress());
+    TEST_ASSERT_EQUAL(image.size(), mock_ota_written.size());
+    TEST_ASSERT_EQUAL_MEMORY(image.data(), mock_ota_written.data(), image.size());
+}
+
+void test_orchestrator_flashes_plain_image()
+{
+    std::vector<uint8_t> image = sampleImage(4096);
+    serve(image);
+
+    UpdateOrchestrator orchestrator;
+    TEST_ASSERT_TRUE(orchestrator.update_from_url("http://server/firmware.bin").succeed());
+    TEST_ASSERT_EQUAL(image.size(), mock_ota_written.size());
+    TEST_ASSERT_EQUAL_MEMORY(image.data(), mock_ota_written.data(), image.size());
+}
+
+void test_orchestrator_aborts_corrupt_compressed_image()
+{
+    std::vector<uint8_t> image = sampleImage(4096);
+    std::vector<uint8_t> compressed = compress(image, 10, 5);
+    compressed[0] = 0x00;  // First record becomes a back-reference
+    serve(compressed);
+
+    Manifest manifest;
+    manifest.url = "http://server/firmware.bin.hs";
+    manifest.compression = Compression::Heatshrink;
+
+    UpdateOrchestrator orchestrator;
+    TEST_ASSERT_TRUE(orchestrator.update(manifest).failed());
+
+    // The update slot was released and a new update can start
+    serve(image);
+    TEST_ASSERT_TRUE(orchestrator.update_from_url("http://server/firmware.bin").succeed());
+}
+
+void test_orchestrator_rejects_unsupported_parameters()
+{
+    serve(sampleImage(1024));
+    mock_ota_written.clear();
+
+    Manifest manifest;
+    manifest.url = "http://server/firmware.bin.hs";
+    manifest.compression = Compression::Heatshrink;
+    manifest.window_bits = 15;
+
+    UpdateOrchestrator orchestrator;
+    TEST_ASSERT_TRUE(orchestrator.update(manifest).failed());
+    TEST_ASSERT_EQUAL(0, mock_ota_written.size());
+}
+#endif
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_heatshrink_round_trip_any_chunking);
+    RUN_TEST(test_heatshrink_default_parameters);
+    RUN_TEST(test_heatshrink_incompressible_data);
+    RUN_TEST(test_heatshrink_rejects_reference_before_start);
+    RUN_TEST(test_heatshrink_detects_truncated_stream);
+    RUN_TEST(test_heatshrink_sink_error_stops_decoding);
+    RUN_TEST(test_heatshrink_supports_limits);
+    RUN_TEST(test_parse_compression);
+    RUN_TEST(test_orchestrator_flashes_compressed_image);
+    RUN_TEST(test_orchestrator_flashes_plain_image);
+    RUN_TEST(test_orchestrator_aborts_corrupt_compressed_image);
+    RUN_TEST(test_orchestrator_rejects_unsupported_parameters);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_heatshrink_round_trip_any_chunking);
+    RUN_TEST(test_heatshrink_default_parameters);
+    RUN_TEST(test_heatshrink_incompressible_data);
+    RUN_TEST(test_heatshrink_rejects_reference_before_start);
+    RUN_TEST(test_heatshrink_detects_truncated_stream);
+    RUN_TEST(test_heatshrink_sink_error_stops_decoding);
+    RUN_TEST(test_heatshrink_supports_limits);
+    RUN_TEST(test_parse_compression);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,386 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/power/DutyCycle.h"
+#include <cmath>
+#include <functional>
+#include <vector>
+
+using namespace plant_nanny::services::power;
+using plant_nanny::services::captors::SensorChannels;
+using plant_nanny::services::captors::SensorReadings;
+namespace channels = plant_nanny::services::captors::channels;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace
+{
+    const int TEMPERATURE = SensorChannels::defaults().find(channels::TEMPERATURE.key);
+    const int HUMIDITY = SensorChannels::defaults().find(channels::SOIL_HUMIDITY.key);
+    const int LUMINOSITY = SensorChannels::defaults().find(channels::LUMINOSITY.key);
+
+    SensorReadings sample(float temperature, float humidity = 40.0f, float luminosity = 60.0f)
+    {
+        SensorReadings data;
+        data.set(TEMPERATURE, temperature);
+        data.set(HUMIDITY, humidity);
+        data.set(LUMINOSITY, luminosity);
+        data.valid = true;
+        return data;
+    }
+
+    DutyCycleConfig test_config()
+    {
+        DutyCycleConfig config;
+        config.enabled = true;
+        config.sleepIntervalSec = 60;
+        config.uploadEveryWakes = 5;
+        config.temperatureDeltaC = 2.0f;
+        config.humidityDeltaPct = 10.0f;
+        config.luminosityDeltaPct = 25.0f;
+        return config;
+    }
+
+    struct Upload
+    {
+        UploadReason reason;
+        size_t wake;
+        std::vector<SensorReadings> samples;
+        std::vector<uint32_t> ages;
+    };
+
+    /**
+     * Simulates a device going through timer wakes. The store plays the part
+     * of RTC memory: it persists across wakes, everything else is rebuilt.
+     */
+    struct Simulator
+    {
+        RtcSampleStore store{};
+        DutyCycleConfig config = test_config();
+        SensorChannels channels = SensorChannels::defaults();
+        std::function<SensorReadings(size_t)> sensor = [](size_t) { return sample(20.0f); };
+        std::function<bool(size_t)> linkUp = [](size_t) { return true; };
+        std::vector<Upload> uploads;
+        size_t failedUploads = 0;
+        uint32_t sleptMs = 0;
+
+        static constexpr uint32_t AWAKE_MS = 250;
+
+        void run(size_t wakes)
+        {
+            for (size_t wake = 0; wake < wakes; wake++)
+            {
+                DutyCycle dutyCycle(config, channels);
+                UploadReason reason = dutyCycle.onWake(store, sensor(wake), sleptMs);
+                if (reason != UploadReason::None && !linkUp(wake))
+                {
+                    failedUploads++;
+                    dutyCycle.onUploadFailed(store);
+                }
+                else if (reason != UploadReason::None)
+                {
+                    Upload upload{reason, wake, {}, {}};
+                    for (size_t i = 0; i < store.count; i++)
+                    {
+                        upload.samples.push_back(store.samples[i].unpack());
+                        upload.ages.push_back(DutyCycle::ageSec(store, i));
+                    }
+                    uploads.push_back(upload);
+                    dutyCycle.onUploaded(store);
+                }
+                sleep(dutyCycle, AWAKE_MS);
+            }
+        }
+
+        void sleep(const DutyCycle &dutyCycle, uint32_t awakeMs)
+        {
+            dutyCycle.onSleep(store, awakeMs);
+            sleptMs = static_cast<uint32_t>(dutyCycle.sleepDurationUs(awakeMs) / 1000);
+        }
+    };
+}
+
+void test_power_sample_pack_roundtrip()
+{
+    SensorReadings data = sample(-12.34f, 56.78f, 99.99f);
+    data.set(LUMINOSITY, NAN);
+
+    SensorReadings unpacked = PackedSample::pack(data, 42).unpack();
+    TEST_ASSERT_TRUE(unpacked.valid);
+    TEST_ASSERT_EQUAL(data.count, unpacked.count);
+    TEST_ASSERT_FLOAT_WITHIN(0.006f, -12.34f, unpacked.get(TEMPERATURE));
+    TEST_ASSERT_FLOAT_WITHIN(0.006f, 56.78f, unpacked.get(HUMIDITY));
+    TEST_ASSERT_TRUE(std::isnan(unpacked.get(LUMINOSITY)));
+
+    SensorReadings invalid;
+    TEST_ASSERT_FALSE(PackedSample::pack(invalid, 0).unpack().valid);
+}
+
+void test_power_first_wake_uploads_then_every_n()
+{
+    Simulator sim;
+    sim.run(11);
+
+    TEST_ASSERT_EQUAL(3, sim.uploads.size());
+    TEST_ASSERT_TRUE(sim.uploads[0].reason == UploadReason::FirstSample);
+    TEST_ASSERT_EQUAL(1, sim.uploads[0].samples.size());
+
+    TEST_ASSERT_TRUE(sim.uploads[1].reason == UploadReason::Interval);
+    TEST_ASSERT_EQUAL(5, sim.uploads[1].wake);
+    TEST_ASSERT_EQUAL(5, sim.uploads[1].samples.size());
+    TEST_ASSERT_EQUAL(10, sim.uploads[2].wake);
+    TEST_ASSERT_EQUAL(0, sim.store.count);
+}
+
+void test_power_batch_ages_follow_sleep_interval()
+{
+    Simulator sim;
+    sim.run(6);
+
+    const Upload &batch = sim.uploads[1];
+    TEST_ASSERT_EQUAL(5, batch.ages.size());
+    TEST_ASSERT_EQUAL_UINT32(240, batch.ages[0]);
+    TEST_ASSERT_EQUAL_UINT32(60, batch.ages[3]);
+    TEST_ASSERT_EQUAL_UINT32(0, batch.ages[4]);
+}
+
+void test_power_threshold_triggers_early_upload()
+{
+    Simulator sim;
+    sim.sensor = [](size_t wake) { return sample(wake < 3 ? 20.0f : 22.5f); };
+    sim.run(4);
+
+    TEST_ASSERT_EQUAL(2, sim.uploads.size());
+    TEST_ASSERT_TRUE(sim.uploads[1].reason == UploadReason::Threshold);
+    TEST_ASSERT_EQUAL(3, sim.uploads[1].wake);
+    TEST_ASSERT_EQUAL(3, sim.uploads[1].samples.size());
+}
+
+void test_power_threshold_measured_from_last_upload()
+{
+    Simulator sim;
+    // Slow drift: 0.5 C per wake, never 2 C between consecutive samples
+    sim.sensor = [](size_t wake) { return sample(20.0f + 0.5f * wake); };
+    sim.run(5);
+
+    TEST_ASSERT_EQUAL(2, sim.uploads.size());
+    TEST_ASSERT_TRUE(sim.uploads[1].reason == UploadReason::Threshold);
+    TEST_ASSERT_EQUAL(4, sim.uploads[1].wake);
+}
+
+void test_power_thresholds_follow_channel_keys()
+{
+    Simulator sim;
+    // Another board: an extra channel first, the known ones reordered
+    sim.channels.clear();
+    sim.channels.add({"soilTempC", "Soil temperature", "C", 1});
+    sim.channels.add(channels::LUMINOSITY);
+    sim.channels.add(channels::TEMPERATURE);
+    sim.sensor = [](size_t wake)
+    {
+        SensorReadings data;
+        data.set(0, wake < 2 ? 10.0f : 30.0f);        // No threshold configured
+        data.set(1, 60.0f);
+        data.set(2, wake < 3 ? 20.0f : 22.5f);
+        data.valid = true;
+        return data;
+    };
+    sim.run(4);
+
+    TEST_ASSERT_EQUAL(2, sim.uploads.size());
+    TEST_ASSERT_TRUE(sim.uploads[1].reason == UploadReason::Threshold);
+    TEST_ASSERT_EQUAL(3, sim.uploads[1].wake);
+    TEST_ASSERT_EQUAL_FLOAT(22.5f, sim.uploads[1].samples.back().get(2));
+}
+
+void test_power_failed_upload_keeps_batch()
+{
+    Simulator sim;
+    sim.linkUp = [](size_t wake) { return wake != 5; };
+    sim.run(11);
+
+    TEST_ASSERT_EQUAL(1, sim.failedUploads);
+    TEST_ASSERT_EQUAL(2, sim.uploads.size());
+    // Retried one full interval later with everything buffered since
+    TEST_ASSERT_EQUAL(10, sim.uploads[1].wake);
+    TEST_ASSERT_EQUAL(10, sim.uploads[1].samples.size());
+    TEST_ASSERT_EQUAL_UINT32(1, sim.store.uploadFailures);
+}
+
+void test_power_partial_upload_drops_published()
+{
+    Simulator sim;
+    sim.sensor = [](size_t wake) { return sample(20.0f, 10.0f + wake); };
+    sim.run(5);
+
+    // Interval upload of 5 samples, the link drops after the second one
+    DutyCycle dutyCycle(sim.config, sim.channels);
+    TEST_ASSERT_TRUE(dutyCycle.onWake(sim.store, sample(20.0f, 15.0f), sim.sleptMs) == UploadReason::Interval);
+    dutyCycle.onPartialUpload(sim.store, 2);
+
+    TEST_ASSERT_EQUAL(3, sim.store.count);
+    TEST_ASSERT_FLOAT_WITHIN(0.006f, 13.0f, sim.store.samples[0].unpack().get(HUMIDITY));
+    TEST_ASSERT_EQUAL_UINT32(120, DutyCycle::ageSec(sim.store, 0));
+    TEST_ASSERT_FLOAT_WITHIN(0.006f, 12.0f, sim.store.reference.unpack().get(HUMIDITY));
+    TEST_ASSERT_TRUE(sim.store.retryPending);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.store.uploadFailures);
+
+    // Everything published: same as a full upload
+    dutyCycle.onPartialUpload(sim.store, 3);
+    TEST_ASSERT_EQUAL(0, sim.store.count);
+    TEST_ASSERT_FALSE(sim.store.retryPending);
+    TEST_ASSERT_TRUE(DutyCycle::isValid(sim.store));
+}
+
+void test_power_full_buffer_drops_oldest()
+{
+    Simulator sim;
+    sim.config.uploadEveryWakes = 1000;
+    sim.linkUp = [](size_t wake) { return wake == 0; };
+    sim.sensor = [](size_t wake) { return sample(20.0f, 10.0f + 0.01f * wake); };
+    sim.run(RtcSampleStore::CAPACITY + 11);
+
+    TEST_ASSERT_EQUAL(RtcSampleStore::CAPACITY, sim.store.count);
+    TEST_ASSERT_EQUAL_UINT32(10, sim.store.droppedSamples);
+    // Tried once when the buffer filled up, not on every wake since
+    TEST_ASSERT_EQUAL(1, sim.failedUploads);
+    // Newest sample is the last one taken
+    SensorReadings newest = sim.store.samples[RtcSampleStore::CAPACITY - 1].unpack();
+    TEST_ASSERT_FLOAT_WITHIN(0.006f, 10.0f + 0.01f * (RtcSampleStore::CAPACITY + 10), newest.get(HUMIDITY));
+}
+
+void test_power_no_link_at_first_wake_waits_interval()
+{
+    Simulator sim;
+    // Above every threshold from wake 1 on: still no retry before wake 5
+    sim.sensor = [](size_t wake) { return sample(wake == 0 ? 20.0f : 30.0f); };
+    sim.linkUp = [](size_t wake) { return wake >= 7; };
+    sim.run(11);
+
+    TEST_ASSERT_EQUAL(2, sim.failedUploads);
+    TEST_ASSERT_EQUAL(1, sim.uploads.size());
+    TEST_ASSERT_TRUE(sim.uploads[0].reason == UploadReason::FirstSample);
+    TEST_ASSERT_EQUAL(10, sim.uploads[0].wake);
+    TEST_ASSERT_EQUAL(11, sim.uploads[0].samples.size());
+    TEST_ASSERT_FALSE(sim.store.retryPending);
+}
+
+void test_power_corrupted_store_is_reset()
+{
+    Simulator sim;
+    sim.run(3);
+    TEST_ASSERT_EQUAL(2, sim.store.count);
+    TEST_ASSERT_TRUE(DutyCycle::isValid(sim.store));
+
+    // Bit flip while asleep (or garbage after power-on)
+    sim.store.samples[0].elapsedSec ^= 0x10;
+    TEST_ASSERT_FALSE(DutyCycle::isValid(sim.store));
+
+    sim.run(1);
+    TEST_ASSERT_EQUAL(2, sim.uploads.size());
+    TEST_ASSERT_TRUE(sim.uploads[1].reason == UploadReason::FirstSample);
+    TEST_ASSERT_EQUAL_UINT32(1, sim.store.wakeCount);
+}
+
+void test_power_elapsed_counts_button_session()
+{
+    Simulator sim;
+    sim.config.uploadEveryWakes = 1000;
+    sim.run(2);
+
+    // Button pressed 10 s into the sleep, then 5 minutes of interaction
+    DutyCycle dutyCycle(sim.config, sim.channels);
+    dutyCycle.onEarlyWake(sim.store, 10000);
+    sim.sleep(dutyCycle, 300000);
+    sim.run(1);
+
+    TEST_ASSERT_EQUAL(2, sim.store.count);
+    // 250 ms awake, 10 s asleep, 300 s awake, then the shortest sleep (100 ms)
+    TEST_ASSERT_EQUAL_UINT32(10 + 300, DutyCycle::ageSec(sim.store, 0));
+    // Sub-second remainder after the last wake went back to sleep: 250 + 100 + 250 ms
+    TEST_ASSERT_EQUAL_UINT16(600, sim.store.elapsedMs);
+    TEST_ASSERT_TRUE(DutyCycle::isValid(sim.store));
+}
+
+void test_power_sleep_compensates_awake_time()
+{
+    DutyCycle dutyCycle(test_config());
+    TEST_ASSERT_EQUAL_UINT64(60000000ULL, dutyCycle.sleepDurationUs(0));
+    TEST_ASSERT_EQUAL_UINT64(57500000ULL, dutyCycle.sleepDurationUs(2500));
+    TEST_ASSERT_EQUAL_UINT64(DutyCycle::MIN_SLEEP_US, dutyCycle.sleepDurationUs(70000));
+}
+
+void test_power_energy_model()
+{
+    DutyCycleConfig config = test_config();
+    PowerProfile profile;
+    profile.deepSleepCurrentMa = 0.5f;
+    profile.sampleCurrentMa = 40.0f;
+    profile.sampleActiveMs = 300;
+    profile.uploadCurrentMa = 120.0f;
+    profile.uploadActiveMs = 3000;
+
+    EnergyEstimate estimate = EnergyModel::estimate(config, profile);
+
+    // (300*40 + 600*120 + 59100*0.5) / 60000
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 1.8925f, estimate.averageCurrentMa);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 60.0f, estimate.samplesPerHour);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 12.0f, estimate.uploadsPerHour);
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, 240.0f, estimate.worstCaseLatencySec);
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 2000.0f / 1.8925f, estimate.batteryLifeHours(2000.0f));
+
+    // Larger batches amortize the radio session
+    config.uploadEveryWakes = 30;
+    TEST_ASSERT_TRUE(EnergyModel::estimate(config, profile).averageCurrentMa < estimate.averageCurrentMa);
+    TEST_ASSERT_TRUE(estimate.averageCurrentMa < profile.alwaysOnCurrentMa);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_power_sample_pack_roundtrip);
+    RUN_TEST(test_power_first_wake_uploads_then_every_n);
+    RUN_TEST(test_power_batch_ages_follow_sleep_interval);
+    RUN_TEST(test_power_threshold_triggers_early_upload);
+    RUN_TEST(test_power_threshold_measured_from_last_upload);
+    RUN_TEST(test_power_thresholds_follow_channel_keys);
+    RUN_TEST(test_power_failed_upload_keeps_batch);
+    RUN_TEST(test_power_partial_upload_drops_published);
+    RUN_TEST(test_power_full_buffer_drops_oldest);
+    RUN_TEST(test_power_no_link_at_first_wake_waits_interval);
+    RUN_TEST(test_power_corrupted_store_is_reset);
+    RUN_TEST(test_power_elapsed_counts_button_session);
+    RUN_TEST(test_power_sleep_compensates_awake_time);
+    RUN_TEST(test_power_energy_model);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_power_sample_pack_roundtrip);
+    RUN_TEST(test_power_first_wake_uploads_then_every_n);
+    RUN_TEST(test_power_batch_ages_follow_sleep_interval);
+    RUN_TEST(test_power_threshold_triggers_early_upload);
+    RUN_TEST(test_power_threshold_measured_from_last_upload);
+    RUN_TEST(test_power_thresholds_follow_channel_keys);
+    RUN_TEST(test_power_failed_upload_keeps_batch);
+    RUN_TEST(test_power_partial_upload_drops_published);
+    RUN_TEST(test_power_full_buffer_drops_oldest);
+    RUN_TEST(test_power_no_link_at_first_wake_waits_interval);
+    RUN_TEST(test_power_corrupted_store_is_reset);
+    RUN_TEST(test_power_elapsed_counts_button_session);
+    RUN_TEST(test_power_sleep_compensates_awake_time);
+    RUN_TEST(test_power_energy_model);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
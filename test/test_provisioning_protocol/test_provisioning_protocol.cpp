@@ -0,0 +1,262 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/bluetooth/ProvisioningProtocol.h"
+#include "libs/common/utils/Crc.h"
+#include <cstring>
+
+using namespace plant_nanny::services::bluetooth;
+
+namespace
+{
+    ProvisioningMessage sampleMessage()
+    {
+        ProvisioningMessage message;
+        message.pin = "123456";
+        message.wifiSsid = "Home \"WiFi\"";
+        message.wifiPassword = "secret-password";
+        message.mqttHost = "broker.local";
+        message.mqttPort = 8883;
+        message.mqttUsername = "device";
+        message.mqttPassword = "mqtt-secret";
+        message.serverId = "server-1";
+        return message;
+    }
+
+    /**
+     * @brief Append the CRC to a hand-built frame of @p length bytes
+     */
+    size_t sealFrame(uint8_t *frame, size_t length)
+    {
+        uint32_t crc = common::utils::Crc32::compute(frame, length);
+        for (int i = 0; i < 4; i++)
+        {
+            frame[length + i] = static_cast<uint8_t>(crc >> (8 * i));
+        }
+        return length + 4;
+    }
+
+    /**
+     * @brief Split a frame into [index][data] writes of at most writeSize bytes and feed them
+     */
+    ProvisioningStatus feedChunked(ProvisioningAssembler &assembler, const uint8_t *frame, size_t length,
+                                   size_t writeSize, size_t *writes = nullptr)
+    {
+        uint8_t chunk[ProvisioningCodec::MAX_FRAME_SIZE + 1];
+        ProvisioningStatus status = ProvisioningStatus::Continue;
+        size_t count = 0;
+        for (size_t offset = 0; offset < length; offset += writeSize - 1)
+        {
+            size_t size = length - offset < writeSize - 1 ? length - offset : writeSize - 1;
+            chunk[0] = static_cast<uint8_t>(count++);
+            memcpy(chunk + 1, frame + offset, size);
+            status = assembler.feed(chunk, size + 1);
+            if (status != ProvisioningStatus::Continue)
+            {
+                break;
+            }
+        }
+        if (writes)
+        {
+            *writes = count;
+        }
+        return status;
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_provisioning_round_trip()
+{
+    uint8_t frame[ProvisioningCodec::MAX_FRAME_SIZE];
+    size_t length = ProvisioningCodec::encode(sampleMessage(), frame, sizeof(frame));
+    TEST_ASSERT_TRUE(length > ProvisioningCodec::HEADER_SIZE);
+    TEST_ASSERT_TRUE(ProvisioningCodec::checkCrc(frame, length));
+
+    auto decoded = ProvisioningCodec::decode(frame, length);
+    TEST_ASSERT_TRUE(decoded.succeed());
+    ProvisioningMessage message = decoded.value();
+    TEST_ASSERT_EQUAL_STRING("123456", message.pin.c_str());
+    TEST_ASSERT_EQUAL_STRING("Home \"WiFi\"", message.wifiSsid.c_str());
+    TEST_ASSERT_EQUAL_STRING("secret-password", message.wifiPassword.c_str());
+    TEST_ASSERT_EQUAL_STRING("broker.local", message.mqttHost.c_str());
+    TEST_ASSERT_EQUAL_UINT16(8883, message.mqttPort);
+    TEST_ASSERT_EQUAL_STRING("device", message.mqttUsername.c_str());
+    TEST_ASSERT_EQUAL_STRING("mqtt-secret", message.mqttPassword.c_str());
+    TEST_ASSERT_EQUAL_STRING("server-1", message.serverId.c_str());
+}
+
+void test_provisioning_encode_rejects_small_buffer()
+{
+    uint8_t frame[32];
+    TEST_ASSERT_EQUAL(0, ProvisioningCodec::encode(sampleMessage(), frame, sizeof(frame)));
+
+    ProvisioningMessage message;
+    message.wifiPassword = std::string(256, 'p');  // Does not fit a TLV length byte
+    uint8_t large[ProvisioningCodec::MAX_FRAME_SIZE];
+    TEST_ASSERT_EQUAL(0, ProvisioningCodec::encode(message, large, sizeof(large)));
+}
+
+void test_provisioning_decode_skips_unknown_fields()
+{
+    uint8_t frame[32] = {0x50, 0x4E, ProvisioningCodec::VERSION, 0, 9, 0,
+                         0x7F, 2, 'x', 'y',      // Field from a newer app
+                         0x02, 3, 'a', 'b', 'c'};
+    size_t length = sealFrame(frame, ProvisioningCodec::HEADER_SIZE + 9);
+
+    auto decoded = ProvisioningCodec::decode(frame, length);
+    TEST_ASSERT_TRUE(decoded.succeed());
+    TEST_ASSERT_EQUAL_STRING("abc", decoded.value().wifiSsid.c_str());
+}
+
+void test_provisioning_decode_rejects_truncated_record()
+{
+    uint8_t frame[32] = {0x50, 0x4E, ProvisioningCodec::VERSION, 0, 4, 0,
+                         0x02, 5, 'a', 'b'};     // Announces 5 bytes, has 2
+    size_t length = sealFrame(frame, ProvisioningCodec::HEADER_SIZE + 4);
+    TEST_ASSERT_TRUE(ProvisioningCodec::decode(frame, length).failed());
+
+    uint8_t port[32] = {0x50, 0x4E, ProvisioningCodec::VERSION, 0, 3, 0,
+                        0x05, 1, 0x50};          // Port must be two bytes
+    length = sealFrame(port, ProvisioningCodec::HEADER_SIZE + 3);
+    TEST_ASSERT_TRUE(ProvisioningCodec::decode(port, length).failed());
+}
+
+void test_provisioning_single_write_completes()
+{
+    uint8_t frame[ProvisioningCodec::MAX_FRAME_SIZE];
+    size_t length = ProvisioningCodec::encode(sampleMessage(), frame, sizeof(frame));
+
+    // Typical message fits one write at ATT MTU 256
+    ProvisioningAssembler assembler;
+    size_t writes = 0;
+    TEST_ASSERT_TRUE(feedChunked(assembler, frame, length, 253, &writes) == ProvisioningStatus::Complete);
+    TEST_ASSERT_EQUAL(1, writes);
+    TEST_ASSERT_EQUAL(length, assembler.frameSize());
+    TEST_ASSERT_EQUAL_MEMORY(frame, assembler.frame(), length);
+}
+
+void test_provisioning_chunked_writes_complete()
+{
+    uint8_t frame[ProvisioningCodec::MAX_FRAME_SIZE];
+    size_t length = ProvisioningCodec::encode(sampleMessage(), frame, sizeof(frame));
+
+    // Default ATT MTU 23: 20 byte writes
+    ProvisioningAssembler assembler;
+    size_t writes = 0;
+    TEST_ASSERT_TRUE(feedChunked(assembler, frame, length, 20, &writes) == ProvisioningStatus::Complete);
+    TEST_ASSERT_TRUE(writes > 1);
+    TEST_ASSERT_TRUE(ProvisioningCodec::decode(assembler.frame(), assembler.frameSize()).succeed());
+}
+
+void test_provisioning_out_of_order_chunk_drops_frame()
+{
+    uint8_t frame[ProvisioningCodec::MAX_FRAME_SIZE];
+    ProvisioningCodec::encode(sampleMessage(), frame, sizeof(frame));
+
+    ProvisioningAssembler assembler;
+    uint8_t chunk[11] = {0};
+    memcpy(chunk + 1, frame, 10);
+    TEST_ASSERT_TRUE(assembler.feed(chunk, sizeof(chunk)) == ProvisioningStatus::Continue);
+
+    chunk[0] = 2;  // Index 1 lost
+    memcpy(chunk + 1, frame + 10, 10);
+    TEST_ASSERT_TRUE(assembler.feed(chunk, sizeof(chunk)) == ProvisioningStatus::OutOfOrder);
+
+    // Continuing the dropped frame is refused until index 0 restarts it
+    chunk[0] = 3;
+    TEST_ASSERT_TRUE(assembler.feed(chunk, sizeof(chunk)) == ProvisioningStatus::OutOfOrder);
+}
+
+void test_provisioning_bad_crc_detected()
+{
+    uint8_t frame[ProvisioningCodec::MAX_FRAME_SIZE];
+    size_t length = ProvisioningCodec::encode(sampleMessage(), frame, sizeof(frame));
+    frame[ProvisioningCodec::HEADER_SIZE + 4] ^= 0x01;
+
+    ProvisioningAssembler assembler;
+    TEST_ASSERT_TRUE(feedChunked(assembler, frame, length, 253) == ProvisioningStatus::BadCrc);
+}
+
+void test_provisioning_bad_header_detected()
+{
+    uint8_t frame[ProvisioningCodec::MAX_FRAME_SIZE];
+    size_t length = ProvisioningCodec::encode(sampleMessage(), frame, sizeof(frame));
+
+    ProvisioningAssembler assembler;
+    frame[0] = 0x00;
+    TEST_ASSERT_TRUE(feedChunked(assembler, frame, length, 253) == ProvisioningStatus::BadFrame);
+
+    frame[0] = 0x50;
+    frame[4] = 0xFF;  // Body longer than MAX_BODY_SIZE
+    frame[5] = 0xFF;
+    TEST_ASSERT_TRUE(feedChunked(assembler, frame, length, 253) == ProvisioningStatus::BadFrame);
+}
+
+void test_provisioning_extra_bytes_rejected()
+{
+    uint8_t frame[ProvisioningCodec::MAX_FRAME_SIZE];
+    size_t length = ProvisioningCodec::encode(sampleMessage(), frame, sizeof(frame));
+    frame[length] = 0xAA;
+
+    ProvisioningAssembler assembler;
+    TEST_ASSERT_TRUE(feedChunked(assembler, frame, length + 1, 253) == ProvisioningStatus::BadFrame);
+}
+
+void test_provisioning_restart_with_index_zero()
+{
+    uint8_t frame[ProvisioningCodec::MAX_FRAME_SIZE];
+    size_t length = ProvisioningCodec::encode(sampleMessage(), frame, sizeof(frame));
+
+    ProvisioningAssembler assembler;
+    uint8_t chunk[11] = {0};
+    memcpy(chunk + 1, frame, 10);
+    assembler.feed(chunk, sizeof(chunk));
+
+    // App retries from the start
+    TEST_ASSERT_TRUE(feedChunked(assembler, frame, length, 20) == ProvisioningStatus::Complete);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_provisioning_round_trip);
+    RUN_TEST(test_provisioning_encode_rejects_small_buffer);
+    RUN_TEST(test_provisioning_decode_skips_unknown_fields);
+    RUN_TEST(test_provisioning_decode_rejects_truncated_record);
+    RUN_TEST(test_provisioning_single_write_completes);
+    RUN_TEST(test_provisioning_chunked_writes_complete);
+    RUN_TEST(test_provisioning_out_of_order_chunk_drops_frame);
+    RUN_TEST(test_provisioning_bad_crc_detected);
+    RUN_TEST(test_provisioning_bad_header_detected);
+    RUN_TEST(test_provisioning_extra_bytes_rejected);
+    RUN_TEST(test_provisioning_restart_with_index_zero);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_provisioning_round_trip);
+    RUN_TEST(test_provisioning_encode_rejects_small_buffer);
+    RUN_TEST(test_provisioning_decode_skips_unknown_fields);
+    RUN_TEST(test_provisioning_decode_rejects_truncated_record);
+    RUN_TEST(test_provisioning_single_write_completes);
+    RUN_TEST(test_provisioning_chunked_writes_complete);
+    RUN_TEST(test_provisioning_out_of_order_chunk_drops_frame);
+    RUN_TEST(test_provisioning_bad_crc_detected);
+    RUN_TEST(test_provisioning_bad_header_detected);
+    RUN_TEST(test_provisioning_extra_bytes_rejected);
+    RUN_TEST(test_provisioning_restart_with_index_zero);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,289 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/rules/RuleEngine.h"
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+using namespace plant_nanny::services::rules;
+using plant_nanny::services::captors::SensorChannels;
+using plant_nanny::services::captors::SensorReadings;
+
+namespace
+{
+    constexpr uint32_t HOUR = 3600;
+
+    RuleCondition condition(const char *channel, RuleComparison comparison, float threshold, float hysteresis)
+    {
+        RuleCondition c;
+        strncpy(c.channel, channel, sizeof(c.channel) - 1);
+        c.comparison = comparison;
+        c.threshold = threshold;
+        c.hysteresis = hysteresis;
+        return c;
+    }
+
+    // Water 200 ml when the soil is below 35 %, re-armed above 40 %, at most every 6 h
+    WateringRules dryRule()
+    {
+        WateringRules rules;
+        rules.count = 1;
+        rules.rules[0].conditions[0] = condition("humidityPct", RuleComparison::Below, 35.0f, 5.0f);
+        rules.rules[0].conditionCount = 1;
+        rules.rules[0].waterAmountMl = 200;
+        rules.rules[0].minCycleSec = 6 * HOUR;
+        return rules;
+    }
+
+    SensorReadings readings(float temperature, float humidity, float luminosity = 50.0f)
+    {
+        SensorReadings r;
+        r.set(0, temperature);
+        r.set(1, humidity);
+        r.set(2, luminosity);
+        r.valid = true;
+        return r;
+    }
+
+    RuleEngine configured(const WateringRules &rules)
+    {
+        RuleEngine engine;
+        TEST_ASSERT_TRUE(engine.configure(rules, SensorChannels::defaults()).succeed());
+        return engine;
+    }
+
+    // What the app does when the pump accepts every dose
+    WateringDecision waterIfDue(RuleEngine &engine, const SensorReadings &r, uint32_t nowSec)
+    {
+        WateringDecision decision = engine.evaluate(r, nowSec);
+        if (decision.water)
+        {
+            engine.noteWatering(nowSec);
+        }
+        return decision;
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_no_rules_never_water()
+{
+    RuleEngine engine;
+    TEST_ASSERT_FALSE(engine.evaluate(readings(22.0f, 0.0f), 0).water);
+    TEST_ASSERT_EQUAL(0, engine.ruleCount());
+}
+
+void test_validate_rejects_unknown_channel_and_bounds()
+{
+    const auto &channels = SensorChannels::defaults();
+    TEST_ASSERT_TRUE(RuleEngine::validate(dryRule(), channels).succeed());
+
+    WateringRules rules = dryRule();
+    strcpy(rules.rules[0].conditions[0].channel, "soil");
+    TEST_ASSERT_TRUE(RuleEngine::validate(rules, channels).failed());
+
+    rules = dryRule();
+    rules.rules[0].conditionCount = 0;
+    TEST_ASSERT_TRUE(RuleEngine::validate(rules, channels).failed());
+
+    rules = dryRule();
+    rules.rules[0].minCycleSec = 60;
+    TEST_ASSERT_TRUE(RuleEngine::validate(rules, channels).failed());
+
+    rules = dryRule();
+    rules.rules[0].waterAmountMl = MAX_WATER_ML + 1;
+    TEST_ASSERT_TRUE(RuleEngine::validate(rules, channels).failed());
+
+    rules = dryRule();
+    rules.rules[0].conditions[0].hysteresis = -1.0f;
+    TEST_ASSERT_TRUE(RuleEngine::validate(rules, channels).failed());
+
+    rules = dryRule();
+    rules.rules[0].conditions[0].threshold = NAN;
+    TEST_ASSERT_TRUE(RuleEngine::validate(rules, channels).failed());
+}
+
+void test_invalid_configure_keeps_previous_rules()
+{
+    RuleEngine engine = configured(dryRule());
+
+    WateringRules bad = dryRule();
+    strcpy(bad.rules[0].conditions[0].channel, "soil");
+    TEST_ASSERT_TRUE(engine.configure(bad, SensorChannels::defaults()).failed());
+
+    TEST_ASSERT_EQUAL(1, engine.ruleCount());
+    TEST_ASSERT_TRUE(engine.evaluate(readings(22.0f, 30.0f), 0).water);
+}
+
+void test_fires_below_threshold_with_amount()
+{
+    RuleEngine engine = configured(dryRule());
+
+    TEST_ASSERT_FALSE(waterIfDue(engine, readings(22.0f, 50.0f), 0).water);
+    TEST_ASSERT_FALSE(waterIfDue(engine, readings(22.0f, 35.0f), 10).water);
+
+    auto decision = waterIfDue(engine, readings(22.0f, 34.0f), 20);
+    TEST_ASSERT_TRUE(decision.water);
+    TEST_ASSERT_EQUAL(0, decision.rule);
+    TEST_ASSERT_EQUAL(200, decision.amountMl);
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, decision.targetPct);
+    TEST_ASSERT_TRUE(engine.state().hasWatered);
+    TEST_ASSERT_EQUAL_UINT32(20, engine.state().lastWateringSec);
+}
+
+void test_min_cycle_limits_repeated_watering()
+{
+    RuleEngine engine = configured(dryRule());
+
+    TEST_ASSERT_TRUE(waterIfDue(engine, readings(22.0f, 30.0f), 100).water);
+    // Still dry: the water has not soaked in yet, wait for the cycle
+    TEST_ASSERT_FALSE(waterIfDue(engine, readings(22.0f, 30.0f), 110).water);
+    TEST_ASSERT_FALSE(waterIfDue(engine, readings(22.0f, 30.0f), 100 + 6 * HOUR - 1).water);
+    TEST_ASSERT_TRUE(waterIfDue(engine, readings(22.0f, 30.0f), 100 + 6 * HOUR).water);
+}
+
+void test_hysteresis_holds_condition_until_released()
+{
+    WateringRules rules = dryRule();
+    rules.rules[0].minCycleSec = MIN_CYCLE_SEC;
+    RuleEngine engine = configured(rules);
+
+    TEST_ASSERT_TRUE(waterIfDue(engine, readings(22.0f, 34.0f), 0).water);
+    TEST_ASSERT_EQUAL_UINT8(1, engine.state().active[0]);
+
+    // Noise around the threshold keeps the condition active...
+    waterIfDue(engine, readings(22.0f, 38.0f), 10);
+    TEST_ASSERT_EQUAL_UINT8(1, engine.state().active[0]);
+    TEST_ASSERT_TRUE(waterIfDue(engine, readings(22.0f, 39.0f), MIN_CYCLE_SEC).water);
+
+    // ...until the soil is back above threshold + hysteresis
+    waterIfDue(engine, readings(22.0f, 41.0f), MIN_CYCLE_SEC + 10);
+    TEST_ASSERT_EQUAL_UINT8(0, engine.state().active[0]);
+    TEST_ASSERT_FALSE(waterIfDue(engine, readings(22.0f, 38.0f), 3 * MIN_CYCLE_SEC).water);
+    TEST_ASSERT_TRUE(waterIfDue(engine, readings(22.0f, 34.9f), 3 * MIN_CYCLE_SEC + 10).water);
+}
+
+void test_all_conditions_must_hold()
+{
+    // Only water a dry pot when it is warm enough for the plant to drink
+    WateringRules rules = dryRule();
+    rules.rules[0].conditions[1] = condition("temperatureC", RuleComparison::Above, 15.0f, 1.0f);
+    rules.rules[0].conditionCount = 2;
+    RuleEngine engine = configured(rules);
+
+    TEST_ASSERT_FALSE(engine.evaluate(readings(10.0f, 30.0f), 0).water);
+    TEST_ASSERT_EQUAL_UINT8(0b01, engine.state().active[0]);
+    TEST_ASSERT_TRUE(engine.evaluate(readings(16.0f, 30.0f), 10).water);
+    TEST_ASSERT_EQUAL_UINT8(0b11, engine.state().active[0]);
+}
+
+void test_first_matching_rule_wins()
+{
+    WateringRules rules = dryRule();
+    rules.count = 2;
+    rules.rules[1] = rules.rules[0];
+    rules.rules[1].conditions[0].threshold = 20.0f;
+    rules.rules[1].waterAmountMl = 400;
+    // Very dry soil gets more water: list the stronger rule first
+    std::swap(rules.rules[0], rules.rules[1]);
+    RuleEngine engine = configured(rules);
+
+    auto decision = engine.evaluate(readings(22.0f, 15.0f), 0);
+    TEST_ASSERT_EQUAL(0, decision.rule);
+    TEST_ASSERT_EQUAL(400, decision.amountMl);
+
+    engine = configured(rules);
+    decision = engine.evaluate(readings(22.0f, 30.0f), 0);
+    TEST_ASSERT_EQUAL(1, decision.rule);
+    TEST_ASSERT_EQUAL(200, decision.amountMl);
+}
+
+void test_missing_reading_never_waters()
+{
+    RuleEngine engine = configured(dryRule());
+
+    TEST_ASSERT_FALSE(engine.evaluate(readings(22.0f, NAN), 0).water);
+
+    SensorReadings invalid = readings(22.0f, 10.0f);
+    invalid.valid = false;
+    TEST_ASSERT_FALSE(engine.evaluate(invalid, 10).water);
+    TEST_ASSERT_FALSE(engine.state().hasWatered);
+}
+
+void test_refused_dose_is_not_recorded()
+{
+    RuleEngine engine = configured(dryRule());
+
+    // The pump refused (reservoir dry, dose running): nothing was watered
+    TEST_ASSERT_TRUE(engine.evaluate(readings(22.0f, 30.0f), 100).water);
+    TEST_ASSERT_FALSE(engine.state().hasWatered);
+    TEST_ASSERT_TRUE(engine.evaluate(readings(22.0f, 30.0f), 110).water);
+}
+
+void test_external_watering_starts_the_cycle()
+{
+    RuleEngine engine = configured(dryRule());
+
+    engine.noteWatering(1000);
+    TEST_ASSERT_FALSE(engine.evaluate(readings(22.0f, 30.0f), 1000 + HOUR).water);
+    TEST_ASSERT_TRUE(engine.evaluate(readings(22.0f, 30.0f), 1000 + 6 * HOUR).water);
+}
+
+void test_clock_reset_forgets_history()
+{
+    RuleEngine engine = configured(dryRule());
+    TEST_ASSERT_TRUE(waterIfDue(engine, readings(22.0f, 30.0f), 50000).water);
+
+    // State restored from RTC memory after the duty-cycle store was reset
+    RuleEngine woken = configured(dryRule());
+    woken.restore(engine.state());
+    TEST_ASSERT_TRUE(waterIfDue(woken, readings(22.0f, 30.0f), 60).water);
+    TEST_ASSERT_EQUAL_UINT32(60, woken.state().lastWateringSec);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_no_rules_never_water);
+    RUN_TEST(test_validate_rejects_unknown_channel_and_bounds);
+    RUN_TEST(test_invalid_configure_keeps_previous_rules);
+    RUN_TEST(test_fires_below_threshold_with_amount);
+    RUN_TEST(test_min_cycle_limits_repeated_watering);
+    RUN_TEST(test_hysteresis_holds_condition_until_released);
+    RUN_TEST(test_all_conditions_must_hold);
+    RUN_TEST(test_first_matching_rule_wins);
+    RUN_TEST(test_missing_reading_never_waters);
+    RUN_TEST(test_refused_dose_is_not_recorded);
+    RUN_TEST(test_external_watering_starts_the_cycle);
+    RUN_TEST(test_clock_reset_forgets_history);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_no_rules_never_water);
+    RUN_TEST(test_validate_rejects_unknown_channel_and_bounds);
+    RUN_TEST(test_invalid_configure_keeps_previous_rules);
+    RUN_TEST(test_fires_below_threshold_with_amount);
+    RUN_TEST(test_min_cycle_limits_repeated_watering);
+    RUN_TEST(test_hysteresis_holds_condition_until_released);
+    RUN_TEST(test_all_conditions_must_hold);
+    RUN_TEST(test_first_matching_rule_wins);
+    RUN_TEST(test_missing_reading_never_waters);
+    RUN_TEST(test_refused_dose_is_not_recorded);
+    RUN_TEST(test_external_watering_starts_the_cycle);
+    RUN_TEST(test_clock_reset_forgets_history);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,226 @@
+#include <unity.h>
+#include "libs/common/scheduler/Scheduler.h"
+#include <string>
+
+using namespace common::scheduler;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace
+{
+    uint64_t fake_now_us = 0;
+
+    Clock fake_clock()
+    {
+        fake_now_us = 0;
+        return []() { return fake_now_us; };
+    }
+
+    void advance_ms(uint32_t ms)
+    {
+        fake_now_us += static_cast<uint64_t>(ms) * 1000;
+    }
+}
+
+void test_scheduler_periodic_runs_then_sleeps_until_release()
+{
+    Scheduler scheduler(fake_clock());
+    int runs = 0;
+    scheduler.addPeriodic("tick", 50, [&]() { runs++; });
+
+    TEST_ASSERT_EQUAL_UINT32(50, scheduler.runOnce());
+    TEST_ASSERT_EQUAL(1, runs);
+
+    advance_ms(20);
+    TEST_ASSERT_EQUAL_UINT32(30, scheduler.runOnce());
+    TEST_ASSERT_EQUAL(1, runs);
+
+    advance_ms(30);
+    TEST_ASSERT_EQUAL_UINT32(50, scheduler.runOnce());
+    TEST_ASSERT_EQUAL(2, runs);
+}
+
+void test_scheduler_sleeps_until_earliest_release()
+{
+    Scheduler scheduler(fake_clock());
+    scheduler.addPeriodic("slow", 1000, []() {});
+    scheduler.addPeriodic("fast", 20, []() {});
+
+    TEST_ASSERT_EQUAL_UINT32(20, scheduler.runOnce());
+    advance_ms(15);
+    TEST_ASSERT_EQUAL_UINT32(5, scheduler.runOnce());
+}
+
+void test_scheduler_runs_earliest_deadline_first()
+{
+    Scheduler scheduler(fake_clock());
+    std::string order;
+    scheduler.addPeriodic("a", 100, [&]() { order += "a"; });
+    scheduler.addPeriodic("b", 10, [&]() { order += "b"; });
+    TaskId event = scheduler.addEvent("e", 5, [&]() { order += "e"; });
+
+    scheduler.signal(event);
+    scheduler.runOnce();
+    TEST_ASSERT_EQUAL_STRING("eba", order.c_str());
+}
+
+void test_scheduler_event_task_runs_only_when_signaled()
+{
+    Scheduler scheduler(fake_clock());
+    int runs = 0;
+    int wakes = 0;
+    TaskId id = scheduler.addEvent("event", 10, [&]() { runs++; });
+    scheduler.setWakeHook([&]() { wakes++; });
+
+    TEST_ASSERT_EQUAL_UINT32(Scheduler::MAX_IDLE_MS, scheduler.runOnce());
+    TEST_ASSERT_EQUAL(0, runs);
+
+    scheduler.signal(id);
+    TEST_ASSERT_EQUAL(1, wakes);
+    scheduler.runOnce();
+    TEST_ASSERT_EQUAL(1, runs);
+
+    scheduler.runOnce();
+    TEST_ASSERT_EQUAL(1, runs);
+}
+
+void test_scheduler_signal_from_task_keeps_loop_awake()
+{
+    Scheduler scheduler(fake_clock());
+    int runs = 0;
+    TaskId event = scheduler.addEvent("event", 10, [&]() { runs++; });
+    scheduler.addPeriodic("producer", 100, [&]() { scheduler.signal(event); });
+
+    // Producer runs first in this pass, the event is picked up on the next
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.runOnce());
+    scheduler.runOnce();
+    TEST_ASSERT_EQUAL(1, runs);
+}
+
+void test_scheduler_measures_run_time_and_overruns()
+{
+    Scheduler scheduler(fake_clock());
+    uint32_t cost_ms = 1;
+    TaskId id = scheduler.addPeriodic("work", 100, [&]() { advance_ms(cost_ms); }, 2000);
+
+    scheduler.runOnce();
+    cost_ms = 5;
+    advance_ms(100);
+    scheduler.runOnce();
+
+    const TaskStats &stats = scheduler.stats(id);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.runs);
+    TEST_ASSERT_EQUAL_UINT32(5000, stats.lastRunUs);
+    TEST_ASSERT_EQUAL_UINT32(5000, stats.maxRunUs);
+    TEST_ASSERT_EQUAL_UINT32(3000, stats.averageRunUs());
+    TEST_ASSERT_EQUAL_UINT32(1, stats.overruns);
+}
+
+void test_scheduler_blocking_task_causes_misses_and_skips()
+{
+    Scheduler scheduler(fake_clock());
+    bool block = false;
+    TaskId blocker = scheduler.addPeriodic("blocker", 100, [&]() { if (block) advance_ms(250); });
+    TaskId victim = scheduler.addPeriodic("victim", 20, []() {});
+
+    for (int i = 0; i < 5; i++)
+    {
+        scheduler.runOnce();
+        advance_ms(20);
+    }
+    block = true;
+    scheduler.runOnce();  // t=100: victim (deadline 120) first, then blocker until 350
+
+    advance_ms(1);
+    scheduler.runOnce();  // victim release 120 (deadline 140) starts at 351
+    const TaskStats &stats = scheduler.stats(victim);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.deadlineMisses);
+    TEST_ASSERT_EQUAL_UINT32(211000, stats.maxLatenessUs);
+    TEST_ASSERT_EQUAL_UINT32(11, stats.skippedPeriods);
+    TEST_ASSERT_EQUAL_UINT32(0, scheduler.stats(blocker).deadlineMisses);
+    TEST_ASSERT_EQUAL_UINT32(2, scheduler.stats(blocker).skippedPeriods);
+
+    // Back on the 20 ms grid, not replaying the missed releases
+    TEST_ASSERT_EQUAL_UINT32(9, scheduler.runOnce());
+}
+
+void test_scheduler_disabled_task_is_ignored()
+{
+    Scheduler scheduler(fake_clock());
+    int runs = 0;
+    TaskId id = scheduler.addPeriodic("fast", 10, [&]() { runs++; });
+    scheduler.addPeriodic("slow", 500, []() {});
+
+    scheduler.setEnabled(id, false);
+    TEST_ASSERT_EQUAL_UINT32(500, scheduler.runOnce());
+    TEST_ASSERT_EQUAL(0, runs);
+
+    scheduler.setEnabled(id, true);
+    scheduler.runOnce();
+    TEST_ASSERT_EQUAL(1, runs);
+}
+
+void test_scheduler_set_period()
+{
+    Scheduler scheduler(fake_clock());
+    TaskId id = scheduler.addPeriodic("tick", 50, []() {});
+    scheduler.runOnce();
+
+    scheduler.setPeriod(id, 200);
+    TEST_ASSERT_EQUAL_UINT32(200, scheduler.runOnce());
+}
+
+void test_scheduler_rejects_when_full()
+{
+    Scheduler scheduler(fake_clock());
+    for (size_t i = 0; i < Scheduler::MAX_TASKS; i++)
+    {
+        TEST_ASSERT_TRUE(scheduler.addEvent("task", 10, []() {}) != INVALID_TASK);
+    }
+    TEST_ASSERT_TRUE(scheduler.addEvent("extra", 10, []() {}) == INVALID_TASK);
+    TEST_ASSERT_EQUAL(Scheduler::MAX_TASKS, scheduler.taskCount());
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_scheduler_periodic_runs_then_sleeps_until_release);
+    RUN_TEST(test_scheduler_sleeps_until_earliest_release);
+    RUN_TEST(test_scheduler_runs_earliest_deadline_first);
+    RUN_TEST(test_scheduler_event_task_runs_only_when_signaled);
+    RUN_TEST(test_scheduler_signal_from_task_keeps_loop_awake);
+    RUN_TEST(test_scheduler_measures_run_time_and_overruns);
+    RUN_TEST(test_scheduler_blocking_task_causes_misses_and_skips);
+    RUN_TEST(test_scheduler_disabled_task_is_ignored);
+    RUN_TEST(test_scheduler_set_period);
+    RUN_TEST(test_scheduler_rejects_when_full);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_scheduler_periodic_runs_then_sleeps_until_release);
+    RUN_TEST(test_scheduler_sleeps_until_earliest_release);
+    RUN_TEST(test_scheduler_runs_earliest_deadline_first);
+    RUN_TEST(test_scheduler_event_task_runs_only_when_signaled);
+    RUN_TEST(test_scheduler_signal_from_task_keeps_loop_awake);
+    RUN_TEST(test_scheduler_measures_run_time_and_overruns);
+    RUN_TEST(test_scheduler_blocking_task_causes_misses_and_skips);
+    RUN_TEST(test_scheduler_disabled_task_is_ignored);
+    RUN_TEST(test_scheduler_set_period);
+    RUN_TEST(test_scheduler_rejects_when_full);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
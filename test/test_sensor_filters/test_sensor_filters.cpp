@@ -0,0 +1,223 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/captors/filter/SensorFilter.h"
+#include <cmath>
+#include <cstddef>
+
+using namespace plant_nanny::services::captors::filter;
+
+namespace
+{
+    // Soil humidity (%) logged every 10 s by a capacitive probe on a long cable.
+    // Pump-motor interference gives single-reading drops; the pot is watered at index 24.
+    const float HUMIDITY_TRACE[] = {
+        44.8f, 45.1f, 44.6f, 45.3f, 44.9f, 6.2f, 45.0f, 44.7f,
+        45.2f, 44.5f, 44.8f, 45.0f, 3.9f, 44.6f, 44.9f, 45.1f,
+        44.4f, 44.7f, 44.8f, 97.5f, 44.6f, 44.5f, 44.9f, 44.3f,
+        61.8f, 68.4f, 70.2f, 70.9f, 71.3f, 70.8f, 71.1f, 70.6f,
+        70.9f, 4.1f, 70.7f, 71.0f, 70.4f, 70.8f, 70.5f, 70.6f,
+    };
+    constexpr size_t HUMIDITY_TRACE_SIZE = sizeof(HUMIDITY_TRACE) / sizeof(HUMIDITY_TRACE[0]);
+    constexpr size_t WATERED_AT = 24;
+
+    // Thermistor (°C) during an afternoon warm-up, with ADC noise of about ±0.3 °C
+    const float TEMPERATURE_TRACE[] = {
+        21.2f, 20.7f, 21.4f, 21.0f, 21.6f, 21.1f, 21.8f, 21.3f,
+        22.0f, 21.6f, 22.3f, 21.9f, 22.5f, 22.1f, 22.8f, 22.3f,
+    };
+    constexpr size_t TEMPERATURE_TRACE_SIZE = sizeof(TEMPERATURE_TRACE) / sizeof(TEMPERATURE_TRACE[0]);
+
+    constexpr float WATERING_THRESHOLD = 30.0f;
+
+    template <typename Filter>
+    void run(Filter &filter, const float *trace, size_t size, float *out)
+    {
+        for (size_t i = 0; i < size; i++)
+        {
+            out[i] = filter.apply(trace[i]);
+        }
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_default_config_is_pass_through()
+{
+    SensorFilter chain{FilterConfig{}};
+    float out[HUMIDITY_TRACE_SIZE];
+    run(chain, HUMIDITY_TRACE, HUMIDITY_TRACE_SIZE, out);
+    for (size_t i = 0; i < HUMIDITY_TRACE_SIZE; i++)
+    {
+        TEST_ASSERT_EQUAL_FLOAT(HUMIDITY_TRACE[i], out[i]);
+    }
+}
+
+void test_median_removes_single_reading_drops()
+{
+    FilterConfig config;
+    config.medianWindow = 3;
+    MedianFilter<MAX_MEDIAN_WINDOW> median;
+    median.configure(config);
+
+    float out[HUMIDITY_TRACE_SIZE];
+    run(median, HUMIDITY_TRACE, HUMIDITY_TRACE_SIZE, out);
+    for (size_t i = 1; i < WATERED_AT; i++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, 45.0f, out[i]);
+    }
+    // The step goes through after one reading of delay
+    TEST_ASSERT_TRUE(out[WATERED_AT + 1] > 60.0f);
+}
+
+void test_median_even_and_clamped_window()
+{
+    FilterConfig config;
+    config.medianWindow = 2;
+    MedianFilter<4> median;
+    median.configure(config);
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, median.apply(10.0f));
+    TEST_ASSERT_EQUAL_FLOAT(15.0f, median.apply(20.0f));
+
+    config.medianWindow = 200;  // More than the storage
+    median.configure(config);
+    const float values[] = {5.0f, 1.0f, 9.0f, 3.0f, 7.0f};
+    float last = 0.0f;
+    for (float value : values)
+    {
+        last = median.apply(value);
+    }
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, last);  // Median of the last 4: 1 3 7 9
+}
+
+void test_spike_rejects_outliers_and_follows_watering()
+{
+    FilterConfig config;
+    config.spikeThreshold = 15.0f;
+    config.spikeConfirmCount = 3;
+    SpikeFilter spike;
+    spike.configure(config);
+
+    float out[HUMIDITY_TRACE_SIZE];
+    run(spike, HUMIDITY_TRACE, HUMIDITY_TRACE_SIZE, out);
+    for (size_t i = 0; i < WATERED_AT + 2; i++)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(1.0f, 45.0f, out[i]);
+    }
+    // Third high reading in a row: accepted as the new level
+    TEST_ASSERT_EQUAL_FLOAT(HUMIDITY_TRACE[WATERED_AT + 2], out[WATERED_AT + 2]);
+    TEST_ASSERT_FLOAT_WITHIN(1.0f, 70.7f, out[33]);
+}
+
+void test_ema_smooths_noise()
+{
+    FilterConfig config;
+    config.emaAlpha = 0.25f;
+    EmaFilter ema;
+    ema.configure(config);
+
+    float out[TEMPERATURE_TRACE_SIZE];
+    run(ema, TEMPERATURE_TRACE, TEMPERATURE_TRACE_SIZE, out);
+    TEST_ASSERT_EQUAL_FLOAT(TEMPERATURE_TRACE[0], out[0]);
+
+    // Zig-zag of the raw trace is gone, the warm-up trend is kept
+    for (size_t i = 4; i < TEMPERATURE_TRACE_SIZE; i++)
+    {
+        TEST_ASSERT_TRUE(out[i] >= out[i - 1] - 0.05f);
+    }
+    TEST_ASSERT_TRUE(out[TEMPERATURE_TRACE_SIZE - 1] > 21.5f);
+}
+
+void test_rate_limiter_bounds_steps()
+{
+    FilterConfig config;
+    config.maxRatePerSample = 10.0f;
+    RateLimiter limiter;
+    limiter.configure(config);
+
+    float out[HUMIDITY_TRACE_SIZE];
+    run(limiter, HUMIDITY_TRACE, HUMIDITY_TRACE_SIZE, out);
+    for (size_t i = 1; i < HUMIDITY_TRACE_SIZE; i++)
+    {
+        TEST_ASSERT_TRUE(std::fabs(out[i] - out[i - 1]) <= 10.0f + 1e-4f);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.5f, 70.6f, out[HUMIDITY_TRACE_SIZE - 1]);
+}
+
+void test_nan_passes_without_touching_state()
+{
+    FilterConfig config;
+    config.medianWindow = 3;
+    config.spikeThreshold = 5.0f;
+    config.emaAlpha = 0.5f;
+    config.maxRatePerSample = 1.0f;
+    SensorFilter chain{config};
+
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, chain.apply(40.0f));
+    TEST_ASSERT_TRUE(std::isnan(chain.apply(NAN)));
+    TEST_ASSERT_EQUAL_FLOAT(40.0f, chain.apply(40.0f));
+    TEST_ASSERT_EQUAL(0, chain.stage<SpikeFilter>().rejectedInARow());
+}
+
+void test_chain_on_noisy_humidity_never_triggers_watering()
+{
+    FilterConfig config;
+    config.medianWindow = 5;
+    config.spikeThreshold = 15.0f;
+    config.spikeConfirmCount = 3;
+    config.emaAlpha = 0.3f;
+    config.maxRatePerSample = 10.0f;
+    SensorFilter chain{config};
+
+    float out[HUMIDITY_TRACE_SIZE];
+    run(chain, HUMIDITY_TRACE, HUMIDITY_TRACE_SIZE, out);
+
+    // Unfiltered, three readings are below the threshold
+    for (size_t i = 0; i < HUMIDITY_TRACE_SIZE; i++)
+    {
+        TEST_ASSERT_TRUE(out[i] > WATERING_THRESHOLD);
+    }
+    // ...and the watering still shows up within a minute
+    TEST_ASSERT_TRUE(out[WATERED_AT + 6] > 60.0f);
+
+    chain.reset();
+    TEST_ASSERT_EQUAL_FLOAT(10.0f, chain.apply(10.0f));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_default_config_is_pass_through);
+    RUN_TEST(test_median_removes_single_reading_drops);
+    RUN_TEST(test_median_even_and_clamped_window);
+    RUN_TEST(test_spike_rejects_outliers_and_follows_watering);
+    RUN_TEST(test_ema_smooths_noise);
+    RUN_TEST(test_rate_limiter_bounds_steps);
+    RUN_TEST(test_nan_passes_without_touching_state);
+    RUN_TEST(test_chain_on_noisy_humidity_never_triggers_watering);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_default_config_is_pass_through);
+    RUN_TEST(test_median_removes_single_reading_drops);
+    RUN_TEST(test_median_even_and_clamped_window);
+    RUN_TEST(test_spike_rejects_outliers_and_follows_watering);
+    RUN_TEST(test_ema_smooths_noise);
+    RUN_TEST(test_rate_limiter_bounds_steps);
+    RUN_TEST(test_nan_passes_without_touching_state);
+    RUN_TEST(test_chain_on_noisy_humidity_never_triggers_watering);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,136 @@
+#include <unity.h>
+#include "libs/common/concurrency/SpscQueue.h"
+#include <string>
+
+#ifdef NATIVE_TEST
+#include <thread>
+#endif
+
+using common::concurrency::SpscQueue;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_spsc_fifo_order()
+{
+    SpscQueue<int, 4> queue;
+    TEST_ASSERT_TRUE(queue.empty());
+
+    TEST_ASSERT_TRUE(queue.push(1));
+    TEST_ASSERT_TRUE(queue.push(2));
+    TEST_ASSERT_TRUE(queue.push(3));
+    TEST_ASSERT_EQUAL(3, queue.size());
+
+    int value = 0;
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL(1, value);
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL(2, value);
+    TEST_ASSERT_TRUE(queue.pop(value));
+    TEST_ASSERT_EQUAL(3, value);
+    TEST_ASSERT_FALSE(queue.pop(value));
+}
+
+void test_spsc_full_queue_drops_and_counts()
+{
+    SpscQueue<int, 2> queue;
+    TEST_ASSERT_TRUE(queue.push(1));
+    TEST_ASSERT_TRUE(queue.push(2));
+    TEST_ASSERT_FALSE(queue.push(3));
+    TEST_ASSERT_EQUAL_UINT32(1, queue.dropped());
+
+    int value = 0;
+    queue.pop(value);
+    TEST_ASSERT_TRUE(queue.push(4));
+    queue.pop(value);
+    TEST_ASSERT_EQUAL(2, value);
+    queue.pop(value);
+    TEST_ASSERT_EQUAL(4, value);
+}
+
+void test_spsc_wraps_around()
+{
+    SpscQueue<int, 4> queue;
+    int value = 0;
+    for (int i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_TRUE(queue.push(i));
+        TEST_ASSERT_TRUE(queue.pop(value));
+        TEST_ASSERT_EQUAL(i, value);
+    }
+    TEST_ASSERT_TRUE(queue.empty());
+}
+
+void test_spsc_moves_non_trivial_items()
+{
+    SpscQueue<std::string, 4> queue;
+    queue.push(std::string(64, 'x'));
+
+    std::string out;
+    TEST_ASSERT_TRUE(queue.pop(out));
+    TEST_ASSERT_EQUAL(64, out.size());
+}
+
+#ifdef NATIVE_TEST
+void test_spsc_concurrent_producer_consumer()
+{
+    static SpscQueue<uint32_t, 16> queue;
+    constexpr uint32_t COUNT = 200000;
+
+    std::thread producer([]() {
+        for (uint32_t i = 0; i < COUNT;)
+        {
+            if (queue.push(i))
+            {
+                i++;
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    bool ordered = true;
+    while (expected < COUNT)
+    {
+        uint32_t value;
+        if (queue.pop(value))
+        {
+            ordered = ordered && value == expected;
+            expected++;
+        }
+    }
+    producer.join();
+
+    TEST_ASSERT_TRUE(ordered);
+    TEST_ASSERT_TRUE(queue.empty());
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_spsc_fifo_order);
+    RUN_TEST(test_spsc_full_queue_drops_and_counts);
+    RUN_TEST(test_spsc_wraps_around);
+    RUN_TEST(test_spsc_moves_non_trivial_items);
+    RUN_TEST(test_spsc_concurrent_producer_consumer);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_spsc_fifo_order);
+    RUN_TEST(test_spsc_full_queue_drops_and_counts);
+    RUN_TEST(test_spsc_wraps_around);
+    RUN_TEST(test_spsc_moves_non_trivial_items);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,267 @@
+#include <unity.h>
+#include "libs/plant_nanny/states/StateMachine.h"
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+
+using namespace plant_nanny;
+using services::button::ButtonEvent;
+
+// Compile-time checks of the transition table
+static_assert(isAllowed(StateId::None, StateId::Normal));
+static_assert(isAllowed(StateId::Normal, StateId::Pairing));
+static_assert(!isAllowed(StateId::Pairing, StateId::Resetting));
+static_assert(!isAllowed(StateId::Resetting, StateId::Normal));
+static_assert(!isAllowed(StateId::Normal, StateId::Normal));
+
+#ifdef NATIVE_TEST
+// Counts heap allocations so transitions can be checked allocation-free
+static size_t g_allocations = 0;
+
+void *operator new(size_t size)
+{
+    g_allocations++;
+    if (void *p = std::malloc(size))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+#endif
+
+namespace
+{
+    uint32_t fake_now_ms = 0;
+
+    class FakeContext : public AppContext
+    {
+    public:
+        ui::ScreenManager screens;
+        ui::screens::PairingScreen pairing;
+        std::string pin;
+        StateId requested = StateId::None;
+
+        ui::ScreenManager &screenManager() override { return screens; }
+        void setCurrentPin(const std::string &value) override { pin = value; }
+        const std::string &currentPin() const override { return pin; }
+        ui::screens::PairingScreen &pairingScreen() override { return pairing; }
+        void requestTransition(StateId stateId) override { requested = stateId; }
+        void armStateTimeout(uint32_t) override {}
+        void restart() override {}
+    };
+
+    class FakeState : public IAppState
+    {
+    public:
+        StateId stateId;
+        StateId onLeftLong = StateId::None;
+        StateId onRightLong = StateId::None;
+        int enters = 0;
+        int exits = 0;
+        int updates = 0;
+
+        explicit FakeState(StateId id) : stateId(id) {}
+
+        StateId id() const override { return stateId; }
+        void onEnter(AppContext &) override { enters++; }
+        void onExit(AppContext &) override { exits++; }
+        void update(AppContext &) override { updates++; }
+
+        StateId handleButton(AppContext &, ButtonEvent event) override
+        {
+            switch (event)
+            {
+                case ButtonEvent::LEFT_LONG_PRESS:  return onLeftLong;
+                case ButtonEvent::RIGHT_LONG_PRESS: return onRightLong;
+                default:                            return StateId::None;
+            }
+        }
+    };
+
+    struct Fixture
+    {
+        FakeContext context;
+        std::shared_ptr<FakeState> normal = std::make_shared<FakeState>(StateId::Normal);
+        std::shared_ptr<FakeState> pairing = std::make_shared<FakeState>(StateId::Pairing);
+        std::shared_ptr<FakeState> resetting = std::make_shared<FakeState>(StateId::Resetting);
+        StateMachine machine{[]() { return fake_now_ms; }};
+
+        Fixture()
+        {
+            fake_now_ms = 0;
+            normal->onLeftLong = StateId::Pairing;
+            normal->onRightLong = StateId::Resetting;
+            pairing->onRightLong = StateId::Resetting;  // Not in the table
+            machine.registerState(normal);
+            machine.registerState(pairing);
+            machine.registerState(resetting);
+        }
+    };
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_state_machine_boot_and_button_transitions()
+{
+    Fixture f;
+    TEST_ASSERT_TRUE(f.machine.transitionTo(StateId::Normal, f.context));
+    TEST_ASSERT_EQUAL(1, f.normal->enters);
+
+    f.machine.handleButton(f.context, ButtonEvent::LEFT_LONG_PRESS);
+    TEST_ASSERT_TRUE(f.machine.currentStateId() == StateId::Pairing);
+    TEST_ASSERT_EQUAL(1, f.normal->exits);
+    TEST_ASSERT_EQUAL(1, f.pairing->enters);
+
+    f.machine.update(f.context);
+    TEST_ASSERT_EQUAL(1, f.pairing->updates);
+}
+
+void test_state_machine_rejects_transition_not_in_table()
+{
+    Fixture f;
+    f.machine.transitionTo(StateId::Normal, f.context);
+    f.machine.transitionTo(StateId::Pairing, f.context);
+
+    f.machine.handleButton(f.context, ButtonEvent::RIGHT_LONG_PRESS);
+    TEST_ASSERT_TRUE(f.machine.currentStateId() == StateId::Pairing);
+    TEST_ASSERT_EQUAL(0, f.pairing->exits);
+    TEST_ASSERT_EQUAL(0, f.resetting->enters);
+
+    const TransitionRecord &last = f.machine.trace().at(f.machine.trace().size() - 1);
+    TEST_ASSERT_FALSE(last.accepted);
+    TEST_ASSERT_TRUE(last.cause == TransitionCause::Button);
+    TEST_ASSERT_EQUAL_UINT32(1, f.machine.trace().rejected());
+}
+
+void test_state_machine_rejects_unregistered_state()
+{
+    FakeContext context;
+    StateMachine machine;
+    TEST_ASSERT_FALSE(machine.transitionTo(StateId::Normal, context));
+    TEST_ASSERT_TRUE(machine.currentStateId() == StateId::None);
+}
+
+void test_state_machine_trace_records_time_and_cause()
+{
+    Fixture f;
+    fake_now_ms = 100;
+    f.machine.transitionTo(StateId::Normal, f.context);
+    fake_now_ms = 250;
+    f.machine.handleButton(f.context, ButtonEvent::LEFT_LONG_PRESS);
+
+    const TransitionTrace &trace = f.machine.trace();
+    TEST_ASSERT_EQUAL(2, trace.size());
+    TEST_ASSERT_EQUAL_UINT32(100, trace.at(0).atMs);
+    TEST_ASSERT_TRUE(trace.at(0).from == StateId::None);
+    TEST_ASSERT_TRUE(trace.at(0).cause == TransitionCause::Request);
+    TEST_ASSERT_EQUAL_UINT32(250, trace.at(1).atMs);
+    TEST_ASSERT_TRUE(trace.at(1).to == StateId::Pairing);
+    TEST_ASSERT_TRUE(trace.at(1).cause == TransitionCause::Button);
+}
+
+void test_state_machine_trace_keeps_latest_records()
+{
+    TransitionTrace trace;
+    for (uint32_t i = 0; i < TransitionTrace::CAPACITY + 5; i++)
+    {
+        TransitionRecord record;
+        record.atMs = i;
+        record.accepted = true;
+        trace.record(record);
+    }
+
+    TEST_ASSERT_EQUAL(TransitionTrace::CAPACITY, trace.size());
+    TEST_ASSERT_EQUAL_UINT32(TransitionTrace::CAPACITY + 5, trace.total());
+    TEST_ASSERT_EQUAL_UINT32(5, trace.at(0).atMs);
+    TEST_ASSERT_EQUAL_UINT32(TransitionTrace::CAPACITY + 4, trace.at(TransitionTrace::CAPACITY - 1).atMs);
+}
+
+void test_state_machine_trace_json()
+{
+    Fixture f;
+    fake_now_ms = 42;
+    f.machine.transitionTo(StateId::Normal, f.context);
+
+    char buffer[256];
+    size_t length = f.machine.trace().toJson(buffer, sizeof(buffer), f.machine.currentStateId(), 99);
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+    TEST_ASSERT_EQUAL_STRING(
+        "{\"type\":\"state_trace\",\"now\":99,\"current\":\"normal\",\"total\":1,\"rejected\":0,"
+        "\"transitions\":[{\"t\":42,\"from\":\"none\",\"to\":\"normal\",\"cause\":\"request\",\"ok\":true}]}",
+        buffer);
+
+    char small[32];
+    TEST_ASSERT_EQUAL(0, f.machine.trace().toJson(small, sizeof(small), f.machine.currentStateId(), 99));
+}
+
+void test_state_machine_full_trace_fits_diagnostics_buffer()
+{
+    TransitionTrace trace;
+    for (size_t i = 0; i < TransitionTrace::CAPACITY; i++)
+    {
+        TransitionRecord record;
+        record.atMs = UINT32_MAX;
+        record.from = StateId::Resetting;
+        record.to = StateId::Resetting;
+        trace.record(record);
+    }
+
+    char buffer[1536];  // App::DiagnosticMessage
+    TEST_ASSERT_TRUE(trace.toJson(buffer, sizeof(buffer), StateId::Resetting, UINT32_MAX) > 0);
+}
+
+#ifdef NATIVE_TEST
+void test_state_machine_transitions_do_not_allocate()
+{
+    Fixture f;
+    f.machine.transitionTo(StateId::Normal, f.context);
+
+    size_t before = g_allocations;
+    f.machine.handleButton(f.context, ButtonEvent::LEFT_LONG_PRESS);
+    f.machine.transitionTo(StateId::Normal, f.context);
+    f.machine.handleButton(f.context, ButtonEvent::RIGHT_SHORT_PRESS);
+    f.machine.transitionTo(StateId::Resetting, f.context);
+    TEST_ASSERT_EQUAL(before, g_allocations);
+}
+
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_state_machine_boot_and_button_transitions);
+    RUN_TEST(test_state_machine_rejects_transition_not_in_table);
+    RUN_TEST(test_state_machine_rejects_unregistered_state);
+    RUN_TEST(test_state_machine_trace_records_time_and_cause);
+    RUN_TEST(test_state_machine_trace_keeps_latest_records);
+    RUN_TEST(test_state_machine_trace_json);
+    RUN_TEST(test_state_machine_full_trace_fits_diagnostics_buffer);
+    RUN_TEST(test_state_machine_transitions_do_not_allocate);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_state_machine_boot_and_button_transitions);
+    RUN_TEST(test_state_machine_rejects_transition_not_in_table);
+    RUN_TEST(test_state_machine_rejects_unregistered_state);
+    RUN_TEST(test_state_machine_trace_records_time_and_cause);
+    RUN_TEST(test_state_machine_trace_keeps_latest_records);
+    RUN_TEST(test_state_machine_trace_json);
+    RUN_TEST(test_state_machine_full_trace_fits_diagnostics_buffer);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
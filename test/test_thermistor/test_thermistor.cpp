@@ -0,0 +1,184 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/captors/temperature/Temperature.h"
+#include <cmath>
+
+using namespace plant_nanny::services::captors::temperature;
+
+namespace
+{
+    // Board wiring, as in SensorManagerConfig::defaultConfig()
+    ThermistorConfig boardConfig()
+    {
+        ThermistorConfig config;
+        config.nominalResistance = 10000.0f;
+        config.nominalTemperature = 25.0f;
+        config.betaCoefficient = 3950.0f;
+        config.seriesResistance = 5600.0f;
+        return config;
+    }
+
+    // The per-reading conversion the table replaced
+    float betaEquation(const ThermistorConfig &config, float adcValue)
+    {
+        float resistance = config.seriesResistance * ((4095 - adcValue) / adcValue);
+        float steinhart = log(resistance / config.nominalResistance);
+        steinhart /= config.betaCoefficient;
+        steinhart += 1.0f / (config.nominalTemperature + 273.15f);
+        steinhart = 1.0f / steinhart;
+        return steinhart - 273.15f;
+    }
+
+    // ADC reading of a thermistor at the given temperature (Beta model)
+    double adcAt(const ThermistorConfig &config, double celsius)
+    {
+        double resistance = config.nominalResistance *
+                            std::exp(config.betaCoefficient * (1.0 / (celsius + 273.15) - 1.0 / (config.nominalTemperature + 273.15)));
+        return 4095.0 * config.seriesResistance / (resistance + config.seriesResistance);
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_constexpr_ln_matches_std()
+{
+    const double values[] = {0.001, 0.5, 1.0, 1.999, 2.0, 10000.0, 123456.0};
+    for (double value : values)
+    {
+        TEST_ASSERT_TRUE(std::fabs(detail::ln(value) - std::log(value)) < 1e-12);
+    }
+}
+
+void test_table_accuracy_minus_20_to_60()
+{
+    ThermistorConfig config = boardConfig();
+    ThermistorTable<> table(config);
+
+    for (double celsius = -20.0; celsius <= 60.0; celsius += 0.5)
+    {
+        double adc = adcAt(config, celsius);
+        TEST_ASSERT_TRUE(std::fabs(thermistorTemperature(config, adc) - celsius) < 1e-6);
+        TEST_ASSERT_FLOAT_WITHIN(0.05f, static_cast<float>(celsius), table.lookup(static_cast<float>(adc)));
+    }
+}
+
+void test_table_matches_previous_conversion()
+{
+    ThermistorConfig config = boardConfig();
+    Temperature sensor;
+    sensor.initialize(33);
+    sensor.configure(config);
+
+    for (float adc = 200.0f; adc < 2900.0f; adc += 7.3f)
+    {
+        TEST_ASSERT_FLOAT_WITHIN(0.05f, betaEquation(config, adc), sensor.convert(adc));
+    }
+}
+
+void test_table_rails_are_nan()
+{
+    TEST_ASSERT_TRUE(std::isnan(DEFAULT_THERMISTOR_TABLE.lookup(0.0f)));
+    TEST_ASSERT_TRUE(std::isnan(DEFAULT_THERMISTOR_TABLE.lookup(10.0f)));
+    TEST_ASSERT_TRUE(std::isnan(DEFAULT_THERMISTOR_TABLE.lookup(4085.0f)));
+    TEST_ASSERT_TRUE(std::isnan(DEFAULT_THERMISTOR_TABLE.lookup(NAN)));
+    TEST_ASSERT_FALSE(std::isnan(DEFAULT_THERMISTOR_TABLE.lookup(4084.0f)));
+}
+
+void test_default_table_is_compile_time()
+{
+    constexpr float midScale = DEFAULT_THERMISTOR_TABLE.lookup(2047.5f);
+    static_assert(midScale > 24.9f && midScale < 25.1f);
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, 25.0f, midScale);
+}
+
+void test_steinhart_hart_fit_reproduces_points()
+{
+    // NTC 10k datasheet values
+    constexpr SteinhartHartCoefficients coefficients = fitSteinhartHart(-20.0, 97070.0, 25.0, 10000.0, 60.0, 2488.0);
+
+    ThermistorConfig config = boardConfig();
+    config.steinhartHart = coefficients;
+    TEST_ASSERT_TRUE(config.steinhartHart.isSet());
+
+    const double points[][2] = {{-20.0, 97070.0}, {25.0, 10000.0}, {60.0, 2488.0}};
+    ThermistorTable<> table(config);
+    for (const auto &point : points)
+    {
+        double adc = 4095.0 * config.seriesResistance / (point[1] + config.seriesResistance);
+        TEST_ASSERT_TRUE(std::fabs(thermistorTemperature(config, adc) - point[0]) < 0.05);
+        TEST_ASSERT_FLOAT_WITHIN(0.1f, static_cast<float>(point[0]), table.lookup(static_cast<float>(adc)));
+    }
+}
+
+#ifdef NATIVE_TEST
+#include <chrono>
+#include <cstdio>
+
+void test_benchmark_table_against_beta_equation()
+{
+    ThermistorConfig config = boardConfig();
+    Temperature sensor;
+    sensor.initialize(33);
+    sensor.configure(config);
+
+    constexpr int ROUNDS = 200;
+    volatile float sink = 0.0f;
+    auto measure = [&](auto convert)
+    {
+        auto start = std::chrono::steady_clock::now();
+        for (int round = 0; round < ROUNDS; round++)
+        {
+            for (int adc = 200; adc < 2900; adc++)
+            {
+                sink = sink + convert(static_cast<float>(adc) + 0.25f);
+            }
+        }
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+               (ROUNDS * 2700.0);
+    };
+
+    double betaNs = measure([&](float adc) { return betaEquation(config, adc); });
+    double tableNs = measure([&](float adc) { return sensor.convert(adc); });
+
+    char message[96];
+    snprintf(message, sizeof(message), "Beta equation %.1f ns, table %.1f ns per conversion", betaNs, tableNs);
+    TEST_MESSAGE(message);
+    TEST_ASSERT_TRUE(tableNs < betaNs);
+}
+#endif
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_constexpr_ln_matches_std);
+    RUN_TEST(test_table_accuracy_minus_20_to_60);
+    RUN_TEST(test_table_matches_previous_conversion);
+    RUN_TEST(test_table_rails_are_nan);
+    RUN_TEST(test_default_table_is_compile_time);
+    RUN_TEST(test_steinhart_hart_fit_reproduces_points);
+    RUN_TEST(test_benchmark_table_against_beta_equation);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_constexpr_ln_matches_std);
+    RUN_TEST(test_table_accuracy_minus_20_to_60);
+    RUN_TEST(test_table_matches_previous_conversion);
+    RUN_TEST(test_table_rails_are_nan);
+    RUN_TEST(test_default_table_is_compile_time);
+    RUN_TEST(test_steinhart_hart_fit_reproduces_points);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,148 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/timesync/SyncedClock.h"
+
+using namespace plant_nanny::services::timesync;
+
+void setUp(void) {}
+void tearDown(void) {}
+
+namespace
+{
+    constexpr int64_t JAN_2025_MS = 1735689600000LL;
+}
+
+void test_unsynced_clock_reads_zero()
+{
+    SyncedClock clock;
+    TEST_ASSERT_FALSE(clock.synced());
+    TEST_ASSERT_EQUAL_INT64(0, clock.unixMs(5000));
+}
+
+void test_rejects_unset_rtc_time()
+{
+    SyncedClock clock;
+    // What time(nullptr) returns before any sync: a few seconds after 1970
+    TEST_ASSERT_FALSE(clock.sync(5000, 5000));
+    TEST_ASSERT_FALSE(clock.synced());
+    TEST_ASSERT_EQUAL_UINT32(0, clock.status().syncCount);
+}
+
+void test_first_sync_dates_earlier_samples()
+{
+    SyncedClock clock;
+    TEST_ASSERT_TRUE(clock.sync(60000, JAN_2025_MS));
+
+    // Sample acquired 50 s before the sync, dated after it
+    TEST_ASSERT_EQUAL_INT64(JAN_2025_MS - 50000, clock.unixMs(10000));
+    TEST_ASSERT_EQUAL_INT64(JAN_2025_MS + 1000, clock.unixMs(61000));
+    TEST_ASSERT_EQUAL_UINT32(0, clock.status().stepCount);
+}
+
+void test_small_error_is_slewed()
+{
+    SyncedClock clock;
+    clock.sync(0, JAN_2025_MS);
+
+    // Monotonic clock 500 ms slow over an hour
+    const uint64_t hour = 3600000;
+    TEST_ASSERT_TRUE(clock.sync(hour, JAN_2025_MS + hour + 500));
+    TEST_ASSERT_EQUAL_INT32(500, clock.status().lastErrorMs);
+    TEST_ASSERT_EQUAL_UINT32(0, clock.status().stepCount);
+
+    // Not applied at once, fully applied after 500 * SLEW_DIVISOR ms
+    TEST_ASSERT_EQUAL_INT64(JAN_2025_MS + hour, clock.unixMs(hour));
+    TEST_ASSERT_EQUAL_INT64(JAN_2025_MS + hour + 10000 + 50, clock.unixMs(hour + 10000));
+    const uint64_t done = hour + 500 * SyncedClock::SLEW_DIVISOR;
+    TEST_ASSERT_EQUAL_INT64(JAN_2025_MS + done + 500, clock.unixMs(done));
+    TEST_ASSERT_EQUAL_INT64(JAN_2025_MS + done + 60500, clock.unixMs(done + 60000));
+}
+
+void test_backward_slew_keeps_time_moving_forward()
+{
+    SyncedClock clock;
+    clock.sync(0, JAN_2025_MS);
+    clock.sync(1000000, JAN_2025_MS + 1000000 - 1500);
+
+    int64_t previous = clock.unixMs(1000000);
+    for (uint64_t t = 1000000; t < 1400000; t += 10)
+    {
+        int64_t now = clock.unixMs(t);
+        TEST_ASSERT_TRUE(now >= previous);
+        previous = now;
+    }
+    TEST_ASSERT_EQUAL_INT64(JAN_2025_MS + 1400000 - 1500, clock.unixMs(1400000));
+}
+
+void test_large_error_steps()
+{
+    SyncedClock clock;
+    clock.sync(0, JAN_2025_MS);
+    TEST_ASSERT_TRUE(clock.sync(10000, JAN_2025_MS + 10000 + 30000));
+
+    TEST_ASSERT_EQUAL_UINT32(1, clock.status().stepCount);
+    TEST_ASSERT_EQUAL_INT32(30000, clock.status().lastErrorMs);
+    TEST_ASSERT_EQUAL_INT64(JAN_2025_MS + 40000, clock.unixMs(10000));
+}
+
+void test_resync_during_slew_folds_progress()
+{
+    SyncedClock clock;
+    clock.sync(0, JAN_2025_MS);
+    clock.sync(100000, JAN_2025_MS + 100000 + 1000);
+
+    // Half the correction went in; the server now agrees with our estimate
+    const uint64_t t = 100000 + 500 * SyncedClock::SLEW_DIVISOR;
+    TEST_ASSERT_TRUE(clock.sync(t, JAN_2025_MS + t + 500));
+    TEST_ASSERT_EQUAL_INT32(0, clock.status().lastErrorMs);
+    TEST_ASSERT_EQUAL_INT64(JAN_2025_MS + t + 500 + 60000, clock.unixMs(t + 60000));
+    TEST_ASSERT_EQUAL_UINT32(3, clock.status().syncCount);
+}
+
+void test_widen_millis_stamp()
+{
+    TEST_ASSERT_EQUAL_UINT64(9000, SyncedClock::widen(9000, 10000));
+    // millis() wrapped between acquisition and now
+    const uint64_t now = 0x100000010ULL;
+    TEST_ASSERT_EQUAL_UINT64(now - 0x20, SyncedClock::widen(0xFFFFFFF0u, now));
+    // Stamp from before boot (e.g. zero-initialised) clamps to 0
+    TEST_ASSERT_EQUAL_UINT64(0, SyncedClock::widen(20000, 10000));
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_unsynced_clock_reads_zero);
+    RUN_TEST(test_rejects_unset_rtc_time);
+    RUN_TEST(test_first_sync_dates_earlier_samples);
+    RUN_TEST(test_small_error_is_slewed);
+    RUN_TEST(test_backward_slew_keeps_time_moving_forward);
+    RUN_TEST(test_large_error_steps);
+    RUN_TEST(test_resync_during_slew_folds_progress);
+    RUN_TEST(test_widen_millis_stamp);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_unsynced_clock_reads_zero);
+    RUN_TEST(test_rejects_unset_rtc_time);
+    RUN_TEST(test_first_sync_dates_earlier_samples);
+    RUN_TEST(test_small_error_is_slewed);
+    RUN_TEST(test_backward_slew_keeps_time_moving_forward);
+    RUN_TEST(test_large_error_steps);
+    RUN_TEST(test_resync_during_slew_folds_progress);
+    RUN_TEST(test_widen_millis_stamp);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif
@@ -0,0 +1,177 @@
+#include <unity.h>
+#include "libs/plant_nanny/services/bluetooth/WifiScanResults.h"
+#include <cstdio>
+#include <cstring>
+
+using plant_nanny::services::bluetooth::WifiScanResults;
+
+namespace
+{
+    bool add(WifiScanResults &results, const char *ssid, int8_t rssi)
+    {
+        return results.add(ssid, strlen(ssid), rssi);
+    }
+}
+
+void setUp(void) {}
+void tearDown(void) {}
+
+void test_wifi_scan_results_sorted_by_rssi()
+{
+    WifiScanResults results;
+    TEST_ASSERT_TRUE(add(results, "weak", -80));
+    TEST_ASSERT_TRUE(add(results, "strong", -40));
+    TEST_ASSERT_TRUE(add(results, "middle", -60));
+
+    TEST_ASSERT_EQUAL(3, results.size());
+    TEST_ASSERT_EQUAL_STRING("strong", results.at(0).ssid);
+    TEST_ASSERT_EQUAL_STRING("middle", results.at(1).ssid);
+    TEST_ASSERT_EQUAL_STRING("weak", results.at(2).ssid);
+}
+
+void test_wifi_scan_results_dedup_keeps_strongest()
+{
+    WifiScanResults results;
+    add(results, "home", -70);
+    add(results, "office", -60);
+
+    // Same SSID seen from another access point or channel
+    TEST_ASSERT_FALSE(add(results, "home", -75));
+    TEST_ASSERT_EQUAL(2, results.size());
+    TEST_ASSERT_EQUAL_STRING("office", results.at(0).ssid);
+
+    TEST_ASSERT_TRUE(add(results, "home", -50));
+    TEST_ASSERT_EQUAL(2, results.size());
+    TEST_ASSERT_EQUAL_STRING("home", results.at(0).ssid);
+    TEST_ASSERT_EQUAL_INT8(-50, results.at(0).rssi);
+}
+
+void test_wifi_scan_results_ignores_empty_and_long_ssids()
+{
+    WifiScanResults results;
+    TEST_ASSERT_FALSE(results.add("", 0, -30));
+    TEST_ASSERT_FALSE(add(results, "123456789012345678901234567890123", -30));
+    TEST_ASSERT_TRUE(add(results, "12345678901234567890123456789012", -30));
+    TEST_ASSERT_EQUAL(1, results.size());
+}
+
+void test_wifi_scan_results_full_evicts_weakest()
+{
+    WifiScanResults results;
+    char ssid[16];
+    for (size_t i = 0; i < WifiScanResults::CAPACITY; i++)
+    {
+        snprintf(ssid, sizeof(ssid), "net%u", static_cast<unsigned>(i));
+        add(results, ssid, static_cast<int8_t>(-50 - static_cast<int>(i)));
+    }
+    const char *weakest = "net9";
+    TEST_ASSERT_EQUAL_STRING(weakest, results.at(WifiScanResults::CAPACITY - 1).ssid);
+
+    TEST_ASSERT_FALSE(add(results, "weaker", -90));
+    TEST_ASSERT_TRUE(add(results, "stronger", -20));
+    TEST_ASSERT_EQUAL(WifiScanResults::CAPACITY, results.size());
+    TEST_ASSERT_EQUAL_STRING("stronger", results.at(0).ssid);
+
+    // The evicted network is gone from the hash set, known ones are still deduped
+    TEST_ASSERT_TRUE(add(results, weakest, -10));
+    TEST_ASSERT_EQUAL_STRING(weakest, results.at(0).ssid);
+    TEST_ASSERT_FALSE(add(results, "net0", -90));
+    TEST_ASSERT_EQUAL(WifiScanResults::CAPACITY, results.size());
+}
+
+void test_wifi_scan_results_clear()
+{
+    WifiScanResults results;
+    add(results, "home", -70);
+    results.clear();
+    TEST_ASSERT_EQUAL(0, results.size());
+    TEST_ASSERT_TRUE(add(results, "home", -70));
+}
+
+void test_wifi_scan_results_json_escapes()
+{
+    WifiScanResults results;
+    add(results, "a\"b", -40);
+    add(results, "c\\d", -50);
+    add(results, "e\nf", -60);
+
+    char buffer[64];
+    size_t length = results.toJson(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING("[\"a\\\"b\",\"c\\\\d\",\"ef\"]", buffer);
+    TEST_ASSERT_EQUAL(strlen(buffer), length);
+}
+
+void test_wifi_scan_results_json_drops_what_does_not_fit()
+{
+    WifiScanResults results;
+    char buffer[16];
+    TEST_ASSERT_EQUAL(2, results.toJson(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("[]", buffer);
+
+    add(results, "first", -40);
+    add(results, "second", -50);
+    results.toJson(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING("[\"first\"]", buffer);
+
+    TEST_ASSERT_EQUAL(0, results.toJson(buffer, 2));
+}
+
+void test_wifi_scan_results_full_list_fits_characteristic()
+{
+    WifiScanResults results;
+    char ssid[WifiScanResults::MAX_SSID_LENGTH + 1];
+    for (size_t i = 0; i < WifiScanResults::CAPACITY; i++)
+    {
+        memset(ssid, '"', WifiScanResults::MAX_SSID_LENGTH);
+        snprintf(ssid, sizeof(ssid), "%02u", static_cast<unsigned>(i));
+        ssid[2] = '"';
+        ssid[WifiScanResults::MAX_SSID_LENGTH] = '\0';
+        add(results, ssid, -50);
+    }
+
+    // Worst case escaping still leaves a valid array inside the 512 B attribute
+    char buffer[512];
+    size_t length = results.toJson(buffer, sizeof(buffer));
+    TEST_ASSERT_TRUE(length > 0);
+    TEST_ASSERT_EQUAL('[', buffer[0]);
+    TEST_ASSERT_EQUAL(']', buffer[length - 1]);
+}
+
+#ifdef NATIVE_TEST
+int main(int argc, char **argv)
+{
+    UNITY_BEGIN();
+
+    RUN_TEST(test_wifi_scan_results_sorted_by_rssi);
+    RUN_TEST(test_wifi_scan_results_dedup_keeps_strongest);
+    RUN_TEST(test_wifi_scan_results_ignores_empty_and_long_ssids);
+    RUN_TEST(test_wifi_scan_results_full_evicts_weakest);
+    RUN_TEST(test_wifi_scan_results_clear);
+    RUN_TEST(test_wifi_scan_results_json_escapes);
+    RUN_TEST(test_wifi_scan_results_json_drops_what_does_not_fit);
+    RUN_TEST(test_wifi_scan_results_full_list_fits_characteristic);
+
+    return UNITY_END();
+}
+#else
+#include <Arduino.h>
+
+void setup()
+{
+    delay(2000);
+    UNITY_BEGIN();
+
+    RUN_TEST(test_wifi_scan_results_sorted_by_rssi);
+    RUN_TEST(test_wifi_scan_results_dedup_keeps_strongest);
+    RUN_TEST(test_wifi_scan_results_ignores_empty_and_long_ssids);
+    RUN_TEST(test_wifi_scan_results_full_evicts_weakest);
+    RUN_TEST(test_wifi_scan_results_clear);
+    RUN_TEST(test_wifi_scan_results_json_escapes);
+    RUN_TEST(test_wifi_scan_results_json_drops_what_does_not_fit);
+    RUN_TEST(test_wifi_scan_results_full_list_fits_characteristic);
+
+    UNITY_END();
+}
+
+void loop() {}
+#endif